@@ -40,7 +40,23 @@ using std::cout;
 using std::endl;
 
 // forward class declaration
-class plot3dBlock;
+class plot3dBlockRange;
+template <typename T>
+class multiArray3d;
+
+// classification of a block face by what lies on the other side of it
+enum class faceType : unsigned char {
+  interior,     // face between two physical cells of the block
+  interblock,   // face on a connection to another block
+  viscousWall,  // face on a viscous wall
+  boundary      // face on any other boundary condition
+};
+
+// function to determine if the cell on the other side of a face is part of
+// the solution domain (a physical cell of this block or of a connected block)
+inline bool FaceHasNeighbor(const faceType &type) {
+  return type == faceType::interior || type == faceType::interblock;
+}
 
 class boundarySurface {
   string bcType_;    // boundary condition name for surface
@@ -129,10 +145,10 @@ class patch {
   // Constructor
   patch();
   patch(const int&, const int&, const int&, const int&, const int&, const int&,
-        const int&, const int&, const plot3dBlock&, const int&, const int&,
-        const bool(&)[4]);
-  patch(const boundarySurface &surf, const plot3dBlock &blk, const int &bNum,
-        const bool (&border)[4], int r = 0, int l = 0) :
+        const int&, const int&, const plot3dBlockRange&, const int&,
+        const int&, const bool(&)[4]);
+  patch(const boundarySurface &surf, const plot3dBlockRange &blk,
+        const int &bNum, const bool (&border)[4], int r = 0, int l = 0) :
       patch(surf.SurfaceType(), bNum, surf.IMin(), surf.IMax(), surf.JMin(),
             surf.JMax(), surf.KMin(), surf.KMax(), blk, r, l, border) {}
 
@@ -227,18 +243,21 @@ class boundaryConditions {
 
   string GetBCName(const int&, const int&, const int&, const int&) const;
   int GetBCTag(const int&, const int&, const int&, const int&) const;
+  void ClassifyFaces(multiArray3d<faceType>&, multiArray3d<faceType>&,
+                     multiArray3d<faceType>&) const;
 
   void AssignFromInput(const int&, const vector<string>&);
 
   boundaryConditions Split(const string&, const int&, const int&,
                            const int&, vector<boundarySurface>&);
-  void DependentSplit(const boundarySurface&, const plot3dBlock&,
-                      const plot3dBlock&, const int&, const string&,
+  void DependentSplit(const boundarySurface&, const plot3dBlockRange&,
+                      const plot3dBlockRange&, const int&, const string&,
                       const int&, const int&, const int&);
   void Join(const boundaryConditions&, const string&, vector<boundarySurface>&);
 
   void BordersSurface(const int&, bool (&)[4]) const;
 
+  int PackSize() const;
   void PackBC(char*(&), const int&, int&) const;
   void UnpackBC(char*(&), const int&, int&);
 
@@ -395,18 +414,18 @@ class decomposition {
   int ParentBlock(const int &a) const {return parBlock_[a];}
   int LocalPosition(const int &a) const {return localPos_[a];}
   int NumProcs() const {return numProcs_;}
-  double IdealLoad(const vector<plot3dBlock>&) const;
-  double MaxLoad(const vector<plot3dBlock>&) const;
-  double MinLoad(const vector<plot3dBlock>&) const;
-  double ProcLoad(const vector<plot3dBlock>&, const int&) const;
-  double LoadRatio(const vector<plot3dBlock>&, const int&) const;
-  int MostOverloadedProc(const vector<plot3dBlock>&, double&) const;
-  int MostUnderloadedProc(const vector<plot3dBlock>&, double&) const;
+  double IdealLoad(const vector<plot3dBlockRange>&) const;
+  double MaxLoad(const vector<plot3dBlockRange>&) const;
+  double MinLoad(const vector<plot3dBlockRange>&) const;
+  double ProcLoad(const vector<plot3dBlockRange>&, const int&) const;
+  double LoadRatio(const vector<plot3dBlockRange>&, const int&) const;
+  int MostOverloadedProc(const vector<plot3dBlockRange>&, double&) const;
+  int MostUnderloadedProc(const vector<plot3dBlockRange>&, double&) const;
   int NumBlocksOnProc(const int&) const;
   vector<int> NumBlocksOnAllProc() const;
   void SendToProc(const int&, const int&, const int&);
   void Split(const int&, const int&, const string&);
-  int SendWholeOrSplit(const vector<plot3dBlock>&, const int&,
+  int SendWholeOrSplit(const vector<plot3dBlockRange>&, const int&,
                        const int&, int&, string&) const;
   int Size() const {return static_cast<int> (rank_.size());}
 
@@ -416,7 +435,8 @@ class decomposition {
   int SplitHistIndex(const int &a) const {return splitHistIndex_[a];}
   string SplitHistDir(const int &a) const {return splitHistDir_[a];}
 
-  void PrintDiagnostics(const vector<plot3dBlock>&) const;
+  void PrintDiagnostics(const vector<plot3dBlockRange>&) const;
+  void BroadcastMPI();
 
   // Destructor
   ~decomposition() noexcept {}
@@ -425,7 +445,7 @@ class decomposition {
 
 // Function declarations
 vector<interblock> GetInterblockBCs(const vector<boundaryConditions>&,
-                                    const vector<plot3dBlock>&,
+                                    const vector<plot3dBlockRange>&,
                                     const decomposition&);
 
 ostream & operator<< (ostream &os, const boundaryConditions&);
@@ -0,0 +1,44 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-17  Michael Nucci (michael.nucci@gmail.com)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#ifndef COMPRESSIONHEADERDEF  // only if the macro COMPRESSIONHEADERDEF is not
+                              // defined execute these lines of code
+#define COMPRESSIONHEADERDEF  // define the macro
+
+/* This header contains the functions to losslessly compress and decompress
+   arrays of doubles, which are used for compressed restart files.
+
+   The values are compressed in three steps. First the bits of each value are
+   treated as an integer, and each value is replaced by its difference from
+   the previous value. Neighboring values of a smooth field share their sign,
+   exponent, and leading bits of mantissa, so the leading bytes of the
+   difference are all zeros (or all ones). Second the bytes are shuffled, so
+   that all of the most significant bytes come first, followed by all of the
+   next most significant bytes, and so on. This gathers these bytes into long
+   runs. Last the shuffled bytes are run length encoded (PackBits). Each step
+   is undone in reverse order to decompress the values exactly.
+*/
+
+#include <vector>   // vector
+
+using std::vector;
+
+// function declarations
+vector<unsigned char> CompressDoubles(const vector<double> &);
+void DecompressDoubles(const unsigned char *, const long long &,
+                       vector<double> &);
+
+#endif
@@ -0,0 +1,122 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-17  Michael Nucci (michael.nucci@gmail.com)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#ifndef EXTRACTIONHEADERDEF  // only if the macro EXTRACTIONHEADERDEF is not
+                             // defined execute these lines of code
+#define EXTRACTIONHEADERDEF  // define the macro
+
+/* This header contains the extraction class and the functions to write
+   extractions.
+
+   An extraction is a small part of the solution that is written more often
+   than the full function file. There are three types of extractions. A walls
+   extraction contains every viscousWall and slipWall surface, a plane
+   extraction contains a plane of constant i, j, or k index of a parent block,
+   and a range extraction contains a range of cells of a parent block. They are
+   specified in the input file as shown below, with each extraction on a
+   single line.
+
+   extractions: <extraction(name=surf; type=walls; variables=[skinFriction]),
+   extraction(name=mid; type=plane; block=0; direction=k; index=3),
+   extraction(name=box; type=range; block=0; start=[0, 0, 0]; end=[9, 9, 0])>
+
+   The variables default to the primitive variables. Plane indices and range
+   starts and ends are cell indices of the parent block, and ranges include
+   their end cells. Each extraction is written as a multi-block Plot3D grid
+   and function file pair, with one block for each wall surface, plane, or
+   range. For walls, the grid is made of the face centers of the wall and the
+   variables are taken from the cells adjacent to the wall. The variable
+   skinFriction is the magnitude of the wall shear stress normalized by the
+   freestream dynamic pressure, and is only available for walls. Each
+   processor writes the part of the extraction in its own procBlocks.
+*/
+
+#include <iostream>        // ostream
+#include <fstream>         // ifstream
+#include <string>          // string
+#include <vector>          // vector
+#include <set>             // set
+#include "vector3d.hpp"    // vector3d
+
+using std::ostream;
+using std::ifstream;
+using std::string;
+using std::vector;
+using std::set;
+
+// forward class declarations
+class procBlock;
+class blockLayout;
+class input;
+class idealGas;
+class sutherland;
+class outputWriter;
+
+class extraction {
+  string name_;              // name of extraction, used in file names
+  string type_;              // walls, plane, or range
+  int block_;                // parent block of plane or range
+  string direction_;         // direction normal to plane (i, j, k)
+  int index_;                // cell index of plane
+  vector3d<int> start_;      // first cell of range
+  vector3d<int> end_;        // last cell of range
+  set<string> variables_;    // variables to write
+
+ public:
+  // constructor
+  extraction() : name_("none"), type_("walls"), block_(0), direction_("i"),
+                 index_(0), start_(0, 0, 0), end_(0, 0, 0),
+                 variables_({"density", "vel_x", "vel_y", "vel_z",
+                             "pressure"}) {}
+  explicit extraction(string &);
+
+  // move constructor and assignment operator
+  extraction(extraction&&) noexcept = default;
+  extraction& operator=(extraction&&) noexcept = default;
+
+  // copy constructor and assignment operator
+  extraction(const extraction&) = default;
+  extraction& operator=(const extraction&) = default;
+
+  // member functions
+  string Name() const {return name_;}
+  string Type() const {return type_;}
+  int Block() const {return block_;}
+  string Direction() const {return direction_;}
+  int Index() const {return index_;}
+  vector3d<int> Start() const {return start_;}
+  vector3d<int> End() const {return end_;}
+  const set<string> & Variables() const {return variables_;}
+  int NumVariables() const {return variables_.size();}
+  void SetVariables(const set<string> &vars) {variables_ = vars;}
+  void Print(ostream &) const;
+
+  // destructor
+  ~extraction() noexcept {}
+};
+
+// function declarations
+ostream &operator<<(ostream &, const extraction &);
+vector<extraction> ReadExtractionList(ifstream &, string &);
+
+void WriteExtractionGrids(const vector<procBlock> &, const blockLayout &,
+                          const input &, outputWriter &);
+void WriteExtractions(const vector<procBlock> &, const blockLayout &,
+                      const idealGas &, const sutherland &, const int &,
+                      const input &, outputWriter &);
+void WriteExtractionMeta(const input &, const int &);
+
+#endif
@@ -38,17 +38,19 @@ class input;
 class genArray;
 
 // This class holds the flux jacobians for the flow and turbulence equations.
-// In the LU-SGS method the jacobians are scalars.
+// In the LU-SGS method the jacobians are scalars. The jacobians are stored in
+// fixed size matrices, so a fluxJacobian does not allocate any memory on the
+// heap.
 
 class fluxJacobian {
-  squareMatrix flowJacobian_;
-  squareMatrix turbJacobian_;
+  flowMatrix flowJacobian_;
+  turbMatrix turbJacobian_;
 
  public:
   // constructors
   fluxJacobian(const double &flow, const double &turb);
   fluxJacobian(const int &flowSize, const int &turbSize);
-  fluxJacobian(const squareMatrix &flow, const squareMatrix &turb)
+  fluxJacobian(const flowMatrix &flow, const turbMatrix &turb)
       : flowJacobian_(flow), turbJacobian_(turb) {}
   fluxJacobian() : fluxJacobian(0.0, 0.0) {}
   explicit fluxJacobian(const uncoupledScalar &specRad) :
@@ -63,13 +65,13 @@ class fluxJacobian {
   fluxJacobian& operator=(const fluxJacobian&) = default;
 
   // member functions
-  squareMatrix FlowJacobian() const {return flowJacobian_;}
-  squareMatrix TurbulenceJacobian() const {return turbJacobian_;}
+  flowMatrix FlowJacobian() const {return flowJacobian_;}
+  turbMatrix TurbulenceJacobian() const {return turbJacobian_;}
 
-  void AddToFlowJacobian(const squareMatrix &jac) {flowJacobian_ += jac;}
-  void AddToTurbJacobian(const squareMatrix &jac) {turbJacobian_ += jac;}
-  void SubtractFromFlowJacobian(const squareMatrix &jac) {flowJacobian_ -= jac;}
-  void SubtractFromTurbJacobian(const squareMatrix &jac) {turbJacobian_ -= jac;}
+  void AddToFlowJacobian(const flowMatrix &jac) {flowJacobian_ += jac;}
+  void AddToTurbJacobian(const turbMatrix &jac) {turbJacobian_ += jac;}
+  void SubtractFromFlowJacobian(const flowMatrix &jac) {flowJacobian_ -= jac;}
+  void SubtractFromTurbJacobian(const turbMatrix &jac) {turbJacobian_ -= jac;}
 
   void MultiplyOnDiagonal(const double &, const bool &);
   void AddOnDiagonal(const double &, const bool &);
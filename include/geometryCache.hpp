@@ -0,0 +1,108 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-17  Michael Nucci (michael.nucci@gmail.com)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#ifndef GEOMETRYCACHEHEADERDEF  // only if the macro GEOMETRYCACHEHEADERDEF is
+                                // not defined execute these lines of code
+#define GEOMETRYCACHEHEADERDEF  // define the macro
+
+/* This header contains the geometryCache class.
+
+   At the start of every run the geometry of each procBlock is calculated from
+   the grid, the geometry of the ghost cells is assigned and swapped across
+   interblocks, and the wall distance is calculated. For large grids this can
+   take longer than many iterations of the solver. The geometry cache stores
+   all of this in a binary file the first time it is calculated, and later runs
+   of the same case read it back instead. It is specified in the input file
+   with the name of the cache file.
+
+   geometryCache: <fileName>
+
+   The cache is keyed by a hash of the size, modification time, and header of
+   the grid file, the reference length, the boundary conditions, the
+   decomposition of the grid into procBlocks, the number of ghost cell layers,
+   and the wall distance method. The grid coordinates are not read to calculate
+   the key. If the cache file does not exist or its key does not match, the
+   geometry is calculated as usual and the cache file is (over)written.
+
+   The cache file starts with the format version and the number of procBlocks
+   (ints), the key (an unsigned 64 bit int), the number of interblocks and an
+   unused int. This is followed by the 8 border flags (ints) of each
+   interblock, and then the data of each procBlock in global order, as laid
+   out by procBlock::PackGeometry (doubles). When the cache is read, each
+   processor memory maps the file and copies out the data of its own
+   procBlocks.
+*/
+
+#include <vector>                  // vector
+#include <string>                  // string
+#include "mpi.h"                   // parallelism
+#include "vector3d.hpp"            // vector3d
+
+using std::vector;
+using std::string;
+
+// forward class declarations
+class procBlock;
+class input;
+class blockLayout;
+class boundaryConditions;
+class interblock;
+
+class geometryCache {
+  string fileName_;                // name of cache file
+  unsigned long long key_;         // hash of everything geometry depends on
+  bool isValid_;                   // cache file exists and matches key
+  MPI_Offset dataStart_;           // location of block data in file (bytes)
+  vector<MPI_Offset> blockStart_;  // location of each procBlock in file
+
+  // private member functions
+  void Hash(const void *, const size_t &);
+  void HashGrid(const string &);
+  void ComputeKey(const input &, const blockLayout &,
+                  const vector<boundaryConditions> &);
+  void CheckFile(const int &);
+
+ public:
+  // constructor
+  geometryCache(const input &, const blockLayout &,
+                const vector<boundaryConditions> &,
+                const vector<interblock> &);
+  geometryCache() : fileName_("none"), key_(0), isValid_(false),
+                    dataStart_(0) {}
+
+  // move constructor and assignment operator
+  geometryCache(geometryCache&&) noexcept = default;
+  geometryCache& operator=(geometryCache&&) noexcept = default;
+
+  // copy constructor and assignment operator
+  geometryCache(const geometryCache&) = default;
+  geometryCache& operator=(const geometryCache&) = default;
+
+  // member functions
+  string FileName() const {return fileName_;}
+  bool IsEnabled() const {return fileName_ != "none";}
+  bool IsValid() const {return isValid_;}
+  void Read(vector<procBlock> &, vector<interblock> &) const;
+  void Write(const vector<procBlock> &, const vector<interblock> &) const;
+
+  // destructor
+  ~geometryCache() noexcept {}
+};
+
+// function declarations
+long long GeometrySize(const vector3d<int> &, const int &);
+
+#endif
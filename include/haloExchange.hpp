@@ -0,0 +1,158 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-17  Michael Nucci (michael.nucci@gmail.com)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#ifndef HALOEXCHANGEHEADERDEF  // only if the macro HALOEXCHANGEHEADERDEF is
+                               // not defined execute these lines of code
+#define HALOEXCHANGEHEADERDEF  // define the macro
+
+/* This header contains the haloExchange class. It is used to swap the ghost
+   cells of interblock boundaries between processors without blocking.
+
+   The exchange is built once, after the interblocks have been sent to all
+   processors. For each interblock with another processor it stores the
+   locations of the cells to send and of the ghost cells to receive into, in
+   the order that the receiving block inserts them. These locations are the
+   same for every cell centered field of a block, so one list serves all of
+   the fields that are swapped. The send and receive buffers are kept between
+   exchanges, so once they have grown to size an exchange does not allocate
+   any memory.
+
+   Fields are added to an exchange one interblock at a time. When a field is
+   added its cells are copied directly into the buffer of the neighboring
+   processor. When the exchange is started one message is sent to and received
+   from each neighbor, holding every field and interblock added for it. Work
+   that does not need the ghost cells (such as swapping slices between blocks
+   on the same processor) can be done before the exchange is completed. Once
+   all messages have arrived the received cells are copied directly into the
+   ghost cells of their arrays.
+
+   Every processor loops over the interblocks and fields in the same order, so
+   the cells are packed by the sender in the same order that the receiver
+   unpacks them.
+
+   The exchange also records which surfaces of each block receive ghost cells
+   from other processors, so the faces that do not need them can be calculated
+   while the exchange is in flight.
+*/
+
+#include <vector>                  // vector
+#include "mpi.h"                   // parallelism
+#include "multiArray3d.hpp"        // multiArray3d
+#include "soaMultiArray3d.hpp"     // soaMultiArray3d
+#include "boundaryConditions.hpp"  // interblock
+
+using std::vector;
+
+// forward class declarations
+class procBlock;
+
+class haloExchange {
+  // cells swapped across an interblock with another processor
+  struct sliceSwap {
+    int neighbor_;          // index of neighboring processor
+    int numCells_;          // number of cells (with ghosts) in block arrays
+    vector<int> sendLoc_;   // locations of cells to send
+    vector<int> recvLoc_;   // locations of ghost cells to receive into
+  };
+
+  // field added to the current exchange, viewed as strided doubles
+  struct fieldSwap {
+    int swap_;              // index of interblock swap
+    double *data_;          // start of array storage
+    int width_;             // number of doubles for each cell
+    int cellStride_;        // distance between consecutive cells
+    int varStride_;         // distance between variables of a cell
+  };
+
+  vector<sliceSwap> swaps_;           // swaps with other processors
+  vector<int> connSwap_;              // swap index for each interblock
+  vector<int> neighbors_;             // ranks of neighboring processors
+  vector<vector<double>> sendBuffers_;  // packed sends for each neighbor
+  vector<vector<double>> recvBuffers_;  // packed receives for each neighbor
+  vector<int> sendCount_;             // doubles packed for each neighbor
+  vector<int> recvCount_;             // doubles expected from each neighbor
+  vector<fieldSwap> fields_;          // fields added to current exchange
+  vector<MPI_Request> requests_;      // requests for all sends/receives
+  vector<bool> haloSurf_;             // surfaces of local blocks receiving
+                                      // ghost cells, 6 for each block
+
+  // private member functions
+  void AddField(const int &, double *, const int &, const int &, const int &,
+                const int &);
+
+ public:
+  // constructor
+  haloExchange(const vector<interblock> &, const vector<procBlock> &,
+               const int &);
+  haloExchange() {}
+
+  // move constructor and assignment operator
+  haloExchange(haloExchange&&) noexcept = default;
+  haloExchange& operator=(haloExchange&&) noexcept = default;
+
+  // copy constructor and assignment operator
+  // an exchange with messages in flight should not be copied
+  haloExchange(const haloExchange&) = delete;
+  haloExchange& operator=(const haloExchange&) = delete;
+
+  // member functions
+  int NumSwaps() const { return swaps_.size(); }
+  int NumNeighbors() const { return neighbors_.size(); }
+  void HaloSurfaces(const int &, bool (&)[6]) const;
+
+  template <typename T>
+  void Add(multiArray3d<T> &, const int &);
+  template <typename T>
+  void Add(soaMultiArray3d<T> &, const int &);
+  void Start();
+  void Complete();
+
+  // destructor
+  ~haloExchange() noexcept {}
+};
+
+// ----------------------------------------------------------------------------
+// member function definitions
+
+/* Member functions to add an array to the exchange across the given
+interblock. The array must be a cell centered array of the local block on the
+interblock. Its cells are packed into the send buffer now, and its ghost cells
+are filled when the exchange is completed.
+*/
+template <typename T>
+void haloExchange::Add(multiArray3d<T> &arr, const int &conn) {
+  // arr -- array to swap ghost cells of
+  // conn -- index of interblock
+
+  // cell data is stored as contiguous doubles, the same as the MPI datatypes
+  static_assert(sizeof(T) % sizeof(double) == 0,
+                "haloExchange requires cells made up of doubles");
+  constexpr auto width = static_cast<int>(sizeof(T) / sizeof(double));
+  this->AddField(conn, reinterpret_cast<double *>(&(*std::begin(arr))), width,
+                 width, 1, arr.Size());
+}
+
+template <typename T>
+void haloExchange::Add(soaMultiArray3d<T> &arr, const int &conn) {
+  // arr -- array to swap ghost cells of
+  // conn -- index of interblock
+
+  // each variable is stored in its own plane
+  this->AddField(conn, &(*std::begin(arr)), NUMVARS, 1, arr.Size(),
+                 arr.Size());
+}
+
+#endif
@@ -25,6 +25,8 @@
 #include "vector3d.hpp"
 #include "boundaryConditions.hpp"
 #include "inputStates.hpp"
+#include "inputOptions.hpp"
+#include "extraction.hpp"
 #include "macros.hpp"
 
 using std::vector;
@@ -80,12 +82,46 @@ class input {
   string turbModel_;  // turbulence model
   int restartFrequency_;  // how often to output restart data
   int iterationStart_;  // starting number for iterations
+  string outputMode_;  // write files while solver waits or continues
+  string outputPrecision_;  // precision of function and grid output files
+  string restartCompression_;  // compression of restart files
+  int extractFrequency_;  // how often to write extractions
+  int probeFrequency_;  // how often to sample probes
+  int probeBufferSize_;  // number of probe samples held before writing
+  string wallDistance_;  // method to calculate wall distance
+  string wallDistanceOrder_;  // order of cells in wall distance search
+  string geometryCache_;  // file to cache geometry and wall distance in
 
   set<string> outputVariables_;  // variables to output
+  set<string> probeVariables_;  // variables to sample at probes
+  vector<vector3d<double>> probeLocations_;  // locations of probes
 
   vector<icState> ics_;  // initial conditions
+  vector<extraction> extractions_;  // parts of solution to write often
   vector<unique_ptr<inputState>> bcStates_;  // information for boundary conditions
 
+  // numerical methods resolved from the strings above
+  timeIntegrationMethod timeIntMethod_;
+  reconstructionMethod reconMethod_;
+  viscousReconstructionMethod viscReconMethod_;
+  limiterMethod limiterMethod_;
+  matrixSolverMethod matrixSolverMethod_;
+  inviscidFluxMethod inviscidFluxMethod_;
+  fluxJacobianMethod invFluxJacMethod_;
+  outputMethod outputMethod_;
+  compressionMethod restartCompressionMethod_;
+  bool isSinglePrecisionOutput_;
+  wallDistanceMethod wallDistanceMethod_;
+  bool isMortonWallDistance_;
+  bool isImplicit_;
+  bool isViscous_;
+  bool isTurbulent_;
+  bool isBlockMatrix_;
+
+  // private member functions
+  void ResolveOptions();
+  void RemoveUnavailableVariables(set<string> &) const;
+
  public:
   // constructor
   input(const string &, const string &);
@@ -126,7 +162,10 @@ class input {
   int NumBC() const {return bc_.size();}
 
   string TimeIntegration() const {return timeIntegration_;}
-  bool IsMultilevelInTime() const {return timeIntegration_ == "bdf2";}
+  timeIntegrationMethod TimeIntegrationMethod() const {return timeIntMethod_;}
+  bool IsMultilevelInTime() const {
+    return timeIntMethod_ == timeIntegrationMethod::bdf2;
+  }
 
   double CFL() const {return cfl_;}
   void CalcCFL(const int &i);
@@ -134,6 +173,10 @@ class input {
   double Kappa() const {return kappa_;}
   string FaceReconstruction() const {return faceReconstruction_;}
   string ViscousFaceReconstruction() const {return viscousFaceReconstruction_;}
+  reconstructionMethod ReconstructionMethod() const {return reconMethod_;}
+  viscousReconstructionMethod ViscousReconstructionMethod() const {
+    return viscReconMethod_;
+  }
   bool UsingConstantReconstruction() const {
     return faceReconstruction_ == "constant";
   }
@@ -143,12 +186,45 @@ class input {
   }
 
   string Limiter() const {return limiter_;}
+  limiterMethod LimiterMethod() const {return limiterMethod_;}
 
   int OutputFrequency() const {return outputFrequency_;}
   int RestartFrequency() const {return restartFrequency_;}
   set<string> OutputVariables() const {return outputVariables_;}
+  string OutputMode() const {return outputMode_;}
+  outputMethod OutputMethod() const {return outputMethod_;}
+  string OutputPrecision() const {return outputPrecision_;}
+  bool IsSinglePrecisionOutput() const {return isSinglePrecisionOutput_;}
+  string RestartCompression() const {return restartCompression_;}
+  compressionMethod RestartCompressionMethod() const {
+    return restartCompressionMethod_;
+  }
+
+  int ExtractFrequency() const {
+    return (extractFrequency_ > 0) ? extractFrequency_ : outputFrequency_;
+  }
+  const vector<extraction> & Extractions() const {return extractions_;}
+  int NumExtractions() const {return extractions_.size();}
 
   bool WriteOutput(const int &nn) const {return (nn + 1) % outputFrequency_ == 0;}
+  const vector<vector3d<double>> & ProbeLocations() const {
+    return probeLocations_;
+  }
+  set<string> ProbeVariables() const {return probeVariables_;}
+  int ProbeFrequency() const {return probeFrequency_;}
+  int ProbeBufferSize() const {return probeBufferSize_;}
+  string WallDistance() const {return wallDistance_;}
+  wallDistanceMethod WallDistanceMethod() const {return wallDistanceMethod_;}
+  string WallDistanceOrder() const {return wallDistanceOrder_;}
+  bool IsMortonWallDistance() const {return isMortonWallDistance_;}
+  string GeometryCache() const {return geometryCache_;}
+  bool IsGeometryCache() const {return geometryCache_ != "none";}
+  bool SampleProbes(const int &nn) const {
+    return !probeLocations_.empty() && (nn + 1) % probeFrequency_ == 0;
+  }
+  bool WriteExtraction(const int &nn) const {
+    return !extractions_.empty() && (nn + 1) % this->ExtractFrequency() == 0;
+  }
   bool WriteRestart(const int &nn) const {
     return (restartFrequency_ == 0) ? false : (nn + 1) % restartFrequency_ == 0;
   }
@@ -156,9 +232,15 @@ class input {
   string EquationSet() const {return equationSet_;}
 
   string MatrixSolver() const {return matrixSolver_;}
+  matrixSolverMethod MatrixSolverMethod() const {return matrixSolverMethod_;}
   int MatrixSweeps() const {return matrixSweeps_;}
   double MatrixRelaxation() const {return matrixRelaxation_;}
-  bool MatrixRequiresInitialization() const;
+  bool MatrixRequiresInitialization() const {
+    // initialize matrix if using DPLUR / BDPLUR, or if using LUSGS / BLUSGS
+    // with more than one sweep
+    return matrixSolverMethod_ == matrixSolverMethod::dplur ||
+        matrixSolverMethod_ == matrixSolverMethod::bdplur || matrixSweeps_ > 1;
+  }
 
   double Theta() const {return timeIntTheta_;}
   double Zeta() const {return timeIntZeta_;}
@@ -170,10 +252,12 @@ class input {
   double CFLStart() const {return cflStart_;}
 
   string InvFluxJac() const {return invFluxJac_;}
+  fluxJacobianMethod InvFluxJacMethod() const {return invFluxJacMethod_;}
 
   double DualTimeCFL() const {return dualTimeCFL_;}
 
   string InviscidFlux() const {return inviscidFlux_;}
+  inviscidFluxMethod InviscidFluxMethod() const {return inviscidFluxMethod_;}
 
   string DecompMethod() const {return decompMethod_;}
   string TurbulenceModel() const {return turbModel_;}
@@ -186,10 +270,10 @@ class input {
 
   void ReadInput(const int &);
 
-  bool IsImplicit() const;
-  bool IsViscous() const;
-  bool IsTurbulent() const;
-  bool IsBlockMatrix() const;
+  bool IsImplicit() const {return isImplicit_;}
+  bool IsViscous() const {return isViscous_;}
+  bool IsTurbulent() const {return isTurbulent_;}
+  bool IsBlockMatrix() const {return isBlockMatrix_;}
 
   string OrderOfAccuracy() const;
 
@@ -206,7 +290,7 @@ class input {
   icState ICStateForBlock(const int &) const;
   const unique_ptr<inputState> & BCData(const int &) const;
 
-  bool IsWenoZ() const {return this->FaceReconstruction() == "wenoZ";}
+  bool IsWenoZ() const {return reconMethod_ == reconstructionMethod::wenoZ;}
 
   // destructor
   ~input() noexcept {}
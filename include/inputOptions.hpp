@@ -0,0 +1,95 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-17  Michael Nucci (michael.nucci@gmail.com)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#ifndef INPUTOPTIONSHEADERDEF  // only if the macro INPUTOPTIONSHEADERDEF is
+                               // not defined execute these lines of code
+#define INPUTOPTIONSHEADERDEF  // define the macro
+
+/* This header contains the enumerations for the numerical methods that can be
+   chosen in the input file. The input class resolves the option strings to
+   these values once when the input file is read, so that the solver does not
+   compare strings inside its loops. The flux kernels take these values as
+   template parameters. */
+
+// method of time integration
+enum class timeIntegrationMethod {
+  explicitEuler,
+  rk4,
+  implicitEuler,
+  crankNicholson,
+  bdf2
+};
+
+// method of face reconstruction for inviscid fluxes
+enum class reconstructionMethod {
+  constant,  // first order
+  muscl,     // upwind, fromm, quick, central, thirdOrder
+  weno,
+  wenoZ
+};
+
+// method of face reconstruction for viscous fluxes
+enum class viscousReconstructionMethod {
+  central,
+  centralFourth
+};
+
+// limiter used with MUSCL reconstruction
+enum class limiterMethod {
+  none,
+  vanAlbada,
+  minmod
+};
+
+// method used to solve implicit system
+enum class matrixSolverMethod {
+  lusgs,
+  blusgs,
+  dplur,
+  bdplur
+};
+
+// numerical flux for inviscid fluxes
+enum class inviscidFluxMethod {
+  roe,
+  rusanov
+};
+
+// approximation for inviscid flux jacobian
+enum class fluxJacobianMethod {
+  rusanov,
+  approximateRoe
+};
+
+// method of writing solution and restart files
+enum class outputMethod {
+  blocking,  // solver waits for each file to be written
+  snapshot   // files are written while the solver continues
+};
+
+// method of calculating distance to nearest viscous wall
+enum class wallDistanceMethod {
+  kdtree,  // exact search of all viscous wall faces
+  eikonal  // fast sweeping of nearest wall points through the cells
+};
+
+// compression of restart files; values are stored in restart files
+enum class compressionMethod {
+  none = 0,
+  lossless = 1  // byte shuffle and run length encoding of each block
+};
+
+#endif
@@ -327,6 +327,7 @@ string Trim(const string &, const string & = " \t\r\n");
 vector3d<double> ReadVector(const string &);
 vector<icState> ReadICList(ifstream &, string &);
 vector<string> ReadStringList(ifstream &, string &);
+vector<vector3d<double>> ReadVectorList(ifstream &, string &);
 vector<unique_ptr<inputState>> ReadBCList(ifstream &, string &);
 string RemoveTrailing(const string &, const string &);
 auto FindBCPosition(const string &, const vector<string> &, string &);
@@ -24,6 +24,7 @@
 #include <memory>        // unique_ptr
 #include "vector3d.hpp"  // vector3d
 #include "macros.hpp"
+#include "inputOptions.hpp"  // inviscidFluxMethod
 
 using std::vector;
 using std::string;
@@ -40,6 +41,10 @@ class genArray;
 class squareMatrix;
 class turbModel;
 
+// number of faces in a batch for the batched flux kernels; this is a multiple
+// of the number of doubles in the widest vector registers (8 for AVX-512)
+constexpr int FLUXBATCH = 8;
+
 class inviscidFlux {
   double data_[NUMVARS];  // rho dot velocity vector
   // rho dot velocity vector * u-velocity + pressure * i-dir-vector
@@ -111,16 +116,61 @@ class inviscidFlux {
 
   genArray ConvertToGenArray() const;
 
+  friend class fluxBatch;
+
   // destructor
   ~inviscidFlux() noexcept {}
 };
 
+/* The fluxBatch class holds the left and right states and the unit area
+   vectors of a batch of faces, and the numerical flux at each face. The data is
+   stored variable by variable with the faces next to each other, so the batched
+   flux kernels are loops over the faces that the compiler turns into vector
+   instructions, with one face in each lane. Each lane is calculated with the
+   same instructions, so the flux at a face does not depend on the other faces
+   in its batch. A batch that is not full is padded with copies of its last
+   face, so the unused lanes hold valid states.
+*/
+class fluxBatch {
+  double left_[NUMVARS][FLUXBATCH];   // left primative variables
+  double right_[NUMVARS][FLUXBATCH];  // right primative variables
+  double area_[3][FLUXBATCH];         // unit area vector
+  double flux_[NUMVARS][FLUXBATCH];   // numerical flux
+
+ public:
+  // member functions
+  template <typename T>
+  void SetFace(const int &, const T &, const T &, const vector3d<double> &);
+  void SetArea(const int &, const vector3d<double> &);
+  template <typename T>
+  T Left(const int &) const;
+  template <typename T>
+  T Right(const int &) const;
+  // states of all faces in batch for one variable
+  double * LeftVar(const int &vv) {return left_[vv];}
+  double * RightVar(const int &vv) {return right_[vv];}
+  // numerical flux of all faces in batch for one variable
+  const double * FluxVar(const int &vv) const {return flux_[vv];}
+  void PadFaces(const int &);
+  inviscidFlux Flux(const int &ff) const {
+    inviscidFlux flux;
+    for (auto vv = 0; vv < NUMVARS; vv++) {
+      flux.data_[vv] = flux_[vv][ff];
+    }
+    return flux;
+  }
+
+  void RoeFlux(const idealGas &);
+  void RusanovFlux(const idealGas &);
+};
+
 // function definitions
 // function to calculate Roe flux with entropy fix
 inviscidFlux RoeFlux(const primVars&, const primVars&, const idealGas&,
                      const vector3d<double>&);
+// function to calculate Rusanov (local Lax-Friedrichs) flux
 inviscidFlux RusanovFlux(const primVars&, const primVars&, const idealGas&,
-                         const vector3d<double>&, const bool&);
+                         const vector3d<double>&);
 
 // function to calculate Roe flux with entropy fix for implicit methods
 void ApproxRoeFluxJacobian(const primVars&, const primVars&, const idealGas&,
@@ -235,4 +285,68 @@ inline const inviscidFlux operator/(const double &lhs, inviscidFlux rhs) {
 
 ostream &operator<<(ostream &os, const inviscidFlux &);
 
+// function to calculate the numerical inviscid flux with the scheme chosen
+// at compile time
+template <inviscidFluxMethod F>
+inviscidFlux NumericalFlux(const primVars &left, const primVars &right,
+                           const idealGas &eqnState,
+                           const vector3d<double> &areaNorm) {
+  return (F == inviscidFluxMethod::roe) ?
+      RoeFlux(left, right, eqnState, areaNorm) :
+      RusanovFlux(left, right, eqnState, areaNorm);
+}
+
+// member function to store the left and right states and the unit area vector
+// of a face in the batch; the states are primVars, which is not fully defined
+// here
+template <typename T>
+void fluxBatch::SetFace(const int &ff, const T &left, const T &right,
+                        const vector3d<double> &areaNorm) {
+  // ff -- index of face in batch
+  // left -- primative variables from left
+  // right -- primative variables from right
+  // areaNorm -- norm area vector of face
+
+  for (auto vv = 0; vv < NUMVARS; vv++) {
+    left_[vv][ff] = left[vv];
+    right_[vv][ff] = right[vv];
+  }
+  this->SetArea(ff, areaNorm);
+}
+
+// member function to store the unit area vector of a face in the batch
+inline void fluxBatch::SetArea(const int &ff,
+                               const vector3d<double> &areaNorm) {
+  // ff -- index of face in batch
+  // areaNorm -- norm area vector of face
+
+  for (auto dd = 0; dd < 3; dd++) {
+    area_[dd][ff] = areaNorm[dd];
+  }
+}
+
+// member functions to return the left and right states of a face in the batch
+template <typename T>
+T fluxBatch::Left(const int &ff) const {
+  return T(left_[0][ff], left_[1][ff], left_[2][ff], left_[3][ff],
+           left_[4][ff], left_[5][ff], left_[6][ff]);
+}
+
+template <typename T>
+T fluxBatch::Right(const int &ff) const {
+  return T(right_[0][ff], right_[1][ff], right_[2][ff], right_[3][ff],
+           right_[4][ff], right_[5][ff], right_[6][ff]);
+}
+
+// function to calculate the numerical inviscid flux of a batch of faces
+// with the scheme chosen at compile time
+template <inviscidFluxMethod F>
+void NumericalFlux(fluxBatch &batch, const idealGas &eqnState) {
+  if (F == inviscidFluxMethod::roe) {
+    batch.RoeFlux(eqnState);
+  } else {
+    batch.RusanovFlux(eqnState);
+  }
+}
+
 #endif
@@ -31,7 +31,7 @@ all cells to a viscous wall. The coordinates of cell faces contacting a
 viscous wall are stored in the data structure in the nodes_ variable. When
 the tree is built the nodes are reordered such that a tree branch to the left
 is the next indice down, and the index of a tree branch to the right is 
-stored in the right_ variable. A simple 2D example will be shown to explain
+stored with the node. A simple 2D example will be shown to explain
 how the data is ordered.
 
 Given a set of points: (7,1), (0,2), (5,4), (3,9), (2,7), (8,6), (1,3), 
@@ -46,33 +46,60 @@ Split - X                (1,3)   (6,5)
 Split - Y           (0,2) (2,7) (7,1) (8,6)
                           (3,9) (5,4) (9,8)
 
-This tree would be stored in the nodes_ and right_ vectors in the following
-way:
-nodes_ = [(4,0), (1,3), (0,2), (2,7), (3,9), (6,5), (7,1), (5,4), (8,6), (9.8)]
-right_ = [  5,     3,    -1,    -1     -1,     8,    -1,    -1,    -1,    -1  ]
+This tree would be stored in the following order, where right gives the
+index of each right branch:
+points = [(4,0), (1,3), (0,2), (2,7), (3,9), (6,5), (7,1), (5,4), (8,6), (9.8)]
+right  = [  5,     3,    -1,    -1     -1,     8,    -1,    -1,    -1,    -1  ]
 
 To traverse the tree, the branch to the left is given by the next indice in 
-the nodes_ vector. For example point (1,3) is at index 1, and its left branch
-is at index 2. The branch to the right is given by the right_ vector. For
+the vector. For example point (1,3) is at index 1, and its left branch
+is at index 2. The branch to the right is given by the right vector. For
 example at point (1,3) is at index 1, its right branch is given by the
-corresponding value at index 1 in the right_ vector. In this case its right
+corresponding value at index 1 in the right vector. In this case its right
 branch is at index 3.
+
+Each point is stored in the nodes_ vector together with the index of its
+right branch, so the search reads one node for each step down the tree. The
+first node of each branch also stores the index of the smallest box that
+holds all of the points in the branch. A branch is only searched if this
+box is closer than the nearest point found so far.
+
+The tree can also find the distances for a batch of points at once. The
+batch is divided among the threads in runs of consecutive points, and the
+search for each point in a run starts from a bound given by the previous
+point, which lets most of the tree be skipped. This works best when
+consecutive points are close together; MortonOrder() gives an order of
+points along a space filling curve for this purpose. Alternatively each
+point can be given its own bound, in which case only nodes closer than the
+bound are found.
 */
 class kdtree {
-  // all points to search through in k-d tree order
-  vector<vector3d<double>> nodes_;
-  vector<int> right_;           // right branch indices
+  // node of the k-d tree; packed into 32 bytes so that the point and its
+  // branch information are read together, and a leaf bin is one contiguous
+  // run of memory
+  struct node {
+    vector3d<double> point_;  // coordinates of point
+    int right_;               // index of right branch, -1 if not a split
+    int box_;                 // index of box of branch starting here, or -1
+  };
+
+  // smallest box holding all points of a branch
+  struct box {
+    vector3d<double> lower_;
+    vector3d<double> upper_;
+  };
+
+  vector<node> nodes_;          // all points in k-d tree order
+  vector<box> boxes_;           // bounding box of every branch
   const int dim_ = 3;           // dimension of space to search
-  const double binSize_ = 32;   // max number of points in a leaf node
+  const int binSize_ = 32;      // max number of points in a leaf node
+  const int batchSize_ = 1024;  // points per thread task in batch search
 
   // private member functions
   int FindMedian(const int &, const int &, const int &);
   void BuildKdtree(const int &, const int &, const int &);
-  void NearestNeighbor(const int &, const int &, const int &,
-                       const vector3d<double> &, vector3d<double> &,
-                       double &) const;
-  bool SphereInside(const vector3d<double>&, const double &,
-                    const vector3d<double>&, const int &) const;
+  int NearestNeighbor(const vector3d<double> &, double &) const;
+  double BoxDistSq(const vector3d<double> &, const int &) const;
 
  public:
   // constructor
@@ -88,10 +115,18 @@ class kdtree {
 
   // member functions
   double NearestNeighbor(const vector3d<double> &, vector3d<double> &) const;
+  vector<double> NearestDistances(const vector<vector3d<double>> &) const;
+  vector<double> NearestDistances(const vector<vector3d<double>> &,
+                                  const vector<double> &) const;
   int Size() const {return nodes_.size();}
+  vector3d<double> Lower() const {return boxes_.front().lower_;}
+  vector3d<double> Upper() const {return boxes_.front().upper_;}
 
   // destructor
   ~kdtree() noexcept {}
 };
 
+// function declarations
+vector<int> MortonOrder(const vector<vector3d<double>> &);
+
 #endif
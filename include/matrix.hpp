@@ -20,13 +20,16 @@
 
 #include <iostream>
 #include <vector>
+#include <cmath>  // fabs
+#include <cstdlib>  // exit
+#include <algorithm>  // swap, max, fill
 #include "macros.hpp"
+#include "genArray.hpp"
 
 using std::ostream;
 using std::vector;
-
-// forward class declarations
-class genArray;
+using std::endl;
+using std::cerr;
 
 // class to store a square matrix
 class squareMatrix {
@@ -215,4 +218,453 @@ inline const squareMatrix operator/(const double &lhs, squareMatrix rhs) {
 }
 
 
+// ---------------------------------------------------------------------------
+/* Class to store a square matrix with a compile time maximum size. The data is
+   stored inline (no heap allocation), so containers of these matrices are a
+   single contiguous allocation. The matrix has a run time size that may be
+   smaller than the maximum (e.g. a 1x1 matrix for the scalar implicit
+   solvers). Entries outside of the active size are always kept at zero. The
+   Inverse, MatMult, and ArrayMult functions dispatch to versions with the
+   loop bounds fixed at compile time for the full size and the scalar size so
+   that they are fully unrolled by the compiler.
+*/
+template <int N>
+class fixedSquareMatrix {
+  int size_;
+  double data_[N * N];
+
+  // private member functions
+  int GetLoc(const int &r, const int &c) const {
+    return r * N + c;
+  }
+  template <int S> void InverseFixed();
+  template <int S>
+  fixedSquareMatrix<N> MatMultFixed(const fixedSquareMatrix<N> &) const;
+  template <int S> genArray ArrayMultFixed(const genArray &, const int &) const;
+
+ public:
+  // constructor
+  explicit fixedSquareMatrix(const int &a) : size_(a), data_{} {
+    if (a > N || a < 0) {
+      cerr << "ERROR: Error in fixedSquareMatrix::fixedSquareMatrix(). Size "
+           << a << " is outside of the supported range [0, " << N << "]"
+           << endl;
+      exit(EXIT_FAILURE);
+    }
+  }
+  fixedSquareMatrix() : fixedSquareMatrix(0) {}
+
+  // move constructor and assignment operator
+  fixedSquareMatrix(fixedSquareMatrix &&) noexcept = default;
+  fixedSquareMatrix& operator=(fixedSquareMatrix &&) = default;
+
+  // copy constructor and assignment operator
+  fixedSquareMatrix(const fixedSquareMatrix &) = default;
+  fixedSquareMatrix& operator=(const fixedSquareMatrix &) = default;
+
+  // member functions
+  int Size() const {return size_;}
+  static constexpr int MaxSize() {return N;}
+  void SwapRows(const int &, const int &);
+  void Inverse();
+  int FindMaxInCol(const int &, const int &, const int &) const;
+  void RowMultiply(const int &, const int &, const double &);
+  void LinCombRow(const int &, const double &, const int &);
+  void Zero() {std::fill(data_, data_ + N * N, 0.0);}
+  void Identity();
+  fixedSquareMatrix<N> MatMult(const fixedSquareMatrix<N> &) const;
+  genArray ArrayMult(const genArray &, const int = 0) const;
+  double MaxAbsValOnDiagonal() const;
+
+  // operator overloads
+  double & operator()(const int &r, const int &c) {
+    return data_[this->GetLoc(r, c)];
+  }
+  const double & operator()(const int &r, const int &c) const {
+    return data_[this->GetLoc(r, c)];
+  }
+
+  // entries outside of the active size are zero, so elementwise addition,
+  // subtraction, and multiplication can operate on the entire storage
+  fixedSquareMatrix<N> & operator+=(const fixedSquareMatrix<N> &mat) {
+    for (auto ii = 0; ii < N * N; ii++) {
+      data_[ii] += mat.data_[ii];
+    }
+    return *this;
+  }
+  fixedSquareMatrix<N> & operator-=(const fixedSquareMatrix<N> &mat) {
+    for (auto ii = 0; ii < N * N; ii++) {
+      data_[ii] -= mat.data_[ii];
+    }
+    return *this;
+  }
+  fixedSquareMatrix<N> & operator*=(const fixedSquareMatrix<N> &mat) {
+    for (auto ii = 0; ii < N * N; ii++) {
+      data_[ii] *= mat.data_[ii];
+    }
+    return *this;
+  }
+  fixedSquareMatrix<N> & operator/=(const fixedSquareMatrix<N> &mat) {
+    for (auto rr = 0; rr < size_; rr++) {
+      for (auto cc = 0; cc < size_; cc++) {
+        (*this)(rr, cc) /= mat(rr, cc);
+      }
+    }
+    return *this;
+  }
+
+  // operations with a scalar only act on the active entries
+  fixedSquareMatrix<N> & operator+=(const double &scalar) {
+    for (auto rr = 0; rr < size_; rr++) {
+      for (auto cc = 0; cc < size_; cc++) {
+        (*this)(rr, cc) += scalar;
+      }
+    }
+    return *this;
+  }
+  fixedSquareMatrix<N> & operator-=(const double &scalar) {
+    for (auto rr = 0; rr < size_; rr++) {
+      for (auto cc = 0; cc < size_; cc++) {
+        (*this)(rr, cc) -= scalar;
+      }
+    }
+    return *this;
+  }
+  fixedSquareMatrix<N> & operator*=(const double &scalar) {
+    for (auto ii = 0; ii < N * N; ii++) {
+      data_[ii] *= scalar;
+    }
+    return *this;
+  }
+  fixedSquareMatrix<N> & operator/=(const double &scalar) {
+    for (auto rr = 0; rr < size_; rr++) {
+      for (auto cc = 0; cc < size_; cc++) {
+        (*this)(rr, cc) /= scalar;
+      }
+    }
+    return *this;
+  }
+
+  fixedSquareMatrix<N> operator+(const double &s) const {
+    auto lhs = *this;
+    return lhs += s;
+  }
+  fixedSquareMatrix<N> operator-(const double &s) const {
+    auto lhs = *this;
+    return lhs -= s;
+  }
+  fixedSquareMatrix<N> operator*(const double &s) const {
+    auto lhs = *this;
+    return lhs *= s;
+  }
+  fixedSquareMatrix<N> operator/(const double &s) const {
+    auto lhs = *this;
+    return lhs /= s;
+  }
+
+  // destructor
+  ~fixedSquareMatrix() noexcept {}
+};
+
+// matrix types used in the flux jacobians
+using flowMatrix = fixedSquareMatrix<NUMFLOWVARS>;
+using turbMatrix = fixedSquareMatrix<NUMVARS - NUMFLOWVARS>;
+
+// member function to swap rows of matrix
+template <int N>
+void fixedSquareMatrix<N>::SwapRows(const int &r1, const int &r2) {
+  if (r1 != r2) {
+    for (auto cc = 0; cc < size_; cc++) {
+      std::swap((*this)(r1, cc), (*this)(r2, cc));
+    }
+  }
+}
+
+// member function to invert matrix using Gauss-Jordan elimination
+template <int N>
+void fixedSquareMatrix<N>::Inverse() {
+  if (size_ == N) {
+    this->InverseFixed<N>();
+  } else if (size_ == 1) {
+    this->InverseFixed<1>();
+  } else if (size_ > 1) {
+    cerr << "ERROR: Error in fixedSquareMatrix::Inverse(). Inverse of size "
+         << size_ << " matrix is not supported!" << endl;
+    exit(EXIT_FAILURE);
+  }
+}
+
+// Gauss-Jordan elimination with the matrix size known at compile time. This
+// follows squareMatrix::Inverse().
+template <int N>
+template <int S>
+void fixedSquareMatrix<N>::InverseFixed() {
+  fixedSquareMatrix<N> I(S);
+  I.Identity();
+
+  for (auto cPivot = 0, r = 0; r < S; r++, cPivot++) {
+    // find pivot row
+    auto rPivot = this->FindMaxInCol(r, cPivot, S - 1);
+
+    // swap rows
+    this->SwapRows(r, rPivot);
+    I.SwapRows(r, rPivot);
+
+    if (r != 0) {  // if not on first row, need to get rid entries ahead of
+                   // pivot
+      for (auto ii = 0; ii < cPivot; ii++) {
+        auto factor = (*this)(r, ii) / (*this)(ii, ii);
+        for (auto cc = 0; cc < S; cc++) {
+          (*this)(r, cc) = (*this)(r, cc) - (*this)(ii, cc) * factor;
+          I(r, cc) = I(r, cc) - I(ii, cc) * factor;
+        }
+      }
+    }
+
+    // normalize row by pivot
+    if ((*this)(r, cPivot) == 0.0) {
+      cerr << "ERROR: Singular matrix in Gauss-Jordan elimination! Matrix (mid "
+              "inversion) is" << endl << *this << endl;
+      exit(EXIT_FAILURE);
+    }
+    auto normFactor = 1.0 / (*this)(r, cPivot);
+    // only multiply entries from pivot and to the right
+    for (auto cc = cPivot; cc < S; cc++) {
+      (*this)(r, cc) = (*this)(r, cc) * normFactor;
+    }
+    for (auto cc = 0; cc < S; cc++) {  // multiply all entries
+      I(r, cc) = I(r, cc) * normFactor;
+    }
+  }
+
+  // matrix is now upper triangular, work way back up to identity matrix
+  // start with second to last row
+  for (auto cPivot = S - 2, r = S - 2; r >= 0; r--, cPivot--) {
+    for (auto ii = S - 1; ii > cPivot; ii--) {
+      auto factor = (*this)(r, ii);
+      for (auto cc = 0; cc < S; cc++) {
+        (*this)(r, cc) = (*this)(r, cc) - (*this)(ii, cc) * factor;
+        I(r, cc) = I(r, cc) - I(ii, cc) * factor;
+      }
+    }
+  }
+
+  // set this matrix equal to its inverse
+  (*this) = I;
+}
+
+// member function to add a linear combination of one row to another
+template <int N>
+void fixedSquareMatrix<N>::LinCombRow(const int &r1, const double &factor,
+                                      const int &r2) {
+  for (auto ii = 0; ii < size_; ii++) {
+    (*this)(r2, ii) = (*this)(r2, ii) - (*this)(r1, ii) * factor;
+  }
+}
+
+// member function to multiply a row by a given factor
+template <int N>
+void fixedSquareMatrix<N>::RowMultiply(const int &r, const int &c,
+                                       const double &factor) {
+  for (auto ii = c; ii < size_; ii++) {
+    (*this)(r, ii) = (*this)(r, ii) * factor;
+  }
+}
+
+// member function to find maximum absolute value in a given column and range
+// within that column and return the corresponding row indice
+template <int N>
+int fixedSquareMatrix<N>::FindMaxInCol(const int &c, const int &start,
+                                       const int &end) const {
+  auto maxVal = 0.0;
+  auto maxRow = 0;
+  for (auto ii = start; ii <= end; ii++) {
+    if (fabs((*this)(ii, c)) > maxVal) {
+      maxVal = fabs((*this)(ii, c));
+      maxRow = ii;
+    }
+  }
+  return maxRow;
+}
+
+// member function for matrix multiplication
+template <int N>
+fixedSquareMatrix<N> fixedSquareMatrix<N>::MatMult(
+    const fixedSquareMatrix<N> &s2) const {
+  if (s2.Size() == N) {
+    return this->MatMultFixed<N>(s2);
+  } else if (s2.Size() == 1) {
+    return this->MatMultFixed<1>(s2);
+  } else {
+    fixedSquareMatrix<N> s1(s2.Size());
+    for (auto cc = 0; cc < s2.Size(); cc++) {
+      for (auto rr = 0; rr < s2.Size(); rr++) {
+        for (auto ii = 0; ii < s2.Size(); ii++) {
+          s1(rr, ii) += (*this)(rr, cc) * s2(cc, ii);
+        }
+      }
+    }
+    return s1;
+  }
+}
+
+// matrix multiplication with the size known at compile time
+template <int N>
+template <int S>
+fixedSquareMatrix<N> fixedSquareMatrix<N>::MatMultFixed(
+    const fixedSquareMatrix<N> &s2) const {
+  fixedSquareMatrix<N> s1(S);
+  for (auto cc = 0; cc < S; cc++) {
+    for (auto rr = 0; rr < S; rr++) {
+      for (auto ii = 0; ii < S; ii++) {
+        s1(rr, ii) += (*this)(rr, cc) * s2(cc, ii);
+      }
+    }
+  }
+  return s1;
+}
+
+// member function to set matrix to Identity
+template <int N>
+void fixedSquareMatrix<N>::Identity() {
+  this->Zero();
+  for (auto rr = 0; rr < size_; rr++) {
+    (*this)(rr, rr) = 1.0;
+  }
+}
+
+// member function to do matrix/vector multplication
+template <int N>
+genArray fixedSquareMatrix<N>::ArrayMult(const genArray &vec,
+                                         const int pos) const {
+  // vec -- vector to multiply with
+  // pos -- position in vector to start multiplication at
+
+  if (size_ == N) {
+    return this->ArrayMultFixed<N>(vec, pos);
+  } else if (size_ == 1) {
+    return this->ArrayMultFixed<1>(vec, pos);
+  } else if (size_ == 0) {
+    return this->ArrayMultFixed<0>(vec, pos);
+  } else {
+    cerr << "ERROR: Error in fixedSquareMatrix::ArrayMult(). Multiplication "
+         << "with size " << size_ << " matrix is not supported!" << endl;
+    exit(EXIT_FAILURE);
+  }
+}
+
+// matrix/vector multiplication with the size known at compile time
+template <int N>
+template <int S>
+genArray fixedSquareMatrix<N>::ArrayMultFixed(const genArray &vec,
+                                              const int &pos) const {
+  // vec -- vector to multiply with
+  // pos -- position in vector to start multiplication at
+
+  auto product = vec;
+
+  // zero out portion of genArray that will be written over
+  if (pos == 0) {
+    for (auto ii = 0; ii < NUMFLOWVARS; ii++) {
+      product[ii] = 0.0;
+    }
+  } else {
+    for (auto ii = pos; ii < NUMVARS; ii++) {
+      product[ii] = 0.0;
+    }
+  }
+
+  for (auto rr = 0; rr < S; rr++) {
+    for (auto cc = 0; cc < S; cc++) {
+      product[pos + rr] += (*this)(rr, cc) * vec[pos + cc];
+    }
+  }
+  return product;
+}
+
+// member function to find maximum absolute value on diagonal
+// this can be used to find the spectral radius of a diagoanl matrix
+template <int N>
+double fixedSquareMatrix<N>::MaxAbsValOnDiagonal() const {
+  auto maxVal = 0.0;
+  for (auto ii = 0; ii < size_; ii++) {
+    maxVal = std::max(fabs((*this)(ii, ii)), maxVal);
+  }
+  return maxVal;
+}
+
+template <int N>
+inline const fixedSquareMatrix<N> operator+(fixedSquareMatrix<N> lhs,
+                                            const fixedSquareMatrix<N> &rhs) {
+  return lhs += rhs;
+}
+
+template <int N>
+inline const fixedSquareMatrix<N> operator-(fixedSquareMatrix<N> lhs,
+                                            const fixedSquareMatrix<N> &rhs) {
+  return lhs -= rhs;
+}
+
+template <int N>
+inline const fixedSquareMatrix<N> operator*(fixedSquareMatrix<N> lhs,
+                                            const fixedSquareMatrix<N> &rhs) {
+  return lhs *= rhs;
+}
+
+template <int N>
+inline const fixedSquareMatrix<N> operator/(fixedSquareMatrix<N> lhs,
+                                            const fixedSquareMatrix<N> &rhs) {
+  return lhs /= rhs;
+}
+
+template <int N>
+inline const fixedSquareMatrix<N> operator+(const double &lhs,
+                                            fixedSquareMatrix<N> rhs) {
+  return rhs += lhs;
+}
+
+template <int N>
+inline const fixedSquareMatrix<N> operator-(const double &lhs,
+                                            fixedSquareMatrix<N> rhs) {
+  for (auto rr = 0; rr < rhs.Size(); rr++) {
+    for (auto cc = 0; cc < rhs.Size(); cc++) {
+      rhs(rr, cc) = lhs - rhs(rr, cc);
+    }
+  }
+  return rhs;
+}
+
+template <int N>
+inline const fixedSquareMatrix<N> operator*(const double &lhs,
+                                            fixedSquareMatrix<N> rhs) {
+  return rhs *= lhs;
+}
+
+template <int N>
+inline const fixedSquareMatrix<N> operator/(const double &lhs,
+                                            fixedSquareMatrix<N> rhs) {
+  for (auto rr = 0; rr < rhs.Size(); rr++) {
+    for (auto cc = 0; cc < rhs.Size(); cc++) {
+      rhs(rr, cc) = lhs / rhs(rr, cc);
+    }
+  }
+  return rhs;
+}
+
+// operation overload for << - allows use of cout, cerr, etc.
+template <int N>
+ostream &operator<<(ostream &os, const fixedSquareMatrix<N> &m) {
+  for (auto rr = 0; rr < m.Size(); rr++) {
+    for (auto cc = 0; cc < m.Size(); cc++) {
+      os << m(rr, cc);
+      if (cc != (m.Size() - 1)) {
+        os << ", ";
+      } else {
+        os << endl;
+      }
+    }
+  }
+  return os;
+}
+
 #endif
@@ -139,8 +139,6 @@ class multiArray3d {
 
   void Fill(const multiArray3d<T> &);
   void PutSlice(const multiArray3d<T> &, const interblock &, const int &);
-  void SwapSliceMPI(const interblock &, const int &, const MPI_Datatype &,
-                    const int = 1);
   void SwapSlice(const interblock &, multiArray3d<T> &);
 
   void Zero(const T &);
@@ -150,9 +148,6 @@ class multiArray3d {
   multiArray3d<T> GrowJ() const;
   multiArray3d<T> GrowK() const;
 
-  void PackSwapUnpackMPI(const interblock &, const MPI_Datatype &, const int &,
-                         const int = 1);
-
   T GetElem(const int &ii, const int &jj, const int &kk) const;
 
   // operator overloads
@@ -1085,126 +1080,6 @@ void multiArray3d<T>::PutSlice(const multiArray3d<T> &array,
   }
 }
 
-/*Member function to pack an array into a buffer, swap it with its
-  interblock partner, and then unpack it into an array.*/
-template <typename T>
-void multiArray3d<T>::PackSwapUnpackMPI(const interblock &inter,
-                                        const MPI_Datatype &MPI_arrData,
-                                        const int &rank, const int tag) {
-  // inter -- interblock boundary for the swap
-  // MPI_arrData -- MPI datatype to pass data type in array
-  // rank -- processor rank
-  // tag -- id to send data with (default 1)
-
-  // swap with mpi_send_recv_replace
-  // pack data into buffer, but first get size
-  auto bufSize = 0;
-  auto tempSize = 0;
-  // add size for states
-  MPI_Pack_size(this->Size(), MPI_arrData, MPI_COMM_WORLD, &tempSize);
-  bufSize += tempSize;
-  // add size for 4 ints for multiArray3d dims and num ghosts
-  MPI_Pack_size(4, MPI_INT, MPI_COMM_WORLD,
-                &tempSize);
-  bufSize += tempSize;
-
-  auto *buffer = new char[bufSize];  // allocate buffer to pack data into
-
-  // pack data into buffer
-  auto numI = this->NumI();
-  auto numJ = this->NumJ();
-  auto numK = this->NumK();
-  auto numGhosts = this->GhostLayers();
-  auto position = 0;
-  MPI_Pack(&numI, 1, MPI_INT, buffer, bufSize, &position,
-           MPI_COMM_WORLD);
-  MPI_Pack(&numJ, 1, MPI_INT, buffer, bufSize, &position,
-           MPI_COMM_WORLD);
-  MPI_Pack(&numK, 1, MPI_INT, buffer, bufSize, &position,
-           MPI_COMM_WORLD);
-  MPI_Pack(&numGhosts, 1, MPI_INT, buffer, bufSize, &position,
-           MPI_COMM_WORLD);
-  MPI_Pack(&data_[0], this->Size(), MPI_arrData, buffer,
-           bufSize, &position, MPI_COMM_WORLD);
-
-  MPI_Status status;
-  if (rank == inter.RankFirst()) {  // send/recv with second entry in interblock
-    MPI_Sendrecv_replace(buffer, bufSize, MPI_PACKED, inter.RankSecond(), tag,
-                         inter.RankSecond(), tag, MPI_COMM_WORLD, &status);
-  } else {  // send/recv with first entry in interblock
-    MPI_Sendrecv_replace(buffer, bufSize, MPI_PACKED, inter.RankFirst(), tag,
-                         inter.RankFirst(), tag, MPI_COMM_WORLD, &status);
-  }
-
-  // put slice back into multiArray3d
-  position = 0;
-  MPI_Unpack(buffer, bufSize, &position, &numI, 1, MPI_INT,
-             MPI_COMM_WORLD);
-  MPI_Unpack(buffer, bufSize, &position, &numJ, 1, MPI_INT,
-             MPI_COMM_WORLD);
-  MPI_Unpack(buffer, bufSize, &position, &numK, 1, MPI_INT,
-             MPI_COMM_WORLD);
-  MPI_Unpack(buffer, bufSize, &position, &numGhosts, 1, MPI_INT,
-             MPI_COMM_WORLD);
-  // resize slice
-  this->SameSizeResize(numI, numJ, numK);
-
-  MPI_Unpack(buffer, bufSize, &position, &data_[0],
-             this->Size(), MPI_arrData, MPI_COMM_WORLD);
-
-  delete[] buffer;
-}
-
-/* Function to swap slice using MPI. This is similar to the SwapSlice
-   function, but is called when the neighboring procBlocks are on different
-   processors.
-*/
-template <typename T>
-void multiArray3d<T>::SwapSliceMPI(const interblock &inter, const int &rank,
-                                   const MPI_Datatype &MPI_arrData,
-                                   const int tag) {
-  // inter -- interblock boundary information
-  // rank -- processor rank
-  // MPI_arrData -- MPI datatype for passing data in *this
-  // tag -- id for MPI swap (default 1)
-
-  // Get indices for slice coming from block to swap
-  auto is = 0, ie = 0;
-  auto js = 0, je = 0;
-  auto ks = 0, ke = 0;
-
-  if (rank == inter.RankFirst()) {  // local block first in interblock
-    inter.FirstSliceIndices(is, ie, js, je, ks, ke, numGhosts_);
-  } else if (rank == inter.RankSecond()) {  // local block second in interblock
-    inter.SecondSliceIndices(is, ie, js, je, ks, ke, numGhosts_);
-  } else {
-    cerr << "ERROR: Error in procBlock::SwapSliceMPI(). Processor rank does "
-            "not match either of interblock ranks!" << endl;
-    exit(EXIT_FAILURE);
-  }
-
-  // get local state slice to swap
-  auto slice = this->Slice({is, ie}, {js, je}, {ks, ke});
-
-  // swap state slices with partner block
-  slice.PackSwapUnpackMPI(inter, MPI_arrData, rank, tag);
-
-  // change interblocks to work with slice and ghosts
-  auto interAdj = inter;
-
-  // change interblocks to work with slice and ghosts
-  // block to insert into is first in interblock
-  if (rank == inter.RankFirst()) {
-    interAdj.AdjustForSlice(true, numGhosts_);
-  } else {  // block to insert into is second in interblock, so pass swapped
-            // version
-    interAdj.AdjustForSlice(false, numGhosts_);
-  }
-
-  // insert state slice into procBlock
-  this->PutSlice(slice, interAdj, numGhosts_);
-}
-
 /* Function to swap ghost cells between two blocks at an interblock
 boundary. Slices are removed from the physical cells (extending into ghost cells
 at the edges) of one block and inserted into the ghost cells of its partner
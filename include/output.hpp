@@ -23,14 +23,23 @@
 It contains function headers to write out the grid at the cell centers in Plot3D
 format, as well as the Plot3D function files.
 It also writes out a master file in Ensight format to name the Plot3D functions.
+The grid, function, and restart files are written by all processors at once,
+with each processor writing its own procBlocks directly into the layout of the
+parent blocks (see parallelIO.hpp). Depending on the output mode, these files
+are either written before the functions return, or written in the background
+while the solver continues.
 */
 
 #include <fstream>
 #include <iostream>
 #include <vector>        // vector
 #include <string>        // string
+#include <set>           // set
 #include <memory>        // unique_ptr
+#include <functional>    // function
+#include "mpi.h"         // MPI_Offset
 #include "multiArray3d.hpp"
+#include "vector3d.hpp"  // vector3d
 
 using std::vector;
 using std::string;
@@ -41,33 +50,49 @@ using std::endl;
 using std::cerr;
 using std::unique_ptr;
 using std::ostream;
+using std::set;
 
 // forward class declarations
 class procBlock;
 class genArray;
-class decomposition;
 class idealGas;
 class sutherland;
 class resid;
 class input;
 class turbModel;
+class blockLayout;
+class outputWriter;
+struct fileRun;
+
+// kernel to store an output variable for every cell of a range of a block;
+// the range is given by the first cell and one past the last cell
+using outputKernel = std::function<void(const procBlock &,
+                                        const vector3d<int> &,
+                                        const vector3d<int> &, double *)>;
 
 // function definitions
-void WriteBlockDims(ofstream &, const vector<procBlock> &, int = 0);
+void WriteBlockDims(ostream &, const blockLayout &, int = 0);
+void WriteVisualization(const string &, const string &, const MPI_Offset &,
+                        vector<fileRun> &, vector<double> &, const input &,
+                        outputWriter &);
+vector<outputKernel> OutputKernels(const set<string> &, const input &,
+                                   const idealGas &, const sutherland &);
 
-void WriteCellCenter(const string &, const vector<procBlock> &,
-                     const decomposition &, const double &);
-void WriteFun(const vector<procBlock> &, const idealGas &,
-              const sutherland &, const int &, const decomposition &,
-              const input &, const unique_ptr<turbModel> &);
+void WriteCellCenter(const vector<procBlock> &, const blockLayout &,
+                     const input &, outputWriter &);
+void WriteFun(const vector<procBlock> &, const blockLayout &, const idealGas &,
+              const sutherland &, const int &, const input &,
+              const unique_ptr<turbModel> &, outputWriter &);
 void WriteRes(const input &, const int &);
 void WriteMeta(const input &, const int &);
+void WriteMeta(const string &, const string &, const string &,
+               const set<string> &, const input &, const int &);
 
-void WriteRestart(const vector<procBlock> &, const idealGas &,
-                  const sutherland &, const int &, const decomposition &,
-                  const input &, const genArray &);
-void ReadRestart(vector<procBlock> &, const string &, input &,
-                 const idealGas &, const sutherland &,
+void WriteRestart(const vector<procBlock> &, const blockLayout &,
+                  const idealGas &, const sutherland &, const int &,
+                  const input &, const genArray &, outputWriter &);
+void ReadRestart(vector<procBlock> &, const blockLayout &, const string &,
+                 input &, const idealGas &, const sutherland &,
                  const unique_ptr<turbModel> &, genArray &);
 
 void WriteResiduals(const input &, genArray &, const genArray &, const resid &,
@@ -76,8 +101,4 @@ void PrintResiduals(const input &, genArray &, const genArray &, const resid &,
                     const double &, const int &, const int &, ostream &);
 void PrintHeaders(const input &, ostream &);
 
-vector<procBlock> Recombine(const vector<procBlock> &, const decomposition &);
-int SplitBlockNumber(const vector<procBlock> &, const decomposition &,
-                     const int &, const int &, const int &, const int &);
-
 #endif
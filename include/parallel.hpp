@@ -39,19 +39,19 @@ using std::ostream;
 // forward class declarations
 class boundaryConditions;
 class procBlock;
-class plot3dBlock;
+class plot3dBlockRange;
 class interblock;
 class decomposition;
 class resid;
 class genArray;
+class kdtree;
 
 // function definitions
-decomposition ManualDecomposition(vector<plot3dBlock>&,
+decomposition ManualDecomposition(vector<plot3dBlockRange>&,
                                   vector<boundaryConditions>&, const int&);
-decomposition CubicDecomposition(vector<plot3dBlock>&,
+decomposition CubicDecomposition(vector<plot3dBlockRange>&,
                                  vector<boundaryConditions>&, const int&);
 
-void SendNumProcBlocks(const vector<int>&, int&);
 void SendConnections(vector<interblock>&, const MPI_Datatype&);
 
 void SetDataTypesMPI(MPI_Datatype&, MPI_Datatype&, MPI_Datatype&, MPI_Datatype&,
@@ -61,17 +61,13 @@ void FreeDataTypesMPI(MPI_Datatype&, MPI_Datatype&, MPI_Datatype&,
                       MPI_Datatype&, MPI_Datatype&, MPI_Datatype&,
                       MPI_Datatype&, MPI_Datatype&);
 
-vector<procBlock> SendProcBlocks(const vector<procBlock>&, const int&,
-                                 const int&, const MPI_Datatype&,
-                                 const MPI_Datatype&, const MPI_Datatype&);
-void GetProcBlocks(vector<procBlock>&, const vector<procBlock>&, const int&,
-                   const MPI_Datatype&, const MPI_Datatype&,
-                   const MPI_Datatype&, const MPI_Datatype&);
-
 void MaxLinf(resid*, resid*, int*, MPI_Datatype*);
 
 void BroadcastString(string& str);
 
-void BroadcastViscFaces(const MPI_Datatype&, vector<vector3d<double>> &);
+void BroadcastBoundaryConditions(vector<boundaryConditions> &);
+void PartitionViscFaces(const MPI_Datatype&, vector<vector3d<double>> &);
+vector<double> NearestWallDistances(const kdtree &,
+                                    const vector<vector3d<double>> &);
 
 #endif
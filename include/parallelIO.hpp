@@ -0,0 +1,161 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-17  Michael Nucci (michael.nucci@gmail.com)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#ifndef PARALLELIOHEADERDEF  // only if the macro PARALLELIOHEADERDEF is not
+                             // defined execute these lines of code
+#define PARALLELIOHEADERDEF  // define the macro
+
+/* This header contains the blockLayout class and the functions used to write
+   and read files from all processors at once with MPI-IO.
+
+   The output files are written in the layout of the parent blocks (the blocks
+   of the grid before it was decomposed). The blockLayout class stores where
+   each procBlock lies within its parent block, so that each processor can
+   find the location in the file of every cell it owns. Each processor then
+   writes or reads its own cells directly, and the solution never has to be
+   gathered on or scattered from the ROOT processor.
+
+   The outputWriter class writes these files during the simulation. The data
+   for a file is first copied from the procBlocks into a staging buffer. In
+   blocking mode the file is then written before the solver continues. In
+   snapshot mode the writer keeps the staging buffer and starts a nonblocking
+   collective write, so the file is written while the solver continues to
+   iterate. Pending writes are completed (and their files closed) by Wait(),
+   which must be called before the next set of files is written and before
+   MPI is finalized.
+*/
+
+#include <vector>                  // vector
+#include <string>                  // string
+#include "mpi.h"                   // parallelism
+#include "vector3d.hpp"            // vector3d
+#include "inputOptions.hpp"        // outputMethod
+
+using std::vector;
+using std::string;
+
+// forward class declarations
+class plot3dBlockRange;
+class decomposition;
+
+class blockLayout {
+  vector<int> parent_;                // parent block of each procBlock
+  vector<vector3d<int>> start_;       // start of each procBlock in parent
+  vector<vector3d<int>> dims_;        // number of cells in each procBlock
+  vector<vector3d<int>> parentDims_;  // number of cells in each parent block
+  vector<long long> cellsBefore_;     // cells in all preceding parent blocks
+
+  // private member functions
+  void CountCells();
+
+ public:
+  // constructor
+  blockLayout(const vector<plot3dBlockRange> &, const decomposition &);
+  blockLayout() {}
+
+  // move constructor and assignment operator
+  blockLayout(blockLayout&&) noexcept = default;
+  blockLayout& operator=(blockLayout&&) noexcept = default;
+
+  // copy constructor and assignment operator
+  blockLayout(const blockLayout&) = default;
+  blockLayout& operator=(const blockLayout&) = default;
+
+  // member functions
+  int NumBlocks() const { return parent_.size(); }
+  int NumParents() const { return parentDims_.size(); }
+  int Parent(const int &a) const { return parent_[a]; }
+  vector3d<int> Start(const int &a) const { return start_[a]; }
+  vector3d<int> Dims(const int &a) const { return dims_[a]; }
+  vector3d<int> ParentDims(const int &a) const { return parentDims_[a]; }
+  long long ParentCells(const int &a) const {
+    return cellsBefore_[a + 1] - cellsBefore_[a];
+  }
+  long long CellsBefore(const int &a) const { return cellsBefore_[a]; }
+  long long TotalCells() const { return cellsBefore_.back(); }
+  long long ParentIndex(const int &, const int &, const int &,
+                        const int &) const;
+
+  void BroadcastMPI();
+
+  // destructor
+  ~blockLayout() noexcept {}
+};
+
+// contiguous run of values (doubles or floats) in a file
+struct fileRun {
+  MPI_Offset file_;    // offset of run in file (bytes)
+  long long buffer_;   // offset of run in buffer (values)
+  int size_;           // number of values in run
+};
+
+class outputWriter {
+  // file being written in the background
+  struct pendingWrite {
+    string name_;               // name of file
+    MPI_File file_;             // open file
+    MPI_Datatype fileType_;     // file view of runs
+    MPI_Datatype bufferType_;   // runs in buffer
+    MPI_Request request_;       // request for nonblocking write
+    vector<double> buffer_;     // staged data to write
+    vector<float> floatBuffer_;  // staged single precision data to write
+  };
+
+  outputMethod method_;           // blocking or snapshot writes
+  vector<pendingWrite> pending_;  // writes that have not been completed
+
+  // private member functions
+  void Start(pendingWrite &, const string &, const string &,
+             const MPI_Offset &, vector<fileRun> &, const void *,
+             const MPI_Datatype &);
+
+ public:
+  // constructor
+  explicit outputWriter(const outputMethod &method = outputMethod::blocking)
+      : method_(method) {}
+
+  // move constructor and assignment operator
+  outputWriter(outputWriter&&) noexcept = default;
+  outputWriter& operator=(outputWriter&&) noexcept = default;
+
+  // copy constructor and assignment operator
+  // a writer with files being written should not be copied
+  outputWriter(const outputWriter&) = delete;
+  outputWriter& operator=(const outputWriter&) = delete;
+
+  // member functions
+  outputMethod Method() const { return method_; }
+  int NumPending() const { return pending_.size(); }
+  void Write(const string &, const string &, const MPI_Offset &,
+             vector<fileRun> &, vector<double> &);
+  void Write(const string &, const string &, const MPI_Offset &,
+             vector<fileRun> &, vector<float> &);
+  void Progress();
+  void Wait();
+
+  // destructor
+  ~outputWriter() noexcept {}
+};
+
+// function declarations
+void CreateRunTypes(vector<fileRun> &, const MPI_Datatype &, MPI_Datatype &,
+                    MPI_Datatype &);
+MPI_File OpenCollective(const string &, const string &, const MPI_Offset &);
+void WriteCollective(const string &, const string &, const MPI_Offset &,
+                     vector<fileRun> &, const void *, const MPI_Datatype &);
+void ReadCollective(MPI_File &, vector<fileRun> &, vector<double> &);
+
+#endif
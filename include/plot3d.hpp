@@ -24,11 +24,13 @@
 
 #include <vector>
 #include <string>
+#include <fstream>
 #include "vector3d.hpp"
 #include "multiArray3d.hpp"
 
 using std::vector;
 using std::string;
+using std::ifstream;
 
 //-------------------------------------------------------------------------
 // Class for an individual plot3d block
@@ -88,9 +90,96 @@ class plot3dBlock {
   ~plot3dBlock() noexcept {}
 };
 
+class plot3dGridFile;
+
+//-------------------------------------------------------------------------
+// Class for a range of points within a block of a plot3d grid file. Only the
+// location of the range is stored, so the grid can be decomposed without
+// loading it. The coordinates of a point are read from the grid file when they
+// are asked for, which is only done for the corners of patches.
+class plot3dBlockRange {
+  const plot3dGridFile *grid_;  // grid file that range is in
+  int parent_;                  // block of grid file that range is in
+  vector3d<int> start_;         // index of first point within parent block
+  vector3d<int> numPts_;        // number of points in each direction
+
+ public:
+  // constructor
+  plot3dBlockRange(const plot3dGridFile &grid, const int &parent,
+                   const vector3d<int> &start, const vector3d<int> &numPts) :
+      grid_(&grid), parent_(parent), start_(start), numPts_(numPts) {}
+  plot3dBlockRange() : grid_(nullptr), parent_(0), start_(0, 0, 0),
+                       numPts_(1, 1, 1) {}
+
+  // move constructor and assignment operator
+  plot3dBlockRange(plot3dBlockRange&&) noexcept = default;
+  plot3dBlockRange& operator=(plot3dBlockRange&&) noexcept = default;
+
+  // copy constructor and assignment operator
+  plot3dBlockRange(const plot3dBlockRange&) = default;
+  plot3dBlockRange& operator=(const plot3dBlockRange&) = default;
+
+  // member functions
+  int Parent() const { return parent_; }
+  vector3d<int> Start() const { return start_; }
+  int NumI() const { return numPts_[0]; }
+  int NumJ() const { return numPts_[1]; }
+  int NumK() const { return numPts_[2]; }
+  int NumCells() const {
+    return (numPts_[0] - 1) * (numPts_[1] - 1) * (numPts_[2] - 1);
+  }
+  vector3d<double> Coords(const int &, const int &, const int &) const;
+
+  void Split(const string &, const int &, plot3dBlockRange &,
+             plot3dBlockRange &) const;
+
+  // destructor
+  ~plot3dBlockRange() noexcept {}
+};
+
+//-------------------------------------------------------------------------
+// Class for a plot3d grid file that has only had its header read. The file is
+// kept open so the coordinates of single points can be read from it.
+class plot3dGridFile {
+  mutable ifstream file_;              // open grid file
+  string name_;                        // name of grid (without extension)
+  double lRef_;                        // reference length
+  vector<vector3d<int>> dims_;         // number of points in each block
+  vector<std::streamoff> blkStart_;    // location of coordinates of each block
+
+ public:
+  // constructor
+  plot3dGridFile(const string &, const double &);
+
+  // move constructor and assignment operator
+  plot3dGridFile(plot3dGridFile&&) = default;
+  plot3dGridFile& operator=(plot3dGridFile&&) = default;
+
+  // copy constructor and assignment operator
+  // blocks keep a pointer to their grid file, so it should not be copied
+  plot3dGridFile(const plot3dGridFile&) = delete;
+  plot3dGridFile& operator=(const plot3dGridFile&) = delete;
+
+  // member functions
+  int NumBlocks() const { return dims_.size(); }
+  vector3d<int> Dims(const int &blk) const { return dims_[blk]; }
+  vector<plot3dBlockRange> Blocks(double &) const;
+  vector3d<double> Coords(const int &, const int &, const int &,
+                          const int &) const;
+
+  // destructor
+  ~plot3dGridFile() noexcept {}
+};
+
 //-------------------------------------------------------------------------
 // function declarations
-vector<plot3dBlock> ReadP3dGrid(const string &, const double &, double &);
+void OpenP3dGrid(const string &, ifstream &);
+vector<vector3d<int>> ReadP3dGridHeader(const string &);
+vector<std::streamoff> P3dBlockLocations(const vector<vector3d<int>> &);
+vector<plot3dBlock> ReadP3dGridRanges(const string &, const double &,
+                                      const vector<int> &,
+                                      const vector<vector3d<int>> &,
+                                      const vector<vector3d<int>> &);
 
 
 #endif
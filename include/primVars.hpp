@@ -36,6 +36,7 @@ supply a ghost state given a boundary condition and boundary cell.  */
 #include "eos.hpp"                 // idealGas, sutherland
 #include "multiArray3d.hpp"        // multiArray3d
 #include "genArray.hpp"            // genArray
+#include "inputOptions.hpp"        // limiterMethod
 #include "macros.hpp"
 
 using std::vector;
@@ -79,6 +80,9 @@ class primVars {
   primVars& operator=(const primVars&) = default;
 
   // member functions
+  const double & operator[](const int &r) const { return data_[r]; }
+  double & operator[](const int &r) { return data_[r]; }
+
   double Rho() const { return data_[0]; }
   double U() const { return data_[1]; }
   double V() const { return data_[2]; }
@@ -174,10 +178,11 @@ class primVars {
 
   // member function to calculate reconstruction of state variables from cell
   // center to cell face this function uses muscle extrapolation resulting in
-  // higher order accuracy
+  // higher order accuracy; the limiter is chosen at compile time
+  template <limiterMethod L>
   primVars FaceReconMUSCL(const primVars &, const primVars &, const double &,
-                          const string &, const double &,
-                          const double &, const double &) const;
+                          const double &, const double &,
+                          const double &) const;
 
   // calculate face reconstruction using 5th order weno scheme
   primVars FaceReconWENO(const primVars &, const primVars &, const primVars &,
@@ -208,6 +213,11 @@ multiArray3d<primVars> GetGhostStates(
     const int &, const input &, const int &, const idealGas &, const sutherland &,
     const unique_ptr<turbModel> &, const int = 1);
 
+template <limiterMethod L>
+void FaceReconMUSCL(const double *, const double *, const double *,
+                    const double *, const double *, const double *,
+                    const double &, const int &, double *);
+
 // member function to calculate temperature from conserved variables and
 // equation of state
 double primVars::Temperature(const idealGas &eqnState) const {
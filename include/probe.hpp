@@ -0,0 +1,101 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-17  Michael Nucci (michael.nucci@gmail.com)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#ifndef PROBEHEADERDEF  // only if the macro PROBEHEADERDEF is not defined
+                        // execute these lines of code
+#define PROBEHEADERDEF  // define the macro
+
+/* This header contains the probeSeries class.
+
+   The probeSeries class records the time history of variables at points in
+   the domain. The probe locations are given in the input file (in the units
+   of the grid), and are located once at the start of the run. Each probe is
+   owned by the processor with the cell center nearest to it. The value at a
+   probe is interpolated from that cell and its neighboring cells in the same
+   block with inverse distance weighting. The samples are buffered in memory,
+   and written to the probe file in large appends.
+
+   The probe file <simName>.probe is binary. It starts with the number of
+   probes and the number of variables (ints), then the name of each variable
+   (an int length followed by the characters), and then the x, y, z location
+   of each probe (doubles). This is followed by one record (doubles) for each
+   sample, made of the iteration number and then each variable for each probe,
+   with all variables of a probe stored together.
+*/
+
+#include <vector>                  // vector
+#include <string>                  // string
+#include <set>                     // set
+#include "vector3d.hpp"            // vector3d
+#include "output.hpp"              // outputKernel
+
+using std::vector;
+using std::string;
+using std::set;
+
+// forward class declarations
+class procBlock;
+class input;
+class idealGas;
+class sutherland;
+
+class probeSeries {
+  // cells used to interpolate a probe owned by this processor
+  struct localProbe {
+    int probe_;                   // index of probe
+    int block_;                   // local position of block
+    vector<vector3d<int>> cells_;  // cells to interpolate from
+    vector<double> weights_;      // interpolation weight of each cell
+  };
+
+  string fileName_;                        // name of probe file
+  vector<vector3d<double>> locations_;     // location of every probe
+  set<string> variables_;                  // variables to record
+  vector<outputKernel> kernels_;           // kernel for each variable
+  vector<localProbe> local_;               // probes owned by this processor
+  int bufferSize_;                         // samples held before writing
+  vector<double> iterations_;              // iteration of each sample
+  vector<double> samples_;                 // values of all samples
+
+  // private member functions
+  void Locate(const vector<procBlock> &);
+  void WriteHeader(const double &) const;
+
+ public:
+  // constructor
+  probeSeries(const vector<procBlock> &, const input &, const idealGas &,
+              const sutherland &);
+
+  // move constructor and assignment operator
+  probeSeries(probeSeries&&) noexcept = default;
+  probeSeries& operator=(probeSeries&&) noexcept = default;
+
+  // copy constructor and assignment operator
+  probeSeries(const probeSeries&) = default;
+  probeSeries& operator=(const probeSeries&) = default;
+
+  // member functions
+  int NumProbes() const {return locations_.size();}
+  int NumVariables() const {return variables_.size();}
+  int NumSamples() const {return iterations_.size();}
+  void Sample(const vector<procBlock> &, const int &);
+  void Flush();
+
+  // destructor
+  ~probeSeries() noexcept {}
+};
+
+#endif
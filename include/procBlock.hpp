@@ -26,12 +26,14 @@
 #include "mpi.h"                   // parallelism
 #include "vector3d.hpp"            // vector3d
 #include "multiArray3d.hpp"        // multiArray3d
+#include "soaMultiArray3d.hpp"     // soaMultiArray3d
 #include "tensor.hpp"              // tensor
 #include "primVars.hpp"            // primVars
 #include "genArray.hpp"            // genArray
 #include "boundaryConditions.hpp"  // interblock, patch
 #include "macros.hpp"
 #include "uncoupledScalar.hpp"     // uncoupledScalar
+#include "inputOptions.hpp"        // numerical method enumerations
 
 using std::vector;
 using std::string;
@@ -47,22 +49,33 @@ using std::unique_ptr;
 class idealGas;
 class sutherland;
 class inviscidFlux;
+class fluxBatch;
 class viscousFlux;
 class input;
 class geomSlice;
 class source;
 class turbModel;
 class plot3dBlock;
+class haloExchange;
 class resid;
 class fluxJacobian;
 class kdtree;
 
+// container for the solution fields; the layout is chosen at build time
+#ifdef SOA_FIELDS
+template <typename T>
+using fieldArray3d = soaMultiArray3d<T>;  // structure of arrays
+#else
+template <typename T>
+using fieldArray3d = multiArray3d<T>;  // array of structures
+#endif
+
 class procBlock {
-  multiArray3d<primVars> state_;  // primative variables at cell center
-  multiArray3d<genArray> consVarsN_;  // conserved variables at time n
-  multiArray3d<genArray> consVarsNm1_;  // conserved variables at time n-1
+  fieldArray3d<primVars> state_;  // primative variables at cell center
+  fieldArray3d<genArray> consVarsN_;  // conserved variables at time n
+  fieldArray3d<genArray> consVarsNm1_;  // conserved variables at time n-1
 
-  multiArray3d<genArray> residual_;  // cell residual
+  fieldArray3d<genArray> residual_;  // cell residual
 
   multiArray3d<unitVec3dMag<double>> fAreaI_;  // face area vector for i-faces
   multiArray3d<unitVec3dMag<double>> fAreaJ_;  // face area vector for j-faces
@@ -97,6 +110,15 @@ class procBlock {
 
   boundaryConditions bc_;  // boundary conditions for block
 
+  // classification of faces, built from boundary conditions (no ghosts)
+  multiArray3d<faceType> faceTypeI_;  // type of i-faces
+  multiArray3d<faceType> faceTypeJ_;  // type of j-faces
+  multiArray3d<faceType> faceTypeK_;  // type of k-faces
+
+  // cells ordered by hyperplane for lu-sgs sweeps (no ghosts)
+  vector<vector3d<int>> hyperplaneCells_;
+  vector<int> hyperplaneStart_;  // index of first cell in each hyperplane
+
   int numGhosts_;  // number of layers of ghost cells surrounding block
   int parBlock_;  // parent block number
   int rank_;  // processor rank
@@ -109,22 +131,63 @@ class procBlock {
   bool isMultiLevelTime_;
 
   // private member functions
+  void ClassifyFaces() {
+    bc_.ClassifyFaces(faceTypeI_, faceTypeJ_, faceTypeK_);
+  }
+  void OrderHyperplanes();
+  // flux kernels are specialized on the numerical methods chosen in the input
+  void CalcInvFlux(const idealGas &, const input &,
+                   const unique_ptr<turbModel> &,
+                   multiArray3d<fluxJacobian> &, const bool (&)[6],
+                   const bool &);
+  template <reconstructionMethod R, limiterMethod L>
+  void CalcInvFlux(const idealGas &, const input &,
+                   const unique_ptr<turbModel> &,
+                   multiArray3d<fluxJacobian> &, const bool (&)[6],
+                   const bool &);
+  template <reconstructionMethod R, limiterMethod L, inviscidFluxMethod F,
+            bool isBlock>
+  void CalcInvFlux(const idealGas &, const input &,
+                   const unique_ptr<turbModel> &,
+                   multiArray3d<fluxJacobian> &, const bool (&)[6],
+                   const bool &);
+  template <reconstructionMethod R, limiterMethod L, inviscidFluxMethod F,
+            bool isBlock>
   void CalcInvFluxI(const idealGas &, const input &,
                     const unique_ptr<turbModel> &,
-                    multiArray3d<fluxJacobian> &);
+                    multiArray3d<fluxJacobian> &, const vector3d<int> &,
+                    const vector3d<int> &, const bool &);
+  template <reconstructionMethod R, limiterMethod L, inviscidFluxMethod F,
+            bool isBlock>
   void CalcInvFluxJ(const idealGas &, const input &,
                     const unique_ptr<turbModel> &,
-                    multiArray3d<fluxJacobian> &);
+                    multiArray3d<fluxJacobian> &, const vector3d<int> &,
+                    const vector3d<int> &, const bool &);
+  template <reconstructionMethod R, limiterMethod L, inviscidFluxMethod F,
+            bool isBlock>
   void CalcInvFluxK(const idealGas &, const input &,
                     const unique_ptr<turbModel> &,
-                    multiArray3d<fluxJacobian> &);
+                    multiArray3d<fluxJacobian> &, const vector3d<int> &,
+                    const vector3d<int> &, const bool &);
+#ifdef SOA_FIELDS
+  template <reconstructionMethod R, limiterMethod L>
+  void FaceReconPlanes(const vector3d<int> &, const vector3d<int> &,
+                       const multiArray3d<double> &, const double &,
+                       const int &, const int &, fluxBatch &) const;
+#endif
 
+  void CalcViscFlux(const sutherland &, const idealGas &, const input &,
+                    const unique_ptr<turbModel> &,
+                    multiArray3d<fluxJacobian> &);
+  template <viscousReconstructionMethod V, bool isBlock>
   void CalcViscFluxI(const sutherland &, const idealGas &, const input &,
                      const unique_ptr<turbModel> &,
                      multiArray3d<fluxJacobian> &);
+  template <viscousReconstructionMethod V, bool isBlock>
   void CalcViscFluxJ(const sutherland &, const idealGas &, const input &,
                      const unique_ptr<turbModel> &,
                      multiArray3d<fluxJacobian> &);
+  template <viscousReconstructionMethod V, bool isBlock>
   void CalcViscFluxK(const sutherland &, const idealGas &, const input &,
                      const unique_ptr<turbModel> &,
                      multiArray3d<fluxJacobian> &);
@@ -144,6 +207,15 @@ class procBlock {
                      const int &);
   void AddToResidual(const viscousFlux &, const int &, const int &,
                      const int &);
+#ifdef SOA_FIELDS
+  void AddToResidual(const fluxBatch &, const vector3d<int> *, const int &,
+                     const vector3d<int> &,
+                     const multiArray3d<unitVec3dMag<double>> &,
+                     const vector3d<int> &, const vector3d<int> &,
+                     const bool &);
+#endif
+  bool InPass(const vector3d<int> &, const vector3d<int> &,
+              const vector3d<int> &, const bool &) const;
   void SubtractFromResidual(const inviscidFlux &, const int &, const int &,
                             const int &);
   void SubtractFromResidual(const viscousFlux &, const int &, const int &,
@@ -157,6 +229,9 @@ class procBlock {
   procBlock(const double &, const plot3dBlock &, const int &,
             const boundaryConditions &, const int &, const int &, const int &,
             const input &, const idealGas &, const sutherland &);
+  procBlock(const double &, const vector3d<int> &, const int &,
+            const boundaryConditions &, const int &, const int &, const int &,
+            const input &, const idealGas &, const sutherland &);
   procBlock(const int &, const int &, const int &, const int &, const bool &,
             const bool &, const bool &, const bool &);
   procBlock() : procBlock(1, 1, 1, 0, false, false, false, false) {}
@@ -362,17 +437,18 @@ class procBlock {
                    const unique_ptr<turbModel> &, const int &, genArray &,
                    resid &);
 
-  void CalcResidualNoSource(const sutherland &, const idealGas &,
-                            const input &,
+  void CalcResidualInterior(const idealGas &, const input &,
                             const unique_ptr<turbModel> &,
-                            multiArray3d<fluxJacobian> &);
+                            multiArray3d<fluxJacobian> &, const bool (&)[6]);
+  void CalcResidualHalo(const sutherland &, const idealGas &, const input &,
+                        const unique_ptr<turbModel> &,
+                        multiArray3d<fluxJacobian> &, const bool (&)[6]);
   void CalcSrcTerms(const sutherland &, const unique_ptr<turbModel> &,
                     const input &, multiArray3d<fluxJacobian> &);
 
   void ResetResidWS();
   void ResetGradients();
   void ResetTurbVars();
-  void CleanResizeVecs(const int &, const int &, const int &, const int &);
 
   void AssignGhostCellsGeom();
   void AssignGhostCellsGeomEdge();
@@ -401,7 +477,15 @@ class procBlock {
                   tensor<double> &, vector3d<double> &, vector3d<double> &,
                   vector3d<double> &) const;
 
-  void CalcWallDistance(const kdtree &);
+  vector<vector3d<int>> WallDistanceCells(const input &) const;
+  void AssignWallDistance(const vector<vector3d<int>> &, const double *);
+  void SeedWallPoints(multiArray3d<vector3d<double>> &,
+                      multiArray3d<double> &) const;
+  bool SweepWallPoints(multiArray3d<vector3d<double>> &,
+                       multiArray3d<double> &) const;
+  void AssignWallDistance(const multiArray3d<double> &);
+  void PackGeometry(double *) const;
+  void UnpackGeometry(const double *);
 
   multiArray3d<genArray> DeltaNMinusOne(const multiArray3d<genArray> &,
                                         const idealGas &, const double &,
@@ -414,12 +498,12 @@ class procBlock {
   multiArray3d<genArray> InitializeMatrixUpdate(
       const input &, const idealGas &eos,
       const multiArray3d<fluxJacobian> &) const;
-  void LUSGS_Forward(const vector<vector3d<int>> &, multiArray3d<genArray> &,
-                     const idealGas &, const input &, const sutherland &,
+  void LUSGS_Forward(multiArray3d<genArray> &, const idealGas &,
+                     const input &, const sutherland &,
                      const unique_ptr<turbModel> &,
                      const multiArray3d<fluxJacobian> &, const int &) const;
-  double LUSGS_Backward(const vector<vector3d<int>> &, multiArray3d<genArray> &,
-                        const idealGas &, const input &, const sutherland &,
+  double LUSGS_Backward(multiArray3d<genArray> &, const idealGas &,
+                        const input &, const sutherland &,
                         const unique_ptr<turbModel> &,
                         const multiArray3d<fluxJacobian> &, const int &) const;
 
@@ -442,21 +526,11 @@ class procBlock {
   void Join(const procBlock &, const string &, vector<boundarySurface> &);
 
   void SwapStateSlice(const interblock &, procBlock &);
-  void SwapStateSliceMPI(const interblock &, const int &, const MPI_Datatype &);
+  void AddStateSliceMPI(const int &, haloExchange &);
   void SwapTurbSlice(const interblock &, procBlock &);
-  void SwapTurbSliceMPI(const interblock &, const int &);
+  void AddTurbSliceMPI(const int &, haloExchange &);
   void SwapGradientSlice(const interblock &, procBlock &);
-  void SwapGradientSliceMPI(const interblock &, const int &,
-                            const MPI_Datatype &, const MPI_Datatype &);
-
-  void PackSendGeomMPI(const MPI_Datatype &, const MPI_Datatype &,
-                       const MPI_Datatype &) const;
-  void RecvUnpackGeomMPI(const MPI_Datatype &, const MPI_Datatype &,
-                         const MPI_Datatype &);
-  void PackSendSolMPI(const MPI_Datatype &, const MPI_Datatype &,
-                      const MPI_Datatype &, const MPI_Datatype &) const;
-  void RecvUnpackSolMPI(const MPI_Datatype &, const MPI_Datatype &,
-                        const MPI_Datatype &, const MPI_Datatype &);
+  void AddGradientSliceMPI(const int &, haloExchange &);
 
   void UpdateAuxillaryVariables(const idealGas &, const sutherland &,
                                 const bool = true);
@@ -467,12 +541,14 @@ class procBlock {
 
   void DumpToFile(const string &, const string &) const;
   void CalcCellWidths();
-  void ReadSolFromRestart(ifstream &, const input &, const idealGas &,
-                          const sutherland &, const unique_ptr<turbModel> &,
-                          const vector<string> &);
-  void ReadSolNm1FromRestart(ifstream &, const input &, const idealGas &,
-                          const sutherland &, const unique_ptr<turbModel> &,
+  void ReadSolFromRestart(vector<double>::const_iterator &, const input &,
+                          const idealGas &, const sutherland &,
+                          const unique_ptr<turbModel> &,
                           const vector<string> &);
+  void ReadSolNm1FromRestart(vector<double>::const_iterator &, const input &,
+                             const idealGas &, const sutherland &,
+                             const unique_ptr<turbModel> &,
+                             const vector<string> &);
 
   // destructor
   ~procBlock() noexcept {}
@@ -102,6 +102,9 @@ class geomSlice {
     return fCenterK_(ii, jj, kk);
   }
 
+  void PackSwapUnpackMPI(const interblock &, const MPI_Datatype &,
+                         const MPI_Datatype &, const int &);
+
   // destructor
   ~geomSlice() noexcept {}
 };
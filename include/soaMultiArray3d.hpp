@@ -0,0 +1,756 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-17  Michael Nucci (michael.nucci@gmail.com)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#ifndef SOAMULTIARRAY3DHEADERDEF  // only if the macro SOAMULTIARRAY3DHEADERDEF
+                                  // is not defined execute these lines of code
+
+#define SOAMULTIARRAY3DHEADERDEF  // define the macro
+
+/* This file contains the header and implementation for a structure of arrays
+   (SoA) version of the multiArray3d class. It is meant to store types that are
+   a fixed collection of NUMVARS doubles (primVars, genArray). Instead of
+   storing the cells contiguously, each variable is stored in its own
+   contiguous plane with the same i, j, k + ghost cell indexing as
+   multiArray3d. This allows loops over a single variable to be unit stride.
+
+   Element access of a non-const array returns a soaCellRef proxy, which reads
+   and writes the cell in the variable planes. Element access of a const array
+   returns a copy of the cell. Kernels that need speed loop over the variable
+   planes directly with Plane() and the 1D location of a cell. Slices are
+   returned as ordinary (array of structures) multiArray3d so that the ghost
+   cell, split, join, and interblock swap code can operate on them unchanged.
+ */
+
+#include <iostream>  // ostream
+#include <vector>    // vector
+#include <string>    // string
+#include <algorithm>  // fill
+#include "mpi.h"
+#include "macros.hpp"
+#include "multiArray3d.hpp"
+#include "boundaryConditions.hpp"  // interblock
+#include "range.hpp"  // range
+
+using std::ostream;
+using std::endl;
+using std::cout;
+using std::cerr;
+using std::vector;
+using std::string;
+
+template <typename T>
+class soaMultiArray3d;
+
+/* Proxy class to a single cell of a soaMultiArray3d. The proxy only holds the
+   location of the cell; it does not hold a copy of it. Reading the proxy as the
+   stored type gathers the cell from the variable planes, and assignments and
+   compound assignments go directly to the variable planes. Proxies can not be
+   copied, so "auto val = arr(ii, jj, kk)" does not compile; a copy of the cell
+   is made by converting to the stored type instead.
+*/
+template <typename T>
+class soaCellRef {
+  soaMultiArray3d<T> &arr_;
+  const int loc_;
+
+ public:
+  // constructor
+  soaCellRef(soaMultiArray3d<T> &arr, const int &loc) : arr_(arr), loc_(loc) {}
+
+  // proxies are not copied
+  soaCellRef(const soaCellRef &) = delete;
+
+  // assignment writes through to the array
+  soaCellRef & operator=(const soaCellRef &ref) {
+    return *this = static_cast<T>(ref);
+  }
+  soaCellRef & operator=(const T &val) {
+    arr_.Scatter(loc_, val);
+    return *this;
+  }
+  soaCellRef & operator+=(const T &val) {
+    for (auto vv = 0; vv < NUMVARS; vv++) {
+      arr_.Var(vv, loc_) += val[vv];
+    }
+    return *this;
+  }
+  soaCellRef & operator-=(const T &val) {
+    for (auto vv = 0; vv < NUMVARS; vv++) {
+      arr_.Var(vv, loc_) -= val[vv];
+    }
+    return *this;
+  }
+  soaCellRef & operator*=(const double &val) {
+    for (auto vv = 0; vv < NUMVARS; vv++) {
+      arr_.Var(vv, loc_) *= val;
+    }
+    return *this;
+  }
+
+  // conversion gathers the cell from the variable planes
+  operator T() const { return arr_.Gather(loc_); }
+
+  // variable access goes directly to the variable planes
+  double & operator[](const int &vv) { return arr_.Var(vv, loc_); }
+  const double & operator[](const int &vv) const { return arr_.Var(vv, loc_); }
+
+  // destructor
+  ~soaCellRef() noexcept {}
+};
+
+template <typename T>
+class soaMultiArray3d {
+  vector<double> data_;  // NUMVARS planes of numI_ * numJ_ * numK_ values
+  int numI_;
+  int numJ_;
+  int numK_;
+  int numGhosts_;
+
+  // private member functions
+  int GetLoc1D(const int &ii, const int &jj, const int &kk) const {
+    return (ii + numGhosts_) + (jj + numGhosts_) * numI_ +
+        (kk + numGhosts_) * numI_ * numJ_;
+  }
+
+ public:
+  // constructor
+  soaMultiArray3d(const int &ii, const int &jj, const int &kk, const int &ng,
+                  const T &init) :
+      data_((ii + 2 * ng) * (jj + 2 * ng) * (kk + 2 * ng) * NUMVARS),
+      numI_(ii + 2 * ng), numJ_(jj + 2 * ng), numK_(kk + 2 * ng),
+      numGhosts_(ng) {
+    this->Zero(init);
+  }
+  soaMultiArray3d(const int &ii, const int &jj, const int &kk, const int &ng) :
+      soaMultiArray3d(ii, jj, kk, ng, T()) {}
+  soaMultiArray3d() : soaMultiArray3d(1, 1, 1, 0) {}
+
+  // conversion from array of structures layout
+  soaMultiArray3d(const multiArray3d<T> &arr) :
+      soaMultiArray3d(arr.NumINoGhosts(), arr.NumJNoGhosts(),
+                      arr.NumKNoGhosts(), arr.GhostLayers()) {
+    this->Insert(arr.RangeI(), arr.RangeJ(), arr.RangeK(), arr);
+  }
+
+  // move constructor and assignment operator
+  soaMultiArray3d(soaMultiArray3d&&) noexcept = default;
+  soaMultiArray3d& operator=(soaMultiArray3d&&) noexcept = default;
+
+  // copy constructor and assignment operator
+  soaMultiArray3d(const soaMultiArray3d&) = default;
+  soaMultiArray3d& operator=(const soaMultiArray3d&) = default;
+
+  // member functions
+  int Size() const {return numI_ * numJ_ * numK_;}
+  int NumI() const {return numI_;}
+  int NumJ() const {return numJ_;}
+  int NumK() const {return numK_;}
+  int NumINoGhosts() const {return numI_ - 2 * numGhosts_;}
+  int NumJNoGhosts() const {return numJ_ - 2 * numGhosts_;}
+  int NumKNoGhosts() const {return numK_ - 2 * numGhosts_;}
+  int GhostLayers() const {return numGhosts_;}
+  int StartI() const {return -numGhosts_;}
+  int StartJ() const {return -numGhosts_;}
+  int StartK() const {return -numGhosts_;}
+  int EndI() const {return numI_ - numGhosts_;}
+  int EndJ() const {return numJ_ - numGhosts_;}
+  int EndK() const {return numK_ - numGhosts_;}
+  int Start(const string &) const;
+  int End(const string &) const;
+
+  int PhysStartI() const {return 0;}
+  int PhysStartJ() const {return 0;}
+  int PhysStartK() const {return 0;}
+  int PhysEndI() const {return this->NumINoGhosts();}
+  int PhysEndJ() const {return this->NumJNoGhosts();}
+  int PhysEndK() const {return this->NumKNoGhosts();}
+  int PhysStart(const string &) const;
+  int PhysEnd(const string &) const;
+
+  int PhysicalSize() const {
+    return this->NumINoGhosts() * this->NumJNoGhosts() * this->NumKNoGhosts();
+  }
+  range RangeI() const {return {this->StartI(), this->EndI()};}
+  range RangeJ() const {return {this->StartJ(), this->EndJ()};}
+  range RangeK() const {return {this->StartK(), this->EndK()};}
+  range PhysRangeI() const {return {this->PhysStartI(), this->PhysEndI()};}
+  range PhysRangeJ() const {return {this->PhysStartJ(), this->PhysEndJ()};}
+  range PhysRangeK() const {return {this->PhysStartK(), this->PhysEndK()};}
+
+  // iterators over the raw variable planes; Size() elements of an MPI
+  // datatype of NUMVARS doubles span the whole array
+  auto begin() noexcept {return data_.begin();}
+  const auto begin() const noexcept {return data_.begin();}
+  auto end() noexcept {return data_.end();}
+  const auto end() const noexcept {return data_.end();}
+
+  // access to the contiguous plane of a single variable
+  double * Plane(const int &vv) {return &data_[vv * this->Size()];}
+  const double * Plane(const int &vv) const {
+    return &data_[vv * this->Size()];
+  }
+  // plane of a single variable starting at a given cell; the cells that
+  // follow it in i are next to it
+  double * Plane(const int &vv, const int &ii, const int &jj, const int &kk) {
+    return &data_[vv * this->Size() + this->GetLoc1D(ii, jj, kk)];
+  }
+  const double * Plane(const int &vv, const int &ii, const int &jj,
+                       const int &kk) const {
+    return &data_[vv * this->Size() + this->GetLoc1D(ii, jj, kk)];
+  }
+  int Loc1D(const int &ii, const int &jj, const int &kk) const {
+    return this->GetLoc1D(ii, jj, kk);
+  }
+
+  // cell access by 1D location
+  double & Var(const int &vv, const int &loc) {
+    return data_[vv * this->Size() + loc];
+  }
+  const double & Var(const int &vv, const int &loc) const {
+    return data_[vv * this->Size() + loc];
+  }
+  // reads of a cell are always inlined, so the loads of variables the caller
+  // does not use are removed; kernels with many reads are otherwise left with
+  // a call that loads all of the variables for every cell
+  ALWAYSINLINE T Gather(const int &loc) const {
+    static_assert(NUMVARS == 7, "soaMultiArray3d::Gather() reads 7 variables");
+    const auto size = this->Size();
+    return T(data_[loc], data_[size + loc], data_[2 * size + loc],
+             data_[3 * size + loc], data_[4 * size + loc],
+             data_[5 * size + loc], data_[6 * size + loc]);
+  }
+  void Scatter(const int &loc, const T &val) {
+    const auto size = this->Size();
+    for (auto vv = 0; vv < NUMVARS; vv++) {
+      data_[vv * size + loc] = val[vv];
+    }
+  }
+
+  multiArray3d<T> Slice(const range &, const range &, const range &) const;
+  multiArray3d<T> Slice(const string &, const range &,
+                        const bool = false) const;
+  multiArray3d<T> Slice(const string &, int, range, range,
+                        const string = "cell", const int = 0) const;
+
+  void Insert(const range &, const range &, const range &,
+              const multiArray3d<T> &);
+  void Insert(const string &, const range &, const multiArray3d<T> &,
+              const bool = false);
+  void Insert(const string &, int, range, range, const multiArray3d<T> &,
+              const string = "cell", const int = 0);
+
+  void Fill(const multiArray3d<T> &);
+  void PutSlice(const multiArray3d<T> &, const interblock &, const int &);
+  void SwapSlice(const interblock &, soaMultiArray3d<T> &);
+
+  void Zero(const T &);
+  void Zero();
+
+  // operator overloads
+  soaCellRef<T> operator()(const int &ii, const int &jj, const int &kk) {
+    return {*this, this->GetLoc1D(ii, jj, kk)};
+  }
+  ALWAYSINLINE
+  T operator()(const int &ii, const int &jj, const int &kk) const {
+    return this->Gather(this->GetLoc1D(ii, jj, kk));
+  }
+  soaCellRef<T> operator()(const int &ind) {
+    return {*this, ind};
+  }
+  ALWAYSINLINE T operator()(const int &ind) const {
+    return this->Gather(ind);
+  }
+  soaCellRef<T> operator()(const string &dir, const int &d1, const int &d2,
+                           const int &d3) {
+    if (dir == "i") {  // direction 1 is i
+      return {*this, this->GetLoc1D(d1, d2, d3)};
+    } else if (dir == "j") {  // direction 1 is j
+      return {*this, this->GetLoc1D(d3, d1, d2)};
+    } else if (dir == "k") {  // direction 1 is k
+      return {*this, this->GetLoc1D(d2, d3, d1)};
+    } else {
+      cerr << "ERROR: Direction " << dir << " is not recognized!" << endl;
+      exit(EXIT_FAILURE);
+    }
+  }
+  T operator()(const string &dir, const int &d1, const int &d2,
+               const int &d3) const {
+    if (dir == "i") {  // direction 1 is i
+      return this->Gather(this->GetLoc1D(d1, d2, d3));
+    } else if (dir == "j") {  // direction 1 is j
+      return this->Gather(this->GetLoc1D(d3, d1, d2));
+    } else if (dir == "k") {  // direction 1 is k
+      return this->Gather(this->GetLoc1D(d2, d3, d1));
+    } else {
+      cerr << "ERROR: Direction " << dir << " is not recognized!" << endl;
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  void ClearResize(const int &ii, const int &jj, const int &kk, const int &ng) {
+    *this = soaMultiArray3d<T>(ii, jj, kk, ng);
+  }
+  void ClearResize(const int &ii, const int &jj, const int &kk,
+                   const int &ng, const T &val) {
+    *this = soaMultiArray3d<T>(ii, jj, kk, ng, val);
+  }
+
+  // destructor
+  ~soaMultiArray3d() noexcept {}
+};
+
+// ---------------------------------------------------------------------------
+// member function definitions
+
+template <typename T>
+int soaMultiArray3d<T>::Start(const string &dir) const {
+  if (dir == "i") {
+    return this->StartI();
+  } else if (dir == "j") {
+    return this->StartJ();
+  } else if (dir == "k") {
+    return this->StartK();
+  } else {
+    cerr << "ERROR: Error in soaMultiArray3d::Start. Direction " << dir
+         << " is not recognized!" << endl;
+    exit(EXIT_FAILURE);
+  }
+}
+
+template <typename T>
+int soaMultiArray3d<T>::End(const string &dir) const {
+  if (dir == "i") {
+    return this->EndI();
+  } else if (dir == "j") {
+    return this->EndJ();
+  } else if (dir == "k") {
+    return this->EndK();
+  } else {
+    cerr << "ERROR: Error in soaMultiArray3d::End. Direction " << dir
+         << " is not recognized!" << endl;
+    exit(EXIT_FAILURE);
+  }
+}
+
+template <typename T>
+int soaMultiArray3d<T>::PhysStart(const string &dir) const {
+  if (dir == "i") {
+    return this->PhysStartI();
+  } else if (dir == "j") {
+    return this->PhysStartJ();
+  } else if (dir == "k") {
+    return this->PhysStartK();
+  } else {
+    cerr << "ERROR: Error in soaMultiArray3d::PhysStart. Direction " << dir
+         << " is not recognized!" << endl;
+    exit(EXIT_FAILURE);
+  }
+}
+
+template <typename T>
+int soaMultiArray3d<T>::PhysEnd(const string &dir) const {
+  if (dir == "i") {
+    return this->PhysEndI();
+  } else if (dir == "j") {
+    return this->PhysEndJ();
+  } else if (dir == "k") {
+    return this->PhysEndK();
+  } else {
+    cerr << "ERROR: Error in soaMultiArray3d::PhysEnd. Direction " << dir
+         << " is not recognized!" << endl;
+    exit(EXIT_FAILURE);
+  }
+}
+
+// member function to return a slice of the array
+// slices are returned in array of structures layout
+template <typename T>
+multiArray3d<T> soaMultiArray3d<T>::Slice(const range &ir, const range &jr,
+                                          const range &kr) const {
+  // ir -- i-index range to take slice [inclusive, exclusive)
+  // jr -- j-index range to take slice [inclusive, exclusive)
+  // kr -- k-index range to take slice [inclusive, exclusive)
+
+  // check that slice bounds are within parent array and that end bounds are
+  // greater than or equal to start bounds
+  if (!ir.IsInside(this->RangeI()) || !jr.IsInside(this->RangeJ()) ||
+      !kr.IsInside(this->RangeK()) || !ir.IsValid() || !jr.IsValid() ||
+      !kr.IsValid()) {
+    cerr << "ERROR: Error in soaMultiArray3d::Slice. Cannot take slice with "
+         << "boundaries " << ir << ", " << jr << ", " << kr << endl
+         << "from array with ranges " << this->RangeI() << ", "
+         << this->RangeJ() << ", " << this->RangeK() << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // slices always have 0 ghost cells
+  multiArray3d<T> arr(ir.Size(), jr.Size(), kr.Size(), 0);
+
+  // s is for index of sliced array, p is for index of parent array
+  for (int ks = arr.StartK(), kp = kr.Start(); ks < arr.EndK(); ks++, kp++) {
+    for (int js = arr.StartJ(), jp = jr.Start(); js < arr.EndJ(); js++, jp++) {
+      for (int is = arr.StartI(), ip = ir.Start(); is < arr.EndI(); is++, ip++) {
+        arr(is, js, ks) = this->Gather(this->GetLoc1D(ip, jp, kp));
+      }
+    }
+  }
+  return arr;
+}
+
+// member function to return a slice of the array
+// Overload to slice only in one direction. This mirrors the multiArray3d
+// version.
+template <typename T>
+multiArray3d<T> soaMultiArray3d<T>::Slice(const string &dir,
+                                          const range &dirRange,
+                                          const bool physOnly) const {
+  // dir -- direction of slice
+  // dirRange -- range of slice in direction given
+  // phsOnly -- flag to only include physical cells in the two directions that
+  //            are not specified as dir
+
+  if (dir == "i") {
+    return physOnly ?
+        this->Slice(dirRange, this->PhysRangeJ(), this->PhysRangeK()) :
+        this->Slice(dirRange, this->RangeJ(), this->RangeK());
+  } else if (dir == "j") {
+    return physOnly ?
+        this->Slice(this->PhysRangeI(), dirRange, this->PhysRangeK()) :
+        this->Slice(this->RangeI(), dirRange, this->RangeK());
+  } else if (dir == "k") {
+    return physOnly ?
+        this->Slice(this->PhysRangeI(), this->PhysRangeJ(), dirRange) :
+        this->Slice(this->RangeI(), this->RangeJ(), dirRange);
+  } else {
+    cerr << "ERROR: Error in soaMultiArray3d::Slice, direction " << dir
+         << " is not recognized!" << endl;
+    exit(EXIT_FAILURE);
+  }
+}
+
+// overload to slice plane out of array
+// this mirrors the multiArray3d version
+template <typename T>
+multiArray3d<T> soaMultiArray3d<T>::Slice(const string &dir, int dirInd,
+                                          range dir1, range dir2,
+                                          const string id,
+                                          const int type) const {
+  // dir -- normal direction of planar slice
+  // dirInd -- index in normal direction
+  // dir1 -- range of direction 1 (direction 3 is normal to slice)
+  // dir2 -- range of direction 2 (direction 3 is normal to slice)
+  // id -- id of array being sliced (i, j, k for faces, cell for cells)
+  // type -- surface type of dir
+
+  if (dir == "i") {  // d1 = j, d2 = k
+    if (type == 2 && id == "i") {  // upper i-surface & i face data
+      dirInd++;
+    }
+    if (id == "j") {
+      dir1.GrowEnd();
+    } else if (id == "k") {
+      dir2.GrowEnd();
+    }
+    return this->Slice(dirInd, dir1, dir2);
+  } else if (dir == "j") {  // d1 = k, d2 = i
+    if (type == 4 && id == "j") {  // upper j-surface & j face data
+      dirInd++;
+    }
+    if (id == "k") {
+      dir1.GrowEnd();
+    } else if (id == "i") {
+      dir2.GrowEnd();
+    }
+    return this->Slice(dir2, dirInd, dir1);
+  } else if (dir == "k") {  // d1 = i, d2 = j
+    if (type == 6 && id == "k") {  // upper k-surface & k face data
+      dirInd++;
+    }
+    if (id == "i") {
+      dir1.GrowEnd();
+    } else if (id == "j") {
+      dir2.GrowEnd();
+    }
+    return this->Slice(dir1, dir2, dirInd);
+  } else {
+    cerr << "ERROR: Error in soaMultiArray3d::Slice, direction " << dir
+         << " is not recognized!" << endl;
+    exit(EXIT_FAILURE);
+  }
+}
+
+// member function to insert an array into this one
+// this is the main insert funciton that all other overloaded insert functions
+// call
+template <typename T>
+void soaMultiArray3d<T>::Insert(const range &ir, const range &jr,
+                                const range &kr, const multiArray3d<T> &arr) {
+  // ir -- i-index range to take slice [inclusive, exclusive)
+  // jr -- j-index range to take slice [inclusive, exclusive)
+  // kr -- k-index range to take slice [inclusive, exclusive)
+  // arr -- array to insert into this one
+
+  // check that given bounds fit in this, sizes match, and that bounds are valid
+  if (!ir.IsInside(this->RangeI()) || !jr.IsInside(this->RangeJ()) ||
+      !kr.IsInside(this->RangeK()) ||
+      ir.Size() != arr.RangeI().Size() || jr.Size() != arr.RangeJ().Size() ||
+      kr.Size() != arr.RangeK().Size() ||
+      !ir.IsValid() || !jr.IsValid() || !kr.IsValid()) {
+    cerr << "ERROR: Error in soaMultiArray3d::Insert. Given array does not fit "
+         << "in given bounds" << endl
+         << "Given bounds: " << ir << ", " << jr << ", " << kr << endl
+         << "Bounds of array being inserted: " << arr.RangeI() << ", "
+         << arr.RangeJ() << ", " << arr.RangeK() << endl;
+    cerr << "Bounds of array accepting data: " << this->RangeI() << ", "
+         << this->RangeJ() << ", " << this->RangeK() << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // s is for index of sliced array, p is for index of parent array
+  for (int ks = arr.StartK(), kp = kr.Start(); ks < arr.EndK(); ks++, kp++) {
+    for (int js = arr.StartJ(), jp = jr.Start(); js < arr.EndJ(); js++, jp++) {
+      for (int is = arr.StartI(), ip = ir.Start(); is < arr.EndI(); is++, ip++) {
+        this->Scatter(this->GetLoc1D(ip, jp, kp), arr(is, js, ks));
+      }
+    }
+  }
+}
+
+// Overload to insert only in one direction. This mirrors the multiArray3d
+// version.
+template <typename T>
+void soaMultiArray3d<T>::Insert(const string &dir, const range &dirRange,
+                                const multiArray3d<T> &arr,
+                                const bool physOnly) {
+  // dir -- direction of slice to insert
+  // dirRange -- range to insert slice into in direction given
+  // arr -- array to insert
+  // phsOnly -- flag to only include physical cells in the two directions that
+  //            are not specified as dir
+
+  if (dir == "i") {
+    if (physOnly) {
+      return this->Insert(dirRange, this->PhysRangeJ(), this->PhysRangeK(), arr);
+    } else {
+      return this->Insert(dirRange, this->RangeJ(), this->RangeK(), arr);
+    }
+  } else if (dir == "j") {
+    if (physOnly) {
+      return this->Insert(this->PhysRangeI(), dirRange, this->PhysRangeK(), arr);
+    } else {
+      return this->Insert(this->RangeI(), dirRange, this->RangeK(), arr);
+    }
+  } else if (dir == "k") {
+    if (physOnly) {
+      return this->Insert(this->PhysRangeI(), this->PhysRangeJ(), dirRange, arr);
+    } else {
+      return this->Insert(this->RangeI(), this->RangeJ(), dirRange, arr);
+    }
+  } else {
+    cerr << "ERROR: Error in soaMultiArray3d::Insert, direction " << dir
+         << " is not recognized!" << endl;
+    exit(EXIT_FAILURE);
+  }
+}
+
+// overload to insert plane into array
+// this mirrors the multiArray3d version
+template <typename T>
+void soaMultiArray3d<T>::Insert(const string &dir, int dirInd, range dir1,
+                                range dir2, const multiArray3d<T> &arr,
+                                const string id, const int type) {
+  // dir -- normal direction of planar slice
+  // dirInd -- index in normal direction
+  // dir1 -- range of direction 1 (direction 3 is normal to slice)
+  // dir2 -- range of direction 2 (direction 3 is normal to slice)
+  // arr -- array to insert
+  // id -- id of array being inserted into (i, j, k for faces, cell for cells)
+  // type -- surface type of dir
+
+  if (dir == "i") {  // d1 = j, d2 = k
+    if (type == 2 && id == "i") {  // upper i-surface & i normal
+      dirInd++;
+    }
+    if (id == "j") {
+      dir1.GrowEnd();
+    } else if (id == "k") {
+      dir2.GrowEnd();
+    }
+    return this->Insert(dirInd, dir1, dir2, arr);
+  } else if (dir == "j") {  // d1 = k, d2 = i
+    if (type == 4 && id == "j") {  // upper j-surface & j normal
+      dirInd++;
+    }
+    if (id == "k") {
+      dir1.GrowEnd();
+    } else if (id == "i") {
+      dir2.GrowEnd();
+    }
+    return this->Insert(dir2, dirInd, dir1, arr);
+  } else if (dir == "k") {  // d1 = i, d2 = j
+    if (type == 6 && id == "k") {  // upper k-surface & k normal
+      dirInd++;
+    }
+    if (id == "i") {
+      dir1.GrowEnd();
+    } else if (id == "j") {
+      dir2.GrowEnd();
+    }
+    return this->Insert(dir1, dir2, dirInd, arr);
+  } else {
+    cerr << "ERROR: Error in soaMultiArray3d::Insert, direction " << dir
+         << " is not recognized!" << endl;
+    exit(EXIT_FAILURE);
+  }
+}
+
+// member function to fill this array with data from a provided one
+// the size of the provided array must be identical to this array
+template <typename T>
+void soaMultiArray3d<T>::Fill(const multiArray3d<T> &arr) {
+  // arr -- array to insert into this one
+
+  // check that given array is same size
+  if (this->Size() != arr.Size()) {
+    cerr << "ERROR: Error in soaMultiArray3d::Fill. Size of given array " <<
+        "does not match size of array to fill!" << endl;
+    cerr << "Size of given array is " << arr.NumI() << ", " << arr.NumJ()
+         << ", " << arr.NumK() << endl;
+    cerr << "Size of array to fill is " << numI_ << ", " << numJ_ <<
+        ", " << numK_ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  for (auto rr = 0; rr < arr.Size(); rr++) {
+    this->Scatter(rr, arr(rr));
+  }
+}
+
+// member function to "zero out" the container with a supplied "zero"
+template <typename T>
+void soaMultiArray3d<T>::Zero(const T &zero) {
+  const auto size = this->Size();
+  for (auto vv = 0; vv < NUMVARS; vv++) {
+    std::fill(data_.begin() + vv * size, data_.begin() + (vv + 1) * size,
+              zero[vv]);
+  }
+}
+
+// member function to "zero out" the container
+template <typename T>
+void soaMultiArray3d<T>::Zero() {
+  std::fill(data_.begin(), data_.end(), 0.0);
+}
+
+// operation overload for << - allows use of cout, cerr, etc.
+template <typename T>
+ostream &operator<<(ostream &os, const soaMultiArray3d<T> &arr) {
+  os << "Size: " << arr.NumI() << ", " << arr.NumJ() << ", "
+     << arr.NumK() << endl;
+  os << "Number of ghost layers: " << arr.GhostLayers() << endl;
+
+  for (auto kk = arr.StartK(); kk < arr.EndK(); kk++) {
+    for (auto jj = arr.StartJ(); jj < arr.EndJ(); jj++) {
+      for (auto ii = arr.StartI(); ii < arr.EndI(); ii++) {
+        os << ii << ", " << jj << ", " << kk << ": " << arr(ii, jj, kk) << endl;
+      }
+    }
+  }
+  return os;
+}
+
+template <typename T>
+void soaMultiArray3d<T>::PutSlice(const multiArray3d<T> &array,
+                                  const interblock &inter, const int &d3) {
+  // array -- array to insert into *this
+  // inter -- interblock data structure defining patches and orientation
+  // d3 -- distance of direction normal to patch to insert
+
+  // check that number of cells to insert matches
+  auto blkCell = inter.Dir1LenFirst() * inter.Dir2LenFirst() * d3;
+  if (blkCell != array.Size()) {
+    cerr << "ERROR: Error in soaMultiArray3d<T>::PutSlice(). Number of cells "
+            "being inserted does not match designated space to insert." << endl;
+    cerr << "Direction 1, 2, 3 of soaMultiArray3d<T> to insert into: "
+         << inter.Dir1LenFirst() << ", " << inter.Dir2LenFirst() << ", "
+         << d3 << endl;
+    cerr << "Direction I, J, K of multiArray3d<T> to insert: " << array.NumI()
+         << ", " << array.NumJ() << ", " << array.NumK() << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // adjust insertion indices if patch borders another interblock on the same
+  // surface of the block
+  const auto adjS1 = (inter.Dir1StartInterBorderFirst()) ? numGhosts_ : 0;
+  const auto adjE1 = (inter.Dir1EndInterBorderFirst()) ? numGhosts_ : 0;
+  const auto adjS2 = (inter.Dir2StartInterBorderFirst()) ? numGhosts_ : 0;
+  const auto adjE2 = (inter.Dir2EndInterBorderFirst()) ? numGhosts_ : 0;
+
+  // loop over cells to insert
+  for (auto l3 = 0; l3 < d3; l3++) {
+    for (auto l2 = adjS2; l2 < inter.Dir2LenFirst() - adjE2; l2++) {
+      for (auto l1 = adjS1; l1 < inter.Dir1LenFirst() - adjE1; l1++) {
+        // get acceptor and inserter indices
+        auto indA = GetSwapLoc(l1, l2, l3, numGhosts_, inter, d3, true);
+        auto indI = GetSwapLoc(l1, l2, l3, array.GhostLayers(), inter, d3,
+                               false);
+
+        // assign cell data
+        this->Scatter(this->GetLoc1D(indA[0], indA[1], indA[2]),
+                      array(indI[0], indI[1], indI[2]));
+      }
+    }
+  }
+}
+
+// Function to swap ghost cells between two arrays at an interblock boundary.
+// This mirrors the multiArray3d version.
+template <typename T>
+void soaMultiArray3d<T>::SwapSlice(const interblock &inter,
+                                   soaMultiArray3d<T> &array) {
+  // inter -- interblock boundary information
+  // array -- second array involved in interblock boundary
+
+  // Get indices for slice coming from first block to swap
+  auto is1 = 0, ie1 = 0;
+  auto js1 = 0, je1 = 0;
+  auto ks1 = 0, ke1 = 0;
+
+  inter.FirstSliceIndices(is1, ie1, js1, je1, ks1, ke1, numGhosts_);
+
+  // Get indices for slice coming from second block to swap
+  auto is2 = 0, ie2 = 0;
+  auto js2 = 0, je2 = 0;
+  auto ks2 = 0, ke2 = 0;
+
+  inter.SecondSliceIndices(is2, ie2, js2, je2, ks2, ke2, array.GhostLayers());
+
+  // get slices to swap
+  auto slice1 = this->Slice({is1, ie1}, {js1, je1}, {ks1, ke1});
+  auto slice2 = array.Slice({is2, ie2}, {js2, je2}, {ks2, ke2});
+
+  // change interblocks to work with slice and ghosts
+  interblock inter1 = inter;
+  interblock inter2 = inter;
+  inter1.AdjustForSlice(false, numGhosts_);
+  inter2.AdjustForSlice(true, array.GhostLayers());
+
+  // put slices in proper blocks
+  this->PutSlice(slice2, inter2, array.GhostLayers());
+  array.PutSlice(slice1, inter1, numGhosts_);
+}
+
+#endif
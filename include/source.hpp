@@ -30,6 +30,7 @@
 #include "macros.hpp"
 #include "vector3d.hpp"
 #include "tensor.hpp"
+#include "matrix.hpp"
 
 using std::vector;
 using std::string;
@@ -43,7 +44,6 @@ using std::unique_ptr;
 class primVars;
 class turbModel;
 class sutherland;
-class squareMatrix;
 
 class source {
   double data_[NUMVARS];  // source variables at cell center
@@ -69,11 +69,11 @@ class source {
   double SrcTke() const { return data_[5]; }
   double SrcOmg() const { return data_[6]; }
 
-  squareMatrix CalcTurbSrc(const unique_ptr<turbModel> &, const primVars &,
-                           const tensor<double> &, const vector3d<double> &,
-                           const vector3d<double> &, const vector3d<double> &,
-                           const sutherland &, const double &, const double &,
-                           const double &);
+  turbMatrix CalcTurbSrc(const unique_ptr<turbModel> &, const primVars &,
+                         const tensor<double> &, const vector3d<double> &,
+                         const vector3d<double> &, const vector3d<double> &,
+                         const sutherland &, const double &, const double &,
+                         const double &);
 
   inline source & operator+=(const source &);
   inline source & operator-=(const source &);
@@ -26,6 +26,7 @@
 #include <string>  // string
 #include "vector3d.hpp"  // vector3d
 #include "tensor.hpp"  // tensor
+#include "matrix.hpp"  // turbMatrix
 
 using std::vector;
 using std::string;
@@ -34,7 +35,6 @@ using std::string;
 class primVars;
 class sutherland;
 class idealGas;
-class squareMatrix;
 
 class turbModel {
   const string eddyViscMethod_;
@@ -69,12 +69,12 @@ class turbModel {
   virtual double SrcSpecRad(const primVars &state,
                             const sutherland &suth,
                             const double &vol) const {return 0.0;}
-  virtual squareMatrix InviscidJacobian(const primVars &state,
-                                        const unitVec3dMag<double> &fArea,
-                                        const bool &positive) const;
-  virtual squareMatrix InviscidConvJacobian(
+  virtual turbMatrix InviscidJacobian(const primVars &state,
+                                      const unitVec3dMag<double> &fArea,
+                                      const bool &positive) const;
+  virtual turbMatrix InviscidConvJacobian(
       const primVars &state, const unitVec3dMag<double> &fArea) const;
-  virtual squareMatrix InviscidDissJacobian(
+  virtual turbMatrix InviscidDissJacobian(
       const primVars &state, const unitVec3dMag<double> &fArea) const;
   virtual double InviscidCellSpecRad(const primVars &state,
                                      const unitVec3dMag<double> &fAreaL,
@@ -82,11 +82,11 @@ class turbModel {
   virtual double InviscidFaceSpecRad(const primVars &state,
                                      const unitVec3dMag<double> &fArea,
                                      const bool &positive) const;
-  virtual squareMatrix ViscousJacobian(const primVars &state,
-                                       const unitVec3dMag<double> &fArea,
-                                       const double &mu, const sutherland &suth,
-                                       const double &dist, const double &mut,
-                                       const double &f1) const;
+  virtual turbMatrix ViscousJacobian(const primVars &state,
+                                     const unitVec3dMag<double> &fArea,
+                                     const double &mu, const sutherland &suth,
+                                     const double &dist, const double &mut,
+                                     const double &f1) const;
   virtual double ViscCellSpecRad(const primVars &state,
                                  const unitVec3dMag<double> &fAreaL,
                                  const unitVec3dMag<double> &fAreaR,
@@ -126,14 +126,14 @@ class turbModel {
                             const double & f1, const bool &positive) const;
 
   // abstract functions
-  virtual squareMatrix CalcTurbSrc(const primVars &state,
-                                   const tensor<double> &velGrad,
-                                   const vector3d<double> &kGrad,
-                                   const vector3d<double> &wGrad,
-                                   const sutherland &suth,
-                                   const double &vol,
-                                   const double &mut, const double &f1,
-                                   double &ksrc, double &wsrc) const = 0;
+  virtual turbMatrix CalcTurbSrc(const primVars &state,
+                                 const tensor<double> &velGrad,
+                                 const vector3d<double> &kGrad,
+                                 const vector3d<double> &wGrad,
+                                 const sutherland &suth,
+                                 const double &vol,
+                                 const double &mut, const double &f1,
+                                 double &ksrc, double &wsrc) const = 0;
   virtual void EddyViscAndBlending(const primVars &state,
                                    const tensor<double> &vGrad,
                                    const vector3d<double> &kGrad,
@@ -143,10 +143,10 @@ class turbModel {
                                    const sutherland &suth,
                                    double &mut, double &f1,
                                    double &f2) const = 0;
-  virtual squareMatrix TurbSrcJac(const primVars &state,
-                                  const double &beta,
-                                  const sutherland &suth,
-                                  const double &vol) const = 0;
+  virtual turbMatrix TurbSrcJac(const primVars &state,
+                                const double &beta,
+                                const sutherland &suth,
+                                const double &vol) const = 0;
 
   virtual void Print() const = 0;
 
@@ -169,12 +169,12 @@ class turbNone : public turbModel {
   turbNone& operator=(const turbNone&) = default;
 
   // member functions
-  squareMatrix CalcTurbSrc(const primVars &state, const tensor<double> &velGrad,
-                           const vector3d<double> &kGrad,
-                           const vector3d<double> &wGrad,
-                           const sutherland &suth, const double &vol,
-                           const double &mut, const double &f1, double &ksrc,
-                           double &wsrc) const override;
+  turbMatrix CalcTurbSrc(const primVars &state, const tensor<double> &velGrad,
+                         const vector3d<double> &kGrad,
+                         const vector3d<double> &wGrad,
+                         const sutherland &suth, const double &vol,
+                         const double &mut, const double &f1, double &ksrc,
+                         double &wsrc) const override;
   void EddyViscAndBlending(const primVars &state,
                            const tensor<double> &vGrad,
                            const vector3d<double> &kGrad,
@@ -196,16 +196,16 @@ class turbNone : public turbModel {
     return 0.0;
   }
 
-  squareMatrix InviscidJacobian(const primVars &state,
-                                const unitVec3dMag<double> &fArea,
-                                const bool &positive) const override;
-  squareMatrix InviscidConvJacobian(
+  turbMatrix InviscidJacobian(const primVars &state,
+                              const unitVec3dMag<double> &fArea,
+                              const bool &positive) const override;
+  turbMatrix InviscidConvJacobian(
       const primVars &state, const unitVec3dMag<double> &fArea) const override;
-  squareMatrix InviscidDissJacobian(
+  turbMatrix InviscidDissJacobian(
       const primVars &state, const unitVec3dMag<double> &fArea) const override;
-  squareMatrix TurbSrcJac(const primVars &state, const double &beta,
-                          const sutherland &suth,
-                          const double &vol) const override;
+  turbMatrix TurbSrcJac(const primVars &state, const double &beta,
+                        const sutherland &suth,
+                        const double &vol) const override;
 
   double TkeMin() const override {return 0.0;}
   double OmegaMin() const override {return 0.0;}
@@ -249,11 +249,11 @@ class turbKWWilcox : public turbModel {
   turbKWWilcox& operator=(const turbKWWilcox&) = default;
 
   // member functions
-  squareMatrix CalcTurbSrc(const primVars &, const tensor<double> &,
-                           const vector3d<double> &, const vector3d<double> &,
-                           const sutherland &, const double &,
-                           const double &, const double &, double &,
-                           double &) const override;
+  turbMatrix CalcTurbSrc(const primVars &, const tensor<double> &,
+                         const vector3d<double> &, const vector3d<double> &,
+                         const sutherland &, const double &,
+                         const double &, const double &, double &,
+                         double &) const override;
   double EddyVisc(const primVars&, const tensor<double> &,
                   const sutherland &, const double &) const override;
   void EddyViscAndBlending(const primVars &, const tensor<double> &,
@@ -265,11 +265,11 @@ class turbKWWilcox : public turbModel {
   bool UseUnlimitedEddyVisc() const override {return true;}
   double SrcSpecRad(const primVars &, const sutherland &,
                     const double &) const override;
-  squareMatrix ViscousJacobian(const primVars &,
-                               const unitVec3dMag<double> &,
-                               const double &, const sutherland &,
-                               const double &, const double &,
-                               const double &) const override;
+  turbMatrix ViscousJacobian(const primVars &,
+                             const unitVec3dMag<double> &,
+                             const double &, const sutherland &,
+                             const double &, const double &,
+                             const double &) const override;
   double ViscCellSpecRad(const primVars &,
                          const unitVec3dMag<double> &,
                          const unitVec3dMag<double> &,
@@ -282,8 +282,8 @@ class turbKWWilcox : public turbModel {
                          const double &, const double &,
                          const double &) const override;
 
-  squareMatrix TurbSrcJac(const primVars &, const double &,
-                          const sutherland &, const double &) const override;
+  turbMatrix TurbSrcJac(const primVars &, const double &,
+                        const sutherland &, const double &) const override;
 
   double TurbPrandtlNumber() const override {return prt_;}
   double WallBeta() const override {return beta0_;}
@@ -345,11 +345,11 @@ class turbKWSst : public turbModel {
   turbKWSst& operator=(const turbKWSst&) = default;
 
   // member functions
-  squareMatrix CalcTurbSrc(const primVars &, const tensor<double> &,
-                           const vector3d<double> &, const vector3d<double> &,
-                           const sutherland &, const double &,
-                           const double &, const double &, double &,
-                           double &) const override;
+  turbMatrix CalcTurbSrc(const primVars &, const tensor<double> &,
+                         const vector3d<double> &, const vector3d<double> &,
+                         const sutherland &, const double &,
+                         const double &, const double &, double &,
+                         double &) const override;
   double EddyVisc(const primVars &, const tensor<double> &,
                   const sutherland &, const double &) const override;
   void EddyViscAndBlending(const primVars &, const tensor<double> &,
@@ -361,11 +361,11 @@ class turbKWSst : public turbModel {
 
   double SrcSpecRad(const primVars &, const sutherland &,
                     const double &) const override;
-  squareMatrix ViscousJacobian(const primVars &,
-                               const unitVec3dMag<double> &,
-                               const double &, const sutherland &,
-                               const double &, const double &,
-                               const double &) const override;
+  turbMatrix ViscousJacobian(const primVars &,
+                             const unitVec3dMag<double> &,
+                             const double &, const sutherland &,
+                             const double &, const double &,
+                             const double &) const override;
   double ViscCellSpecRad(const primVars &,
                          const unitVec3dMag<double> &,
                          const unitVec3dMag<double> &,
@@ -378,8 +378,8 @@ class turbKWSst : public turbModel {
                          const double &, const double &,
                          const double &) const override;
 
-  squareMatrix TurbSrcJac(const primVars &, const double &,
-                          const sutherland &, const double &) const override;
+  turbMatrix TurbSrcJac(const primVars &, const double &,
+                        const sutherland &, const double &) const override;
 
   double WallBeta() const override {return beta1_;}
   double TurbPrandtlNumber() const override {return prt_;}
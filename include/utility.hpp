@@ -40,6 +40,7 @@ class fluxJacobian;
 class kdtree;
 class resid;
 class primVars;
+class haloExchange;
 
 // function definitions
 template <typename T>
@@ -64,14 +65,24 @@ vector3d<double> ScalarGradGG(
     const vector3d<double> &, const double &);
 
 void SwapGeomSlice(interblock &, procBlock &, procBlock &);
+void SwapGeomSliceMPI(interblock &, procBlock &, const int &,
+                      const MPI_Datatype &, const MPI_Datatype &);
+void SwapGeometry(vector<interblock> &, vector<procBlock> &, const int &,
+                  const MPI_Datatype &, const MPI_Datatype &);
 
 void GetBoundaryConditions(vector<procBlock> &, const input &, const idealGas &,
                            const sutherland &, const unique_ptr<turbModel> &,
                            vector<interblock> &, const int &,
-                           const MPI_Datatype &);
+                           haloExchange &);
+void CompleteBoundaryConditions(vector<procBlock> &, const input &,
+                                const idealGas &, const sutherland &,
+                                const unique_ptr<turbModel> &,
+                                haloExchange &);
 
 vector<vector3d<double>> GetViscousFaceCenters(const vector<procBlock> &);
-void CalcWallDistance(vector<procBlock> &, const kdtree &);
+void CalcWallDistance(vector<procBlock> &, const kdtree &, const input &);
+int CalcWallDistanceEikonal(vector<procBlock> &, const vector<interblock> &,
+                            const int &, haloExchange &);
 
 void AssignSolToTimeN(vector<procBlock> &, const idealGas &);
 void AssignSolToTimeNm1(vector<procBlock> &);
@@ -80,36 +91,39 @@ void ExplicitUpdate(vector<procBlock> &, const input &, const idealGas &,
                     const double &, const sutherland &,
                     const unique_ptr<turbModel> &, const int &, genArray &,
                     resid &);
+void AccumulateResidual(const vector<genArray> &, const vector<resid> &,
+                        genArray &, resid &);
 double ImplicitUpdate(vector<procBlock> &, vector<multiArray3d<fluxJacobian>> &,
                       const input &, const idealGas &, const double &,
                       const sutherland &, const unique_ptr<turbModel> &,
                       const int &, genArray &, resid &,
                       const vector<interblock> &, const int &,
-                      const MPI_Datatype &);
+                      haloExchange &);
 
 void SwapImplicitUpdate(vector<multiArray3d<genArray>> &,
                         const vector<interblock> &, const int &,
-                        const MPI_Datatype &, const int &);
+                        const int &, haloExchange &);
 void SwapTurbVars(vector<procBlock> &, const vector<interblock> &, const int &,
-                  const int &);
+                  const int &, haloExchange &);
 void SwapGradients(vector<procBlock> &, const vector<interblock> &, const int &,
-                   const MPI_Datatype &, const MPI_Datatype &, const int &);
+                   const int &, haloExchange &);
 
 void CalcResidual(vector<procBlock> &,
                   vector<multiArray3d<fluxJacobian>> &,
                   const sutherland &, const idealGas &, const input &,
                   const unique_ptr<turbModel> &,
-                  const vector<interblock> &, const int &, const MPI_Datatype &,
-                  const MPI_Datatype &);
+                  const vector<interblock> &, const int &, haloExchange &);
 
 void CalcTimeStep(vector<procBlock> &, const input &, const double &);
+bool ThreadOverBlocks(const vector<procBlock> &);
 
 // void GetSolMMinusN(vector<multiArray3d<genArray>> &, const vector<procBlock> &,
 //                    const vector<multiArray3d<genArray>> &,
 //                    const idealGas &, const input &, const int &);
 
 // function to reorder block by hyperplanes
-vector<vector3d<int>> HyperplaneReorder(const int &, const int &, const int &);
+vector<vector3d<int>> HyperplaneReorder(const int &, const int &, const int &,
+                                        vector<int> &);
 
 void ResizeArrays(const vector<procBlock> &, const input &,
                   vector<multiArray3d<fluxJacobian>> &);
@@ -22,7 +22,8 @@
 #include <vector>     // vector
 #include "boundaryConditions.hpp"
 #include "vector3d.hpp"  // vector3d
-#include "plot3d.hpp"  // plot3dBlock
+#include "plot3d.hpp"  // plot3dBlockRange
+#include "multiArray3d.hpp"  // multiArray3d
 
 using std::cout;
 using std::endl;
@@ -170,6 +171,78 @@ int boundaryConditions::GetBCTag(const int &i, const int &j, const int &k,
   return bcTag;
 }
 
+/* Member function to classify every i, j, and k face of the block. Faces
+   between physical cells are interior faces, and faces on the block boundary
+   take the type of the boundary surface they lie on. This is done once so that
+   loops over cells can determine the type of a face with a single lookup
+   instead of searching the boundary surfaces by name. The surfaces are visited
+   in reverse order so that faces on an edge shared by two surfaces take the
+   type of the first surface, matching GetBCName().
+*/
+void boundaryConditions::ClassifyFaces(multiArray3d<faceType> &faceI,
+                                       multiArray3d<faceType> &faceJ,
+                                       multiArray3d<faceType> &faceK) const {
+  // faceI -- classification of i-faces
+  // faceJ -- classification of j-faces
+  // faceK -- classification of k-faces
+
+  // dimensions of block (cells)
+  const auto numI = this->BlockDimI();
+  const auto numJ = this->BlockDimJ();
+  const auto numK = this->BlockDimK();
+
+  faceI = {numI + 1, numJ, numK, 0, faceType::interior};
+  faceJ = {numI, numJ + 1, numK, 0, faceType::interior};
+  faceK = {numI, numJ, numK + 1, 0, faceType::interior};
+
+  // faces on block boundary not covered by a surface are treated as boundary
+  // faces
+  for (auto kk = 0; kk < numK; kk++) {
+    for (auto jj = 0; jj < numJ; jj++) {
+      faceI(0, jj, kk) = faceType::boundary;
+      faceI(numI, jj, kk) = faceType::boundary;
+    }
+  }
+  for (auto kk = 0; kk < numK; kk++) {
+    for (auto ii = 0; ii < numI; ii++) {
+      faceJ(ii, 0, kk) = faceType::boundary;
+      faceJ(ii, numJ, kk) = faceType::boundary;
+    }
+  }
+  for (auto jj = 0; jj < numJ; jj++) {
+    for (auto ii = 0; ii < numI; ii++) {
+      faceK(ii, jj, 0) = faceType::boundary;
+      faceK(ii, jj, numK) = faceType::boundary;
+    }
+  }
+
+  for (auto nn = this->NumSurfaces() - 1; nn >= 0; nn--) {
+    auto type = faceType::boundary;
+    if (this->GetBCTypes(nn) == "interblock") {
+      type = faceType::interblock;
+    } else if (this->GetBCTypes(nn) == "viscousWall") {
+      type = faceType::viscousWall;
+    }
+
+    // get face array surface lies on
+    auto &faces = (nn < this->NumSurfI()) ? faceI :
+        (nn < this->NumSurfI() + this->NumSurfJ()) ? faceJ : faceK;
+
+    // surface ranges are inclusive of upper index, so limit to face array
+    const auto iMax = std::min(this->GetIMax(nn), faces.NumI() - 1);
+    const auto jMax = std::min(this->GetJMax(nn), faces.NumJ() - 1);
+    const auto kMax = std::min(this->GetKMax(nn), faces.NumK() - 1);
+
+    for (auto kk = this->GetKMin(nn); kk <= kMax; kk++) {
+      for (auto jj = this->GetJMin(nn); jj <= jMax; jj++) {
+        for (auto ii = this->GetIMin(nn); ii <= iMax; ii++) {
+          faces(ii, jj, kk) = type;
+        }
+      }
+    }
+  }
+}
+
 // Member function to fill one "row" of the vectors with data that has been
 // read in from the input file. This function is called from
 // input::ReadInput(). It is necessary so that the private data can be
@@ -381,7 +454,7 @@ range interblock::Dir2RangeSecond() const {
 /* Function to go through the boundary conditions and pair the interblock
    BCs together and determine their orientation.*/
 vector<interblock> GetInterblockBCs(const vector<boundaryConditions> &bc,
-                                    const vector<plot3dBlock> &grid,
+                                    const vector<plot3dBlockRange> &grid,
                                     const decomposition &decomp) {
   // bc -- vector of boundaryConditions for all blocks
   // grid -- vector of plot3Dblocks for entire computational mesh
@@ -1408,14 +1481,14 @@ boundaryConditions boundaryConditions::Split(const string &dir, const int &ind,
    have been split, its block_ number updated, or both. In order to correctly
    match up the dependents of the interblock must be updated for the split.*/
 void boundaryConditions::DependentSplit(const boundarySurface &surf,
-                                        const plot3dBlock &part,
-                                        const plot3dBlock &self,
+                                        const plot3dBlockRange &part,
+                                        const plot3dBlockRange &self,
                                         const int &sblk, const string &dir,
                                         const int &ind, const int &lblk,
                                         const int &ublk) {
   // surf -- boundarySurface of partner block_
-  // part -- plot3dBlock that surf is assigned to
-  // self -- plot3dBlock that (*this) is assigned to
+  // part -- plot3dBlockRange that surf is assigned to
+  // self -- plot3dBlockRange that (*this) is assigned to
   // sblk -- block_ number of self
   // dir -- direction that partner split was in
   // ind -- index of split
@@ -2041,7 +2114,7 @@ patch::patch() {
 // constructor with arguements passed
 patch::patch(const int &bound, const int &b, const int &d1s, const int &d1e,
              const int &d2s, const int &d2e, const int &d3s, const int &d3e,
-             const plot3dBlock &blk, const int &r, const int &l,
+             const plot3dBlockRange &blk, const int &r, const int &l,
              const bool (&border)[4]) {
   // bound -- boundary number which patch is on (1-6)
   // b -- parent block number
@@ -2050,7 +2123,7 @@ patch::patch(const int &bound, const int &b, const int &d1s, const int &d1e,
   // d2s -- direction 2 starting index
   // d2e -- direction 2 ending index
   // d3s -- direction 3 surface index (constant surface that patch is on)
-  // blk -- plot3dBlock that patch is on
+  // blk -- plot3dBlockRange that patch is on
   // r -- rank of block
   // l -- local position of block
   // border -- flags indicating if patch borders an interblock bc on sides 1/2
@@ -2158,6 +2231,26 @@ ostream &operator<<(ostream &os, const patch &p) {
   return os;
 }
 
+// member function to return the size of the buffer needed to pack a
+// boundaryConditions with PackBC()
+int boundaryConditions::PackSize() const {
+  auto bufSize = 0;
+  auto tempSize = 0;
+  // add size for number of surfaces in each direction
+  MPI_Pack_size(3, MPI_INT, MPI_COMM_WORLD, &tempSize);
+  bufSize += tempSize;
+  // 8x because iMin, iMax, jMin, jMax, kMin, kMax, tags, string sizes
+  MPI_Pack_size(this->NumSurfaces() * 8, MPI_INT, MPI_COMM_WORLD, &tempSize);
+  bufSize += tempSize;
+  for (auto jj = 0; jj < this->NumSurfaces(); jj++) {
+    // add size for bc types (+1 for c_str end character)
+    MPI_Pack_size(this->GetBCTypes(jj).size() + 1, MPI_CHAR, MPI_COMM_WORLD,
+                  &tempSize);
+    bufSize += tempSize;
+  }
+  return bufSize;
+}
+
 /*Member function to pack a boundaryConditions into a buffer so that in can be
  * sent with MPI.*/
 void boundaryConditions::PackBC(char *(&sendBuffer), const int &sendBufSize,
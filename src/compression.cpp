@@ -0,0 +1,145 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-17  Michael Nucci (michael.nucci@gmail.com)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#include <iostream>   // cerr
+#include <cstdint>    // uint64_t
+#include <cstring>    // memcpy
+#include <algorithm>  // min, fill
+#include <vector>     // vector
+#include "compression.hpp"
+
+using std::cerr;
+using std::endl;
+
+// number of bytes in each value
+constexpr int valueBytes = sizeof(uint64_t);
+
+// longest literal and repeated runs in the run length encoding
+constexpr int maxLiteral = 128;
+constexpr int minRepeat = 3;
+constexpr int maxRepeat = 130;
+
+/* Function to compress an array of doubles. The bytes of the difference of
+consecutive values are shuffled and then run length encoded. In the encoding a
+control byte c less than 128 is followed by c + 1 literal bytes, and any other
+control byte is followed by one byte that is repeated c - 125 times.
+*/
+vector<unsigned char> CompressDoubles(const vector<double> &values) {
+  // values -- array to compress
+
+  // difference each value from the previous one, and shuffle bytes so that
+  // the most significant byte of every value comes first
+  const auto numValues = values.size();
+  vector<unsigned char> shuffled(numValues * valueBytes);
+  uint64_t prev = 0;
+  for (auto ii = 0U; ii < numValues; ii++) {
+    uint64_t bits = 0;
+    std::memcpy(&bits, &values[ii], sizeof(bits));
+    const auto diff = bits - prev;
+    prev = bits;
+    for (auto bb = 0; bb < valueBytes; bb++) {
+      shuffled[(valueBytes - 1 - bb) * numValues + ii] =
+          static_cast<unsigned char>(diff >> (8 * bb));
+    }
+  }
+
+  // run length encode shuffled bytes
+  vector<unsigned char> packed;
+  packed.reserve(shuffled.size() + shuffled.size() / maxLiteral + 1);
+  const auto numBytes = shuffled.size();
+  size_t ii = 0;
+  size_t litStart = 0;
+  auto flushLiterals = [&](const size_t &end) {
+    while (litStart < end) {
+      const auto len = std::min(end - litStart,
+                                static_cast<size_t>(maxLiteral));
+      packed.push_back(static_cast<unsigned char>(len - 1));
+      packed.insert(packed.end(), shuffled.begin() + litStart,
+                    shuffled.begin() + litStart + len);
+      litStart += len;
+    }
+  };
+  while (ii < numBytes) {
+    // find length of run of repeated bytes
+    size_t run = 1;
+    while (ii + run < numBytes && run < maxRepeat &&
+           shuffled[ii + run] == shuffled[ii]) {
+      run++;
+    }
+    if (run >= minRepeat) {
+      flushLiterals(ii);
+      packed.push_back(static_cast<unsigned char>(run + 125));
+      packed.push_back(shuffled[ii]);
+      ii += run;
+      litStart = ii;
+    } else {
+      ii += run;
+    }
+  }
+  flushLiterals(numBytes);
+
+  return packed;
+}
+
+// function to decompress an array of doubles compressed by CompressDoubles()
+void DecompressDoubles(const unsigned char *packed, const long long &numPacked,
+                       vector<double> &values) {
+  // packed -- compressed bytes
+  // numPacked -- number of compressed bytes
+  // values -- output array (already sized to number of values)
+
+  // undo run length encoding
+  const auto numValues = values.size();
+  vector<unsigned char> shuffled(numValues * valueBytes);
+  auto pos = 0LL;
+  size_t out = 0;
+  while (pos < numPacked) {
+    const auto control = static_cast<unsigned int>(packed[pos++]);
+    const auto len = control < maxLiteral ? control + 1 : control - 125;
+    if (pos + (control < maxLiteral ? len : 1) > numPacked ||
+        out + len > shuffled.size()) {
+      cerr << "ERROR: Error in DecompressDoubles(). Compressed data is "
+           << "corrupt!" << endl;
+      exit(EXIT_FAILURE);
+    }
+    if (control < maxLiteral) {
+      std::memcpy(&shuffled[out], &packed[pos], len);
+      pos += len;
+    } else {
+      std::fill(shuffled.begin() + out, shuffled.begin() + out + len,
+                packed[pos++]);
+    }
+    out += len;
+  }
+  if (out != shuffled.size()) {
+    cerr << "ERROR: Error in DecompressDoubles(). Compressed data holds "
+         << out << " bytes, but " << shuffled.size() << " were expected!"
+         << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // unshuffle bytes and undo difference with previous value
+  uint64_t prev = 0;
+  for (auto ii = 0U; ii < numValues; ii++) {
+    uint64_t diff = 0;
+    for (auto bb = 0; bb < valueBytes; bb++) {
+      diff |= static_cast<uint64_t>(
+          shuffled[(valueBytes - 1 - bb) * numValues + ii]) << (8 * bb);
+    }
+    prev += diff;
+    std::memcpy(&values[ii], &prev, sizeof(prev));
+  }
+}
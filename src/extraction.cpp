@@ -0,0 +1,626 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-17  Michael Nucci (michael.nucci@gmail.com)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#include <iostream>     // cout
+#include <sstream>      // ostringstream
+#include <vector>       // vector
+#include <string>       // string
+#include <cmath>        // fabs
+#include <algorithm>    // max, min, fill
+#include "extraction.hpp"
+#include "inputStates.hpp"         // Tokenize, Trim, ReadVector
+#include "input.hpp"               // input
+#include "procBlock.hpp"           // procBlock
+#include "boundaryConditions.hpp"  // boundaryConditions
+#include "eos.hpp"                 // idealGas, sutherland
+#include "parallelIO.hpp"          // blockLayout, outputWriter
+#include "output.hpp"              // OutputKernels, WriteVisualization
+
+using std::cout;
+using std::endl;
+using std::cerr;
+using std::ostringstream;
+using std::to_string;
+
+// part of an extraction lying in a single parent block
+struct extractRegion {
+  int parent_;         // parent block
+  int side_;           // surface type of wall (1-6), or 0 for cells
+  int tag_;            // boundary condition tag of wall
+  string bcType_;      // boundary condition of wall
+  vector3d<int> lo_;   // first cell of region in parent block
+  vector3d<int> hi_;   // one past last cell of region in parent block
+
+  long long NumCells() const {
+    return static_cast<long long>(hi_[0] - lo_[0]) * (hi_[1] - lo_[1]) *
+        (hi_[2] - lo_[2]);
+  }
+};
+
+// construct extraction from string
+extraction::extraction(string &str) : extraction() {
+  const auto start = str.find("(") + 1;
+  const auto end = str.find(")") - 1;
+  const auto range = end - start + 1;  // +/-1 to ignore ()
+  auto spec = str.substr(start, range);
+  const auto id = str.substr(0, start - 1);
+  if (id != "extraction") {
+    cerr << "ERROR. Extraction specifier " << id << " is not recognized!"
+         << endl;
+    exit(EXIT_FAILURE);
+  }
+  auto tokens = Tokenize(spec, ";");
+
+  // erase portion used so multiple extractions in same string can easily be
+  // found
+  str.erase(0, end);
+
+  // parameter counters
+  auto nameCount = 0;
+  auto typeCount = 0;
+  auto blockCount = 0;
+  auto directionCount = 0;
+  auto indexCount = 0;
+  auto startCount = 0;
+  auto endCount = 0;
+  auto variablesCount = 0;
+
+  for (auto &token : tokens) {
+    auto param = Tokenize(token, "=");
+    if (param.size() != 2) {
+      cerr << "ERROR. Problem with extraction parameter " << token << endl;
+      exit(EXIT_FAILURE);
+    }
+
+    if (param[0] == "name") {
+      name_ = RemoveTrailing(param[1], ",");
+      nameCount++;
+    } else if (param[0] == "type") {
+      type_ = RemoveTrailing(param[1], ",");
+      typeCount++;
+    } else if (param[0] == "block") {
+      block_ = stoi(RemoveTrailing(param[1], ","));
+      blockCount++;
+    } else if (param[0] == "direction") {
+      direction_ = RemoveTrailing(param[1], ",");
+      directionCount++;
+    } else if (param[0] == "index") {
+      index_ = stoi(RemoveTrailing(param[1], ","));
+      indexCount++;
+    } else if (param[0] == "start") {
+      const auto vec = ReadVector(RemoveTrailing(param[1], ","));
+      start_ = {static_cast<int>(vec[0]), static_cast<int>(vec[1]),
+                static_cast<int>(vec[2])};
+      startCount++;
+    } else if (param[0] == "end") {
+      const auto vec = ReadVector(RemoveTrailing(param[1], ","));
+      end_ = {static_cast<int>(vec[0]), static_cast<int>(vec[1]),
+              static_cast<int>(vec[2])};
+      endCount++;
+    } else if (param[0] == "variables") {
+      const auto listStart = param[1].find("[") + 1;
+      const auto listEnd = param[1].find("]");
+      if (listStart == 0 || listEnd == string::npos) {
+        cerr << "ERROR. Extraction variables must be a list in []." << endl;
+        exit(EXIT_FAILURE);
+      }
+      variables_.clear();
+      for (auto &var : Tokenize(param[1].substr(listStart,
+                                                listEnd - listStart), ",")) {
+        variables_.insert(var);
+      }
+      variablesCount++;
+    } else {
+      cerr << "ERROR. Extraction specifier " << param[0]
+           << " is not recognized!" << endl;
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  // sanity checks
+  // required variables
+  if (nameCount != 1 || typeCount != 1) {
+    cerr << "ERROR. For extraction name and type must be specified, and only "
+         << "specified once." << endl;
+    exit(EXIT_FAILURE);
+  }
+  // optional variables
+  if (blockCount > 1 || directionCount > 1 || indexCount > 1 ||
+      startCount > 1 || endCount > 1 || variablesCount > 1) {
+    cerr << "ERROR. For extraction " << name_ << ", parameters can only be "
+         << "specified once." << endl;
+    exit(EXIT_FAILURE);
+  }
+  if (type_ == "walls") {
+    if (blockCount + directionCount + indexCount + startCount + endCount > 0) {
+      cerr << "ERROR. For walls extraction " << name_ << ", only name, type, "
+           << "and variables can be specified." << endl;
+      exit(EXIT_FAILURE);
+    }
+  } else if (type_ == "plane") {
+    if (blockCount != 1 || directionCount != 1 || indexCount != 1 ||
+        startCount + endCount > 0) {
+      cerr << "ERROR. For plane extraction " << name_ << ", block, direction, "
+           << "and index must be specified." << endl;
+      exit(EXIT_FAILURE);
+    }
+    if (direction_ != "i" && direction_ != "j" && direction_ != "k") {
+      cerr << "ERROR. For plane extraction " << name_ << ", direction "
+           << direction_ << " is not recognized!" << endl;
+      exit(EXIT_FAILURE);
+    }
+  } else if (type_ == "range") {
+    if (blockCount != 1 || startCount != 1 || endCount != 1 ||
+        directionCount + indexCount > 0) {
+      cerr << "ERROR. For range extraction " << name_ << ", block, start, "
+           << "and end must be specified." << endl;
+      exit(EXIT_FAILURE);
+    }
+  } else {
+    cerr << "ERROR. Extraction type " << type_ << " is not recognized!"
+         << endl;
+    exit(EXIT_FAILURE);
+  }
+  if (type_ != "walls" && variables_.count("skinFriction") > 0) {
+    cerr << "ERROR. For extraction " << name_ << ", skinFriction is only "
+         << "available for walls." << endl;
+    exit(EXIT_FAILURE);
+  }
+  if (variables_.empty()) {
+    cerr << "ERROR. For extraction " << name_ << ", at least one variable "
+         << "must be specified." << endl;
+    exit(EXIT_FAILURE);
+  }
+}
+
+void extraction::Print(ostream &os) const {
+  os << "extraction(name=" << name_ << "; type=" << type_;
+  if (type_ == "plane") {
+    os << "; block=" << block_ << "; direction=" << direction_ << "; index="
+       << index_;
+  } else if (type_ == "range") {
+    os << "; block=" << block_ << "; start=[" << start_ << "]; end=[" << end_
+       << "]";
+  }
+  os << "; variables=[";
+  auto count = 0U;
+  for (auto &var : variables_) {
+    os << var;
+    if (++count < variables_.size()) {
+      os << ", ";
+    }
+  }
+  os << "])";
+}
+
+ostream &operator<<(ostream &os, const extraction &ex) {
+  ex.Print(os);
+  return os;
+}
+
+// function to check that extraction names are unique, and will not overwrite
+// the function files of the full solution
+void CheckExtractionName(const vector<extraction> &exList,
+                         const string &name) {
+  if (name == "center") {
+    cerr << "ERROR. Extraction name " << name << " is reserved for the full "
+         << "solution output." << endl;
+    exit(EXIT_FAILURE);
+  }
+  for (auto &ex : exList) {
+    if (ex.Name() == name) {
+      cerr << "ERROR. Extraction name " << name << " is used more than once."
+           << endl;
+      exit(EXIT_FAILURE);
+    }
+  }
+}
+
+// function to read list of extractions from input file
+vector<extraction> ReadExtractionList(ifstream &inFile, string &str) {
+  vector<extraction> exList;
+  auto openList = false;
+  do {
+    const auto start = openList ? 0 : str.find("<");
+    const auto listOpened = str.find("<") == string::npos ? false : true;
+    const auto end = str.find(">");
+    openList = (end == string::npos) ? true : false;
+
+    // test for extraction on current line
+    // if < or > is alone on a line, should not look for extraction
+    auto exPos = str.find("extraction");
+    if (exPos != string::npos) {  // there is an extraction in current line
+      string list;
+      if (listOpened && openList) {  // list opened on current line, remains open
+        list = str.substr(start + 1, string::npos);
+      } else if (listOpened && !openList) {  // list opened/closed on current line
+        const auto range = end - start - 1;
+        list = str.substr(start + 1, range);  // +/- 1 to ignore <>
+      } else if (!listOpened && openList) {  // list was open and remains open
+        list = str.substr(start, string::npos);
+      } else {  // list was open and is now closed
+        const auto range = end - start;
+        list = str.substr(start, range);
+      }
+
+      auto nextEx = list.find("extraction");
+      while (nextEx != string::npos) {  // there are more extractions to read
+        list.erase(0, nextEx);  // remove commas separating extractions
+        extraction ex(list);
+        CheckExtractionName(exList, ex.Name());
+        exList.push_back(ex);
+        nextEx = list.find("extraction");
+      }
+    }
+
+    if (openList) {
+      getline(inFile, str);
+      str = Trim(str);
+    }
+  } while (openList);
+
+  return exList;
+}
+
+/* Function to find the regions of an extraction in the parent blocks. Walls
+extractions have a region for each viscousWall and slipWall surface of the
+parent blocks, made of the cells adjacent to the surface. Plane and range
+extractions have a single region.
+*/
+vector<extractRegion> ExtractionRegions(const extraction &ex,
+                                        const input &inp,
+                                        const blockLayout &layout) {
+  // ex -- extraction to find regions of
+  // inp -- input variables
+  // layout -- location of procBlocks within parent blocks
+
+  vector<extractRegion> regions;
+  if (ex.Type() == "walls") {
+    for (auto pp = 0; pp < layout.NumParents(); pp++) {
+      const auto bc = inp.BC(pp);
+      for (auto ss = 0; ss < bc.NumSurfaces(); ss++) {
+        const auto bcType = bc.GetBCTypes(ss);
+        if (bcType != "viscousWall" && bcType != "slipWall") {
+          continue;
+        }
+        // surface ranges are given in nodes; the region is the layer of
+        // cells next to the surface
+        const auto surf = bc.GetSurface(ss);
+        const auto side = surf.SurfaceType();
+        const auto dir = (side - 1) / 2;
+        vector3d<int> lo(surf.IMin(), surf.JMin(), surf.KMin());
+        vector3d<int> hi(surf.IMax(), surf.JMax(), surf.KMax());
+        if (side % 2 == 0) {  // upper surface
+          lo[dir]--;
+        }
+        hi[dir] = lo[dir] + 1;
+        regions.push_back({pp, side, surf.Tag(), bcType, lo, hi});
+      }
+    }
+  } else {
+    if (ex.Block() < 0 || ex.Block() >= layout.NumParents()) {
+      cerr << "ERROR: Error in ExtractionRegions(). Block " << ex.Block()
+           << " of extraction " << ex.Name() << " does not exist!" << endl;
+      exit(EXIT_FAILURE);
+    }
+    const auto dims = layout.ParentDims(ex.Block());
+    extractRegion region{ex.Block(), 0, -1, "none", {0, 0, 0}, dims};
+    if (ex.Type() == "plane") {
+      const auto dir = ex.Direction() == "i" ? 0 :
+          (ex.Direction() == "j" ? 1 : 2);
+      region.lo_[dir] = ex.Index();
+      region.hi_[dir] = ex.Index() + 1;
+    } else {  // range
+      region.lo_ = ex.Start();
+      region.hi_ = ex.End() + 1;
+    }
+    for (auto dd = 0; dd < 3; dd++) {
+      if (region.lo_[dd] < 0 || region.hi_[dd] > dims[dd] ||
+          region.lo_[dd] >= region.hi_[dd]) {
+        cerr << "ERROR: Error in ExtractionRegions(). Extraction " << ex.Name()
+             << " is outside of block " << ex.Block() << " with " << dims
+             << " cells!" << endl;
+        exit(EXIT_FAILURE);
+      }
+    }
+    regions.push_back(region);
+  }
+  return regions;
+}
+
+// function to write the Plot3D header of an extraction, which gives the
+// number of regions and their dimensions
+string ExtractionHeader(const vector<extractRegion> &regions, int numVars) {
+  // regions -- regions of extraction
+  // numVars -- number of variables (0 for grid files)
+
+  ostringstream header;
+  int numRegions = regions.size();
+  header.write(reinterpret_cast<char *>(&numRegions), sizeof(numRegions));
+  for (auto &region : regions) {
+    for (auto dd = 0; dd < 3; dd++) {
+      auto dim = region.hi_[dd] - region.lo_[dd];
+      header.write(reinterpret_cast<char *>(&dim), sizeof(dim));
+    }
+    if (numVars > 0) {
+      header.write(reinterpret_cast<char *>(&numVars), sizeof(numVars));
+    }
+  }
+  return header.str();
+}
+
+/* Function to stage the values of an extraction that lie in the procBlocks on
+this processor. Each region is written like a Plot3D block with the given
+number of values for each cell. The part of each region in a procBlock is
+passed to the given function with the range of cells in procBlock indices,
+which must store the given value for each cell in the range. The size of the
+file is returned.
+*/
+template <typename T>
+MPI_Offset StageRegions(const vector<procBlock> &vars,
+                        const blockLayout &layout,
+                        const vector<extractRegion> &regions,
+                        const int &numValues, const MPI_Offset &dataStart,
+                        const MPI_Offset &varSize, const T &stage,
+                        vector<fileRun> &runs, vector<double> &buffer) {
+  // vars -- procBlocks on this processor
+  // layout -- location of procBlocks within parent blocks
+  // regions -- regions of extraction
+  // numValues -- number of values for each cell
+  // dataStart -- size of file header
+  // varSize -- size of each value in file
+  // stage -- function to store values of a range of cells
+  // runs -- location of data in file and buffer
+  // buffer -- staged data to write
+
+  // values in all preceding regions
+  vector<long long> valuesBefore(regions.size() + 1, 0);
+  for (auto rr = 0U; rr < regions.size(); rr++) {
+    valuesBefore[rr + 1] = valuesBefore[rr] + regions[rr].NumCells() *
+        numValues;
+  }
+
+  for (const auto &blk : vars) {
+    const auto gp = blk.GlobalPos();
+    const auto start = layout.Start(gp);
+    const auto end = start + layout.Dims(gp);
+    const vector3d<int> blkStart(blk.StartI(), blk.StartJ(), blk.StartK());
+    for (auto rr = 0U; rr < regions.size(); rr++) {
+      const auto &region = regions[rr];
+      if (region.parent_ != layout.Parent(gp)) {
+        continue;
+      }
+      // part of region in this procBlock
+      vector3d<int> lo, hi;
+      auto isEmpty = false;
+      for (auto dd = 0; dd < 3; dd++) {
+        lo[dd] = std::max(region.lo_[dd], start[dd]);
+        hi[dd] = std::min(region.hi_[dd], end[dd]);
+        isEmpty = isEmpty || lo[dd] >= hi[dd];
+      }
+      if (isEmpty) {
+        continue;
+      }
+
+      const auto regionDims = region.hi_ - region.lo_;
+      const auto rowLength = hi[0] - lo[0];
+      for (auto vv = 0; vv < numValues; vv++) {
+        const auto bufferStart = static_cast<long long>(buffer.size());
+        auto pos = bufferStart;
+        for (auto kk = lo[2]; kk < hi[2]; kk++) {
+          for (auto jj = lo[1]; jj < hi[1]; jj++) {
+            const auto cell = valuesBefore[rr] + vv * region.NumCells() +
+                (lo[0] - region.lo_[0]) + regionDims[0] *
+                ((jj - region.lo_[1]) +
+                 static_cast<long long>(regionDims[1]) * (kk - region.lo_[2]));
+            runs.push_back({dataStart + cell * varSize, pos, rowLength});
+            pos += rowLength;
+          }
+        }
+        buffer.resize(pos);
+        stage(blk, region, vv, lo - start + blkStart, hi - start + blkStart,
+              &buffer[bufferStart]);
+      }
+    }
+  }
+  return dataStart + valuesBefore.back() * varSize;
+}
+
+// function to get the center and unit normal of the wall face of a cell
+void WallFace(const procBlock &blk, const int &side, const int &ii,
+              const int &jj, const int &kk, vector3d<double> &center,
+              vector3d<double> &normal) {
+  // blk -- block to get face of
+  // side -- surface type of wall
+  // ii -- i-index of cell next to wall
+  // jj -- j-index of cell next to wall
+  // kk -- k-index of cell next to wall
+  // center -- center of wall face
+  // normal -- unit normal of wall face
+
+  // upper surfaces are on the upper face of the cell
+  const auto up = (side % 2 == 0) ? 1 : 0;
+  if (side <= 2) {
+    center = blk.FCenterI(ii + up, jj, kk);
+    normal = blk.FAreaUnitI(ii + up, jj, kk);
+  } else if (side <= 4) {
+    center = blk.FCenterJ(ii, jj + up, kk);
+    normal = blk.FAreaUnitJ(ii, jj + up, kk);
+  } else {
+    center = blk.FCenterK(ii, jj, kk + up);
+    normal = blk.FAreaUnitK(ii, jj, kk + up);
+  }
+}
+
+/* Function to store the skin friction for a range of cells next to a wall.
+The wall shear stress is found from the difference in the tangential velocity
+of the cell and the wall, divided by the distance from the cell center to the
+wall. It is normalized by the freestream dynamic pressure.
+*/
+void SkinFriction(const procBlock &blk, const extractRegion &region,
+                  const vector3d<int> &lo, const vector3d<int> &hi,
+                  const input &inp, const idealGas &eqnState,
+                  const sutherland &suth, double *out) {
+  // blk -- block to store skin friction of
+  // region -- wall region
+  // lo -- first cell of range
+  // hi -- one past last cell of range
+  // inp -- input variables
+  // eqnState -- equation of state
+  // suth -- sutherland's law for viscosity
+  // out -- location to store values
+
+  const auto numCells = (hi[0] - lo[0]) * (hi[1] - lo[1]) * (hi[2] - lo[2]);
+  if (region.bcType_ != "viscousWall") {  // no shear on slip walls
+    std::fill(out, out + numCells, 0.0);
+    return;
+  }
+
+  const auto refSoS = inp.ARef(eqnState);
+  const auto wallVel = inp.BCData(region.tag_)->Velocity() / refSoS;
+  const auto scale = suth.NondimScaling() * inp.RRef() * refSoS * refSoS /
+      (0.5 * inp.RRef() * inp.VelRef().MagSq());
+
+  vector3d<double> center, normal;
+  for (auto kk = lo[2]; kk < hi[2]; kk++) {
+    for (auto jj = lo[1]; jj < hi[1]; jj++) {
+      for (auto ii = lo[0]; ii < hi[0]; ii++) {
+        WallFace(blk, region.side_, ii, jj, kk, center, normal);
+        const auto vel = blk.State(ii, jj, kk).Velocity() - wallVel;
+        const auto velTan = vel - normal * vel.DotProd(normal);
+        const auto dist =
+            fabs((blk.Center(ii, jj, kk) - center).DotProd(normal));
+        *out++ = blk.Viscosity(ii, jj, kk) * velTan.Mag() / dist * scale;
+      }
+    }
+  }
+}
+
+/* Function to write the grids of all extractions. The grid of a walls
+extraction is made of the centers of the wall faces, and the grid of other
+extractions is made of cell centers. Each processor writes the part of each
+extraction in its own procBlocks.
+*/
+void WriteExtractionGrids(const vector<procBlock> &vars,
+                          const blockLayout &layout, const input &inp,
+                          outputWriter &writer) {
+  // vars -- procBlocks on this processor
+  // layout -- location of procBlocks within parent blocks
+  // inp -- input variables
+  // writer -- writer for output files
+
+  const MPI_Offset varSize =
+      inp.IsSinglePrecisionOutput() ? sizeof(float) : sizeof(double);
+  const auto lRef = inp.LRef();
+
+  for (auto &ex : inp.Extractions()) {
+    const auto writeName = inp.SimNameRoot() + "_" + ex.Name() + ".xyz";
+    const auto regions = ExtractionRegions(ex, inp, layout);
+    const auto header = ExtractionHeader(regions, 0);
+
+    // write out x, y, z coordinates; for a given region, first write out all
+    // x coordinates, then all y coordinates, then all z coordinates
+    vector<fileRun> runs;
+    vector<double> buffer;
+    const auto fileSize = StageRegions(
+        vars, layout, regions, 3, header.size(), varSize,
+        [lRef](const procBlock &blk, const extractRegion &region,
+               const int &dd, const vector3d<int> &lo,
+               const vector3d<int> &hi, double *out) {
+          vector3d<double> center, normal;
+          for (auto kk = lo[2]; kk < hi[2]; kk++) {
+            for (auto jj = lo[1]; jj < hi[1]; jj++) {
+              for (auto ii = lo[0]; ii < hi[0]; ii++) {
+                if (region.side_ > 0) {
+                  WallFace(blk, region.side_, ii, jj, kk, center, normal);
+                } else {
+                  center = blk.Center(ii, jj, kk);
+                }
+                *out++ = center[dd] * lRef;
+              }
+            }
+          }
+        }, runs, buffer);
+
+    WriteVisualization(writeName, header, fileSize, runs, buffer, inp, writer);
+  }
+}
+
+/* Function to write the function files of all extractions. The variables are
+evaluated with the same kernels as the full function file, but only for the
+cells of the extraction. Each processor writes the part of each extraction in
+its own procBlocks.
+*/
+void WriteExtractions(const vector<procBlock> &vars,
+                      const blockLayout &layout, const idealGas &eqnState,
+                      const sutherland &suth, const int &solIter,
+                      const input &inp, outputWriter &writer) {
+  // vars -- procBlocks on this processor
+  // layout -- location of procBlocks within parent blocks
+  // eqnState -- equation of state
+  // suth -- sutherland's law for viscosity
+  // solIter -- iteration number of solution
+  // inp -- input variables
+  // writer -- writer for output files
+
+  const MPI_Offset varSize =
+      inp.IsSinglePrecisionOutput() ? sizeof(float) : sizeof(double);
+
+  for (auto &ex : inp.Extractions()) {
+    const auto writeName = inp.SimNameRoot() + "_" + to_string(solIter) +
+        "_" + ex.Name() + ".fun";
+    const auto regions = ExtractionRegions(ex, inp, layout);
+    const auto header = ExtractionHeader(regions, ex.NumVariables());
+
+    // skin friction depends on the wall, so it is not one of the output
+    // kernels; find which kernel stores each variable
+    auto cellVars = ex.Variables();
+    cellVars.erase("skinFriction");
+    const auto kernels = OutputKernels(cellVars, inp, eqnState, suth);
+    vector<int> kernelIndex;
+    for (auto &var : ex.Variables()) {
+      kernelIndex.push_back(var == "skinFriction" ? -1 :
+                            std::distance(cellVars.begin(),
+                                          cellVars.find(var)));
+    }
+
+    vector<fileRun> runs;
+    vector<double> buffer;
+    const auto fileSize = StageRegions(
+        vars, layout, regions, ex.NumVariables(), header.size(), varSize,
+        [&](const procBlock &blk, const extractRegion &region,
+            const int &vv, const vector3d<int> &lo, const vector3d<int> &hi,
+            double *out) {
+          if (kernelIndex[vv] < 0) {
+            SkinFriction(blk, region, lo, hi, inp, eqnState, suth, out);
+          } else {
+            kernels[kernelIndex[vv]](blk, lo, hi, out);
+          }
+        }, runs, buffer);
+
+    WriteVisualization(writeName, header, fileSize, runs, buffer, inp, writer);
+  }
+}
+
+// function to write out plot3d meta data for Paraview for all extractions
+void WriteExtractionMeta(const input &inp, const int &iter) {
+  for (auto &ex : inp.Extractions()) {
+    const auto root = inp.SimNameRoot() + "_";
+    WriteMeta(root + ex.Name() + ".p3d", root + ex.Name() + ".xyz",
+              root + to_string(iter) + "_" + ex.Name() + ".fun",
+              ex.Variables(), inp, iter);
+  }
+}
@@ -35,20 +35,16 @@ using std::string;
 using std::unique_ptr;
 
 // constructor
-// if constructed with two doubles, create scalar squareMatrix
-fluxJacobian::fluxJacobian(const double &flow, const double &turb) {
-  flowJacobian_ = squareMatrix(1);
+// if constructed with two doubles, create scalar matrices
+fluxJacobian::fluxJacobian(const double &flow, const double &turb)
+    : flowJacobian_(1), turbJacobian_(1) {
   flowJacobian_ += flow;
-
-  turbJacobian_ = squareMatrix(1);
   turbJacobian_ += turb;
 }
 
-// if constructed with two intss, create scalar squareMatrix with given size
-fluxJacobian::fluxJacobian(const int &flowSize, const int &turbSize) {
-  flowJacobian_ = squareMatrix(flowSize);
-  turbJacobian_ = squareMatrix(turbSize);
-}
+// if constructed with two intss, create matrices with given size
+fluxJacobian::fluxJacobian(const int &flowSize, const int &turbSize)
+    : flowJacobian_(flowSize), turbJacobian_(turbSize) {}
 
 
 // member functions
@@ -149,8 +145,8 @@ void fluxJacobian::InvFluxJacobian(const primVars &state,
   const auto a3 = eqnState.Gamma() - 2.0;
 
   // begin jacobian calculation
-  flowJacobian_ = squareMatrix(inp.NumFlowEquations());
-  turbJacobian_ = squareMatrix(inp.NumTurbEquations());
+  flowJacobian_ = flowMatrix(inp.NumFlowEquations());
+  turbJacobian_ = turbMatrix(inp.NumTurbEquations());
 
   // calculate flux derivatives wrt left state
   // column zero
@@ -262,8 +258,8 @@ void fluxJacobian::DelPrimativeDelConservative(const primVars &state,
   const auto gammaMinusOne = eos.Gamma() - 1.0;
   const auto invRho = 1.0 / state.Rho();
 
-  flowJacobian_ = squareMatrix(inp.NumFlowEquations());
-  turbJacobian_ = squareMatrix(inp.NumTurbEquations());
+  flowJacobian_ = flowMatrix(inp.NumFlowEquations());
+  turbJacobian_ = turbMatrix(inp.NumTurbEquations());
 
   // assign column 0
   flowJacobian_(0, 0) = 1.0;
@@ -317,8 +313,8 @@ void fluxJacobian::ApproxTSLJacobian(const primVars &state,
   // left -- flag that is negative if using left state
   // vGrad -- velocity gradient
 
-  flowJacobian_ = squareMatrix(inp.NumFlowEquations());
-  turbJacobian_ = squareMatrix(inp.NumTurbEquations());
+  flowJacobian_ = flowMatrix(inp.NumFlowEquations());
+  turbJacobian_ = turbMatrix(inp.NumTurbEquations());
 
   const auto mu = suth.NondimScaling() * lamVisc;
   const auto mut = suth.NondimScaling() * turbVisc;
@@ -498,7 +494,7 @@ genArray OffDiagonal(const primVars &offDiag, const primVars &diag,
 
   genArray offDiagonal(0.0);
 
-  if (inp.InvFluxJac() == "rusanov") {
+  if (inp.InvFluxJacMethod() == fluxJacobianMethod::rusanov) {
     if (inp.IsBlockMatrix()) {
       offDiagonal = RusanovBlockOffDiagonal(offDiag, update, fArea, mu, mut, f1,
                                             dist, eos, suth, turb, inp,
@@ -508,16 +504,12 @@ genArray OffDiagonal(const primVars &offDiag, const primVars &diag,
                                              f1, dist, eos, suth, turb,
                                              inp.IsViscous(), positive);
     }
-  } else if (inp.InvFluxJac() == "approximateRoe") {
+  } else {  // approximate roe
     // always use flux change off diagonal with roe method
     offDiagonal = RoeOffDiagonal(offDiag, diag, update, fArea, mu, mut,
                                  f1, dist, eos, suth, turb,
                                  inp.IsViscous(), inp.IsTurbulent(),
                                  positive);
-  } else {
-    cerr << "ERROR: Error in OffDiagonal(), inviscid flux jacobian method of "
-         << inp.InvFluxJac() << " is not recognized!" << endl;
-    exit(EXIT_FAILURE);
   }
 
   return offDiagonal;
@@ -0,0 +1,306 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-17  Michael Nucci (michael.nucci@gmail.com)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#include <iostream>     // cout, cerr
+#include <fstream>      // ifstream
+#include <sstream>      // ostringstream
+#include <vector>       // vector
+#include <string>       // string
+#include <cstring>      // memcpy
+#include <sys/mman.h>   // mmap, munmap
+#include <fcntl.h>      // open
+#include <unistd.h>     // close
+#include <sys/stat.h>   // stat
+#include "mpi.h"        // parallelism
+#include "geometryCache.hpp"
+#include "procBlock.hpp"           // procBlock
+#include "input.hpp"               // input
+#include "boundaryConditions.hpp"  // boundaryConditions, interblock
+#include "parallelIO.hpp"          // blockLayout, WriteCollective
+#include "plot3d.hpp"              // ReadP3dGridHeader
+#include "macros.hpp"              // ROOTP
+
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::ios;
+using std::ifstream;
+using std::ostringstream;
+
+// version of cache file format; change when the layout of the file changes
+constexpr int CACHEVERSION = 1;
+
+// constructor -- find key of grid and check if cache file matches it
+geometryCache::geometryCache(const input &inp, const blockLayout &layout,
+                             const vector<boundaryConditions> &bcs,
+                             const vector<interblock> &connections)
+    : geometryCache() {
+  // inp -- input variables
+  // layout -- location of each procBlock within its parent block
+  // bcs -- boundary conditions of each procBlock
+  // connections -- interblock boundary conditions
+
+  if (!inp.IsGeometryCache()) {
+    return;
+  }
+  fileName_ = inp.GeometryCache();
+
+  // header is followed by the border flags of each interblock, and then the
+  // data of each procBlock
+  dataStart_ = 4 * sizeof(int) + sizeof(key_) +
+      8 * sizeof(int) * connections.size();
+  blockStart_.resize(layout.NumBlocks() + 1, dataStart_);
+  for (auto ll = 0; ll < layout.NumBlocks(); ll++) {
+    blockStart_[ll + 1] = blockStart_[ll] + sizeof(double) *
+        GeometrySize(layout.Dims(ll), inp.NumberGhostLayers());
+  }
+
+  auto rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  if (rank == ROOTP) {
+    this->ComputeKey(inp, layout, bcs);
+    this->CheckFile(connections.size());
+  }
+  MPI_Bcast(&key_, 1, MPI_UNSIGNED_LONG_LONG, ROOTP, MPI_COMM_WORLD);
+  auto isValid = static_cast<int>(isValid_);
+  MPI_Bcast(&isValid, 1, MPI_INT, ROOTP, MPI_COMM_WORLD);
+  isValid_ = isValid;
+}
+
+// member function to add bytes to the key with the 64 bit FNV-1a hash
+void geometryCache::Hash(const void *data, const size_t &size) {
+  // data -- bytes to hash
+  // size -- number of bytes
+
+  const auto *bytes = static_cast<const unsigned char *>(data);
+  for (auto ii = 0U; ii < size; ii++) {
+    key_ ^= bytes[ii];
+    key_ *= 1099511628211ULL;
+  }
+}
+
+/* Member function to add the grid file to the key. The grid coordinates are
+not read; instead the key uses the size and modification time of the grid file,
+and its header (the number of blocks and the size of each block). Rewriting the
+grid file changes its modification time, so the cache is recalculated.
+*/
+void geometryCache::HashGrid(const string &gridName) {
+  // gridName -- name of grid (without extension)
+
+  const auto fileName = gridName + ".xyz";
+  struct stat fileStat;
+  if (stat(fileName.c_str(), &fileStat) != 0) {
+    cerr << "ERROR: Error in geometryCache::HashGrid(). File " << fileName
+         << " could not be found!!!" << endl;
+    exit(EXIT_FAILURE);
+  }
+  const long long sizeTime[] = {static_cast<long long>(fileStat.st_size),
+                                static_cast<long long>(fileStat.st_mtime)};
+  this->Hash(sizeTime, sizeof(sizeTime));
+
+  const auto dims = ReadP3dGridHeader(gridName);
+  const auto numBlocks = static_cast<int>(dims.size());
+  this->Hash(&numBlocks, sizeof(numBlocks));
+  for (const auto &dim : dims) {
+    const int numPts[] = {dim.X(), dim.Y(), dim.Z()};
+    this->Hash(numPts, sizeof(numPts));
+  }
+}
+
+/* Member function to calculate the key of the cache. The key is a hash of
+everything the geometry and wall distance depend on: the grid file (see
+HashGrid()), the reference length, the location of each procBlock within its
+parent block, the boundary conditions of each procBlock, the number of ghost
+cell layers, and the wall distance method. The processor ranks of the
+procBlocks are not included, as they do not change the geometry.
+*/
+void geometryCache::ComputeKey(const input &inp, const blockLayout &layout,
+                               const vector<boundaryConditions> &bcs) {
+  // inp -- input variables
+  // layout -- location of each procBlock within its parent block
+  // bcs -- boundary conditions of each procBlock
+
+  key_ = 14695981039346656037ULL;
+  this->Hash(&CACHEVERSION, sizeof(CACHEVERSION));
+  this->HashGrid(inp.GridName());
+
+  const auto lRef = inp.LRef();
+  this->Hash(&lRef, sizeof(lRef));
+  const auto numGhosts = inp.NumberGhostLayers();
+  this->Hash(&numGhosts, sizeof(numGhosts));
+  const auto method = static_cast<int>(inp.WallDistanceMethod());
+  this->Hash(&method, sizeof(method));
+
+  for (auto ll = 0; ll < layout.NumBlocks(); ll++) {
+    const int location[] = {layout.Parent(ll), layout.Start(ll).X(),
+                            layout.Start(ll).Y(), layout.Start(ll).Z(),
+                            layout.Dims(ll).X(), layout.Dims(ll).Y(),
+                            layout.Dims(ll).Z()};
+    this->Hash(location, sizeof(location));
+  }
+
+  ostringstream bcText;
+  for (const auto &bc : bcs) {
+    bcText << bc;
+  }
+  const auto text = bcText.str();
+  this->Hash(text.data(), text.size());
+}
+
+// member function to check if the cache file exists and matches the key
+void geometryCache::CheckFile(const int &numConnections) {
+  // numConnections -- number of interblocks
+
+  isValid_ = false;
+  ifstream cacheFile(fileName_, ios::in | ios::binary | ios::ate);
+  if (!cacheFile ||
+      static_cast<MPI_Offset>(cacheFile.tellg()) != blockStart_.back()) {
+    return;
+  }
+  cacheFile.seekg(0, ios::beg);
+
+  auto version = 0;
+  auto numBlocks = 0;
+  auto key = 0ULL;
+  auto numConn = 0;
+  cacheFile.read(reinterpret_cast<char *>(&version), sizeof(version));
+  cacheFile.read(reinterpret_cast<char *>(&numBlocks), sizeof(numBlocks));
+  cacheFile.read(reinterpret_cast<char *>(&key), sizeof(key));
+  cacheFile.read(reinterpret_cast<char *>(&numConn), sizeof(numConn));
+  isValid_ = cacheFile && version == CACHEVERSION &&
+      numBlocks == static_cast<int>(blockStart_.size()) - 1 && key == key_ &&
+      numConn == numConnections;
+}
+
+/* Member function to assign the geometry, cell widths, and wall distance of
+the procBlocks on this processor from the cache file. This replaces the
+assignment of ghost cell geometry, the geometry swap across interblocks, the
+cell width calculation, and the wall distance calculation. The file is memory
+mapped, so each processor only reads the parts of the file it needs.
+*/
+void geometryCache::Read(vector<procBlock> &blocks,
+                         vector<interblock> &connections) const {
+  // blocks -- procBlocks on this processor
+  // connections -- interblock boundary conditions
+
+  const auto fd = open(fileName_.c_str(), O_RDONLY);
+  if (fd < 0) {
+    cerr << "ERROR: Error in geometryCache::Read(). File " << fileName_
+         << " did not open correctly!!!" << endl;
+    exit(EXIT_FAILURE);
+  }
+  const auto fileSize = blockStart_.back();
+  auto *data = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    cerr << "ERROR: Error in geometryCache::Read(). File " << fileName_
+         << " could not be memory mapped!" << endl;
+    exit(EXIT_FAILURE);
+  }
+  const auto *bytes = static_cast<const char *>(data);
+
+  // border flags set when geometry was swapped
+  vector<int> borders(8 * connections.size());
+  std::memcpy(borders.data(), bytes + 4 * sizeof(int) + sizeof(key_),
+              borders.size() * sizeof(int));
+  for (auto ii = 0U; ii < connections.size(); ii++) {
+    for (auto aa = 0; aa < 4; aa++) {
+      if (borders[8 * ii + aa]) {
+        connections[ii].UpdateBorderFirst(aa);
+      }
+      if (borders[8 * ii + 4 + aa]) {
+        connections[ii].UpdateBorderSecond(aa);
+      }
+    }
+  }
+
+#pragma omp parallel for schedule(dynamic)
+  for (auto bb = 0U; bb < blocks.size(); bb++) {
+    auto &blk = blocks[bb];
+    blk.UnpackGeometry(reinterpret_cast<const double *>(
+        bytes + blockStart_[blk.GlobalPos()]));
+  }
+
+  munmap(data, fileSize);
+}
+
+/* Member function to write the cache file. ROOT writes the header and the
+border flags of the interblocks, and each processor writes the data of its own
+procBlocks. This must be called after the wall distance is calculated.
+*/
+void geometryCache::Write(const vector<procBlock> &blocks,
+                          const vector<interblock> &connections) const {
+  // blocks -- procBlocks on this processor
+  // connections -- interblock boundary conditions
+
+  ostringstream header;
+  const int numBlocks = blockStart_.size() - 1;
+  const int numConn = connections.size();
+  const auto unused = 0;
+  header.write(reinterpret_cast<const char *>(&CACHEVERSION),
+               sizeof(CACHEVERSION));
+  header.write(reinterpret_cast<const char *>(&numBlocks), sizeof(numBlocks));
+  header.write(reinterpret_cast<const char *>(&key_), sizeof(key_));
+  header.write(reinterpret_cast<const char *>(&numConn), sizeof(numConn));
+  header.write(reinterpret_cast<const char *>(&unused), sizeof(unused));
+  for (const auto &conn : connections) {
+    const int borders[] = {conn.Dir1StartInterBorderFirst(),
+                           conn.Dir1EndInterBorderFirst(),
+                           conn.Dir2StartInterBorderFirst(),
+                           conn.Dir2EndInterBorderFirst(),
+                           conn.Dir1StartInterBorderSecond(),
+                           conn.Dir1EndInterBorderSecond(),
+                           conn.Dir2StartInterBorderSecond(),
+                           conn.Dir2EndInterBorderSecond()};
+    header.write(reinterpret_cast<const char *>(borders), sizeof(borders));
+  }
+
+  vector<fileRun> runs;
+  vector<double> buffer;
+  for (const auto &blk : blocks) {
+    const auto size = GeometrySize({blk.NumI(), blk.NumJ(), blk.NumK()},
+                                   blk.NumGhosts());
+    const auto bufferStart = static_cast<long long>(buffer.size());
+    runs.push_back({blockStart_[blk.GlobalPos()], bufferStart,
+                    static_cast<int>(size)});
+    buffer.resize(bufferStart + size);
+    blk.PackGeometry(buffer.data() + bufferStart);
+  }
+
+  WriteCollective(fileName_, header.str(), blockStart_.back(), runs,
+                  buffer.data(), MPI_DOUBLE);
+}
+
+/* Function to return the number of doubles of geometry stored for a procBlock
+by procBlock::PackGeometry. This is the volume, center, cell widths, and wall
+distance of each cell, and the area and center of each face, all including
+ghost cells.
+*/
+long long GeometrySize(const vector3d<int> &dims, const int &numGhosts) {
+  // dims -- number of cells in block in each direction
+  // numGhosts -- number of ghost cell layers
+
+  const auto ni = static_cast<long long>(dims.X() + 2 * numGhosts);
+  const auto nj = static_cast<long long>(dims.Y() + 2 * numGhosts);
+  const auto nk = static_cast<long long>(dims.Z() + 2 * numGhosts);
+  const auto cells = ni * nj * nk;
+  const auto faces = (ni + 1) * nj * nk + ni * (nj + 1) * nk +
+      ni * nj * (nk + 1);
+
+  // volume, center, 3 widths, and wall distance for cells; area vector and
+  // magnitude, and center for faces
+  return 8 * cells + 7 * faces;
+}
@@ -0,0 +1,249 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-17  Michael Nucci (michael.nucci@gmail.com)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#include <iostream>   // cerr
+#include <algorithm>  // find, sort, unique
+#include "haloExchange.hpp"
+#include "procBlock.hpp"
+
+using std::cerr;
+using std::endl;
+
+// function to call the given function for the location of every cell that is
+// inserted across an interblock, in the order that PutSlice() inserts them
+template <typename F>
+void ForEachInsert(const interblock &inter, const int &numGhosts,
+                   const F &func) {
+  // inter -- interblock adjusted for slice, with receiving block first
+  // numGhosts -- number of layers of ghost cells
+  // func -- function to call with location of each cell
+
+  // adjust insertion indices if patch borders another interblock on the same
+  // surface of the block
+  const auto adjS1 = (inter.Dir1StartInterBorderFirst()) ? numGhosts : 0;
+  const auto adjE1 = (inter.Dir1EndInterBorderFirst()) ? numGhosts : 0;
+  const auto adjS2 = (inter.Dir2StartInterBorderFirst()) ? numGhosts : 0;
+  const auto adjE2 = (inter.Dir2EndInterBorderFirst()) ? numGhosts : 0;
+
+  for (auto l3 = 0; l3 < numGhosts; l3++) {
+    for (auto l2 = adjS2; l2 < inter.Dir2LenFirst() - adjE2; l2++) {
+      for (auto l1 = adjS1; l1 < inter.Dir1LenFirst() - adjE1; l1++) {
+        func(l1, l2, l3);
+      }
+    }
+  }
+}
+
+/* Constructor to build the exchange for all interblocks between a block on
+this processor and a block on another processor. The cells to send are found
+by following the insertion done by the partner block, so the cells are sent in
+the order the partner inserts them into its ghost cells.
+*/
+haloExchange::haloExchange(const vector<interblock> &conn,
+                           const vector<procBlock> &blocks, const int &rank)
+    : connSwap_(conn.size(), -1), haloSurf_(6 * blocks.size(), false) {
+  // conn -- interblock boundary conditions
+  // blocks -- procBlocks on this processor
+  // rank -- processor rank
+
+  for (auto ii = 0U; ii < conn.size(); ii++) {
+    const auto isFirst = conn[ii].RankFirst() == rank;
+    const auto isSecond = conn[ii].RankSecond() == rank;
+    if (isFirst == isSecond) {
+      // both sides of interblock are on this processor, or neither are
+      continue;
+    }
+
+    const auto localBlock = isFirst ? conn[ii].LocalBlockFirst()
+                                    : conn[ii].LocalBlockSecond();
+    const auto &blk = blocks[localBlock];
+    const auto surf = isFirst ? conn[ii].BoundaryFirst()
+                              : conn[ii].BoundarySecond();
+    haloSurf_[6 * localBlock + surf - 1] = true;
+    const auto partner = isFirst ? conn[ii].RankSecond() : conn[ii].RankFirst();
+
+    // location of cell in block arrays with ghost cells
+    const auto numGhosts = blk.NumGhosts();
+    const auto numI = blk.NumI() + 2 * numGhosts;
+    const auto numJ = blk.NumJ() + 2 * numGhosts;
+    const auto numK = blk.NumK() + 2 * numGhosts;
+    auto loc1D = [&](const int &i, const int &j, const int &k) {
+      return (i + numGhosts) + (j + numGhosts) * numI +
+          (k + numGhosts) * numI * numJ;
+    };
+
+    sliceSwap swap;
+    swap.neighbor_ = partner;
+    swap.numCells_ = numI * numJ * numK;
+
+    // cells to send; these make up the slice that the partner block inserts
+    auto is = 0, ie = 0, js = 0, je = 0, ks = 0, ke = 0;
+    if (isFirst) {
+      conn[ii].FirstSliceIndices(is, ie, js, je, ks, ke, numGhosts);
+    } else {
+      conn[ii].SecondSliceIndices(is, ie, js, je, ks, ke, numGhosts);
+    }
+    auto partnerAdj = conn[ii];
+    partnerAdj.AdjustForSlice(!isFirst, numGhosts);
+    ForEachInsert(partnerAdj, numGhosts,
+                  [&](const int &l1, const int &l2, const int &l3) {
+      const auto ind = GetSwapLoc(l1, l2, l3, 0, partnerAdj, numGhosts,
+                                  false);
+      swap.sendLoc_.push_back(loc1D(is + ind[0], js + ind[1], ks + ind[2]));
+    });
+
+    // ghost cells to receive into
+    auto localAdj = conn[ii];
+    localAdj.AdjustForSlice(isFirst, numGhosts);
+    ForEachInsert(localAdj, numGhosts,
+                  [&](const int &l1, const int &l2, const int &l3) {
+      const auto ind = GetSwapLoc(l1, l2, l3, numGhosts, localAdj, numGhosts,
+                                  true);
+      swap.recvLoc_.push_back(loc1D(ind[0], ind[1], ind[2]));
+    });
+
+    connSwap_[ii] = swaps_.size();
+    swaps_.push_back(std::move(swap));
+  }
+
+  // find all neighboring processors, and convert rank of neighbor for each
+  // swap to its index
+  for (const auto &swap : swaps_) {
+    neighbors_.push_back(swap.neighbor_);
+  }
+  std::sort(std::begin(neighbors_), std::end(neighbors_));
+  neighbors_.erase(std::unique(std::begin(neighbors_), std::end(neighbors_)),
+                   std::end(neighbors_));
+  for (auto &swap : swaps_) {
+    swap.neighbor_ = std::find(std::begin(neighbors_), std::end(neighbors_),
+                               swap.neighbor_) - std::begin(neighbors_);
+  }
+
+  sendBuffers_.resize(neighbors_.size());
+  recvBuffers_.resize(neighbors_.size());
+  sendCount_.assign(neighbors_.size(), 0);
+  recvCount_.assign(neighbors_.size(), 0);
+  requests_.reserve(2 * neighbors_.size());
+}
+
+// member function to get the surfaces of a block that receive ghost cells
+// from other processors
+void haloExchange::HaloSurfaces(const int &blk, bool (&haloSurf)[6]) const {
+  // blk -- index of block on this processor
+  // haloSurf -- flag for each surface (il, iu, jl, ju, kl, ku)
+
+  for (auto ss = 0; ss < 6; ss++) {
+    const auto ind = 6 * blk + ss;
+    haloSurf[ss] = ind < static_cast<int>(haloSurf_.size()) && haloSurf_[ind];
+  }
+}
+
+// member function to pack a field into the send buffer of its neighbor and
+// record where it should be unpacked to
+void haloExchange::AddField(const int &conn, double *data, const int &width,
+                            const int &cellStride, const int &varStride,
+                            const int &numCells) {
+  // conn -- index of interblock
+  // data -- start of array storage
+  // width -- number of doubles for each cell
+  // cellStride -- distance between consecutive cells
+  // varStride -- distance between variables of a cell
+  // numCells -- number of cells in array
+
+  if (connSwap_[conn] < 0) {
+    cerr << "ERROR: Error in haloExchange::AddField(). Interblock " << conn
+         << " is not swapped with another processor!" << endl;
+    exit(EXIT_FAILURE);
+  }
+  const auto &swap = swaps_[connSwap_[conn]];
+  if (numCells != swap.numCells_) {
+    cerr << "ERROR: Error in haloExchange::AddField(). Array with " << numCells
+         << " cells does not match block with " << swap.numCells_ << " cells!"
+         << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // grow buffers if necessary
+  const auto nn = swap.neighbor_;
+  auto &sendBuf = sendBuffers_[nn];
+  const auto sendSize = sendCount_[nn] + swap.sendLoc_.size() * width;
+  if (sendBuf.size() < sendSize) {
+    sendBuf.resize(sendSize);
+  }
+
+  // pack cells
+  auto pos = sendCount_[nn];
+  for (const auto &loc : swap.sendLoc_) {
+    for (auto vv = 0; vv < width; vv++) {
+      sendBuf[pos++] = data[loc * cellStride + vv * varStride];
+    }
+  }
+  sendCount_[nn] = pos;
+  recvCount_[nn] += swap.recvLoc_.size() * width;
+
+  fields_.push_back({connSwap_[conn], data, width, cellStride, varStride});
+}
+
+/* Member function to start the exchange. One message is sent to and received
+from each neighboring processor that has fields added for it.
+*/
+void haloExchange::Start() {
+  requests_.clear();
+  for (auto nn = 0U; nn < neighbors_.size(); nn++) {
+    if (recvCount_[nn] > 0) {
+      if (recvBuffers_[nn].size() < static_cast<size_t>(recvCount_[nn])) {
+        recvBuffers_[nn].resize(recvCount_[nn]);
+      }
+      requests_.emplace_back();
+      MPI_Irecv(recvBuffers_[nn].data(), recvCount_[nn], MPI_DOUBLE,
+                neighbors_[nn], 1, MPI_COMM_WORLD, &requests_.back());
+    }
+  }
+  for (auto nn = 0U; nn < neighbors_.size(); nn++) {
+    if (sendCount_[nn] > 0) {
+      requests_.emplace_back();
+      MPI_Isend(sendBuffers_[nn].data(), sendCount_[nn], MPI_DOUBLE,
+                neighbors_[nn], 1, MPI_COMM_WORLD, &requests_.back());
+    }
+  }
+}
+
+// member function to wait for all messages and then unpack the received
+// cells into the ghost cells of their arrays
+void haloExchange::Complete() {
+  MPI_Waitall(requests_.size(), requests_.data(), MPI_STATUSES_IGNORE);
+
+  // unpack fields in the order they were added; reuse receive counts as the
+  // position in each buffer
+  std::fill(std::begin(recvCount_), std::end(recvCount_), 0);
+  for (const auto &field : fields_) {
+    const auto &swap = swaps_[field.swap_];
+    const auto &recvBuf = recvBuffers_[swap.neighbor_];
+    auto &pos = recvCount_[swap.neighbor_];
+    for (const auto &loc : swap.recvLoc_) {
+      for (auto vv = 0; vv < field.width_; vv++) {
+        field.data_[loc * field.cellStride_ + vv * field.varStride_] =
+            recvBuf[pos++];
+      }
+    }
+  }
+
+  // exchange can be reused for another set of fields
+  std::fill(std::begin(sendCount_), std::end(sendCount_), 0);
+  std::fill(std::begin(recvCount_), std::end(recvCount_), 0);
+  fields_.clear();
+  requests_.clear();
+}
@@ -86,9 +86,19 @@ input::input(const string &name, const string &resName) : simName_(name),
   turbModel_ = "none";  // default turbulence model is none
   restartFrequency_ = 0;  // default to not write restarts
   iterationStart_ = 0;  // default to start from iteration zero
+  outputMode_ = "blocking";  // default to wait for files to be written
+  outputPrecision_ = "double";  // default to full precision output
+  restartCompression_ = "none";  // default to uncompressed restarts
+  extractFrequency_ = 0;  // default to write extractions with output
+  probeFrequency_ = 1;  // default to sample probes every iteration
+  probeBufferSize_ = 1000;  // default to write probes every 1000 samples
+  wallDistance_ = "kdtree";  // default to exact wall distance
+  wallDistanceOrder_ = "morton";  // default to search cells in curve order
+  geometryCache_ = "none";  // default to not cache geometry
 
   // default to primative variables
   outputVariables_ = {"density", "vel_x", "vel_y", "vel_z", "pressure"};
+  probeVariables_ = {"vel_x", "vel_y", "vel_z", "pressure"};
 
   // keywords in the input file that the parser is looking for to define
   // variables
@@ -107,6 +117,10 @@ input::input(const string &name, const string &resName) : simName_(name),
            "limiter",
            "outputFrequency",
            "restartFrequency",
+           "outputMode",
+           "outputPrecision",
+           "restartCompression",
+           "extractFrequency",
            "equationSet",
            "temperatureRef",
            "matrixSolver",
@@ -123,8 +137,18 @@ input::input(const string &name, const string &resName) : simName_(name),
            "turbulenceModel",
            "outputVariables",
            "initialConditions",
+           "extractions",
+           "probeLocations",
+           "probeVariables",
+           "probeFrequency",
+           "probeBufferSize",
+           "wallDistance",
+           "wallDistanceOrder",
+           "geometryCache",
            "boundaryStates",
            "boundaryConditions"};
+
+  this->ResolveOptions();
 }
 
 // function to print the time
@@ -303,6 +327,51 @@ void input::ReadInput(const int &rank) {
           if (rank == ROOTP) {
             cout << key << ": " << this->RestartFrequency() << endl;
           }
+        } else if (key == "outputMode") {
+          outputMode_ = tokens[1];
+          if (rank == ROOTP) {
+            cout << key << ": " << this->OutputMode() << endl;
+          }
+        } else if (key == "outputPrecision") {
+          outputPrecision_ = tokens[1];
+          if (rank == ROOTP) {
+            cout << key << ": " << this->OutputPrecision() << endl;
+          }
+        } else if (key == "restartCompression") {
+          restartCompression_ = tokens[1];
+          if (rank == ROOTP) {
+            cout << key << ": " << this->RestartCompression() << endl;
+          }
+        } else if (key == "extractFrequency") {
+          extractFrequency_ = stoi(tokens[1]);
+          if (rank == ROOTP) {
+            cout << key << ": " << this->ExtractFrequency() << endl;
+          }
+        } else if (key == "probeFrequency") {
+          probeFrequency_ = stoi(tokens[1]);
+          if (rank == ROOTP) {
+            cout << key << ": " << this->ProbeFrequency() << endl;
+          }
+        } else if (key == "probeBufferSize") {
+          probeBufferSize_ = stoi(tokens[1]);
+          if (rank == ROOTP) {
+            cout << key << ": " << this->ProbeBufferSize() << endl;
+          }
+        } else if (key == "wallDistance") {
+          wallDistance_ = tokens[1];
+          if (rank == ROOTP) {
+            cout << key << ": " << this->WallDistance() << endl;
+          }
+        } else if (key == "wallDistanceOrder") {
+          wallDistanceOrder_ = tokens[1];
+          if (rank == ROOTP) {
+            cout << key << ": " << this->WallDistanceOrder() << endl;
+          }
+        } else if (key == "geometryCache") {
+          geometryCache_ = tokens[1];
+          if (rank == ROOTP) {
+            cout << key << ": " << this->GeometryCache() << endl;
+          }
         } else if (key == "equationSet") {
           equationSet_ = tokens[1];
           if (rank == ROOTP) {
@@ -412,6 +481,37 @@ void input::ReadInput(const int &rank) {
               }
             }
           }
+        } else if (key == "extractions") {
+          extractions_ = ReadExtractionList(inFile, tokens[1]);
+          if (rank == ROOTP) {
+            cout << key << ": <";
+            for (auto ii = 0U; ii < extractions_.size(); ++ii) {
+              cout << extractions_[ii];
+              if (ii == extractions_.size() - 1) {
+                cout << ">" << endl;
+              } else {
+                cout << "," << endl << "              ";
+              }
+            }
+          }
+        } else if (key == "probeLocations") {
+          probeLocations_ = ReadVectorList(inFile, tokens[1]);
+          if (rank == ROOTP) {
+            cout << key << ": " << probeLocations_.size() << " probes" << endl;
+          }
+        } else if (key == "probeVariables") {
+          probeVariables_.clear();
+          for (auto &var : ReadStringList(inFile, tokens[1])) {
+            probeVariables_.insert(var);
+          }
+          if (rank == ROOTP) {
+            cout << key << ": <";
+            auto count = 0U;
+            for (auto &var : probeVariables_) {
+              cout << var << (++count < probeVariables_.size() ? ", " : ">");
+            }
+            cout << endl;
+          }
         } else if (key == "boundaryStates") {
           bcStates_ = ReadBCList(inFile, tokens[1]);
           if (rank == ROOTP) {
@@ -486,6 +586,9 @@ void input::ReadInput(const int &rank) {
   }
 
 
+  // resolve numerical methods from input strings
+  this->ResolveOptions();
+
   // input file sanity checks
   this->CheckNonlinearIterations();
   this->CheckOutputVariables();
@@ -531,44 +634,163 @@ int input::NumEquations() const {
   return numEqns;
 }
 
-// member function to determine of method is implicit or explicit
-bool input::IsImplicit() const {
-  if (timeIntegration_ == "implicitEuler" ||
-      timeIntegration_ == "crankNicholson" ||
-      timeIntegration_ == "bdf2") {
-    return true;
+/* Member function to resolve the strings describing the numerical methods to
+   enumerations. This is done once after the input file is read so that the
+   solver does not need to compare strings during the simulation.
+*/
+void input::ResolveOptions() {
+  // time integration
+  if (timeIntegration_ == "explicitEuler") {
+    timeIntMethod_ = timeIntegrationMethod::explicitEuler;
+  } else if (timeIntegration_ == "rk4") {
+    timeIntMethod_ = timeIntegrationMethod::rk4;
+  } else if (timeIntegration_ == "implicitEuler") {
+    timeIntMethod_ = timeIntegrationMethod::implicitEuler;
+  } else if (timeIntegration_ == "crankNicholson") {
+    timeIntMethod_ = timeIntegrationMethod::crankNicholson;
+  } else if (timeIntegration_ == "bdf2") {
+    timeIntMethod_ = timeIntegrationMethod::bdf2;
   } else {
-    return false;
+    cerr << "ERROR: Error in input::ResolveOptions(). Time integration scheme "
+         << timeIntegration_ << " is not recognized!" << endl;
+    exit(EXIT_FAILURE);
   }
-}
+  isImplicit_ = timeIntMethod_ == timeIntegrationMethod::implicitEuler ||
+      timeIntMethod_ == timeIntegrationMethod::crankNicholson ||
+      timeIntMethod_ == timeIntegrationMethod::bdf2;
 
-// member function to determine of method is vicous or inviscid
-bool input::IsViscous() const {
-  if (equationSet_ == "navierStokes" ||
-      equationSet_ == "rans") {
-    return true;
+  // face reconstruction
+  if (this->UsingConstantReconstruction()) {
+    reconMethod_ = reconstructionMethod::constant;
+  } else if (this->UsingMUSCLReconstruction()) {
+    reconMethod_ = reconstructionMethod::muscl;
+  } else if (faceReconstruction_ == "weno") {
+    reconMethod_ = reconstructionMethod::weno;
+  } else if (faceReconstruction_ == "wenoZ") {
+    reconMethod_ = reconstructionMethod::wenoZ;
   } else {
-    return false;
+    cerr << "ERROR: Error in input::ResolveOptions(). Face reconstruction "
+         << "method " << faceReconstruction_ << " is not recognized!" << endl;
+    exit(EXIT_FAILURE);
   }
-}
 
-// member function to determine of method is turbulent
-bool input::IsTurbulent() const {
-  if (equationSet_ == "rans") {
-    return true;
+  if (viscousFaceReconstruction_ == "central") {
+    viscReconMethod_ = viscousReconstructionMethod::central;
+  } else if (viscousFaceReconstruction_ == "centralFourth") {
+    viscReconMethod_ = viscousReconstructionMethod::centralFourth;
   } else {
-    return false;
+    cerr << "ERROR: Error in input::ResolveOptions(). Viscous face "
+         << "reconstruction method " << viscousFaceReconstruction_
+         << " is not recognized!" << endl;
+    exit(EXIT_FAILURE);
   }
-}
 
-// member function to determine if solution should use a block matrix
-bool input::IsBlockMatrix() const {
-  if (this->IsImplicit() && (matrixSolver_ == "bdplur" ||
-                             matrixSolver_ == "blusgs")) {
-    return true;
+  // limiter
+  if (limiter_ == "none") {
+    limiterMethod_ = limiterMethod::none;
+  } else if (limiter_ == "vanAlbada") {
+    limiterMethod_ = limiterMethod::vanAlbada;
+  } else if (limiter_ == "minmod") {
+    limiterMethod_ = limiterMethod::minmod;
   } else {
-    return false;
+    cerr << "ERROR: Error in input::ResolveOptions(). Limiter " << limiter_
+         << " is not recognized!" << endl;
+    exit(EXIT_FAILURE);
   }
+
+  // matrix solver
+  if (matrixSolver_ == "lusgs") {
+    matrixSolverMethod_ = matrixSolverMethod::lusgs;
+  } else if (matrixSolver_ == "blusgs") {
+    matrixSolverMethod_ = matrixSolverMethod::blusgs;
+  } else if (matrixSolver_ == "dplur") {
+    matrixSolverMethod_ = matrixSolverMethod::dplur;
+  } else if (matrixSolver_ == "bdplur") {
+    matrixSolverMethod_ = matrixSolverMethod::bdplur;
+  } else {
+    cerr << "ERROR: Error in input::ResolveOptions(). Matrix solver "
+         << matrixSolver_ << " is not recognized!" << endl;
+    exit(EXIT_FAILURE);
+  }
+  isBlockMatrix_ = isImplicit_ &&
+      (matrixSolverMethod_ == matrixSolverMethod::blusgs ||
+       matrixSolverMethod_ == matrixSolverMethod::bdplur);
+
+  // inviscid flux and flux jacobian
+  if (inviscidFlux_ == "roe") {
+    inviscidFluxMethod_ = inviscidFluxMethod::roe;
+  } else if (inviscidFlux_ == "rusanov") {
+    inviscidFluxMethod_ = inviscidFluxMethod::rusanov;
+  } else {
+    cerr << "ERROR: Error in input::ResolveOptions(). Inviscid flux "
+         << inviscidFlux_ << " is not recognized!" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  if (invFluxJac_ == "rusanov") {
+    invFluxJacMethod_ = fluxJacobianMethod::rusanov;
+  } else if (invFluxJac_ == "approximateRoe") {
+    invFluxJacMethod_ = fluxJacobianMethod::approximateRoe;
+  } else {
+    cerr << "ERROR: Error in input::ResolveOptions(). Inviscid flux jacobian "
+         << invFluxJac_ << " is not recognized!" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // output
+  if (outputMode_ == "blocking") {
+    outputMethod_ = outputMethod::blocking;
+  } else if (outputMode_ == "snapshot") {
+    outputMethod_ = outputMethod::snapshot;
+  } else {
+    cerr << "ERROR: Error in input::ResolveOptions(). Output mode "
+         << outputMode_ << " is not recognized!" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  if (outputPrecision_ == "double") {
+    isSinglePrecisionOutput_ = false;
+  } else if (outputPrecision_ == "single") {
+    isSinglePrecisionOutput_ = true;
+  } else {
+    cerr << "ERROR: Error in input::ResolveOptions(). Output precision "
+         << outputPrecision_ << " is not recognized!" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  if (wallDistance_ == "kdtree") {
+    wallDistanceMethod_ = wallDistanceMethod::kdtree;
+  } else if (wallDistance_ == "eikonal") {
+    wallDistanceMethod_ = wallDistanceMethod::eikonal;
+  } else {
+    cerr << "ERROR: Error in input::ResolveOptions(). Wall distance method "
+         << wallDistance_ << " is not recognized!" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  if (wallDistanceOrder_ == "morton") {
+    isMortonWallDistance_ = true;
+  } else if (wallDistanceOrder_ == "index") {
+    isMortonWallDistance_ = false;
+  } else {
+    cerr << "ERROR: Error in input::ResolveOptions(). Wall distance order "
+         << wallDistanceOrder_ << " is not recognized!" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  if (restartCompression_ == "none") {
+    restartCompressionMethod_ = compressionMethod::none;
+  } else if (restartCompression_ == "lossless") {
+    restartCompressionMethod_ = compressionMethod::lossless;
+  } else {
+    cerr << "ERROR: Error in input::ResolveOptions(). Restart compression "
+         << restartCompression_ << " is not recognized!" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // equation set
+  isViscous_ = equationSet_ == "navierStokes" || equationSet_ == "rans";
+  isTurbulent_ = equationSet_ == "rans";
 }
 
 string input::OrderOfAccuracy() const {
@@ -631,7 +853,26 @@ void input::CheckNonlinearIterations() {
 
 // member function to check validity of the requested output variables
 void input::CheckOutputVariables() {
-  for (auto var : outputVariables_) {
+  this->RemoveUnavailableVariables(outputVariables_);
+  this->RemoveUnavailableVariables(probeVariables_);
+  for (auto &ex : extractions_) {
+    auto vars = ex.Variables();
+    this->RemoveUnavailableVariables(vars);
+    if (vars.empty()) {
+      cerr << "ERROR: Extraction " << ex.Name() << " has no variables that "
+           << "are available for this simulation!" << endl;
+      exit(EXIT_FAILURE);
+    }
+    ex.SetVariables(vars);
+  }
+}
+
+// member function to remove variables that are not available for the
+// simulation from a set of output variables
+void input::RemoveUnavailableVariables(set<string> &vars) const {
+  // vars -- variables to check
+  const auto allVars = vars;
+  for (auto var : allVars) {
     if (!this->IsTurbulent()) {  // can't have turbulent varibles output
       if (var == "tke" || var == "sdr" || var == "viscosityRatio" ||
           var.find("tkeGrad_") != string::npos ||
@@ -639,7 +880,7 @@ void input::CheckOutputVariables() {
           var == "resid_sdr") {
         cerr << "WARNING: Variable " << var <<
             " is not available for laminar simulations." << endl;
-        outputVariables_.erase(var);
+        vars.erase(var);
       }
 
       if (!this->IsViscous()) {  // can't have viscous variables output
@@ -647,7 +888,7 @@ void input::CheckOutputVariables() {
             || var.find("tempGrad_") != string::npos) {
           cerr << "WARNING: Variable " << var <<
               " is not available for inviscid simulations." << endl;
-          outputVariables_.erase(var);
+          vars.erase(var);
         }
       }
     }
@@ -681,13 +922,6 @@ double input::ViscousCFLCoefficient() const {
   return coeff;
 }
 
-bool input::MatrixRequiresInitialization() const {
-  // initialize matrix if using DPLUR / BDPLUR, or if using LUSGS / BLUSGS with
-  // more than one sweep
-  return (matrixSolver_ == "dplur" || matrixSolver_ == "bdplur" ||
-          matrixSweeps_ > 1) ? true : false;
-}
-
 int input::NumberGhostLayers() const {
   if (this->UsingConstantReconstruction()) {
     return 1;
@@ -761,3 +761,36 @@ vector<string> ReadStringList(ifstream &inFile, string &str) {
   return strList;
 }
 
+
+// function to read list of vectors from input file
+vector<vector3d<double>> ReadVectorList(ifstream &inFile, string &str) {
+  vector<vector3d<double>> vecList;
+  auto openList = false;
+  do {
+    const auto start = openList ? 0 : str.find("<") + 1;
+    const auto end = str.find(">");
+    openList = (end == string::npos) ? true : false;
+
+    // read all vectors on current line; each vector must be on a single line
+    auto list = str.substr(start, openList ? string::npos : end - start);
+    auto vecStart = list.find("[");
+    while (vecStart != string::npos) {
+      const auto vecEnd = list.find("]", vecStart);
+      if (vecEnd == string::npos) {
+        cerr << "ERROR. Vector " << list.substr(vecStart) << " in list is "
+             << "not closed on the same line." << endl;
+        exit(EXIT_FAILURE);
+      }
+      vecList.push_back(ReadVector(list.substr(vecStart,
+                                               vecEnd - vecStart + 1)));
+      vecStart = list.find("[", vecEnd);
+    }
+
+    if (openList) {
+      getline(inFile, str);
+      str = Trim(str);
+    }
+  } while (openList);
+
+  return vecList;
+}
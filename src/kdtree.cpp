@@ -15,9 +15,12 @@
     along with this program.  If not, see <http://www.gnu.org/licenses/>. */
 
 #include <iostream>     // cout
-#include <algorithm>    // nth_element
+#include <algorithm>    // nth_element, partition, sort
 #include <limits>       // numeric_limits
 #include <vector>       // vector
+#include <numeric>      // iota
+#include <cstdint>      // uint64_t
+#include <cmath>        // sqrt
 #include "kdtree.hpp"
 
 using std::cout;
@@ -28,8 +31,10 @@ using std::cerr;
 kdtree::kdtree(const vector<vector3d<double>> &points) {
   // points -- all points to search through, stored in kdtree
 
-  nodes_ = points;
-  right_ = vector<int>(points.size(), -1);
+  nodes_.reserve(points.size());
+  for (const auto &pt : points) {
+    nodes_.push_back({pt, -1, -1});
+  }
   this->BuildKdtree(0, nodes_.size(), 0);
 }
 
@@ -48,12 +53,11 @@ int kdtree::FindMedian(const int &start, const int &end,
 
   // put median of data in position that median would be in a sorted vector
   // this is prefered to std::sort because it is O(n) instead of O(n log(n))
-  // use lambda function to compare vector3d based on given dimension
+  // use lambda function to compare nodes based on given dimension
   std::nth_element(nodes_.begin() + start, nodes_.begin() + medPos,
                    nodes_.begin() + end,
-                   [&dim] (const vector3d<double> &p1,
-                           const vector3d<double> &p2)
-                   {return p1[dim] < p2[dim];});
+                   [&dim] (const node &n1, const node &n2)
+                   {return n1.point_[dim] < n2.point_[dim];});
 
   // return index of median
   return medPos;
@@ -67,9 +71,24 @@ void kdtree::BuildKdtree(const int &start, const int &end,
   // depth -- depth of tree
 
   const auto numPts = end - start;
+  if (numPts == 0) {
+    return;
+  }
+
+  // find bounding box of branch; this is stored with the first node of the
+  // branch once the branch is reordered
+  box bounds = {nodes_[start].point_, nodes_[start].point_};
+  for (auto ii = start + 1; ii < end; ii++) {
+    for (auto dd = 0; dd < dim_; dd++) {
+      bounds.lower_[dd] = std::min(bounds.lower_[dd], nodes_[ii].point_[dd]);
+      bounds.upper_[dd] = std::max(bounds.upper_[dd], nodes_[ii].point_[dd]);
+    }
+  }
+  boxes_.push_back(bounds);
 
   // recursive base case - at leaf node
   if (numPts <= binSize_) {
+    nodes_[start].box_ = boxes_.size() - 1;
     return;
   }
 
@@ -81,7 +100,7 @@ void kdtree::BuildKdtree(const int &start, const int &end,
 
   // move median to first element
   std::swap(nodes_[start], nodes_[medInd]);
-  const auto median = nodes_[start][dim];
+  const auto median = nodes_[start].point_[dim];
 
   // put all elements less than or equal to the median in
   // top portion of vector, and all other elements in bottom
@@ -90,116 +109,149 @@ void kdtree::BuildKdtree(const int &start, const int &end,
   // start is at median, so use next index down
   const auto splitIndex = std::partition(nodes_.begin() + start + 1,
                                          nodes_.begin() + end,
-                                         [&median, &dim]
-                                         (const vector3d<double> &p1)
-                                         {return p1[dim] <= median;});
+                                         [&median, &dim] (const node &n1)
+                                         {return n1.point_[dim] <= median;});
 
   // record split index as index of right branch
   // std::partition returns iterator to 2nd partition which is right side
-  right_[start] = splitIndex - nodes_.begin();
+  // the node at start is never moved by the recursive calls, so the
+  // branch information stays with it
+  nodes_[start].right_ = splitIndex - nodes_.begin();
+  nodes_[start].box_ = boxes_.size() - 1;
 
   // recursively build left and right branches
-  this->BuildKdtree(start + 1, right_[start], depth + 1);  // left
-  this->BuildKdtree(right_[start], end, depth + 1);  // right
+  this->BuildKdtree(start + 1, nodes_[start].right_, depth + 1);  // left
+  this->BuildKdtree(nodes_[start].right_, end, depth + 1);  // right
 }
 
 /* Private member function to peform a nearest neighbor search.
 The algorithm works in the following way. First it determines which
 bin of the k-d tree the point to find the neighbor for would lie in
-through a series of recursive calls. Once it reaches the correct bin,
-it does a brute force linear search to find the closest point in 
-that bin. It updates the minimum distance and neighbor accordingly.
-As the recursive calls unwind up the stack, it checks to see if it is
-possible that a closer node lies on the other side of a branch split.
-This is done by realizing that a closer point must lie inside of a 
-sphere centered at point at which the nearest neighbor is being found,
-with a radius of the current minimum distance. If this sphere crosses
-over the splitting coordinate at a given tree node, then the subtree
-on that side must be recursively searched as well.
+by stepping down the tree. Once it reaches the correct bin, it does a
+brute force linear search to find the closest point in that bin. It
+updates the minimum distance and neighbor accordingly. At each split on
+the way down, the branch on the other side of the split is saved on a
+stack. The saved branches are taken off the stack in the reverse order.
+
+A closer node can only lie in a branch if the sphere centered at the
+point at which the nearest neighbor is being found, with a radius of the
+current minimum distance, enters the bounding box of the branch. Branches
+are skipped, and the search stops stepping down the tree, whenever the
+sphere does not enter the box. The boxes hold the points tightly, so this
+works well even when the point is far from all nodes, as is the case for
+cells far from a wall.
+
+The search only finds points that are closer than the minimum distance
+given to it, so a smaller starting value lets more of the tree be
+skipped. The index of the nearest node is returned, or -1 if no node is
+closer than the starting value.
  */
-void kdtree::NearestNeighbor(const int &start, const int &end,
-                             const int &depth,
-                             const vector3d<double> &pt,
-                             vector3d<double> &neighbor,
-                             double &minDist) const {
-  // start -- starting index in nodes_ to do search on
-  // end -- ending index in nodes_ to do search on
-  // depth -- depth of tree node that search is on
+int kdtree::NearestNeighbor(const vector3d<double> &pt,
+                            double &minDist) const {
   // pt -- point to find nearest neighbor of
-  // neighbor -- current best guess for nearest neighbor
   // minDist -- current minimum distance squared found
 
-  const auto numPts = end - start;
+  // branch of tree left to search, and distance squared to its box
+  struct branch {
+    int start_;
+    int end_;
+    int depth_;
+    double distSq_;
+  };
+  // one branch is saved for each split on the way down to a bin, so the
+  // depth of the tree (at most 32 for an int number of nodes) is the most
+  // branches that are ever saved
+  branch stack[64];
+  auto numBranches = 0;
+  if (this->Size() > 0) {
+    stack[numBranches++] = {0, this->Size(), 0, this->BoxDistSq(pt, 0)};
+  }
 
-  // recursive base case - at leaf node do linear search
-  if (numPts <= binSize_) {
-    for (auto ii = start; ii < end; ii++) {
-      auto testDistance = pt.DistSq(nodes_[ii]);
-      if (testDistance < minDist) {
-        minDist = testDistance;
-        neighbor = nodes_[ii];
-      }
+  auto neighbor = -1;
+  while (numBranches > 0) {
+    auto br = stack[--numBranches];
+    // if bounding sphere does not enter branch, skip it
+    if (br.distSq_ > minDist) {
+      continue;
     }
-    return;
-  }
 
-  // determine dimension of branch split
-  const auto dim = depth % dim_;
+    auto atBin = true;
+    while (br.end_ - br.start_ > binSize_) {
+      const auto &split = nodes_[br.start_];
 
-  // check to see if splitting node is closer than current closest
-  auto testDistance = pt.DistSq(nodes_[start]);
-  if (testDistance < minDist) {
-    minDist = testDistance;
-    neighbor = nodes_[start];
-  }
+      // check to see if splitting node is closer than current closest
+      auto testDistance = pt.DistSq(split.point_);
+      if (testDistance < minDist) {
+        minDist = testDistance;
+        neighbor = br.start_;
+      }
 
-  // determine if point is on left or right side of split
-  if (pt[dim] <= nodes_[start][dim]) {  // left side ---------------------
-    // point is on left side, so recursively search left side first
-    this->NearestNeighbor(start + 1, right_[start],
-                          depth + 1, pt, neighbor, minDist);
-
-    // if bounding sphere enters right partition, recursively
-    // search this side of tree
-    if (this->SphereInside(pt, minDist, nodes_[start], dim)) {
-      this->NearestNeighbor(right_[start], end,
-                            depth + 1, pt, neighbor, minDist);
+      // determine if point is on left or right side of split, search that
+      // side first and save the other side
+      const auto dim = br.depth_ % dim_;
+      auto other = br;
+      if (pt[dim] <= split.point_[dim]) {  // left side
+        other.start_ = split.right_;
+        br.end_ = split.right_;
+        br.start_++;
+      } else {  // right side
+        other.start_++;
+        other.end_ = split.right_;
+        br.start_ = split.right_;
+      }
+      br.depth_++;
+      other.depth_++;
+
+      if (other.end_ > other.start_) {
+        other.distSq_ = this->BoxDistSq(pt, other.start_);
+        if (other.distSq_ <= minDist) {
+          stack[numBranches++] = other;
+        }
+      }
+      if (br.end_ == br.start_ ||
+          this->BoxDistSq(pt, br.start_) > minDist) {
+        atBin = false;
+        break;
+      }
     }
 
-  } else {  // right side ------------------------------------------------
-    // point is on right side, so recursively search right side first
-    this->NearestNeighbor(right_[start], end,
-                          depth + 1, pt, neighbor, minDist);
-
-    // if bounding sphere enters left partition, recursively
-    // search this side of tree
-    if (this->SphereInside(pt, minDist, nodes_[start], dim)) {
-      this->NearestNeighbor(start + 1, right_[start],
-                            depth + 1, pt, neighbor, minDist);
+    // at leaf node do linear search
+    if (atBin) {
+      for (auto ii = br.start_; ii < br.end_; ii++) {
+        auto testDistance = pt.DistSq(nodes_[ii].point_);
+        if (testDistance < minDist) {
+          minDist = testDistance;
+          neighbor = ii;
+        }
+      }
     }
   }
+  return neighbor;
 }
 
-/* Private member function to determine if the bounding sphere crosses
-over the split at a given tree node. Since the splits are done at 
-constant x, y, or z values, only the coordinates in one direction 
-need to be compared to determine if the sphere crosses over.
+/* Private member function to find the distance squared from a point to the
+bounding box of the branch starting at a given node. The distance to the box
+in each direction is never more than the distance to any point in the box in
+that direction, and the terms are summed in the same order as
+vector3d::DistSq(), so with roundoff the result is still never more than the
+distance squared to any point in the box.
 */
-bool kdtree::SphereInside(const vector3d<double> &guess,
-                          const double &rSq,
-                          const vector3d<double> &split,
-                          const int &dim) const {
-  // guess -- current guess for nearest neighbor
-  // rSq -- current minimum distance squared
-  // split -- coordinates at splitting node
-  // dim -- dimension of split
-
-  auto dist2Split =  guess[dim] - split[dim];
-  dist2Split *= dist2Split;  // compare squared distances
-
-  // if the distance to the split is greater than the current min
-  // distance, the bounding sphere cannot cross the split
-  return (dist2Split > rSq) ? false : true;
+double kdtree::BoxDistSq(const vector3d<double> &pt, const int &start) const {
+  // pt -- point to find distance from
+  // start -- index of first node of branch
+
+  const auto &bounds = boxes_[nodes_[start].box_];
+  vector3d<double> offset;
+  for (auto dd = 0; dd < dim_; dd++) {
+    if (pt[dd] < bounds.lower_[dd]) {
+      offset[dd] = bounds.lower_[dd] - pt[dd];
+    } else if (pt[dd] > bounds.upper_[dd]) {
+      offset[dd] = pt[dd] - bounds.upper_[dd];
+    } else {
+      offset[dd] = 0.0;
+    }
+  }
+  return offset.MagSq();
 }
 
 // Public member functions
@@ -212,8 +264,133 @@ double kdtree::NearestNeighbor(const vector3d<double> &pt,
 
   // start with large initial guess
   auto minDist = std::numeric_limits<double>::max();
-  this->NearestNeighbor(0, nodes_.size(), 0, pt, neighbor, minDist);
+  const auto nearest = this->NearestNeighbor(pt, minDist);
+  if (nearest >= 0) {
+    neighbor = nodes_[nearest].point_;
+  }
 
   // return distance, not distance squared
   return sqrt(minDist);
 }
+
+/* Member function to find the distance to the nearest neighbor of each point
+in a batch. The points are divided among the threads in runs of batchSize_
+points. The nearest neighbor of a point can be no farther away than the
+distance to the nearest neighbor of the previous point plus the distance
+between the two points, so this is used to start the search of every point
+after the first in a run. The bound is enlarged slightly so that roundoff
+can never exclude the nearest neighbor, and if nothing is found within it
+(only possible when the bound is zero) the search is repeated from scratch.
+Because the search always finds the closest point within its bound, the
+distances are exactly those of separate searches, for any order of points
+and any number of threads.
+*/
+vector<double> kdtree::NearestDistances(
+    const vector<vector3d<double>> &pts) const {
+  // pts -- points to find distance to nearest neighbor for
+
+  vector<double> distances(pts.size());
+  const auto numPts = static_cast<int>(pts.size());
+  const auto numBatches = (numPts + batchSize_ - 1) / batchSize_;
+
+#pragma omp parallel for schedule(dynamic)
+  for (auto bb = 0; bb < numBatches; bb++) {
+    const auto start = bb * batchSize_;
+    const auto end = std::min(start + batchSize_, numPts);
+    for (auto ii = start; ii < end; ii++) {
+      auto minDist = std::numeric_limits<double>::max();
+      auto nearest = -1;
+      if (ii > start) {
+        const auto bound = distances[ii - 1] + pts[ii].Distance(pts[ii - 1]);
+        minDist = bound * bound * (1.0 + 1.0e-10);
+        nearest = this->NearestNeighbor(pts[ii], minDist);
+      }
+      if (nearest < 0) {
+        minDist = std::numeric_limits<double>::max();
+        this->NearestNeighbor(pts[ii], minDist);
+      }
+      // store distance, not distance squared
+      distances[ii] = sqrt(minDist);
+    }
+  }
+  return distances;
+}
+
+/* Member function to find the distance to the nearest neighbor of each point
+in a batch, where each point is only searched for neighbors closer than a
+given distance. If there are none, the maximum double is returned for that
+point. As above the bound is enlarged slightly for roundoff, so a neighbor
+just outside of it may also be found.
+*/
+vector<double> kdtree::NearestDistances(const vector<vector3d<double>> &pts,
+                                        const vector<double> &bounds) const {
+  // pts -- points to find distance to nearest neighbor for
+  // bounds -- distance to search within for each point
+
+  vector<double> distances(pts.size());
+  const auto numPts = static_cast<int>(pts.size());
+
+#pragma omp parallel for schedule(dynamic, 1024)
+  for (auto ii = 0; ii < numPts; ii++) {
+    auto minDist = bounds[ii] * bounds[ii] * (1.0 + 1.0e-10);
+    const auto nearest = this->NearestNeighbor(pts[ii], minDist);
+    // store distance, not distance squared
+    distances[ii] = (nearest < 0) ? std::numeric_limits<double>::max() :
+        sqrt(minDist);
+  }
+  return distances;
+}
+
+/* Function to order points along a Morton (z-order) space filling curve.
+The coordinates of each point are scaled to 21 bit integers over the
+bounding box of the points, and the bits of the three integers are
+interleaved to give the position of the point along the curve. Points that
+are close together along the curve are close together in space. The
+indices of the points in curve order are returned.
+*/
+vector<int> MortonOrder(const vector<vector3d<double>> &pts) {
+  // pts -- points to order
+
+  // find bounding box of points
+  vector3d<double> lo(std::numeric_limits<double>::max(),
+                      std::numeric_limits<double>::max(),
+                      std::numeric_limits<double>::max());
+  auto hi = lo * -1.0;
+  for (const auto &pt : pts) {
+    for (auto dd = 0; dd < 3; dd++) {
+      lo[dd] = std::min(lo[dd], pt[dd]);
+      hi[dd] = std::max(hi[dd], pt[dd]);
+    }
+  }
+
+  // spread lower 21 bits of integer so there are two zero bits between each
+  auto Spread = [] (uint64_t val) {
+    val &= 0x1fffff;
+    val = (val | val << 32) & 0x1f00000000ffff;
+    val = (val | val << 16) & 0x1f0000ff0000ff;
+    val = (val | val << 8) & 0x100f00f00f00f00f;
+    val = (val | val << 4) & 0x10c30c30c30c30c3;
+    val = (val | val << 2) & 0x1249249249249249;
+    return val;
+  };
+
+  const auto maxCoord = static_cast<double>((1 << 21) - 1);
+  vector<uint64_t> keys(pts.size(), 0);
+  for (auto ii = 0U; ii < pts.size(); ii++) {
+    for (auto dd = 0; dd < 3; dd++) {
+      const auto range = hi[dd] - lo[dd];
+      const auto scaled = (range > 0.0) ?
+          (pts[ii][dd] - lo[dd]) / range * maxCoord : 0.0;
+      keys[ii] |= Spread(static_cast<uint64_t>(scaled)) << dd;
+    }
+  }
+
+  // sort indices by key; ties are kept in their original order
+  vector<int> order(pts.size());
+  std::iota(std::begin(order), std::end(order), 0);
+  std::sort(std::begin(order), std::end(order),
+            [&keys] (const int &i1, const int &i2)
+            {return keys[i1] < keys[i2] ||
+                  (keys[i1] == keys[i2] && i1 < i2);});
+  return order;
+}
@@ -20,6 +20,10 @@
 #include <string>        // stl string
 #include <memory>        // unique_ptr
 
+#ifdef _OPENMP
+#include <omp.h>         // omp_get_max_threads
+#endif
+
 #ifdef __linux__
 #include <cfenv>         // exceptions
 #elif __APPLE__
@@ -42,6 +46,11 @@
 #include "kdtree.hpp"
 #include "fluxJacobian.hpp"
 #include "utility.hpp"
+#include "haloExchange.hpp"
+#include "parallelIO.hpp"
+#include "extraction.hpp"
+#include "probe.hpp"
+#include "geometryCache.hpp"
 
 using std::cout;
 using std::cerr;
@@ -53,10 +62,25 @@ int main(int argc, char *argv[]) {
   // of processors and rank of each processor
   auto numProcs = 1;
   auto rank = 0;
-  MPI_Init(&argc, &argv);
+  // only the main thread makes MPI calls; other threads work on blocks
+  int threadSupport = MPI_THREAD_SINGLE;
+  MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &threadSupport);
   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
 
+#ifdef _OPENMP
+  // threads call into code that may use MPI, so the MPI library must at least
+  // allow calls from the main thread while other threads are running
+  if (threadSupport < MPI_THREAD_FUNNELED) {
+    if (rank == ROOTP) {
+      cerr << "ERROR: MPI library does not support MPI_THREAD_FUNNELED, which "
+           << "is required to run with OpenMP threads." << endl;
+      cerr << "Provided thread support level is " << threadSupport << endl;
+    }
+    MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+  }
+#endif
+
   // Get MPI version
   auto version = 3;
   auto subversion = 0;
@@ -67,6 +91,10 @@ int main(int argc, char *argv[]) {
     cout << "Compiled on " << __DATE__ << " at " << __TIME__ << endl;
     cout << "Using MPI Version " << version << "." << subversion << endl;
     cout << "Using " << numProcs << " processors" << endl;
+#ifdef _OPENMP
+    cout << "Using " << omp_get_max_threads() << " threads per processor"
+         << endl;
+#endif
   }
   MPI_Barrier(MPI_COMM_WORLD);
 
@@ -99,6 +127,7 @@ int main(int argc, char *argv[]) {
   auto totalCells = 0.0;
   input inputVars(inputFile, restartFile);
   decomposition decomp;
+  blockLayout layout;
   auto numProcBlock = 0;
 
   // Parse input file
@@ -117,20 +146,19 @@ int main(int argc, char *argv[]) {
   // Get turbulence model
   const auto turb = inputVars.AssignTurbulenceModel();
 
-  vector<plot3dBlock> mesh;
   vector<interblock> connections;
-  vector<procBlock> stateBlocks;
-  vector<vector3d<double>> viscFaces;
+  vector<boundaryConditions> bcs;
   genArray residL2First(0.0);  // l2 norm residuals to normalize by
 
   if (rank == ROOTP) {
     cout << "Number of equations: " << inputVars.NumEquations() << endl << endl;
 
-    // Read grid
-    mesh = ReadP3dGrid(inputVars.GridName(), inputVars.LRef(), totalCells);
+    // Read grid header; coordinates are only read at patch corners
+    const plot3dGridFile gridFile(inputVars.GridName(), inputVars.LRef());
+    auto mesh = gridFile.Blocks(totalCells);
 
     // Get BCs for blocks
-    auto bcs = inputVars.AllBC();
+    bcs = inputVars.AllBC();
 
     // Decompose grid
     if (inputVars.DecompMethod() == "manual") {
@@ -146,36 +174,11 @@ int main(int argc, char *argv[]) {
     // Get interblock BCs
     connections = GetInterblockBCs(bcs, mesh, decomp);
 
-    // Initialize the whole mesh with ICs and assign ghost cells geometry
-    stateBlocks.resize(mesh.size());
-    for (auto ll = 0U; ll < mesh.size(); ll++) {
-      stateBlocks[ll] = procBlock(aRef, mesh[ll], decomp.ParentBlock(ll),
-                                  bcs[ll], ll, decomp.Rank(ll),
-                                  decomp.LocalPosition(ll), inputVars, eos,
-                                  suth);
-      stateBlocks[ll].AssignGhostCellsGeom();
-    }
-    // if restart, get data from restart file
-    if (inputVars.IsRestart()) {
-      ReadRestart(stateBlocks, restartFile, inputVars, eos, suth, turb,
-                  residL2First);
-    }
-
-    // Swap geometry for interblock BCs
-    for (auto &conn : connections) {
-      SwapGeomSlice(conn, stateBlocks[conn.BlockFirst()],
-                    stateBlocks[conn.BlockSecond()]);
-    }
-    // Get ghost cell edge data
-    for (auto &block : stateBlocks) {
-      block.AssignGhostCellsGeomEdge();
-    }
+    // Get location of each procBlock within its parent block
+    layout = blockLayout(mesh, decomp);
 
-    // Get face centers of faces with viscous wall BC
-    viscFaces = GetViscousFaceCenters(stateBlocks);
-
-    cout << "Solution Initialized" << endl << endl;
-    //---------------------------------------------------------------------
+    // grid coordinates are never read in full on ROOT; each processor reads
+    // the grid of its own procBlocks
   }
 
   // Set MPI datatypes
@@ -186,25 +189,90 @@ int main(int argc, char *argv[]) {
                   MPI_interblock, MPI_DOUBLE_5INT, MPI_vec3dMag,
                   MPI_uncoupledScalar, MPI_tensorDouble);
 
-  // Send number of procBlocks to all processors
-  SendNumProcBlocks(decomp.NumBlocksOnAllProc(), numProcBlock);
+  // Send decomposition, layout, BCs, and connections to all processors
+  decomp.BroadcastMPI();
+  layout.BroadcastMPI();
+  BroadcastBoundaryConditions(bcs);
+  SendConnections(connections, MPI_interblock);
+  numProcBlock = decomp.NumBlocksOnProc(rank);
+
+  // Geometry and wall distance are read from the cache if it matches this
+  // case
+  const geometryCache cache(inputVars, layout, bcs, connections);
+
+  vector<procBlock> localStateBlocks(numProcBlock);
+  if (cache.IsValid()) {
+    // Initialize procBlocks on this processor with ICs and assign geometry
+    // from cache
+    for (auto ll = 0; ll < decomp.Size(); ll++) {
+      if (decomp.Rank(ll) == rank) {
+        localStateBlocks[decomp.LocalPosition(ll)] =
+            procBlock(aRef, layout.Dims(ll), decomp.ParentBlock(ll), bcs[ll],
+                      ll, rank, decomp.LocalPosition(ll), inputVars, eos,
+                      suth);
+      }
+    }
+    cache.Read(localStateBlocks, connections);
+  } else {
+    // Read grid of procBlocks on this processor
+    vector<int> localParents;
+    vector<vector3d<int>> localStarts, localPts;
+    for (auto ll = 0; ll < decomp.Size(); ll++) {
+      if (decomp.Rank(ll) == rank) {
+        localParents.push_back(layout.Parent(ll));
+        localStarts.push_back(layout.Start(ll));
+        // number of points is 1 more than number of cells
+        localPts.push_back(layout.Dims(ll) + 1);
+      }
+    }
+    const auto localMesh = ReadP3dGridRanges(inputVars.GridName(),
+                                             inputVars.LRef(), localParents,
+                                             localStarts, localPts);
+
+    // Initialize procBlocks on this processor with ICs and assign ghost cells
+    // geometry
+    for (auto ll = 0, mm = 0; ll < decomp.Size(); ll++) {
+      if (decomp.Rank(ll) == rank) {
+        auto &block = localStateBlocks[decomp.LocalPosition(ll)];
+        block = procBlock(aRef, localMesh[mm++], decomp.ParentBlock(ll),
+                          bcs[ll], ll, rank, decomp.LocalPosition(ll),
+                          inputVars, eos, suth);
+        block.AssignGhostCellsGeom();
+      }
+    }
 
-  // Send procBlocks to appropriate processor
-  auto localStateBlocks = SendProcBlocks(stateBlocks, rank, numProcBlock,
-                                         MPI_cellData, MPI_vec3d, MPI_vec3dMag);
+    // Swap geometry for interblock BCs
+    SwapGeometry(connections, localStateBlocks, rank, MPI_vec3d,
+                 MPI_vec3dMag);
+
+    // Get ghost cell edge data
+    for (auto &block : localStateBlocks) {
+      block.AssignGhostCellsGeomEdge();
+    }
+  }
+
+  // if restart, each processor reads its own blocks from the restart file
+  if (inputVars.IsRestart()) {
+    ReadRestart(localStateBlocks, layout, restartFile, inputVars, eos, suth,
+                turb, residL2First);
+  }
 
   // Update auxillary variables (temperature, viscosity, etc), cell widths
   for (auto ll = 0U; ll < localStateBlocks.size(); ll++) {
     localStateBlocks[ll].UpdateAuxillaryVariables(eos, suth, false);
     localStateBlocks[ll].UpdateUnlimTurbEddyVisc(turb, false);
-    localStateBlocks[ll].CalcCellWidths();
+    if (!cache.IsValid()) {
+      localStateBlocks[ll].CalcCellWidths();
+    }
   }
 
-  // Send connections to all processors
-  SendConnections(connections, MPI_interblock);
+  if (rank == ROOTP) {
+    cout << "Solution Initialized" << endl << endl;
+  }
 
-  // Broadcast viscous face centers to all processors
-  BroadcastViscFaces(MPI_vec3d, viscFaces);
+  // Find cells to swap across interblocks with other processors; this is
+  // reused for every exchange
+  haloExchange exchange(connections, localStateBlocks, rank);
 
   // Create operation
   MPI_Op MPI_MAX_LINF;
@@ -214,33 +282,66 @@ int main(int argc, char *argv[]) {
   //-----------------------------------------------------------------------
   // wall distance calculation
 
-  const auto wallStart = std::chrono::high_resolution_clock::now();
+  if (cache.IsValid()) {
+    if (rank == ROOTP) {
+      cout << "Geometry and wall distance read from cache "
+           << cache.FileName() << endl << endl;
+    }
+  } else {
+    const auto wallStart = std::chrono::high_resolution_clock::now();
 
-  if (rank == ROOTP) {
-    cout << "Starting wall distance calculation..." << endl;
-    cout << "Building k-d tree..." << endl;
-  }
+    if (rank == ROOTP) {
+      cout << "Starting wall distance calculation..." << endl;
+    }
 
-  // Construct k-d tree for wall distance calculation
-  kdtree tree(viscFaces);
+    if (inputVars.WallDistanceMethod() == wallDistanceMethod::eikonal) {
+      const auto numCycles = CalcWallDistanceEikonal(localStateBlocks,
+                                                     connections, rank,
+                                                     exchange);
+      if (rank == ROOTP) {
+        cout << "Wall points converged after " << numCycles << " sweep cycles"
+             << endl;
+      }
+    } else {
+      if (rank == ROOTP) {
+        cout << "Building k-d tree..." << endl;
+      }
 
-  if (rank == ROOTP) {
-    const auto kdEnd = std::chrono::high_resolution_clock::now();
-    const std::chrono::duration<double> kdDuration = kdEnd - wallStart;
-    cout << "K-d tree complete after " << kdDuration.count() << " seconds"
-         << endl;
-  }
+      // Get face centers of faces with viscous wall BC, and divide them evenly
+      // among processors
+      auto viscFaces = GetViscousFaceCenters(localStateBlocks);
+      PartitionViscFaces(MPI_vec3d, viscFaces);
 
-  if (tree.Size() > 0) {
-    CalcWallDistance(localStateBlocks, tree);
-  }
+      // Construct k-d tree of viscous faces on this processor for wall distance
+      // calculation
+      kdtree tree(viscFaces);
 
-  MPI_Barrier(MPI_COMM_WORLD);
-  if (rank == ROOTP) {
-    const auto wallEnd = std::chrono::high_resolution_clock::now();
-    const std::chrono::duration<double> wallDuration = wallEnd - wallStart;
-    cout << "Wall distance calculation finished after " << wallDuration.count()
-         << " seconds" << endl << endl;
+      if (rank == ROOTP) {
+        const auto kdEnd = std::chrono::high_resolution_clock::now();
+        const std::chrono::duration<double> kdDuration = kdEnd - wallStart;
+        cout << "K-d tree complete after " << kdDuration.count() << " seconds"
+             << endl;
+      }
+
+      CalcWallDistance(localStateBlocks, tree, inputVars);
+    }
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    if (rank == ROOTP) {
+      const auto wallEnd = std::chrono::high_resolution_clock::now();
+      const std::chrono::duration<double> wallDuration = wallEnd - wallStart;
+      cout << "Wall distance calculation finished after "
+           << wallDuration.count() << " seconds" << endl << endl;
+    }
+
+    // store geometry and wall distance for later runs
+    if (cache.IsEnabled()) {
+      cache.Write(localStateBlocks, connections);
+      if (rank == ROOTP) {
+        cout << "Geometry and wall distance written to cache "
+             << cache.FileName() << endl << endl;
+      }
+    }
   }
 
   //-----------------------------------------------------------------------
@@ -250,10 +351,6 @@ int main(int argc, char *argv[]) {
     ResizeArrays(localStateBlocks, inputVars, mainDiagonal);
   }
 
-  // Send/recv solutions - necessary to get wall distances
-  GetProcBlocks(stateBlocks, localStateBlocks, rank, MPI_cellData,
-                MPI_uncoupledScalar, MPI_vec3d, MPI_tensorDouble);
-
   ofstream resFile;
   if (rank == ROOTP) {
     // Open residual file
@@ -266,16 +363,28 @@ int main(int argc, char *argv[]) {
       cerr << "ERROR: Could not open residual file!" << endl;
       exit(EXIT_FAILURE);
     }
+  }
+
+  // writer for grid, function, and restart files
+  outputWriter writer(inputVars.OutputMethod());
 
-    // Write out cell centers grid file
-    WriteCellCenter(inputVars.GridName(), stateBlocks, decomp, inputVars.LRef());
+  // Write out cell centers grid file
+  WriteCellCenter(localStateBlocks, layout, inputVars, writer);
+  WriteExtractionGrids(localStateBlocks, layout, inputVars, writer);
 
-    // Write out initial results
-    WriteFun(stateBlocks, eos, suth, inputVars.IterationStart(), decomp,
-             inputVars, turb);
+  // Write out initial results
+  WriteFun(localStateBlocks, layout, eos, suth, inputVars.IterationStart(),
+           inputVars, turb, writer);
+  WriteExtractions(localStateBlocks, layout, eos, suth,
+                   inputVars.IterationStart(), inputVars, writer);
+  if (rank == ROOTP) {
     WriteMeta(inputVars, inputVars.IterationStart());
+    WriteExtractionMeta(inputVars, inputVars.IterationStart());
   }
 
+  // Locate probes; samples are buffered and written in large appends
+  probeSeries probes(localStateBlocks, inputVars, eos, suth);
+
   // ----------------------------------------------------------------------
   // ----------------------- Start Main Loop ------------------------------
   // ----------------------------------------------------------------------
@@ -287,7 +396,8 @@ int main(int argc, char *argv[]) {
     inputVars.CalcCFL(nn);
 
     // Store time-n solution, for time integration methods that require it
-    if (inputVars.IsImplicit() || inputVars.TimeIntegration() == "rk4") {
+    if (inputVars.IsImplicit() ||
+        inputVars.TimeIntegrationMethod() == timeIntegrationMethod::rk4) {
       AssignSolToTimeN(localStateBlocks, eos);
       if (!inputVars.IsRestart() && nn == 0) {
         AssignSolToTimeNm1(localStateBlocks);
@@ -298,11 +408,11 @@ int main(int argc, char *argv[]) {
     for (auto mm = 0; mm < inputVars.NonlinearIterations(); mm++) {
       // Get boundary conditions for all blocks
       GetBoundaryConditions(localStateBlocks, inputVars, eos, suth, turb,
-                            connections, rank, MPI_cellData);
+                            connections, rank, exchange);
 
       // Calculate residual (RHS)
       CalcResidual(localStateBlocks, mainDiagonal, suth, eos, inputVars,
-                   turb, connections, rank, MPI_tensorDouble, MPI_vec3d);
+                   turb, connections, rank, exchange);
 
       // Calculate time step
       CalcTimeStep(localStateBlocks, inputVars, aRef);
@@ -315,7 +425,7 @@ int main(int argc, char *argv[]) {
         matrixResid = ImplicitUpdate(localStateBlocks, mainDiagonal,
                                      inputVars, eos, aRef, suth, turb, mm,
                                      residL2, residLinf, connections, rank,
-                                     MPI_cellData);
+                                     exchange);
       } else {  // explicit time integration
         ExplicitUpdate(localStateBlocks, inputVars, eos, aRef, suth, turb, mm,
                        residL2, residLinf);
@@ -348,30 +458,64 @@ int main(int argc, char *argv[]) {
       }
     }  // loop for nonlinear iterations ---------------------------------------
 
-    // write out function file
-    if (inputVars.WriteOutput(nn) || inputVars.WriteRestart(nn)) {
-      // Send/recv solutions
-      GetProcBlocks(stateBlocks, localStateBlocks, rank, MPI_cellData,
-                    MPI_uncoupledScalar, MPI_vec3d, MPI_tensorDouble);
+    // record probes every sample, but only write them when buffer is full or
+    // the solution is saved for restart
+    if (inputVars.SampleProbes(nn)) {
+      probes.Sample(localStateBlocks, nn + inputVars.IterationStart() + 1);
+    }
+    if (inputVars.WriteRestart(nn)) {
+      probes.Flush();
+    }
+
+    // finish writing previous files before staging new ones, so that only one
+    // set of files is held in memory at a time
+    if (inputVars.WriteOutput(nn) || inputVars.WriteRestart(nn) ||
+        inputVars.WriteExtraction(nn)) {
+      writer.Wait();
+    } else {
+      writer.Progress();
+    }
 
-      if (rank == ROOTP && inputVars.WriteOutput(nn)) {
+    // write out function file
+    // all processors write their own blocks
+    if (inputVars.WriteOutput(nn)) {
+      if (rank == ROOTP) {
         cout << "writing out function file at iteration "
              << nn + inputVars.IterationStart()<< endl;
-        // Write out function file
-        WriteFun(stateBlocks, eos, suth, (nn + inputVars.IterationStart() + 1),
-                 decomp, inputVars, turb);
+      }
+      // Write out function file
+      WriteFun(localStateBlocks, layout, eos, suth,
+               (nn + inputVars.IterationStart() + 1), inputVars, turb, writer);
+      if (rank == ROOTP) {
         WriteMeta(inputVars, (nn + inputVars.IterationStart() + 1));
       }
-      if (rank == ROOTP && inputVars.WriteRestart(nn)) {
+    }
+    // write out extractions
+    // all processors write their own part of each extraction
+    if (inputVars.WriteExtraction(nn)) {
+      WriteExtractions(localStateBlocks, layout, eos, suth,
+                       (nn + inputVars.IterationStart() + 1), inputVars,
+                       writer);
+      if (rank == ROOTP) {
+        WriteExtractionMeta(inputVars, (nn + inputVars.IterationStart() + 1));
+      }
+    }
+    if (inputVars.WriteRestart(nn)) {
+      if (rank == ROOTP) {
         cout << "writing out restart file at iteration "
              << nn + inputVars.IterationStart()<< endl;
-        // Write out restart file
-        WriteRestart(stateBlocks, eos, suth, (nn + inputVars.IterationStart() + 1),
-                     decomp, inputVars, residL2First);
       }
+      // Write out restart file
+      WriteRestart(localStateBlocks, layout, eos, suth,
+                   (nn + inputVars.IterationStart() + 1), inputVars,
+                   residL2First, writer);
     }
   }  // loop for time step -----------------------------------------------------
 
+  // finish writing any files still being written
+  probes.Flush();
+  writer.Wait();
+
   if (rank == ROOTP) {
     // close residual file
     resFile.close();
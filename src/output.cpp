@@ -17,10 +17,13 @@
 #include <iostream>
 #include <iomanip>
 #include <fstream>
+#include <sstream>
 #include <vector>
 #include <string>
-#include <utility>  // pair
 #include <cmath>
+#include <cstdint>  // int64_t
+#include <functional>  // function
+#include <algorithm>   // fill
 #include "output.hpp"
 #include "turbulence.hpp"
 #include "vector3d.hpp"  // vector3d
@@ -35,6 +38,8 @@
 #include "boundaryConditions.hpp"  // decomposition
 #include "resid.hpp"               // resid
 #include "genArray.hpp"            // genArray
+#include "parallelIO.hpp"          // blockLayout
+#include "compression.hpp"         // CompressDoubles
 
 using std::cout;
 using std::endl;
@@ -43,284 +48,583 @@ using std::vector;
 using std::string;
 using std::ios;
 using std::ofstream;
+using std::ostringstream;
 using std::to_string;
 using std::max;
-using std::pair;
 using std::setw;
 using std::setprecision;
 using std::unique_ptr;
 
 //-----------------------------------------------------------------------
 // function declarations
+// function to write a visualization file in the precision chosen in the input
+// file; single precision values are rounded from the staged doubles
+void WriteVisualization(const string &writeName, const string &header,
+                        const MPI_Offset &fileSize, vector<fileRun> &runs,
+                        vector<double> &buffer, const input &inp,
+                        outputWriter &writer) {
+  // writeName -- name of file to write
+  // header -- bytes at start of file
+  // fileSize -- total size of file in bytes
+  // runs -- location of data in file and buffer
+  // buffer -- staged data to write
+  // inp -- input variables
+  // writer -- writer for output files
+
+  if (inp.IsSinglePrecisionOutput()) {
+    vector<float> singleBuffer(std::begin(buffer), std::end(buffer));
+    buffer.clear();
+    buffer.shrink_to_fit();
+    writer.Write(writeName, header, fileSize, runs, singleBuffer);
+  } else {
+    writer.Write(writeName, header, fileSize, runs, buffer);
+  }
+}
+
 // function to write out cell centers of grid in plot3d format
-void WriteCellCenter(const string &gridName, const vector<procBlock> &vars,
-                     const decomposition &decomp, const double &LRef) {
-  // recombine procblocks into original configuration
-  auto recombVars = Recombine(vars, decomp);
+/* The file is written in the layout of the parent blocks. Each processor
+writes the cell centers of its own procBlocks.
+*/
+void WriteCellCenter(const vector<procBlock> &vars, const blockLayout &layout,
+                     const input &inp, outputWriter &writer) {
+  // vars -- procBlocks on this processor
+  // layout -- location of procBlocks within parent blocks
+  // inp -- input variables
+  // writer -- writer for output files
 
-  // open binary output file
   const string fEnd = "_center";
   const string fPostfix = ".xyz";
-  const auto writeName = gridName + fEnd + fPostfix;
-  ofstream outFile(writeName, ios::out | ios::binary);
-
-  // check to see if file opened correctly
-  if (outFile.fail()) {
-    cerr << "ERROR: Grid file " << writeName << " did not open correctly!!!"
-         << endl;
-    exit(EXIT_FAILURE);
-  }
-
-  WriteBlockDims(outFile, recombVars);
-
-  // write out x, y, z coordinates of cell centers
-  for (auto ll = 0U; ll < recombVars.size(); ll++) {  // loop over all blocks
+  const auto writeName = inp.GridName() + fEnd + fPostfix;
+
+  ostringstream header;
+  WriteBlockDims(header, layout);
+  const auto dataStart = static_cast<MPI_Offset>(header.str().size());
+  const MPI_Offset varSize =
+      inp.IsSinglePrecisionOutput() ? sizeof(float) : sizeof(double);
+
+  // write out x, y, z coordinates of cell centers; for a given block, first
+  // write out all x coordinates, then all y coordinates, then all z
+  // coordinates
+  vector<fileRun> runs;
+  vector<double> buffer;
+  for (const auto &blk : vars) {  // loop over all blocks
+    const auto parent = layout.Parent(blk.GlobalPos());
+    const auto parentStart = dataStart +
+        layout.CellsBefore(parent) * 3 * varSize;
     for (auto nn = 0; nn < 3; nn++) {  // loop over dimensions (3)
-      for (auto kk = recombVars[ll].StartK(); kk < recombVars[ll].EndK();
-           kk++) {
-        for (auto jj = recombVars[ll].StartJ(); jj < recombVars[ll].EndJ();
-             jj++) {
-          for (auto ii = recombVars[ll].StartI(); ii < recombVars[ll].EndI();
-               ii++) {
+      for (auto kk = blk.StartK(); kk < blk.EndK(); kk++) {
+        for (auto jj = blk.StartJ(); jj < blk.EndJ(); jj++) {
+          const auto cell = nn * layout.ParentCells(parent) +
+              layout.ParentIndex(blk.GlobalPos(), blk.StartI(), jj, kk);
+          runs.push_back({parentStart + cell * varSize,
+                          static_cast<long long>(buffer.size()), blk.NumI()});
+          for (auto ii = blk.StartI(); ii < blk.EndI(); ii++) {
             // get the cell center coordinates (dimensionalized)
-            auto dumVec = recombVars[ll].Center(ii, jj, kk) * LRef;
-
-            // for a given block, first write out all x coordinates, then all y
-            // coordinates, then all z coordinates
-            auto dumDouble = dumVec[nn];
-            // write to file
-            outFile.write(reinterpret_cast<char *>(&dumDouble),
-                          sizeof(dumDouble));
+            buffer.push_back(blk.Center(ii, jj, kk)[nn] * inp.LRef());
           }
         }
       }
     }
   }
 
-  // close output file
-  outFile.close();
+  const auto fileSize = dataStart + layout.TotalCells() * 3 * varSize;
+  WriteVisualization(writeName, header.str(), fileSize, runs, buffer, inp,
+                     writer);
+}
+
+//----------------------------------------------------------------------
+// function to make a kernel that evaluates a variable at every cell of a range
+// of a block, storing the values in the order they are written to file
+template <typename T>
+outputKernel CellKernel(const T &value) {
+  // value -- function returning value of variable at a cell
+  return [value](const procBlock &blk, const vector3d<int> &lo,
+                 const vector3d<int> &hi, double *out) {
+    for (auto kk = lo[2]; kk < hi[2]; kk++) {
+      for (auto jj = lo[1]; jj < hi[1]; jj++) {
+        for (auto ii = lo[0]; ii < hi[0]; ii++) {
+          *out++ = value(blk, ii, jj, kk);
+        }
+      }
+    }
+  };
+}
+
+// function to make a kernel that stores a value that is constant over a block
+template <typename T>
+outputKernel BlockKernel(const T &value) {
+  // value -- function returning value of variable for a block
+  return [value](const procBlock &blk, const vector3d<int> &lo,
+                 const vector3d<int> &hi, double *out) {
+    const auto numCells = (hi[0] - lo[0]) * (hi[1] - lo[1]) * (hi[2] - lo[2]);
+    std::fill(out, out + numCells, value(blk));
+  };
+}
+
+/* Function to resolve output variables into kernels. This is done once for
+each function file, so the variable names are not compared for each cell. The
+kernels are in the same order as the given variables, and each one stores its
+variable (in dimensional form) for every cell of a range of a block.
+*/
+vector<outputKernel> OutputKernels(const set<string> &vars, const input &inp,
+                                   const idealGas &eqnState,
+                                   const sutherland &suth) {
+  // vars -- variables to output
+  // inp -- input variables
+  // eqnState -- equation of state
+  // suth -- sutherland's law for viscosity
+
+  // define reference values
+  const auto refSoS = inp.ARef(eqnState);
+  const auto rRef = inp.RRef();
+  const auto lRef = inp.LRef();
+  const auto tRef = inp.TRef();
+  const auto muRef = suth.MuRef();
+  const auto &eos = eqnState;
+
+  // scaling for variables
+  const auto pScale = rRef * refSoS * refSoS;
+  const auto dtScale = refSoS * lRef;
+  const auto tkeScale = refSoS * refSoS;
+  const auto sdrScale = refSoS * refSoS * rRef / muRef;
+  const auto velGradScale = refSoS / lRef;
+  const auto tempGradScale = tRef / lRef;
+  const auto tkeGradScale = refSoS * refSoS / lRef;
+  const auto sdrGradScale = refSoS * refSoS * rRef / (muRef * lRef);
+  const auto massResidScale = rRef * refSoS * lRef * lRef;
+  const auto momResidScale = rRef * refSoS * refSoS * lRef * lRef;
+  const auto engResidScale = rRef * pow(refSoS, 3.0) * lRef * lRef;
+  const auto sdrResidScale =
+      rRef * rRef * pow(refSoS, 4.0) * lRef * lRef / muRef;
+  const auto pRef = inp.PRef();
+  const auto qRef = 0.5 * rRef * inp.VelRef().MagSq();
+
+  vector<outputKernel> kernels;
+  for (auto &var : vars) {
+    if (var == "density") {
+      kernels.push_back(CellKernel([=](const procBlock &blk, const int &ii,
+                                       const int &jj, const int &kk) {
+        return blk.State(ii, jj, kk).Rho() * rRef;
+      }));
+    } else if (var == "vel_x") {
+      kernels.push_back(CellKernel([=](const procBlock &blk, const int &ii,
+                                       const int &jj, const int &kk) {
+        return blk.State(ii, jj, kk).U() * refSoS;
+      }));
+    } else if (var == "vel_y") {
+      kernels.push_back(CellKernel([=](const procBlock &blk, const int &ii,
+                                       const int &jj, const int &kk) {
+        return blk.State(ii, jj, kk).V() * refSoS;
+      }));
+    } else if (var == "vel_z") {
+      kernels.push_back(CellKernel([=](const procBlock &blk, const int &ii,
+                                       const int &jj, const int &kk) {
+        return blk.State(ii, jj, kk).W() * refSoS;
+      }));
+    } else if (var == "pressure") {
+      kernels.push_back(CellKernel([=](const procBlock &blk, const int &ii,
+                                       const int &jj, const int &kk) {
+        return blk.State(ii, jj, kk).P() * pScale;
+      }));
+    } else if (var == "pressureCoefficient") {
+      kernels.push_back(CellKernel([=](const procBlock &blk, const int &ii,
+                                       const int &jj, const int &kk) {
+        return (blk.State(ii, jj, kk).P() * pScale - pRef) / qRef;
+      }));
+    } else if (var == "mach") {
+      kernels.push_back(CellKernel([&eos](const procBlock &blk, const int &ii,
+                                          const int &jj, const int &kk) {
+        const auto state = blk.State(ii, jj, kk);
+        return state.Velocity().Mag() / state.SoS(eos);
+      }));
+    } else if (var == "sos") {
+      kernels.push_back(CellKernel([&eos, refSoS](
+          const procBlock &blk, const int &ii, const int &jj, const int &kk) {
+        return blk.State(ii, jj, kk).SoS(eos) * refSoS;
+      }));
+    } else if (var == "dt") {
+      kernels.push_back(CellKernel([=](const procBlock &blk, const int &ii,
+                                       const int &jj, const int &kk) {
+        return blk.Dt(ii, jj, kk) / dtScale;
+      }));
+    } else if (var == "temperature") {
+      kernels.push_back(CellKernel([=](const procBlock &blk, const int &ii,
+                                       const int &jj, const int &kk) {
+        return blk.Temperature(ii, jj, kk) * tRef;
+      }));
+    } else if (var == "rank") {
+      kernels.push_back(BlockKernel([](const procBlock &blk) {
+        return static_cast<double>(blk.Rank());
+      }));
+    } else if (var == "globalPosition") {
+      kernels.push_back(BlockKernel([](const procBlock &blk) {
+        return static_cast<double>(blk.GlobalPos());
+      }));
+    } else if (var == "viscosityRatio") {
+      kernels.push_back(CellKernel([](const procBlock &blk, const int &ii,
+                                      const int &jj, const int &kk) {
+        return blk.IsTurbulent() ?
+            blk.EddyViscosity(ii, jj, kk) / blk.Viscosity(ii, jj, kk) : 0.0;
+      }));
+    } else if (var == "tke") {
+      kernels.push_back(CellKernel([=](const procBlock &blk, const int &ii,
+                                       const int &jj, const int &kk) {
+        return blk.State(ii, jj, kk).Tke() * tkeScale;
+      }));
+    } else if (var == "sdr") {
+      kernels.push_back(CellKernel([=](const procBlock &blk, const int &ii,
+                                       const int &jj, const int &kk) {
+        return blk.State(ii, jj, kk).Omega() * sdrScale;
+      }));
+    } else if (var == "wallDistance") {
+      kernels.push_back(CellKernel([=](const procBlock &blk, const int &ii,
+                                       const int &jj, const int &kk) {
+        return blk.WallDist(ii, jj, kk) * lRef;
+      }));
+    } else if (var == "velGrad_ux") {
+      kernels.push_back(CellKernel([=](const procBlock &blk, const int &ii,
+                                       const int &jj, const int &kk) {
+        return blk.VelGrad(ii, jj, kk).XX() * velGradScale;
+      }));
+    } else if (var == "velGrad_vx") {
+      kernels.push_back(CellKernel([=](const procBlock &blk, const int &ii,
+                                       const int &jj, const int &kk) {
+        return blk.VelGrad(ii, jj, kk).XY() * velGradScale;
+      }));
+    } else if (var == "velGrad_wx") {
+      kernels.push_back(CellKernel([=](const procBlock &blk, const int &ii,
+                                       const int &jj, const int &kk) {
+        return blk.VelGrad(ii, jj, kk).XZ() * velGradScale;
+      }));
+    } else if (var == "velGrad_uy") {
+      kernels.push_back(CellKernel([=](const procBlock &blk, const int &ii,
+                                       const int &jj, const int &kk) {
+        return blk.VelGrad(ii, jj, kk).YX() * velGradScale;
+      }));
+    } else if (var == "velGrad_vy") {
+      kernels.push_back(CellKernel([=](const procBlock &blk, const int &ii,
+                                       const int &jj, const int &kk) {
+        return blk.VelGrad(ii, jj, kk).YY() * velGradScale;
+      }));
+    } else if (var == "velGrad_wy") {
+      kernels.push_back(CellKernel([=](const procBlock &blk, const int &ii,
+                                       const int &jj, const int &kk) {
+        return blk.VelGrad(ii, jj, kk).YZ() * velGradScale;
+      }));
+    } else if (var == "velGrad_uz") {
+      kernels.push_back(CellKernel([=](const procBlock &blk, const int &ii,
+                                       const int &jj, const int &kk) {
+        return blk.VelGrad(ii, jj, kk).ZX() * velGradScale;
+      }));
+    } else if (var == "velGrad_vz") {
+      kernels.push_back(CellKernel([=](const procBlock &blk, const int &ii,
+                                       const int &jj, const int &kk) {
+        return blk.VelGrad(ii, jj, kk).ZY() * velGradScale;
+      }));
+    } else if (var == "velGrad_wz") {
+      kernels.push_back(CellKernel([=](const procBlock &blk, const int &ii,
+                                       const int &jj, const int &kk) {
+        return blk.VelGrad(ii, jj, kk).ZZ() * velGradScale;
+      }));
+    } else if (var == "tempGrad_x") {
+      kernels.push_back(CellKernel([=](const procBlock &blk, const int &ii,
+                                       const int &jj, const int &kk) {
+        return blk.TempGrad(ii, jj, kk).X() * tempGradScale;
+      }));
+    } else if (var == "tempGrad_y") {
+      kernels.push_back(CellKernel([=](const procBlock &blk, const int &ii,
+                                       const int &jj, const int &kk) {
+        return blk.TempGrad(ii, jj, kk).Y() * tempGradScale;
+      }));
+    } else if (var == "tempGrad_z") {
+      kernels.push_back(CellKernel([=](const procBlock &blk, const int &ii,
+                                       const int &jj, const int &kk) {
+        return blk.TempGrad(ii, jj, kk).Z() * tempGradScale;
+      }));
+    } else if (var == "tkeGrad_x") {
+      kernels.push_back(CellKernel([=](const procBlock &blk, const int &ii,
+                                       const int &jj, const int &kk) {
+        return blk.TkeGrad(ii, jj, kk).X() * tkeGradScale;
+      }));
+    } else if (var == "tkeGrad_y") {
+      kernels.push_back(CellKernel([=](const procBlock &blk, const int &ii,
+                                       const int &jj, const int &kk) {
+        return blk.TkeGrad(ii, jj, kk).Y() * tkeGradScale;
+      }));
+    } else if (var == "tkeGrad_z") {
+      kernels.push_back(CellKernel([=](const procBlock &blk, const int &ii,
+                                       const int &jj, const int &kk) {
+        return blk.TkeGrad(ii, jj, kk).Z() * tkeGradScale;
+      }));
+    } else if (var == "omegaGrad_x") {
+      kernels.push_back(CellKernel([=](const procBlock &blk, const int &ii,
+                                       const int &jj, const int &kk) {
+        return blk.OmegaGrad(ii, jj, kk).X() * sdrGradScale;
+      }));
+    } else if (var == "omegaGrad_y") {
+      kernels.push_back(CellKernel([=](const procBlock &blk, const int &ii,
+                                       const int &jj, const int &kk) {
+        return blk.OmegaGrad(ii, jj, kk).Y() * sdrGradScale;
+      }));
+    } else if (var == "omegaGrad_z") {
+      kernels.push_back(CellKernel([=](const procBlock &blk, const int &ii,
+                                       const int &jj, const int &kk) {
+        return blk.OmegaGrad(ii, jj, kk).Z() * sdrGradScale;
+      }));
+    } else if (var == "resid_mass") {
+      kernels.push_back(CellKernel([=](const procBlock &blk, const int &ii,
+                                       const int &jj, const int &kk) {
+        return blk.Residual(ii, jj, kk, 0) * massResidScale;
+      }));
+    } else if (var == "resid_mom_x") {
+      kernels.push_back(CellKernel([=](const procBlock &blk, const int &ii,
+                                       const int &jj, const int &kk) {
+        return blk.Residual(ii, jj, kk, 1) * momResidScale;
+      }));
+    } else if (var == "resid_mom_y") {
+      kernels.push_back(CellKernel([=](const procBlock &blk, const int &ii,
+                                       const int &jj, const int &kk) {
+        return blk.Residual(ii, jj, kk, 2) * momResidScale;
+      }));
+    } else if (var == "resid_mom_z") {
+      kernels.push_back(CellKernel([=](const procBlock &blk, const int &ii,
+                                       const int &jj, const int &kk) {
+        return blk.Residual(ii, jj, kk, 3) * momResidScale;
+      }));
+    } else if (var == "resid_energy") {
+      kernels.push_back(CellKernel([=](const procBlock &blk, const int &ii,
+                                       const int &jj, const int &kk) {
+        return blk.Residual(ii, jj, kk, 4) * engResidScale;
+      }));
+    } else if (var == "resid_tke") {
+      kernels.push_back(CellKernel([=](const procBlock &blk, const int &ii,
+                                       const int &jj, const int &kk) {
+        return blk.Residual(ii, jj, kk, 5) * engResidScale;
+      }));
+    } else if (var == "resid_sdr") {
+      kernels.push_back(CellKernel([=](const procBlock &blk, const int &ii,
+                                       const int &jj, const int &kk) {
+        return blk.Residual(ii, jj, kk, 6) * sdrResidScale;
+      }));
+    } else {
+      cerr << "ERROR: Variable " << var
+           << " to write to function file is not defined!" << endl;
+      exit(EXIT_FAILURE);
+    }
+  }
+  return kernels;
 }
 
 //----------------------------------------------------------------------
 // function to write out variables in function file format
-void WriteFun(const vector<procBlock> &vars, const idealGas &eqnState,
-              const sutherland &suth, const int &solIter,
-              const decomposition &decomp, const input &inp,
-              const unique_ptr<turbModel> &turb) {
-  // recombine blocks into original structure
-  auto recombVars = Recombine(vars, decomp);
-
-  // open binary plot3d function file
+/* The file is written in the layout of the parent blocks. Each processor
+writes the variables of its own procBlocks. The output variables are resolved
+into kernels once, and then each kernel stores its variable for a whole block.
+*/
+void WriteFun(const vector<procBlock> &vars, const blockLayout &layout,
+              const idealGas &eqnState, const sutherland &suth,
+              const int &solIter, const input &inp,
+              const unique_ptr<turbModel> &turb, outputWriter &writer) {
+  // vars -- procBlocks on this processor
+  // layout -- location of procBlocks within parent blocks
+  // eqnState -- equation of state
+  // suth -- sutherland's law for viscosity
+  // solIter -- iteration number of solution
+  // inp -- input variables
+  // turb -- turbulence model
+  // writer -- writer for output files
+
+  // binary plot3d function file
   const string fEnd = "_center";
   const string fPostfix = ".fun";
   const auto writeName = inp.SimNameRoot() + "_" + to_string(solIter) + fEnd +
       fPostfix;
-  ofstream outFile(writeName, ios::out | ios::binary);
 
-  // check to see if file opened correctly
-  if (outFile.fail()) {
-    cerr << "ERROR: Function file " << writeName << " did not open correctly!!!"
-         << endl;
-    exit(EXIT_FAILURE);
-  }
+  ostringstream header;
+  WriteBlockDims(header, layout, inp.NumVarsOutput());
+  const auto dataStart = static_cast<MPI_Offset>(header.str().size());
+  const MPI_Offset varSize =
+      inp.IsSinglePrecisionOutput() ? sizeof(float) : sizeof(double);
 
-  WriteBlockDims(outFile, recombVars, inp.NumVarsOutput());
+  const auto kernels = OutputKernels(inp.OutputVariables(), inp, eqnState,
+                                     suth);
 
-  // define reference speed of sound
-  const auto refSoS = inp.ARef(eqnState);
+  // size buffer for all variables of all blocks
+  auto bufferSize = 0LL;
+  for (const auto &blk : vars) {
+    bufferSize += static_cast<long long>(blk.NumI()) * blk.NumJ() *
+        blk.NumK() * kernels.size();
+  }
 
   // write out variables
-  for (auto ll = 0U; ll < recombVars.size(); ll++) {  // loop over all blocks
+  vector<fileRun> runs;
+  vector<double> buffer(bufferSize);
+  auto pos = 0LL;
+  for (const auto &blk : vars) {  // loop over all blocks
+    const auto parent = layout.Parent(blk.GlobalPos());
+    const auto parentStart = dataStart + layout.CellsBefore(parent) *
+        inp.NumVarsOutput() * varSize;
     // loop over the number of variables to write out
-    for (auto &var : inp.OutputVariables()) {
-      // write out dimensional variables -- loop over physical cells
-      for (auto kk = recombVars[ll].StartK(); kk < recombVars[ll].EndK(); kk++) {
-        for (auto jj = recombVars[ll].StartJ(); jj < recombVars[ll].EndJ(); jj++) {
-          for (auto ii = recombVars[ll].StartI(); ii < recombVars[ll].EndI(); ii++) {
-            auto value = 0.0;
-            if (var == "density") {
-              value = recombVars[ll].State(ii, jj, kk).Rho();
-              value *= inp.RRef();
-            } else if (var == "vel_x") {
-              value = recombVars[ll].State(ii, jj, kk).U();
-              value *= refSoS;
-            } else if (var == "vel_y") {
-              value = recombVars[ll].State(ii, jj, kk).V();
-              value *= refSoS;
-            } else if (var == "vel_z") {
-              value = recombVars[ll].State(ii, jj, kk).W();
-              value *= refSoS;
-            } else if (var == "pressure") {
-              value = recombVars[ll].State(ii, jj, kk).P();
-              value *= inp.RRef() * refSoS * refSoS;
-            } else if (var == "mach") {
-              auto vel = recombVars[ll].State(ii, jj, kk).Velocity();
-              value = vel.Mag() / recombVars[ll].State(ii, jj, kk).SoS(eqnState);
-            } else if (var == "sos") {
-              value = recombVars[ll].State(ii, jj, kk).SoS(eqnState);
-              value *= refSoS;
-            } else if (var == "dt") {
-              value = recombVars[ll].Dt(ii, jj, kk);
-              value /= refSoS * inp.LRef();
-            } else if (var == "temperature") {
-              value = recombVars[ll].Temperature(ii, jj, kk);
-              value *= inp.TRef();
-            } else if (var == "rank") {
-              value = vars[SplitBlockNumber(recombVars, decomp,
-                                            ll, ii, jj, kk)].Rank();
-            } else if (var == "globalPosition") {
-              value = vars[SplitBlockNumber(recombVars, decomp,
-                                            ll, ii, jj, kk)].GlobalPos();
-            } else if (var == "viscosityRatio") {
-              value = recombVars[ll].IsTurbulent() ?
-                  recombVars[ll].EddyViscosity(ii, jj, kk) /
-                  recombVars[ll].Viscosity(ii, jj, kk)
-                  : 0.0;
-            } else if (var == "tke") {
-              value = recombVars[ll].State(ii, jj, kk).Tke();
-              value *= refSoS * refSoS;
-            } else if (var == "sdr") {
-              value = recombVars[ll].State(ii, jj, kk).Omega();
-              value *= refSoS * refSoS * inp.RRef() / suth.MuRef();
-            } else if (var == "wallDistance") {
-              value = recombVars[ll].WallDist(ii, jj, kk);
-              value *= inp.LRef();
-            } else if (var == "velGrad_ux") {
-              value = recombVars[ll].VelGrad(ii, jj, kk).XX();
-              value *= refSoS / inp.LRef();
-            } else if (var == "velGrad_vx") {
-              value = recombVars[ll].VelGrad(ii, jj, kk).XY();
-              value *= refSoS / inp.LRef();
-            } else if (var == "velGrad_wx") {
-              value = recombVars[ll].VelGrad(ii, jj, kk).XZ();
-              value *= refSoS / inp.LRef();
-            } else if (var == "velGrad_uy") {
-              value = recombVars[ll].VelGrad(ii, jj, kk).YX();
-              value *= refSoS / inp.LRef();
-            } else if (var == "velGrad_vy") {
-              value = recombVars[ll].VelGrad(ii, jj, kk).YY();
-              value *= refSoS / inp.LRef();
-            } else if (var == "velGrad_wy") {
-              value = recombVars[ll].VelGrad(ii, jj, kk).YZ();
-              value *= refSoS / inp.LRef();
-            } else if (var == "velGrad_uz") {
-              value = recombVars[ll].VelGrad(ii, jj, kk).ZX();
-              value *= refSoS / inp.LRef();
-            } else if (var == "velGrad_vz") {
-              value = recombVars[ll].VelGrad(ii, jj, kk).ZY();
-              value *= refSoS / inp.LRef();
-            } else if (var == "velGrad_wz") {
-              value = recombVars[ll].VelGrad(ii, jj, kk).ZZ();
-              value *= refSoS / inp.LRef();
-            } else if (var == "tempGrad_x") {
-              value = recombVars[ll].TempGrad(ii, jj, kk).X();
-              value *= inp.TRef() / inp.LRef();
-            } else if (var == "tempGrad_y") {
-              value = recombVars[ll].TempGrad(ii, jj, kk).Y();
-              value *= inp.TRef() / inp.LRef();
-            } else if (var == "tempGrad_z") {
-              value = recombVars[ll].TempGrad(ii, jj, kk).Z();
-              value *= inp.TRef() / inp.LRef();
-            } else if (var == "tkeGrad_x") {
-              value = recombVars[ll].TkeGrad(ii, jj, kk).X();
-              value *= refSoS * refSoS / inp.LRef();
-            } else if (var == "tkeGrad_y") {
-              value = recombVars[ll].TkeGrad(ii, jj, kk).Y();
-              value *= refSoS * refSoS / inp.LRef();
-            } else if (var == "tkeGrad_z") {
-              value = recombVars[ll].TkeGrad(ii, jj, kk).Z();
-              value *= refSoS * refSoS / inp.LRef();
-            } else if (var == "omegaGrad_x") {
-              value = recombVars[ll].OmegaGrad(ii, jj, kk).X();
-              value *= refSoS * refSoS * inp.RRef() /
-                  (suth.MuRef() * inp.LRef());
-            } else if (var == "omegaGrad_y") {
-              value = recombVars[ll].OmegaGrad(ii, jj, kk).Y();
-              value *= refSoS * refSoS * inp.RRef() /
-                  (suth.MuRef() * inp.LRef());
-            } else if (var == "omegaGrad_z") {
-              value = recombVars[ll].OmegaGrad(ii, jj, kk).Z();
-              value *= refSoS * refSoS * inp.RRef() /
-                  (suth.MuRef() * inp.LRef());
-            } else if (var == "resid_mass") {
-              value = recombVars[ll].Residual(ii, jj, kk, 0);
-              value *= inp.RRef() * refSoS * inp.LRef() * inp.LRef();
-            } else if (var == "resid_mom_x") {
-              value = recombVars[ll].Residual(ii, jj, kk, 1);
-              value *= inp.RRef() * refSoS * refSoS * inp.LRef() *
-                  inp.LRef();
-            } else if (var == "resid_mom_y") {
-              value = recombVars[ll].Residual(ii, jj, kk, 2);
-              value *= inp.RRef() * refSoS * refSoS * inp.LRef() *
-                  inp.LRef();
-            } else if (var == "resid_mom_z") {
-              value = recombVars[ll].Residual(ii, jj, kk, 3);
-              value *= inp.RRef() * refSoS * refSoS * inp.LRef() *
-                  inp.LRef();
-            } else if (var == "resid_energy") {
-              value = recombVars[ll].Residual(ii, jj, kk, 4);
-              value *= inp.RRef() * pow(refSoS, 3.0) * inp.LRef() *
-                  inp.LRef();
-            } else if (var == "resid_tke") {
-              value = recombVars[ll].Residual(ii, jj, kk, 5);
-              value *= inp.RRef() * pow(refSoS, 3.0) * inp.LRef() *
-                  inp.LRef();
-            } else if (var == "resid_sdr") {
-              value = recombVars[ll].Residual(ii, jj, kk, 6);
-              value *= inp.RRef() * inp.RRef() * pow(refSoS, 4.0) *
-                  inp.LRef() * inp.LRef() / suth.MuRef();
-            } else {
-              cerr << "ERROR: Variable " << var
-                   << " to write to function file is not defined!" << endl;
-              exit(EXIT_FAILURE);
-            }
-
-            outFile.write(reinterpret_cast<char *>(&value), sizeof(value));
-          }
+    for (auto vv = 0U; vv < kernels.size(); vv++) {
+      // rows of physical cells are written in order
+      for (auto kk = blk.StartK(); kk < blk.EndK(); kk++) {
+        for (auto jj = blk.StartJ(); jj < blk.EndJ(); jj++) {
+          const auto cell = vv * layout.ParentCells(parent) +
+              layout.ParentIndex(blk.GlobalPos(), blk.StartI(), jj, kk);
+          runs.push_back({parentStart + cell * varSize, pos, blk.NumI()});
+          pos += blk.NumI();
         }
       }
+      kernels[vv](blk, {blk.StartI(), blk.StartJ(), blk.StartK()},
+                  {blk.EndI(), blk.EndJ(), blk.EndK()},
+                  &buffer[pos - blk.NumI() * blk.NumJ() * blk.NumK()]);
     }
   }
 
-  // close plot3d function file
-  outFile.close();
+  const auto fileSize = dataStart + layout.TotalCells() *
+      inp.NumVarsOutput() * varSize;
+  WriteVisualization(writeName, header.str(), fileSize, runs, buffer, inp,
+                     writer);
 }
 
-// function to write out variables in function file format
-void WriteRestart(const vector<procBlock> &splitVars, const idealGas &eqnState,
-                  const sutherland &suth, const int &solIter,
-                  const decomposition &decomp, const input &inp,
-                  const genArray &residL2First) {
-  // recombine blocks into original structure
-  auto vars = Recombine(splitVars, decomp);
+/* Function to compress the staged restart data. The data of each procBlock at
+each time level is compressed separately, so each processor compresses its own
+blocks. The compressed sizes are then shared with all processors, so that every
+processor can find the location of its blocks in the file. The table of
+compressed blocks is added to the header, and the staged data and runs are
+replaced by the compressed blocks. Each compressed block is padded to a whole
+number of doubles. The size of the file is returned.
+*/
+MPI_Offset CompressRestart(const vector<procBlock> &vars,
+                           const blockLayout &layout, const int &numVars,
+                           const int &numSols, ostringstream &header,
+                           vector<fileRun> &runs, vector<double> &buffer) {
+  // vars -- procBlocks on this processor
+  // layout -- location of procBlocks within parent blocks
+  // numVars -- number of variables for each cell
+  // numSols -- number of time levels
+  // header -- header of restart file
+  // runs -- location of data in file and buffer
+  // buffer -- staged data, all blocks at time n followed by time n-1
+
+  const auto numBlks = layout.NumBlocks();
+
+  // compress each block; the staged values are stored cell by cell, so they
+  // are reordered to store each variable contiguously
+  vector<vector<unsigned char>> packed;
+  packed.reserve(numSols * vars.size());
+  vector<int64_t> packedSize(numSols * numBlks, 0);
+  auto pos = 0LL;
+  for (auto ss = 0; ss < numSols; ss++) {
+    for (const auto &blk : vars) {
+      const auto numCells = blk.NumI() * blk.NumJ() * blk.NumK();
+      vector<double> values(numCells * numVars);
+      for (auto cc = 0; cc < numCells; cc++) {
+        for (auto vv = 0; vv < numVars; vv++) {
+          values[vv * numCells + cc] = buffer[pos + cc * numVars + vv];
+        }
+      }
+      pos += values.size();
+      packed.push_back(CompressDoubles(values));
+      packedSize[ss * numBlks + blk.GlobalPos()] = packed.back().size();
+    }
+  }
 
-  // open binary restart file
+  // blocks on other processors have zero size here
+  MPI_Allreduce(MPI_IN_PLACE, packedSize.data(), packedSize.size(),
+                MPI_INT64_T, MPI_SUM, MPI_COMM_WORLD);
+
+  // write location of each block within its parent block
+  header.write(reinterpret_cast<const char *>(&numBlks), sizeof(numBlks));
+  for (auto bb = 0; bb < numBlks; bb++) {
+    const auto start = layout.Start(bb);
+    const auto dims = layout.Dims(bb);
+    int blkInfo[7] = {layout.Parent(bb), start[0], start[1], start[2],
+                      dims[0], dims[1], dims[2]};
+    header.write(reinterpret_cast<char *>(blkInfo), sizeof(blkInfo));
+  }
+
+  // write offset and compressed size of each block at each time level
+  auto padded = [](const int64_t &size) {
+    return (size + sizeof(double) - 1) / sizeof(double);
+  };
+  vector<int64_t> offsets(packedSize.size());
+  MPI_Offset offset = static_cast<MPI_Offset>(header.str().size()) +
+      2 * packedSize.size() * sizeof(int64_t);
+  for (auto ii = 0U; ii < offsets.size(); ii++) {
+    offsets[ii] = offset;
+    offset += padded(packedSize[ii]) * sizeof(double);
+  }
+  header.write(reinterpret_cast<char *>(offsets.data()),
+               offsets.size() * sizeof(int64_t));
+  header.write(reinterpret_cast<char *>(packedSize.data()),
+               packedSize.size() * sizeof(int64_t));
+
+  // replace staged data with compressed blocks
+  runs.clear();
+  buffer.clear();
+  auto pp = 0;
+  for (auto ss = 0; ss < numSols; ss++) {
+    for (const auto &blk : vars) {
+      const auto &blkPacked = packed[pp++];
+      const auto size = static_cast<int>(padded(blkPacked.size()));
+      runs.push_back({offsets[ss * numBlks + blk.GlobalPos()],
+                      static_cast<long long>(buffer.size()), size});
+      buffer.resize(buffer.size() + size, 0.0);
+      std::copy(std::begin(blkPacked), std::end(blkPacked),
+                reinterpret_cast<unsigned char *>(&*(std::end(buffer) - size)));
+    }
+  }
+  return offset;
+}
+
+// function to write out restart file
+/* The file is written in the layout of the parent blocks. Each processor
+writes the solution of its own procBlocks. The header starts with the negative
+of the restart format version, which tells it apart from files written before
+the format was versioned (these start with the number of time levels). After
+the block dimensions the header holds the compression method and the offset of
+the data of each block for each time level, so that a reader can go directly to
+any block. Compressed files instead hold a table of the compressed procBlocks
+(see CompressRestart()).
+*/
+void WriteRestart(const vector<procBlock> &vars, const blockLayout &layout,
+                  const idealGas &eqnState, const sutherland &suth,
+                  const int &solIter, const input &inp,
+                  const genArray &residL2First, outputWriter &writer) {
+  // vars -- procBlocks on this processor
+  // layout -- location of procBlocks within parent blocks
+  // eqnState -- equation of state
+  // suth -- sutherland's law for viscosity
+  // solIter -- iteration number of solution
+  // inp -- input variables
+  // residL2First -- residuals to normalize by (only used on ROOT)
+  // writer -- writer for output files
+
+  // binary restart file
   const string fPostfix = ".rst";
   const auto writeName = inp.SimNameRoot() + "_" + to_string(solIter) + fPostfix;
-  ofstream outFile(writeName, ios::out | ios::binary);
 
-  // check to see if file opened correctly
-  if (outFile.fail()) {
-    cerr << "ERROR: Restart file " << writeName << " did not open correctly!!!"
-         << endl;
-    exit(EXIT_FAILURE);
-  }
+  ostringstream header;
+
+  // write format version
+  auto version = -RESTARTVERSION;
+  header.write(reinterpret_cast<char *>(&version), sizeof(version));
 
   // write number of time steps contained in file
   auto numSols = inp.IsMultilevelInTime() ? 2 : 1;
-  outFile.write(reinterpret_cast<char *>(&numSols), sizeof(numSols));
+  header.write(reinterpret_cast<char *>(&numSols), sizeof(numSols));
 
   // write iteration number
-  outFile.write(const_cast<char *>(reinterpret_cast<const char *>(&solIter)),
-                sizeof(solIter));
+  header.write(reinterpret_cast<const char *>(&solIter), sizeof(solIter));
 
   // write number of equations
   auto numEqns = inp.NumEquations();
-  outFile.write(reinterpret_cast<char *>(&numEqns), sizeof(numEqns));
+  header.write(reinterpret_cast<char *>(&numEqns), sizeof(numEqns));
 
   // write residual values
-  outFile.write(const_cast<char *>(reinterpret_cast<const char *>(&residL2First)),
-                sizeof(residL2First));
+  header.write(reinterpret_cast<const char *>(&residL2First),
+               sizeof(residL2First));
 
   // variables to write to restart file
   vector<string> restartVars = {"density", "vel_x", "vel_y", "vel_z", "pressure"};
@@ -328,41 +632,72 @@ void WriteRestart(const vector<procBlock> &splitVars, const idealGas &eqnState,
     restartVars.push_back("tke");
     restartVars.push_back("sdr");
   }
-
-  WriteBlockDims(outFile, vars, restartVars.size());
+  const auto numVars = static_cast<int>(restartVars.size());
+
+  WriteBlockDims(header, layout, numVars);
+  const MPI_Offset varSize = sizeof(double);
+
+  // write compression method
+  const auto isCompressed =
+      inp.RestartCompressionMethod() != compressionMethod::none;
+  auto compression = static_cast<int>(inp.RestartCompressionMethod());
+  header.write(reinterpret_cast<char *>(&compression), sizeof(compression));
+
+  // solution at time n-1 follows solution at time n for all blocks
+  const auto solSize = layout.TotalCells() * numVars * varSize;
+
+  // write offset of data for each block at each time level; compressed blocks
+  // are located once their compressed sizes are known
+  const MPI_Offset dataStart = isCompressed ? 0 :
+      static_cast<MPI_Offset>(header.str().size()) +
+      numSols * layout.NumParents() * static_cast<MPI_Offset>(sizeof(int64_t));
+  for (auto ss = 0; ss < numSols && !isCompressed; ss++) {
+    for (auto ll = 0; ll < layout.NumParents(); ll++) {
+      int64_t offset = dataStart + ss * solSize +
+          layout.CellsBefore(ll) * numVars * varSize;
+      header.write(reinterpret_cast<char *>(&offset), sizeof(offset));
+    }
+  }
 
   // define reference speed of sound
   const auto refSoS = inp.ARef(eqnState);
 
   // write out variables
-  for (auto ll = 0U; ll < vars.size(); ll++) {  // loop over all blocks
+  vector<fileRun> runs;
+  vector<double> buffer;
+  for (const auto &blk : vars) {  // loop over all blocks
     // write out dimensional variables -- loop over physical cells
-    for (auto kk = vars[ll].StartK(); kk < vars[ll].EndK(); kk++) {
-      for (auto jj = vars[ll].StartJ(); jj < vars[ll].EndJ(); jj++) {
-        for (auto ii = vars[ll].StartI(); ii < vars[ll].EndI(); ii++) {
+    for (auto kk = blk.StartK(); kk < blk.EndK(); kk++) {
+      for (auto jj = blk.StartJ(); jj < blk.EndJ(); jj++) {
+        const auto cell = layout.CellsBefore(layout.Parent(blk.GlobalPos())) +
+            layout.ParentIndex(blk.GlobalPos(), blk.StartI(), jj, kk);
+        runs.push_back({dataStart + cell * numVars * varSize,
+                        static_cast<long long>(buffer.size()),
+                        blk.NumI() * numVars});
+        for (auto ii = blk.StartI(); ii < blk.EndI(); ii++) {
           // loop over the number of variables to write out
           for (auto &var : restartVars) {
             auto value = 0.0;
             if (var == "density") {
-              value = vars[ll].State(ii, jj, kk).Rho();
+              value = blk.State(ii, jj, kk).Rho();
               value *= inp.RRef();
             } else if (var == "vel_x") {
-              value = vars[ll].State(ii, jj, kk).U();
+              value = blk.State(ii, jj, kk).U();
               value *= refSoS;
             } else if (var == "vel_y") {
-              value = vars[ll].State(ii, jj, kk).V();
+              value = blk.State(ii, jj, kk).V();
               value *= refSoS;
             } else if (var == "vel_z") {
-              value = vars[ll].State(ii, jj, kk).W();
+              value = blk.State(ii, jj, kk).W();
               value *= refSoS;
             } else if (var == "pressure") {
-              value = vars[ll].State(ii, jj, kk).P();
+              value = blk.State(ii, jj, kk).P();
               value *= inp.RRef() * refSoS * refSoS;
             } else if (var == "tke") {
-              value = vars[ll].State(ii, jj, kk).Tke();
+              value = blk.State(ii, jj, kk).Tke();
               value *= refSoS * refSoS;
             } else if (var == "sdr") {
-              value = vars[ll].State(ii, jj, kk).Omega();
+              value = blk.State(ii, jj, kk).Omega();
               value *= refSoS * refSoS * inp.RRef() / suth.MuRef();
             } else {
               cerr << "ERROR: Variable " << var
@@ -370,7 +705,7 @@ void WriteRestart(const vector<procBlock> &splitVars, const idealGas &eqnState,
               exit(EXIT_FAILURE);
             }
 
-            outFile.write(reinterpret_cast<char *>(&value), sizeof(value));
+            buffer.push_back(value);
           }
         }
       }
@@ -380,34 +715,40 @@ void WriteRestart(const vector<procBlock> &splitVars, const idealGas &eqnState,
   // write out 2nd solution
   if (numSols == 2) {
     // these variables are conserved variables
-    for (auto ll = 0U; ll < vars.size(); ll++) {  // loop over all blocks
+    for (const auto &blk : vars) {  // loop over all blocks
       // write out dimensional variables -- loop over physical cells
-      for (auto kk = vars[ll].StartK(); kk < vars[ll].EndK(); kk++) {
-        for (auto jj = vars[ll].StartJ(); jj < vars[ll].EndJ(); jj++) {
-          for (auto ii = vars[ll].StartI(); ii < vars[ll].EndI(); ii++) {
+      for (auto kk = blk.StartK(); kk < blk.EndK(); kk++) {
+        for (auto jj = blk.StartJ(); jj < blk.EndJ(); jj++) {
+          const auto cell =
+              layout.CellsBefore(layout.Parent(blk.GlobalPos())) +
+              layout.ParentIndex(blk.GlobalPos(), blk.StartI(), jj, kk);
+          runs.push_back({dataStart + solSize + cell * numVars * varSize,
+                          static_cast<long long>(buffer.size()),
+                          blk.NumI() * numVars});
+          for (auto ii = blk.StartI(); ii < blk.EndI(); ii++) {
             // loop over the number of variables to write out
             for (auto &var : restartVars) {
               auto value = 0.0;
               if (var == "density") {
-                value = vars[ll].ConsVarsNm1(ii, jj, kk)[0];
+                value = blk.ConsVarsNm1(ii, jj, kk)[0];
                 value *= inp.RRef();
               } else if (var == "vel_x") {  // conserved var is rho-u
-                value = vars[ll].ConsVarsNm1(ii, jj, kk)[1];
+                value = blk.ConsVarsNm1(ii, jj, kk)[1];
                 value *= refSoS * inp.RRef();
               } else if (var == "vel_y") {  // conserved var is rho-v
-                value = vars[ll].ConsVarsNm1(ii, jj, kk)[2];
+                value = blk.ConsVarsNm1(ii, jj, kk)[2];
                 value *= refSoS * inp.RRef();
               } else if (var == "vel_z") {  // conserved var is rho-w
-                value = vars[ll].ConsVarsNm1(ii, jj, kk)[3];
+                value = blk.ConsVarsNm1(ii, jj, kk)[3];
                 value *= refSoS * inp.RRef();
               } else if (var == "pressure") {  // conserved var is rho-E
-                value = vars[ll].ConsVarsNm1(ii, jj, kk)[4];
+                value = blk.ConsVarsNm1(ii, jj, kk)[4];
                 value *= refSoS * refSoS * inp.RRef();
               } else if (var == "tke") {  // conserved var is rho-tke
-                value = vars[ll].ConsVarsNm1(ii, jj, kk)[5];
+                value = blk.ConsVarsNm1(ii, jj, kk)[5];
                 value *= refSoS * refSoS * inp.RRef();
               } else if (var == "sdr") {  // conserved var is rho-sdr
-                value = vars[ll].ConsVarsNm1(ii, jj, kk)[6];
+                value = blk.ConsVarsNm1(ii, jj, kk)[6];
                 value *= refSoS * refSoS * inp.RRef() * inp.RRef() / suth.MuRef();
               } else {
                 cerr << "ERROR: Variable " << var
@@ -415,7 +756,7 @@ void WriteRestart(const vector<procBlock> &splitVars, const idealGas &eqnState,
                 exit(EXIT_FAILURE);
               }
 
-              outFile.write(reinterpret_cast<char *>(&value), sizeof(value));
+              buffer.push_back(value);
             }
           }
         }
@@ -423,72 +764,308 @@ void WriteRestart(const vector<procBlock> &splitVars, const idealGas &eqnState,
     }
   }
 
-  // close restart file
-  outFile.close();
+  auto fileSize = dataStart + numSols * solSize;
+  if (isCompressed) {
+    fileSize = CompressRestart(vars, layout, numVars, numSols, header, runs,
+                               buffer);
+  }
+  writer.Write(writeName, header.str(), fileSize, runs, buffer);
 }
 
-void ReadRestart(vector<procBlock> &vars, const string &restartName,
-                 input &inp, const idealGas &eos, const sutherland &suth,
-                 const unique_ptr<turbModel> &turb, genArray &residL2First) {
-  // open binary plot3d grid file
-  ifstream fName(restartName, ios::in | ios::binary);
+/* Function to read the solution of the procBlocks on this processor from the
+compressed blocks of a restart file. The file may have been written with a
+different decomposition, so each processor reads and decompresses every
+compressed block that overlaps one of its procBlocks, and copies the overlap
+into place. The data is returned in the same order as it is stored in an
+uncompressed file, all blocks at time n followed by all blocks at time n-1.
+*/
+vector<double> ReadCompressedRestart(MPI_File &inFile,
+                                     const vector<procBlock> &vars,
+                                     const blockLayout &layout,
+                                     const int &numVars, const int &readSols,
+                                     const vector<int> &packedInfo,
+                                     const vector<int64_t> &offsets,
+                                     const vector<int64_t> &packedSize) {
+  // inFile -- restart file
+  // vars -- procBlocks on this processor
+  // layout -- location of procBlocks within parent blocks
+  // numVars -- number of variables for each cell
+  // readSols -- number of time levels to read
+  // packedInfo -- parent, start, and dimensions of each compressed block
+  // offsets -- location of each compressed block at each time level
+  // packedSize -- size in bytes of each compressed block at each time level
+
+  const auto numPacked = static_cast<int>(packedInfo.size()) / 7;
+  auto packedStart = [&packedInfo](const int &pp) {
+    return vector3d<int>(packedInfo[7 * pp + 1], packedInfo[7 * pp + 2],
+                         packedInfo[7 * pp + 3]);
+  };
+  auto packedDims = [&packedInfo](const int &pp) {
+    return vector3d<int>(packedInfo[7 * pp + 4], packedInfo[7 * pp + 5],
+                         packedInfo[7 * pp + 6]);
+  };
+
+  // find range of cells in overlap of a procBlock and a compressed block
+  auto overlap = [&](const procBlock &blk, const int &pp, vector3d<int> &lo,
+                     vector3d<int> &hi) {
+    if (packedInfo[7 * pp] != layout.Parent(blk.GlobalPos())) {
+      return false;
+    }
+    const auto blkStart = layout.Start(blk.GlobalPos());
+    const auto blkDims = layout.Dims(blk.GlobalPos());
+    const auto start = packedStart(pp);
+    const auto dims = packedDims(pp);
+    for (auto dd = 0; dd < 3; dd++) {
+      lo[dd] = std::max(blkStart[dd], start[dd]);
+      hi[dd] = std::min(blkStart[dd] + blkDims[dd], start[dd] + dims[dd]);
+      if (lo[dd] >= hi[dd]) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  // find compressed blocks to read
+  vector<int> needed;
+  for (auto pp = 0; pp < numPacked; pp++) {
+    for (const auto &blk : vars) {
+      vector3d<int> lo, hi;
+      if (overlap(blk, pp, lo, hi)) {
+        needed.push_back(pp);
+        break;
+      }
+    }
+  }
 
-  // check to see if file opened correctly
-  if (fName.fail()) {
+  // read compressed blocks
+  vector<fileRun> runs;
+  vector<long long> packedPos;
+  auto packedTotal = 0LL;
+  for (auto ss = 0; ss < readSols; ss++) {
+    for (const auto &pp : needed) {
+      const auto ind = ss * numPacked + pp;
+      const auto size = static_cast<int>(
+          (packedSize[ind] + sizeof(double) - 1) / sizeof(double));
+      runs.push_back({static_cast<MPI_Offset>(offsets[ind]), packedTotal,
+                      size});
+      packedPos.push_back(packedTotal);
+      packedTotal += size;
+    }
+  }
+  vector<double> packed(packedTotal);
+  ReadCollective(inFile, runs, packed);
+
+  // find start of each procBlock in data
+  vector<long long> blkPos(readSols * vars.size() + 1, 0);
+  for (auto ss = 0; ss < readSols; ss++) {
+    for (auto bb = 0U; bb < vars.size(); bb++) {
+      const auto ind = ss * vars.size() + bb;
+      blkPos[ind + 1] = blkPos[ind] + static_cast<long long>(vars[bb].NumI()) *
+          vars[bb].NumJ() * vars[bb].NumK() * numVars;
+    }
+  }
+
+  // decompress each block and copy its overlap with each procBlock
+  vector<double> data(blkPos.back());
+  auto nn = 0;
+  for (auto ss = 0; ss < readSols; ss++) {
+    for (const auto &pp : needed) {
+      const auto ind = ss * numPacked + pp;
+      const auto start = packedStart(pp);
+      const auto dims = packedDims(pp);
+      const auto numCells = dims[0] * dims[1] * dims[2];
+      vector<double> values(numCells * numVars);
+      DecompressDoubles(
+          reinterpret_cast<const unsigned char *>(&packed[packedPos[nn++]]),
+          packedSize[ind], values);
+
+      for (auto bb = 0U; bb < vars.size(); bb++) {
+        vector3d<int> lo, hi;
+        if (!overlap(vars[bb], pp, lo, hi)) {
+          continue;
+        }
+        const auto blkStart = layout.Start(vars[bb].GlobalPos());
+        const auto blkDims = layout.Dims(vars[bb].GlobalPos());
+        const auto pos = blkPos[ss * vars.size() + bb];
+        for (auto kk = lo[2]; kk < hi[2]; kk++) {
+          for (auto jj = lo[1]; jj < hi[1]; jj++) {
+            for (auto ii = lo[0]; ii < hi[0]; ii++) {
+              const auto blkCell = (ii - blkStart[0]) + blkDims[0] *
+                  ((jj - blkStart[1]) + blkDims[1] * (kk - blkStart[2]));
+              const auto cell = (ii - start[0]) + dims[0] *
+                  ((jj - start[1]) + dims[1] * (kk - start[2]));
+              for (auto vv = 0; vv < numVars; vv++) {
+                data[pos + blkCell * numVars + vv] =
+                    values[vv * numCells + cell];
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+  return data;
+}
+
+/* Function to read a restart file. ROOT reads the header and sends it to all
+processors, and then every processor reads the solution of its own procBlocks
+directly from the file. The data of each block is found from the offset table
+in the header. Restart files written before the format was versioned have no
+offset table; for these the offsets are found from the block dimensions.
+Compressed files are read by ReadCompressedRestart().
+*/
+void ReadRestart(vector<procBlock> &vars, const blockLayout &layout,
+                 const string &restartName, input &inp, const idealGas &eos,
+                 const sutherland &suth, const unique_ptr<turbModel> &turb,
+                 genArray &residL2First) {
+  // vars -- procBlocks on this processor
+  // layout -- location of procBlocks within parent blocks
+  // restartName -- name of restart file
+  // inp -- input variables
+  // eos -- equation of state
+  // suth -- sutherland's law for viscosity
+  // turb -- turbulence model
+  // residL2First -- residuals to normalize by
+
+  auto rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  // open binary restart file
+  MPI_File fName;
+  if (MPI_File_open(MPI_COMM_WORLD, restartName.c_str(), MPI_MODE_RDONLY,
+                    MPI_INFO_NULL, &fName) != MPI_SUCCESS) {
     cerr << "ERROR: Error in ReadRestart(). Restart file " << restartName
          << " did not open correctly!!!" << endl;
     exit(EXIT_FAILURE);
   }
 
-  // read the number of time levels in file
-  cout << "Reading restart file..." << endl;
-  auto numSols = 0;
-  fName.read(reinterpret_cast<char *>(&numSols), sizeof(numSols));
-  cout << "Number of time levels: " << numSols << endl;
+  // number of time levels, iteration number, number of equations, compression
+  // method, number of compressed blocks
+  int counts[5] = {0, 0, 0, 0, 0};
+  auto &numSols = counts[0];
+  auto &iterNum = counts[1];
+  auto &numEqns = counts[2];
+  auto &compression = counts[3];
+  auto &numPacked = counts[4];
+  vector<int64_t> offsets, packedSize;
+  vector<int> packedInfo;
+
+  if (rank == ROOTP) {
+    MPI_Offset pos = 0;
+    auto read = [&fName, &pos](void *data, const int &size) {
+      MPI_File_read_at(fName, pos, data, size, MPI_BYTE, MPI_STATUS_IGNORE);
+      pos += size;
+    };
+
+    // read the format version, or the number of time levels if there is none
+    cout << "Reading restart file..." << endl;
+    auto version = 0;
+    read(&version, sizeof(version));
+    if (version < 0) {
+      version = -version;
+      read(&numSols, sizeof(numSols));
+    } else {
+      numSols = version;
+      version = 1;
+    }
+    if (version > RESTARTVERSION) {
+      cerr << "ERROR: Error in ReadRestart(). Restart file version " << version
+           << " is newer than supported version " << RESTARTVERSION << "!"
+           << endl;
+      exit(EXIT_FAILURE);
+    }
+    cout << "Number of time levels: " << numSols << endl;
 
-  if (inp.IsMultilevelInTime() && numSols != 2) {
-    cerr << "WARNING: Using multilevel time integration scheme, but only one "
-         << "time level found in restart file" << endl;
-  }
+    if (inp.IsMultilevelInTime() && numSols != 2) {
+      cerr << "WARNING: Using multilevel time integration scheme, but only one "
+           << "time level found in restart file" << endl;
+    }
 
-  // iteration number
-  auto iterNum = 0;
-  fName.read(reinterpret_cast<char *>(&iterNum), sizeof(iterNum));
-  cout << "Data from iteration: " << iterNum << endl;
-  inp.SetIterationStart(iterNum);
+    // iteration number
+    read(&iterNum, sizeof(iterNum));
+    cout << "Data from iteration: " << iterNum << endl;
 
-  // read the number of equations
-  auto numEqns = 0;
-  fName.read(reinterpret_cast<char *>(&numEqns), sizeof(numEqns));
-  cout << "Number of equations: " << numEqns << endl;
+    // read the number of equations
+    read(&numEqns, sizeof(numEqns));
+    cout << "Number of equations: " << numEqns << endl;
 
-  // read the residuals to normalize by
-  fName.read(reinterpret_cast<char *>(&residL2First), sizeof(residL2First));
+    // read the residuals to normalize by
+    read(&residL2First, sizeof(residL2First));
 
-  // read the number of blocks
-  auto numBlks = 0;
-  fName.read(reinterpret_cast<char *>(&numBlks), sizeof(numBlks));
-  if (numBlks != static_cast<int>(vars.size())) {
-    cerr << "ERROR: Number of blocks in restart file does not match grid!"
-         << endl;
-  }
+    // read the number of blocks
+    auto numBlks = 0;
+    read(&numBlks, sizeof(numBlks));
+    if (numBlks != layout.NumParents()) {
+      cerr << "ERROR: Number of blocks in restart file does not match grid!"
+           << endl;
+      exit(EXIT_FAILURE);
+    }
 
-  // read the block sizes and check for match with grid
-  for (auto ii = 0; ii < numBlks; ii++) {
-    auto numI = 0, numJ = 0, numK = 0, numVars = 0;
-    fName.read(reinterpret_cast<char *>(&numI), sizeof(numI));
-    fName.read(reinterpret_cast<char *>(&numJ), sizeof(numJ));
-    fName.read(reinterpret_cast<char *>(&numK), sizeof(numK));
-    fName.read(reinterpret_cast<char *>(&numVars), sizeof(numVars));
-    if (numI != vars[ii].NumI() || numJ != vars[ii].NumJ() ||
-        numK != vars[ii].NumK() || numVars != numEqns) {
-      cerr << "ERROR: Problem with restart file. Block size does not match "
-           << "grid, or number of variables in block does not match number of "
-           << "equations!" << endl;
+    // read the block sizes and check for match with grid
+    for (auto ii = 0; ii < numBlks; ii++) {
+      int dims[4] = {0, 0, 0, 0};
+      read(dims, sizeof(dims));
+      const auto gridDims = layout.ParentDims(ii);
+      if (dims[0] != gridDims[0] || dims[1] != gridDims[1] ||
+          dims[2] != gridDims[2] || dims[3] != numEqns) {
+        cerr << "ERROR: Problem with restart file. Block size does not match "
+             << "grid, or number of variables in block does not match number "
+             << "of equations!" << endl;
+        exit(EXIT_FAILURE);
+      }
+    }
+
+    // read the compression method
+    if (version >= 3) {
+      read(&compression, sizeof(compression));
+    }
+
+    // read the offset of each block at each time level
+    offsets.resize(numSols * numBlks);
+    if (compression == static_cast<int>(compressionMethod::lossless)) {
+      // compressed blocks are the procBlocks of the run that wrote the file
+      read(&numPacked, sizeof(numPacked));
+      packedInfo.resize(7 * numPacked);
+      read(packedInfo.data(), packedInfo.size() * sizeof(int));
+      offsets.resize(numSols * numPacked);
+      packedSize.resize(offsets.size());
+      read(offsets.data(), offsets.size() * sizeof(int64_t));
+      read(packedSize.data(), packedSize.size() * sizeof(int64_t));
+    } else if (compression != static_cast<int>(compressionMethod::none)) {
+      cerr << "ERROR: Error in ReadRestart(). Compression method "
+           << compression << " is not recognized!" << endl;
       exit(EXIT_FAILURE);
+    } else if (version >= 2) {
+      read(offsets.data(), offsets.size() * sizeof(int64_t));
+    } else {
+      // data follows block sizes, with all blocks at time n first
+      for (auto ss = 0; ss < numSols; ss++) {
+        for (auto ll = 0; ll < numBlks; ll++) {
+          offsets[ss * numBlks + ll] = pos + (ss * layout.TotalCells() +
+              layout.CellsBefore(ll)) * numEqns * sizeof(double);
+        }
+      }
     }
   }
 
+  // send header to all processors
+  MPI_Bcast(counts, 5, MPI_INT, ROOTP, MPI_COMM_WORLD);
+  MPI_Bcast(&residL2First, sizeof(residL2First), MPI_BYTE, ROOTP,
+            MPI_COMM_WORLD);
+  const auto isCompressed = numPacked > 0;
+  offsets.resize(numSols * (isCompressed ? numPacked : layout.NumParents()));
+  MPI_Bcast(offsets.data(), offsets.size(), MPI_INT64_T, ROOTP,
+            MPI_COMM_WORLD);
+  if (isCompressed) {
+    packedInfo.resize(7 * numPacked);
+    MPI_Bcast(packedInfo.data(), packedInfo.size(), MPI_INT, ROOTP,
+              MPI_COMM_WORLD);
+    packedSize.resize(offsets.size());
+    MPI_Bcast(packedSize.data(), packedSize.size(), MPI_INT64_T, ROOTP,
+              MPI_COMM_WORLD);
+  }
+  inp.SetIterationStart(iterNum);
+
   // variables to read from restart file
   vector<string> restartVars = {"density", "vel_x", "vel_y", "vel_z", "pressure"};
   if (numEqns == 7) {
@@ -496,40 +1073,75 @@ void ReadRestart(vector<procBlock> &vars, const string &restartName,
     restartVars.push_back("sdr");
   }
 
+  // find rows of cells of each block to read; all blocks at time n come first
+  // in the buffer, followed by all blocks at time n-1
+  const auto readSols = (inp.IsMultilevelInTime() && numSols == 2) ? 2 : 1;
+  vector<fileRun> runs;
+  auto bufferSize = 0LL;
+  for (auto ss = 0; ss < readSols && !isCompressed; ss++) {
+    for (const auto &blk : vars) {
+      const auto parent = layout.Parent(blk.GlobalPos());
+      const auto blkStart = offsets[ss * layout.NumParents() + parent];
+      for (auto kk = blk.StartK(); kk < blk.EndK(); kk++) {
+        for (auto jj = blk.StartJ(); jj < blk.EndJ(); jj++) {
+          const auto cell =
+              layout.ParentIndex(blk.GlobalPos(), blk.StartI(), jj, kk);
+          runs.push_back({static_cast<MPI_Offset>(blkStart + cell * numEqns *
+                                                  sizeof(double)),
+                          bufferSize, blk.NumI() * numEqns});
+          bufferSize += blk.NumI() * numEqns;
+        }
+      }
+    }
+  }
+
+  vector<double> buffer(bufferSize);
+  if (isCompressed) {
+    buffer = ReadCompressedRestart(fName, vars, layout, numEqns, readSols,
+                                   packedInfo, offsets, packedSize);
+  } else {
+    ReadCollective(fName, runs, buffer);
+  }
+  MPI_File_close(&fName);
+
   // loop over blocks and initialize
-  cout << "Reading solution from time n..." << endl;
+  if (rank == ROOTP) {
+    cout << "Reading solution from time n..." << endl;
+  }
+  auto resData = buffer.cbegin();
   for (auto &block : vars) {
-    block.ReadSolFromRestart(fName, inp, eos, suth, turb, restartVars);
+    block.ReadSolFromRestart(resData, inp, eos, suth, turb, restartVars);
   }
-  if (inp.IsMultilevelInTime() && numSols == 2) {
-    cout << "Reading solution from time n-1..." << endl;
+  if (readSols == 2) {
+    if (rank == ROOTP) {
+      cout << "Reading solution from time n-1..." << endl;
+    }
     for (auto &block : vars) {
-      block.ReadSolNm1FromRestart(fName, inp, eos, suth, turb, restartVars);
+      block.ReadSolNm1FromRestart(resData, inp, eos, suth, turb, restartVars);
     }
   }
 
-  // close restart file
-  fName.close();
-  cout << "Done with restart file" << endl << endl;
+  if (rank == ROOTP) {
+    cout << "Done with restart file" << endl << endl;
+  }
 }
 
 
 
 
-void WriteBlockDims(ofstream &outFile, const vector<procBlock> &vars,
+// function to write out the dimensions of the parent blocks
+void WriteBlockDims(ostream &outFile, const blockLayout &layout,
                     int numVars) {
   // write number of blocks to file
-  auto numBlks = static_cast<int>(vars.size());
+  auto numBlks = layout.NumParents();
   outFile.write(reinterpret_cast<char *>(&numBlks), sizeof(numBlks));
 
   // loop over all blocks and write out imax, jmax, kmax, numVars
   for (auto ll = 0; ll < numBlks; ll++) {
-    auto dumInt = vars[ll].NumI();
-    outFile.write(reinterpret_cast<char *>(&dumInt), sizeof(dumInt));
-    dumInt = vars[ll].NumJ();
-    outFile.write(reinterpret_cast<char *>(&dumInt), sizeof(dumInt));
-    dumInt = vars[ll].NumK();
-    outFile.write(reinterpret_cast<char *>(&dumInt), sizeof(dumInt));
+    auto dims = layout.ParentDims(ll);
+    outFile.write(reinterpret_cast<char *>(&dims[0]), sizeof(dims[0]));
+    outFile.write(reinterpret_cast<char *>(&dims[1]), sizeof(dims[1]));
+    outFile.write(reinterpret_cast<char *>(&dims[2]), sizeof(dims[2]));
 
     if (numVars > 0) {
       outFile.write(reinterpret_cast<char *>(&numVars), sizeof(numVars));
@@ -619,14 +1231,27 @@ void WriteRes(const input &inp, const int &iter) {
 
 // function to write out plot3d meta data for Paraview
 void WriteMeta(const input &inp, const int &iter) {
-  // open meta file
-  const string fMetaPostfix = ".p3d";
   const string fEnd = "_center";
-  const auto metaName = inp.SimNameRoot() + fEnd + fMetaPostfix;
-  ofstream metaFile(metaName, ios::out);
-
+  const auto metaName = inp.SimNameRoot() + fEnd + ".p3d";
   const auto gridName = inp.GridName() + fEnd + ".xyz";
   const auto funName = inp.SimNameRoot() + "_" + to_string(iter) + fEnd + ".fun";
+  WriteMeta(metaName, gridName, funName, inp.OutputVariables(), inp, iter);
+}
+
+// function to write out plot3d meta data for Paraview for the given grid and
+// function files
+void WriteMeta(const string &metaName, const string &gridName,
+               const string &funName, const set<string> &outputVars,
+               const input &inp, const int &iter) {
+  // metaName -- name of meta file
+  // gridName -- name of grid file
+  // funName -- name of function file
+  // outputVars -- variables in function file
+  // inp -- input variables
+  // iter -- iteration number of solution
+
+  // open meta file
+  ofstream metaFile(metaName, ios::out);
 
   // check to see if file opened correctly
   if (metaFile.fail()) {
@@ -635,13 +1260,14 @@ void WriteMeta(const input &inp, const int &iter) {
     exit(EXIT_FAILURE);
   }
 
-  const auto outputVars = inp.OutputVariables();
-
   // write to meta file
   metaFile << "{" << endl;
   metaFile << "\"auto-detect-format\" : true," << endl;
   metaFile << "\"format\" : \"binary\"," << endl;
   metaFile << "\"language\" : \"C\"," << endl;
+  if (inp.IsSinglePrecisionOutput()) {
+    metaFile << "\"precision\" : 32," << endl;
+  }
   metaFile << "\"filenames\" : [{ \"time\" : " << iter << ", \"xyz\" : \""
            << gridName << "\", \"function\" : \"" << funName << "\" }]," << endl;
 
@@ -750,93 +1376,3 @@ void PrintResiduals(const input &inp, genArray &residL2First,
 
   os.unsetf(std::ios::fixed | std::ios::scientific);
 }
-
-/*Function to take in a vector of split procBlocks and return a vector of joined
- * procblocks (in their original configuration before grid decomposition).*/
-vector<procBlock> Recombine(const vector<procBlock> &vars,
-                            const decomposition &decomp) {
-  // vars -- vector of split procBlocks
-  // decomp -- decomposition
-
-  auto recombVars = vars;
-  vector<boundarySurface> dumSurf;
-  for (auto ii = decomp.NumSplits() - 1; ii >= 0; ii--) {
-    // recombine blocks and resize vector
-    recombVars[decomp.SplitHistBlkLower(ii)]
-        .Join(recombVars[decomp.SplitHistBlkUpper(ii)], decomp.SplitHistDir(ii),
-              dumSurf);
-    recombVars.resize(recombVars.size() - 1);
-  }
-
-  return recombVars;
-}
-
-/*Function to take in indices from the recombined procBlocks and determine which
- * split procBlock index the cell is associated with.*/
-int SplitBlockNumber(const vector<procBlock> &vars, const decomposition &decomp,
-                     const int &blk, const int &ii, const int &jj,
-                     const int &kk) {
-  // vars -- vector of recombined procblocks
-  // decomp -- decomposition data structure
-  // blk -- block number
-  // ii -- i index of cell in recombined block to find split block number
-  // jj -- j index of cell in recombined block to find split block number
-  // kk -- k index of cell in recombined block to find split block number
-
-  // Get block dimensions (both lower and upper extents)
-  vector<pair<vector3d<int>, vector3d<int>>> blkDims(vars.size());
-  vector3d<int> initialLower(0, 0, 0);
-  for (auto bb = 0U; bb < blkDims.size(); bb++) {
-    vector3d<int> dims(vars[bb].NumI(), vars[bb].NumJ(), vars[bb].NumK());
-    blkDims[bb].first = initialLower;
-    blkDims[bb].second = dims;
-  }
-
-  auto ind = blk;
-
-  // no splits, cell must be in parent block already
-  if (decomp.NumSplits() == 0) {
-    return ind;
-  } else {  // cell is in lower split already
-    for (auto ss = 0; ss < decomp.NumSplits(); ss++) {  // loop over all splits
-      // wrong parent block - split won't effect search so use dummy value
-      if (blk != decomp.ParentBlock(ss + vars.size())) {
-        pair<vector3d<int>, vector3d<int>> dumBlk(initialLower, initialLower);
-        blkDims.push_back(dumBlk);
-      } else {
-        // "split" blocks - change lower limits of block
-        if (decomp.SplitHistDir(ss) == "i") {
-          pair<vector3d<int>, vector3d<int>> splitBlk =
-              blkDims[decomp.SplitHistBlkLower(ss)];
-          splitBlk.first[0] += decomp.SplitHistIndex(ss);
-          blkDims.push_back(splitBlk);
-        } else if (decomp.SplitHistDir(ss) == "j") {
-          pair<vector3d<int>, vector3d<int>> splitBlk =
-              blkDims[decomp.SplitHistBlkLower(ss)];
-          splitBlk.first[1] += decomp.SplitHistIndex(ss);
-          blkDims.push_back(splitBlk);
-        } else {  // direction is k
-          pair<vector3d<int>, vector3d<int>> splitBlk =
-              blkDims[decomp.SplitHistBlkLower(ss)];
-          splitBlk.first[2] += decomp.SplitHistIndex(ss);
-          blkDims.push_back(splitBlk);
-        }
-
-        // test to see if block is in upper split
-        if (!(ii <= blkDims[decomp.SplitHistBlkUpper(ss)].second.X() &&
-              jj <= blkDims[decomp.SplitHistBlkUpper(ss)].second.Y() &&
-              kk <= blkDims[decomp.SplitHistBlkUpper(ss)].second.Z() &&
-              ii >= blkDims[decomp.SplitHistBlkUpper(ss)].first.X() &&
-              jj >= blkDims[decomp.SplitHistBlkUpper(ss)].first.Y() &&
-              kk >= blkDims[decomp.SplitHistBlkUpper(ss)].first.Z())) {
-          // cell not in upper split, but in lower split - found block index
-          return decomp.SplitHistBlkLower(ss);
-        } else {  // cell in upper split (and lower split)
-          ind = decomp.SplitHistBlkUpper(ss);
-        }
-      }
-    }
-  }
-
-  return ind;  // cell was in uppermost split for given parent block
-}
@@ -20,6 +20,8 @@
 #include <vector>  // vector
 #include <string>  // string
 #include <memory>  // make_unique
+#include <limits>  // numeric_limits
+#include <cmath>   // sqrt
 #include "parallel.hpp"
 #include "output.hpp"
 #include "vector3d.hpp"            // vector3d
@@ -30,6 +32,7 @@
 #include "resid.hpp"               // resid
 #include "macros.hpp"
 #include "genArray.hpp"
+#include "kdtree.hpp"              // kdtree, MortonOrder
 
 using std::max_element;
 using std::min_element;
@@ -41,7 +44,7 @@ using std::make_unique;
 decomposition assumes that each block will reside on it's own processor.
 The processor list tells how many procBlocks a processor will have.
 */
-decomposition ManualDecomposition(vector<plot3dBlock> &grid,
+decomposition ManualDecomposition(vector<plot3dBlockRange> &grid,
                                   vector<boundaryConditions> &bcs,
                                   const int &numProc) {
   // grid -- vector of procBlocks (no need to split procBlocks or combine them
@@ -92,7 +95,7 @@ decomposition ManualDecomposition(vector<plot3dBlock> &grid,
 /* Function to return processor list for cubic decomposition.
 The processor list tells how many procBlocks a processor will have.
 */
-decomposition CubicDecomposition(vector<plot3dBlock> &grid,
+decomposition CubicDecomposition(vector<plot3dBlockRange> &grid,
                                  vector<boundaryConditions> &bcs,
                                  const int &numProc) {
   // grid -- vector of procBlocks (no need to split procBlocks or combine them
@@ -125,7 +128,7 @@ decomposition CubicDecomposition(vector<plot3dBlock> &grid,
       auto newBlk = static_cast<int>(grid.size());
 
       vector<boundarySurface> altSurf;
-      plot3dBlock lBlk, uBlk;
+      plot3dBlockRange lBlk, uBlk;
       grid[blk].Split(dir, ind, lBlk, uBlk);
       grid.push_back(uBlk);
       auto newBcs = bcs[blk].Split(dir, ind, blk, newBlk, altSurf);
@@ -172,13 +175,6 @@ decomposition CubicDecomposition(vector<plot3dBlock> &grid,
   return decomp;
 }
 
-// function to send each processor the number of procBlocks that it should
-// contain
-void SendNumProcBlocks(const vector<int> &loadBal, int &numProcBlock) {
-  MPI_Scatter(&loadBal[0], 1, MPI_INT, &numProcBlock, 1, MPI_INT, ROOTP,
-              MPI_COMM_WORLD);
-}
-
 // function to send each processor the vector of interblocks it needs to compute
 // its boundary conditions
 void SendConnections(vector<interblock> &connections,
@@ -345,131 +341,6 @@ void FreeDataTypesMPI(MPI_Datatype &MPI_vec3d, MPI_Datatype &MPI_cellData,
   MPI_Type_free(&MPI_interblock);
 }
 
-/* Function to send procBlocks to their appropriate processor. This function is
-called after the decomposition has been run. The procBlock data all
-resides on the ROOT processor. In this function, the ROOT processor packs the
-procBlocks and sends them to the appropriate processor. All the non-ROOT
-processors receive and unpack the data from ROOT. This is used to send the
-geometric block data from ROOT to all the processors at the beginning of the
-simulation.
-*/
-vector<procBlock> SendProcBlocks(const vector<procBlock> &blocks,
-                                 const int &rank, const int &numProcBlock,
-                                 const MPI_Datatype &MPI_cellData,
-                                 const MPI_Datatype &MPI_vec3d,
-                                 const MPI_Datatype &MPI_vec3dMag) {
-  // blocks -- full vector of all procBlocks. This is only used on ROOT
-  //           processor, all other processors just need a dummy variable to
-  //           call the function
-  // rank -- processor rank. Used to determine if process should send or
-  //         receive
-  // numProcBlock -- number of procBlocks that the processor should have. (All
-  //                 processors may give different values).
-  // MPI_cellData -- MPI_Datatype used for primVars and genArray transmission
-  // MPI_vec3d -- MPI_Datatype used for vector3d<double>  transmission
-  // MPI_vec3dMag -- MPI_Datatype used for unitVec3dMag<double>  transmission
-
-  // vector of procBlocks for each processor
-  vector<procBlock> localBlocks(numProcBlock);
-
-  //------------------------------------------------------------------------
-  //                                  ROOT
-  //------------------------------------------------------------------------
-  if (rank == ROOTP) {  // may have to pack and send data
-    // loop over ALL blocks
-    for (auto ii = 0U; ii < blocks.size(); ii++) {
-      // no need to send data because it is already on root processor
-      if (blocks[ii].Rank() == ROOTP) {
-        localBlocks[blocks[ii].LocalPosition()] = blocks[ii];
-      } else {  // send data to receiving processors
-        // pack and send procBlock
-        blocks[ii].PackSendGeomMPI(MPI_cellData, MPI_vec3d, MPI_vec3dMag);
-      }
-    }
-    //--------------------------------------------------------------------------
-    //                                NON - ROOT
-    //--------------------------------------------------------------------------
-  } else {  // receive and unpack data (non-root)
-    for (auto ii = 0; ii < numProcBlock; ii++) {
-      // recv and unpack procBlock
-      procBlock tempBlock;
-      tempBlock.RecvUnpackGeomMPI(MPI_cellData, MPI_vec3d, MPI_vec3dMag);
-
-      // add procBlock to output vector
-      localBlocks[tempBlock.LocalPosition()] = tempBlock;
-    }
-  }
-
-  return localBlocks;
-}
-
-/* Function to send procBlocks to the root processor. In this function, the
-non-ROOT processors pack the procBlocks and send them to the ROOT processor.
-The ROOT processor receives and unpacks the data from the non-ROOT processors.
-This is used to get all the data on the ROOT processor to write out results.
-*/
-void GetProcBlocks(vector<procBlock> &blocks,
-                   const vector<procBlock> &localBlocks, const int &rank,
-                   const MPI_Datatype &MPI_cellData,
-                   const MPI_Datatype &MPI_uncoupledScalar,
-                   const MPI_Datatype &MPI_vec3d,
-                   const MPI_Datatype &MPI_tensorDouble) {
-  // blocks -- full vector of all procBlocks. This is only used on ROOT
-  //           processor, all other processors just need a dummy variable to
-  //           call the function
-  // localBlocks -- procBlocks local to each processor. These are sent to ROOT
-  // rank -- processor rank. Used to determine if process should send or
-  //         receive
-  // MPI_cellData -- MPI_Datatype used for primVars and genArray transmission
-  // MPI_uncoupledScalar -- MPI_Datatype used for uncoupledScalar transmission
-  // MPI_vec3d -- MPI_Datatype used for vector3d<double> transmission
-  // MPI_tensorDouble -- MPI_Datatype used for tensor<double> transmission
-
-  //--------------------------------------------------------------------------
-  //                                      ROOT
-  //--------------------------------------------------------------------------
-  if (rank == ROOTP) {  // may have to recv and unpack data
-    for (auto ii = 0U; ii < blocks.size(); ii++) {  // loop over ALL blocks
-      if (blocks[ii].Rank() == ROOTP) {  // no need to recv data because it is
-                                        // already on ROOT processor
-        // assign local state block to global state block in order of local
-        // state vector
-        blocks[ii] = localBlocks[blocks[ii].LocalPosition()];
-      } else {  // recv data from sending processors
-        blocks[ii].RecvUnpackSolMPI(MPI_cellData, MPI_uncoupledScalar,
-                                    MPI_vec3d, MPI_tensorDouble);
-      }
-    }
-    //-------------------------------------------------------------------------
-    //                                   NON - ROOT
-    //-------------------------------------------------------------------------
-  } else {  // pack and send data (non-root)
-    // get vector of local positions
-    vector<int> localPos(localBlocks.size());
-    for (auto ii = 0U; ii < localPos.size(); ii++) {
-      localPos[ii] = localBlocks[ii].LocalPosition();
-    }
-
-    for (auto ii = 0U; ii < localBlocks.size(); ii++) {
-      // need to send data in order of global position, not local position to
-      // prevent deadlock
-      auto minGlobal = 0;
-      for (auto jj = 0U; jj < localPos.size(); jj++) {
-        if (localBlocks[localPos[jj]].GlobalPos() <
-            localBlocks[minGlobal].GlobalPos()) {
-          minGlobal = jj;
-        }
-      }
-
-      localBlocks[localPos[minGlobal]].PackSendSolMPI(MPI_cellData,
-                                                      MPI_uncoupledScalar,
-                                                      MPI_vec3d,
-                                                      MPI_tensorDouble);
-      localPos.erase(localPos.begin() + minGlobal);
-    }
-  }
-}
-
 /*function to broadcast a string from ROOT to all processors. This is needed
 because it is not garunteed in the MPI standard that the commmand
 line arguments will be on any processor but ROOT.  */
@@ -523,8 +394,8 @@ decomposition::decomposition(const int &num, const int &nProcs) {
 
 /*Member function to determine the ideal load given the mesh. The ideal load the
  * the total number of cells divided by the number of processors.*/
-double decomposition::IdealLoad(const vector<plot3dBlock> &grid) const {
-  // grid -- vector of plot3dBlocks containing entire grid
+double decomposition::IdealLoad(const vector<plot3dBlockRange> &grid) const {
+  // grid -- vector of plot3dBlockRanges containing entire grid
 
   auto totalCells = 0;
   for (auto ii = 0U; ii < grid.size(); ii++) {
@@ -537,8 +408,8 @@ double decomposition::IdealLoad(const vector<plot3dBlock> &grid) const {
 
 /*Member function to determine the maximum load (number of cells) on a
  * processor.*/
-double decomposition::MaxLoad(const vector<plot3dBlock> &grid) const {
-  // grid -- vector of plot3dBlocks containing entire grid (split for
+double decomposition::MaxLoad(const vector<plot3dBlockRange> &grid) const {
+  // grid -- vector of plot3dBlockRanges containing entire grid (split for
   // decomposition)
 
   vector<int> load(numProcs_, 0);
@@ -551,8 +422,8 @@ double decomposition::MaxLoad(const vector<plot3dBlock> &grid) const {
 
 /*Member function to determine the minimum load (number of cells) on a
  * processor.*/
-double decomposition::MinLoad(const vector<plot3dBlock> &grid) const {
-  // grid -- vector of plot3dBlocks containing entire grid (split for
+double decomposition::MinLoad(const vector<plot3dBlockRange> &grid) const {
+  // grid -- vector of plot3dBlockRanges containing entire grid (split for
   // decomposition)
 
   vector<int> load(numProcs_, 0);
@@ -565,9 +436,9 @@ double decomposition::MinLoad(const vector<plot3dBlock> &grid) const {
 
 /*Member function to determine the index of the maximum loaded (number of cells)
  * processor.*/
-int decomposition::MostOverloadedProc(const vector<plot3dBlock> &grid,
+int decomposition::MostOverloadedProc(const vector<plot3dBlockRange> &grid,
                                       double &overload) const {
-  // grid -- vector of plot3dBlocks containing entire grid (split for
+  // grid -- vector of plot3dBlockRanges containing entire grid (split for
   // decomposition)
   // overload -- how much the processor is overloaded by
 
@@ -582,9 +453,9 @@ int decomposition::MostOverloadedProc(const vector<plot3dBlock> &grid,
 
 /*Member function to determine the index of the minimum loaded (number of cells)
  * processor.*/
-int decomposition::MostUnderloadedProc(const vector<plot3dBlock> &grid,
+int decomposition::MostUnderloadedProc(const vector<plot3dBlockRange> &grid,
                                        double &underload) const {
-  // grid -- vector of plot3dBlocks containing entire grid (split for
+  // grid -- vector of plot3dBlockRanges containing entire grid (split for
   // decomposition)
   // underload -- how much processor is underloaded by
 
@@ -692,9 +563,9 @@ ostream &operator<<(ostream &os, const decomposition &d) {
   return os;
 }
 
-double decomposition::ProcLoad(const vector<plot3dBlock> &grid,
+double decomposition::ProcLoad(const vector<plot3dBlockRange> &grid,
                                const int &proc) const {
-  // grid -- vector of plot3dBlocks making up entire grid
+  // grid -- vector of plot3dBlockRanges making up entire grid
   // proc -- rank of processor to calculate load for
 
   auto load = 0;
@@ -706,9 +577,9 @@ double decomposition::ProcLoad(const vector<plot3dBlock> &grid,
   return static_cast<double>(load);
 }
 
-double decomposition::LoadRatio(const vector<plot3dBlock> &grid,
+double decomposition::LoadRatio(const vector<plot3dBlockRange> &grid,
                                 const int &proc) const {
-  // grid -- vector of plot3dBlocks making up entire grid
+  // grid -- vector of plot3dBlockRanges making up entire grid
   // proc -- rank of processor to calculate ratio for
 
   auto ideal = this->IdealLoad(grid);
@@ -721,10 +592,10 @@ from a given processor. If it is determined to send a split block, the index of
 the
 split is returned, and the direction string is changed to the appropriate value.
 If a whole block is to be sent, the index returned is -1.*/
-int decomposition::SendWholeOrSplit(const vector<plot3dBlock> &grid,
+int decomposition::SendWholeOrSplit(const vector<plot3dBlockRange> &grid,
                                     const int &send, const int &recv, int &blk,
                                     string &dir) const {
-  // grid -- vector of plot3dBlocks making up entire grid
+  // grid -- vector of plot3dBlockRanges making up entire grid
   // send -- rank of processor to sending block
   // recv -- rank of process to receive block
   // blk -- block to split or send
@@ -807,7 +678,8 @@ int decomposition::SendWholeOrSplit(const vector<plot3dBlock> &grid,
   return ind;
 }
 
-void decomposition::PrintDiagnostics(const vector<plot3dBlock> &grid) const {
+void decomposition::PrintDiagnostics(
+    const vector<plot3dBlockRange> &grid) const {
   cout << "Decomposition for " << numProcs_ << " processors" << endl;
   for (auto ii = 0U; ii < rank_.size(); ii++) {
     cout << "Block: " << ii << "; Rank: " << rank_[ii]
@@ -828,16 +700,286 @@ void decomposition::PrintDiagnostics(const vector<plot3dBlock> &grid) const {
   }
 }
 
+// member function to broadcast the decomposition from ROOT to all processors
+void decomposition::BroadcastMPI() {
+  // first determine the number of blocks and splits and send that to all
+  // processors
+  int sizes[3] = {this->Size(), this->NumSplits(), numProcs_};
+  MPI_Bcast(sizes, 3, MPI_INT, ROOTP, MPI_COMM_WORLD);
+
+  // allocate space to receive the decomposition
+  rank_.resize(sizes[0]);
+  parBlock_.resize(sizes[0]);
+  localPos_.resize(sizes[0]);
+  splitHistBlkLow_.resize(sizes[1]);
+  splitHistBlkUp_.resize(sizes[1]);
+  splitHistIndex_.resize(sizes[1]);
+  numProcs_ = sizes[2];
+
+  MPI_Bcast(rank_.data(), rank_.size(), MPI_INT, ROOTP, MPI_COMM_WORLD);
+  MPI_Bcast(parBlock_.data(), parBlock_.size(), MPI_INT, ROOTP,
+            MPI_COMM_WORLD);
+  MPI_Bcast(localPos_.data(), localPos_.size(), MPI_INT, ROOTP,
+            MPI_COMM_WORLD);
+  MPI_Bcast(splitHistBlkLow_.data(), splitHistBlkLow_.size(), MPI_INT, ROOTP,
+            MPI_COMM_WORLD);
+  MPI_Bcast(splitHistBlkUp_.data(), splitHistBlkUp_.size(), MPI_INT, ROOTP,
+            MPI_COMM_WORLD);
+  MPI_Bcast(splitHistIndex_.data(), splitHistIndex_.size(), MPI_INT, ROOTP,
+            MPI_COMM_WORLD);
+
+  // split directions are single characters (i, j, or k)
+  string dirs;
+  for (const auto &dir : splitHistDir_) {
+    dirs += dir;
+  }
+  dirs.resize(sizes[1]);
+  MPI_Bcast(&dirs[0], dirs.size(), MPI_CHAR, ROOTP, MPI_COMM_WORLD);
+  splitHistDir_.resize(sizes[1]);
+  for (auto ii = 0; ii < sizes[1]; ii++) {
+    splitHistDir_[ii] = string(1, dirs[ii]);
+  }
+}
+
+/* Function to broadcast the boundary conditions of all blocks from ROOT to all
+processors. They are packed into a single buffer and sent at once.
+*/
+void BroadcastBoundaryConditions(vector<boundaryConditions> &bcs) {
+  // bcs -- boundary conditions for all blocks (only needed on ROOT)
+
+  auto rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  // first determine the number of blocks and size of buffer and send that to
+  // all processors
+  int sizes[2] = {static_cast<int>(bcs.size()), 0};
+  for (const auto &bc : bcs) {
+    sizes[1] += bc.PackSize();
+  }
+  MPI_Bcast(sizes, 2, MPI_INT, ROOTP, MPI_COMM_WORLD);
+
+  auto *buffer = new char[sizes[1]];  // allocate buffer to pack data into
+  auto position = 0;
+  if (rank == ROOTP) {
+    for (const auto &bc : bcs) {
+      bc.PackBC(buffer, sizes[1], position);
+    }
+  }
+
+  MPI_Bcast(buffer, sizes[1], MPI_PACKED, ROOTP, MPI_COMM_WORLD);
+
+  if (rank != ROOTP) {
+    bcs.resize(sizes[0]);
+    for (auto &bc : bcs) {
+      bc.UnpackBC(buffer, sizes[1], position);
+    }
+  }
+
+  delete[] buffer;  // deallocate buffer
+}
+
 
-void BroadcastViscFaces(const MPI_Datatype &MPI_vec3d,
+/* Function to divide the viscous face centers found on each processor evenly
+among all processors. The faces on each processor are first ordered along a
+space filling curve. The list of all faces, ordered by processor, is then cut
+into equal parts, one for each processor. Each part is made of runs of faces
+that are close together, so the bounding box of each part stays small.
+*/
+void PartitionViscFaces(const MPI_Datatype &MPI_vec3d,
                         vector<vector3d<double>> &viscFaces) {
-  // first determine the number of viscous faces and send that to all processors
+  // MPI_vec3d -- MPI datatype for a vector3d<double>
+  // viscFaces -- viscous face centers on this processor, on output the part
+  //              of all viscous faces given to this processor
+
+  auto rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  auto numProcs = 1;
+  MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+
+  // order faces on this processor along a space filling curve
+  const auto order = MortonOrder(viscFaces);
+  vector<vector3d<double>> sorted;
+  sorted.reserve(order.size());
+  for (const auto &ind : order) {
+    sorted.push_back(viscFaces[ind]);
+  }
+
+  // determine the number of viscous faces on each processor, and the
+  // position of the first in the list of all faces
   auto nFaces = static_cast<int>(viscFaces.size());
-  MPI_Bcast(&nFaces, 1, MPI_INT, ROOTP, MPI_COMM_WORLD);
+  vector<int> counts(numProcs, 0);
+  MPI_Allgather(&nFaces, 1, MPI_INT, counts.data(), 1, MPI_INT,
+                MPI_COMM_WORLD);
+  vector<int> displs(numProcs, 0);
+  for (auto ii = 1; ii < numProcs; ii++) {
+    displs[ii] = displs[ii - 1] + counts[ii - 1];
+  }
+  const auto numFaces = displs.back() + counts.back();
+
+  // position in list of all faces of first face in part of each processor
+  auto PartStart = [&numFaces, &numProcs] (const int &pp) {
+    return static_cast<int>(static_cast<long long>(pp) * numFaces / numProcs);
+  };
+
+  // faces sent to each processor, and received from each processor
+  vector<int> sendCounts(numProcs, 0);
+  vector<int> sendDispls(numProcs, 0);
+  vector<int> recvCounts(numProcs, 0);
+  vector<int> recvDispls(numProcs, 0);
+  for (auto pp = 0; pp < numProcs; pp++) {
+    auto first = std::max(PartStart(pp), displs[rank]);
+    auto last = std::min(PartStart(pp + 1), displs[rank] + nFaces);
+    if (last > first) {
+      sendCounts[pp] = last - first;
+      sendDispls[pp] = first - displs[rank];
+    }
 
-  viscFaces.resize(nFaces);  // allocate space to receive the viscous faces
+    first = std::max(PartStart(rank), displs[pp]);
+    last = std::min(PartStart(rank + 1), displs[pp] + counts[pp]);
+    recvCounts[pp] = std::max(last - first, 0);
+    if (pp > 0) {
+      recvDispls[pp] = recvDispls[pp - 1] + recvCounts[pp - 1];
+    }
+  }
 
-  // broadcast all viscous faces to all processors
-  MPI_Bcast(&viscFaces[0], viscFaces.size(), MPI_vec3d, ROOTP,
-            MPI_COMM_WORLD);
+  vector<vector3d<double>> part(PartStart(rank + 1) - PartStart(rank));
+  MPI_Alltoallv(sorted.data(), sendCounts.data(), sendDispls.data(),
+                MPI_vec3d, part.data(), recvCounts.data(), recvDispls.data(),
+                MPI_vec3d, MPI_COMM_WORLD);
+  viscFaces = std::move(part);
+}
+
+/* Function to find the distance to the nearest viscous wall face of each point,
+when the viscous faces are divided among the processors by
+PartitionViscFaces(). Each processor holds a k-d tree of its part of the
+faces, and the bounding boxes of all parts are shared. First each point is
+searched for in the local part. The nearest face can be no farther away than
+this, or than the farthest corner of the bounding box of any part, since the
+part holds at least one face inside of its box. This bound decides which other
+parts may hold a closer face: a point is only sent to a processor if the box
+of its part is closer than the bound, and that processor only searches for
+faces closer than the bound. All of the points for a processor are sent in a
+single message, and the distances are returned the same way. The distance to
+a point is the smallest found, which is exactly the distance found by
+searching all of the faces at once.
+*/
+vector<double> NearestWallDistances(const kdtree &tree,
+                                    const vector<vector3d<double>> &pts) {
+  // tree -- k-d tree of viscous faces on this processor
+  // pts -- points to find distance to nearest viscous face for
+
+  auto rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  auto numProcs = 1;
+  MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+
+  // share bounding box and number of faces of each part
+  constexpr auto boxSize = 7;
+  vector<double> boxes(boxSize * numProcs, 0.0);
+  if (tree.Size() > 0) {
+    for (auto dd = 0; dd < 3; dd++) {
+      boxes[boxSize * rank + dd] = tree.Lower()[dd];
+      boxes[boxSize * rank + 3 + dd] = tree.Upper()[dd];
+    }
+  }
+  boxes[boxSize * rank + 6] = tree.Size();
+  MPI_Allgather(MPI_IN_PLACE, boxSize, MPI_DOUBLE, boxes.data(), boxSize,
+                MPI_DOUBLE, MPI_COMM_WORLD);
+
+  // distance squared from point to nearest and farthest point of a box; the
+  // terms are summed in the same order as vector3d::DistSq() so that the
+  // nearest distance is never more than the distance to a face in the box
+  auto BoxDistSq = [&boxes] (const vector3d<double> &pt, const int &pp,
+                             const bool &farthest) {
+    const auto *box = &boxes[boxSize * pp];
+    vector3d<double> offset;
+    for (auto dd = 0; dd < 3; dd++) {
+      const auto below = box[dd] - pt[dd];
+      const auto above = pt[dd] - box[3 + dd];
+      offset[dd] = farthest ? std::max(-below, -above) :
+          std::max(std::max(below, above), 0.0);
+    }
+    return offset.MagSq();
+  };
+
+  // search local part, and decide which other parts to search
+  auto distances = (tree.Size() > 0) ? tree.NearestDistances(pts) :
+      vector<double>(pts.size(), std::numeric_limits<double>::max());
+  vector<vector<int>> sent(numProcs);
+  vector<vector<double>> queries(numProcs);
+  for (auto ii = 0U; ii < pts.size(); ii++) {
+    auto bound = distances[ii];
+    for (auto pp = 0; pp < numProcs; pp++) {
+      if (boxes[boxSize * pp + 6] > 0) {
+        bound = std::min(bound,
+                         sqrt(BoxDistSq(pts[ii], pp, true)) * (1.0 + 1.0e-10));
+      }
+    }
+    const auto boundSq = bound * bound * (1.0 + 1.0e-10);
+    for (auto pp = 0; pp < numProcs; pp++) {
+      if (pp != rank && boxes[boxSize * pp + 6] > 0 &&
+          BoxDistSq(pts[ii], pp, false) < boundSq) {
+        sent[pp].push_back(ii);
+        queries[pp].insert(std::end(queries[pp]),
+                           {pts[ii].X(), pts[ii].Y(), pts[ii].Z(), bound});
+      }
+    }
+  }
+
+  // send points to other processors; each is sent as its coordinates and
+  // bound
+  vector<int> sendCounts(numProcs, 0);
+  vector<int> sendDispls(numProcs, 0);
+  vector<double> sendBuf;
+  for (auto pp = 0; pp < numProcs; pp++) {
+    sendCounts[pp] = sent[pp].size();
+    sendDispls[pp] = (pp > 0) ? sendDispls[pp - 1] + sendCounts[pp - 1] : 0;
+    sendBuf.insert(std::end(sendBuf), std::begin(queries[pp]),
+                   std::end(queries[pp]));
+  }
+  vector<int> recvCounts(numProcs, 0);
+  vector<int> recvDispls(numProcs, 0);
+  MPI_Alltoall(sendCounts.data(), 1, MPI_INT, recvCounts.data(), 1, MPI_INT,
+               MPI_COMM_WORLD);
+  for (auto pp = 1; pp < numProcs; pp++) {
+    recvDispls[pp] = recvDispls[pp - 1] + recvCounts[pp - 1];
+  }
+  const auto numRecv = recvDispls.back() + recvCounts.back();
+
+  // counts and displacements of the coordinates and bounds
+  auto Scale = [] (const vector<int> &vec, const int &factor) {
+    auto scaled = vec;
+    for (auto &val : scaled) {
+      val *= factor;
+    }
+    return scaled;
+  };
+  vector<double> recvBuf(4 * numRecv);
+  MPI_Alltoallv(sendBuf.data(), Scale(sendCounts, 4).data(),
+                Scale(sendDispls, 4).data(), MPI_DOUBLE, recvBuf.data(),
+                Scale(recvCounts, 4).data(), Scale(recvDispls, 4).data(),
+                MPI_DOUBLE, MPI_COMM_WORLD);
+
+  // search local part for points from other processors
+  vector<vector3d<double>> recvPts(numRecv);
+  vector<double> recvBounds(numRecv);
+  for (auto ii = 0; ii < numRecv; ii++) {
+    recvPts[ii] = {recvBuf[4 * ii], recvBuf[4 * ii + 1], recvBuf[4 * ii + 2]};
+    recvBounds[ii] = recvBuf[4 * ii + 3];
+  }
+  const auto found = tree.NearestDistances(recvPts, recvBounds);
+
+  // return distances to processors that sent points
+  vector<double> results(sendBuf.size() / 4);
+  MPI_Alltoallv(found.data(), recvCounts.data(), recvDispls.data(),
+                MPI_DOUBLE, results.data(), sendCounts.data(),
+                sendDispls.data(), MPI_DOUBLE, MPI_COMM_WORLD);
+
+  for (auto pp = 0; pp < numProcs; pp++) {
+    for (auto ss = 0U; ss < sent[pp].size(); ss++) {
+      auto &dist = distances[sent[pp][ss]];
+      dist = std::min(dist, results[sendDispls[pp] + ss]);
+    }
+  }
+  return distances;
 }
@@ -0,0 +1,342 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-17  Michael Nucci (michael.nucci@gmail.com)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#include <iostream>   // cerr
+#include <algorithm>  // sort, max
+#include <vector>     // vector
+#include <string>     // string
+#include "parallelIO.hpp"
+#include "plot3d.hpp"              // plot3dBlockRange
+#include "boundaryConditions.hpp"  // decomposition
+#include "macros.hpp"
+
+using std::cerr;
+using std::endl;
+using std::max;
+
+/* Constructor to find the location of each procBlock within its parent block.
+The blocks of the grid are given in their global order after decomposition.
+The location of each split block is found by replaying the split history of the
+decomposition; the upper block of a split starts at the split index of the
+lower block.
+*/
+blockLayout::blockLayout(const vector<plot3dBlockRange> &blocks,
+                         const decomposition &decomp)
+    : parent_(blocks.size()), start_(blocks.size()), dims_(blocks.size()) {
+  // blocks -- blocks of grid after decomposition
+  // decomp -- decomposition of grid
+
+  for (auto ss = 0; ss < decomp.NumSplits(); ss++) {
+    auto upperStart = start_[decomp.SplitHistBlkLower(ss)];
+    const auto dir = decomp.SplitHistDir(ss);
+    if (dir == "i") {
+      upperStart[0] += decomp.SplitHistIndex(ss);
+    } else if (dir == "j") {
+      upperStart[1] += decomp.SplitHistIndex(ss);
+    } else if (dir == "k") {
+      upperStart[2] += decomp.SplitHistIndex(ss);
+    } else {
+      cerr << "ERROR: Error in blockLayout::blockLayout(). Direction " << dir
+           << " is not recognized! Choose either i, j, or k." << endl;
+      exit(EXIT_FAILURE);
+    }
+    start_[decomp.SplitHistBlkUpper(ss)] = upperStart;
+  }
+
+  // parent block extends to the end of its furthest split
+  parentDims_.resize(blocks.size() - decomp.NumSplits());
+  for (auto bb = 0U; bb < blocks.size(); bb++) {
+    parent_[bb] = decomp.ParentBlock(bb);
+    // number of cells is 1 less than number of points
+    dims_[bb] = {blocks[bb].NumI() - 1, blocks[bb].NumJ() - 1,
+                 blocks[bb].NumK() - 1};
+    auto &dims = parentDims_[parent_[bb]];
+    dims[0] = max(dims[0], start_[bb][0] + dims_[bb][0]);
+    dims[1] = max(dims[1], start_[bb][1] + dims_[bb][1]);
+    dims[2] = max(dims[2], start_[bb][2] + dims_[bb][2]);
+  }
+
+  this->CountCells();
+}
+
+// member function to find the number of cells in the parent blocks preceding
+// each parent block
+void blockLayout::CountCells() {
+  cellsBefore_.assign(parentDims_.size() + 1, 0);
+  for (auto pp = 0U; pp < parentDims_.size(); pp++) {
+    cellsBefore_[pp + 1] = cellsBefore_[pp] +
+        static_cast<long long>(parentDims_[pp][0]) * parentDims_[pp][1] *
+        parentDims_[pp][2];
+  }
+}
+
+// member function to return the index within its parent block of a cell in a
+// procBlock
+long long blockLayout::ParentIndex(const int &blk, const int &ii,
+                                   const int &jj, const int &kk) const {
+  // blk -- global position of procBlock
+  // ii -- i-index of cell in procBlock (physical cells only)
+  // jj -- j-index of cell in procBlock (physical cells only)
+  // kk -- k-index of cell in procBlock (physical cells only)
+
+  const auto &dims = parentDims_[parent_[blk]];
+  return (start_[blk][0] + ii) +
+      static_cast<long long>(start_[blk][1] + jj) * dims[0] +
+      static_cast<long long>(start_[blk][2] + kk) * dims[0] * dims[1];
+}
+
+// member function to broadcast the layout from ROOT to all processors
+void blockLayout::BroadcastMPI() {
+  // first determine the number of blocks and send that to all processors
+  int numBlocks[2] = {this->NumBlocks(), this->NumParents()};
+  MPI_Bcast(numBlocks, 2, MPI_INT, ROOTP, MPI_COMM_WORLD);
+
+  // allocate space to receive the layout
+  parent_.resize(numBlocks[0]);
+  start_.resize(numBlocks[0]);
+  dims_.resize(numBlocks[0]);
+  parentDims_.resize(numBlocks[1]);
+
+  // vector3d<int> is stored as 3 contiguous ints
+  MPI_Bcast(parent_.data(), parent_.size(), MPI_INT, ROOTP, MPI_COMM_WORLD);
+  MPI_Bcast(start_.data(), 3 * start_.size(), MPI_INT, ROOTP, MPI_COMM_WORLD);
+  MPI_Bcast(dims_.data(), 3 * dims_.size(), MPI_INT, ROOTP, MPI_COMM_WORLD);
+  MPI_Bcast(parentDims_.data(), 3 * parentDims_.size(), MPI_INT, ROOTP,
+            MPI_COMM_WORLD);
+
+  this->CountCells();
+}
+
+/* Function to create the datatypes describing runs of values in a file and
+in a buffer. The runs are sorted by their location in the file and joined where
+they are contiguous in both the file and the buffer. They are then described to
+MPI-IO with one indexed datatype for the file and one for the buffer, so each
+processor can transfer all of its data in a single collective call.
+*/
+void CreateRunTypes(vector<fileRun> &runs, const MPI_Datatype &valueType,
+                    MPI_Datatype &fileType, MPI_Datatype &bufferType) {
+  // runs -- location of data in file and buffer
+  // valueType -- datatype of values in runs
+  // fileType -- output datatype for file view
+  // bufferType -- output datatype for buffer
+
+  // file view must be in increasing order of location in file
+  std::sort(std::begin(runs), std::end(runs),
+            [](const fileRun &a, const fileRun &b) { return a.file_ < b.file_; });
+
+  auto valueSize = 0;
+  MPI_Type_size(valueType, &valueSize);
+
+  vector<int> sizes;
+  vector<MPI_Aint> fileDisp, bufferDisp;
+  sizes.reserve(runs.size());
+  fileDisp.reserve(runs.size());
+  bufferDisp.reserve(runs.size());
+  for (const auto &run : runs) {
+    const MPI_Aint bufferLoc = run.buffer_ * valueSize;
+    const MPI_Aint prevBytes =
+        sizes.empty() ? 0 : static_cast<MPI_Aint>(sizes.back()) * valueSize;
+    if (!sizes.empty() && fileDisp.back() + prevBytes == run.file_ &&
+        bufferDisp.back() + prevBytes == bufferLoc) {
+      // run continues previous run in file and buffer
+      sizes.back() += run.size_;
+    } else {
+      sizes.push_back(run.size_);
+      fileDisp.push_back(run.file_);
+      bufferDisp.push_back(bufferLoc);
+    }
+  }
+
+  MPI_Type_create_hindexed(sizes.size(), sizes.data(), fileDisp.data(),
+                           valueType, &fileType);
+  MPI_Type_commit(&fileType);
+  MPI_Type_create_hindexed(sizes.size(), sizes.data(), bufferDisp.data(),
+                           valueType, &bufferType);
+  MPI_Type_commit(&bufferType);
+}
+
+// function to open a file for writing by all processors; ROOT writes the
+// header of the file
+MPI_File OpenCollective(const string &fileName, const string &header,
+                        const MPI_Offset &fileSize) {
+  // fileName -- name of file to write
+  // header -- bytes at start of file (only used on ROOT)
+  // fileSize -- total size of file in bytes
+
+  auto rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  MPI_File outFile;
+  if (MPI_File_open(MPI_COMM_WORLD, fileName.c_str(),
+                    MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL,
+                    &outFile) != MPI_SUCCESS) {
+    cerr << "ERROR: Error in OpenCollective(). File " << fileName
+         << " did not open correctly!!!" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // remove any old data past the end of the file
+  MPI_File_set_size(outFile, fileSize);
+
+  if (rank == ROOTP) {
+    MPI_File_write_at(outFile, 0, header.data(), header.size(), MPI_CHAR,
+                      MPI_STATUS_IGNORE);
+  }
+  return outFile;
+}
+
+// function to write a file with data from all processors; ROOT writes the
+// header of the file, and every processor writes its runs of values
+void WriteCollective(const string &fileName, const string &header,
+                     const MPI_Offset &fileSize, vector<fileRun> &runs,
+                     const void *buffer, const MPI_Datatype &valueType) {
+  // fileName -- name of file to write
+  // header -- bytes at start of file (only used on ROOT)
+  // fileSize -- total size of file in bytes
+  // runs -- location of data in file and buffer
+  // buffer -- data to write
+  // valueType -- datatype of values in buffer
+
+  auto outFile = OpenCollective(fileName, header, fileSize);
+
+  MPI_Datatype fileType, bufferType;
+  CreateRunTypes(runs, valueType, fileType, bufferType);
+
+  // processors without any data still take part in the collective write
+  MPI_File_set_view(outFile, 0, MPI_BYTE, fileType, "native", MPI_INFO_NULL);
+  MPI_File_write_all(outFile, buffer, runs.empty() ? 0 : 1, bufferType,
+                     MPI_STATUS_IGNORE);
+
+  MPI_Type_free(&fileType);
+  MPI_Type_free(&bufferType);
+  MPI_File_close(&outFile);
+}
+
+/* Member functions to write a file with data from all processors. In blocking
+mode the file is written before returning. In snapshot mode the writer takes the
+staging buffer (leaving the given buffer empty) and starts a nonblocking
+collective write; the buffer is kept until the write is completed by Wait().
+*/
+void outputWriter::Write(const string &fileName, const string &header,
+                         const MPI_Offset &fileSize, vector<fileRun> &runs,
+                         vector<double> &buffer) {
+  // fileName -- name of file to write
+  // header -- bytes at start of file (only used on ROOT)
+  // fileSize -- total size of file in bytes
+  // runs -- location of data in file and buffer
+  // buffer -- staged data to write
+
+  if (method_ == outputMethod::blocking) {
+    WriteCollective(fileName, header, fileSize, runs, buffer.data(),
+                    MPI_DOUBLE);
+    return;
+  }
+
+  pendingWrite write;
+  write.buffer_.swap(buffer);
+  this->Start(write, fileName, header, fileSize, runs, write.buffer_.data(),
+              MPI_DOUBLE);
+}
+
+void outputWriter::Write(const string &fileName, const string &header,
+                         const MPI_Offset &fileSize, vector<fileRun> &runs,
+                         vector<float> &buffer) {
+  // fileName -- name of file to write
+  // header -- bytes at start of file (only used on ROOT)
+  // fileSize -- total size of file in bytes
+  // runs -- location of data in file and buffer
+  // buffer -- staged data to write
+
+  if (method_ == outputMethod::blocking) {
+    WriteCollective(fileName, header, fileSize, runs, buffer.data(),
+                    MPI_FLOAT);
+    return;
+  }
+
+  pendingWrite write;
+  write.floatBuffer_.swap(buffer);
+  this->Start(write, fileName, header, fileSize, runs,
+              write.floatBuffer_.data(), MPI_FLOAT);
+}
+
+// member function to open a file and start a nonblocking write of the data
+// staged in the given write
+void outputWriter::Start(pendingWrite &write, const string &fileName,
+                         const string &header, const MPI_Offset &fileSize,
+                         vector<fileRun> &runs, const void *data,
+                         const MPI_Datatype &valueType) {
+  // write -- write holding staged data
+  // fileName -- name of file to write
+  // header -- bytes at start of file (only used on ROOT)
+  // fileSize -- total size of file in bytes
+  // runs -- location of data in file and buffer
+  // data -- start of staged data
+  // valueType -- datatype of values in staged data
+
+  write.name_ = fileName;
+  write.file_ = OpenCollective(fileName, header, fileSize);
+  CreateRunTypes(runs, valueType, write.fileType_, write.bufferType_);
+
+  MPI_File_set_view(write.file_, 0, MPI_BYTE, write.fileType_, "native",
+                    MPI_INFO_NULL);
+  MPI_File_iwrite_all(write.file_, data, runs.empty() ? 0 : 1,
+                      write.bufferType_, &write.request_);
+
+  // moving the write does not move the data in its buffer
+  pending_.push_back(std::move(write));
+}
+
+// member function to let pending writes progress; some MPI libraries only
+// advance nonblocking I/O when a request is tested
+void outputWriter::Progress() {
+  for (auto &write : pending_) {
+    auto done = 0;
+    MPI_Test(&write.request_, &done, MPI_STATUS_IGNORE);
+  }
+}
+
+// member function to wait for all pending writes to finish and close their
+// files; closing is collective, so all processors wait in the same order
+void outputWriter::Wait() {
+  for (auto &write : pending_) {
+    MPI_Wait(&write.request_, MPI_STATUS_IGNORE);
+    MPI_Type_free(&write.fileType_);
+    MPI_Type_free(&write.bufferType_);
+    MPI_File_close(&write.file_);
+  }
+  pending_.clear();
+}
+
+// function to read runs of doubles from a file opened by all processors
+void ReadCollective(MPI_File &inFile, vector<fileRun> &runs,
+                    vector<double> &buffer) {
+  // inFile -- file to read from
+  // runs -- location of data in file and buffer
+  // buffer -- buffer to read data into (already sized)
+
+  MPI_Datatype fileType, bufferType;
+  CreateRunTypes(runs, MPI_DOUBLE, fileType, bufferType);
+
+  MPI_File_set_view(inFile, 0, MPI_BYTE, fileType, "native", MPI_INFO_NULL);
+  MPI_File_read_all(inFile, buffer.data(), runs.empty() ? 0 : 1, bufferType,
+                    MPI_STATUS_IGNORE);
+
+  // reset view so file can be read by byte offset again
+  MPI_File_set_view(inFile, 0, MPI_BYTE, MPI_BYTE, "native", MPI_INFO_NULL);
+
+  MPI_Type_free(&fileType);
+  MPI_Type_free(&bufferType);
+}
@@ -19,7 +19,9 @@
 #include <cstdlib>
 #include <string>
 #include <vector>
+#include <algorithm>  // max
 #include "plot3d.hpp"
+#include "parallelIO.hpp"  // ReadCollective
 
 using std::cout;
 using std::cerr;
@@ -427,91 +429,276 @@ multiArray3d<vector3d<double>> plot3dBlock::FaceCenterK() const {
 }
 
 //------------------------------------------------------------------------------
-// function to read in a plot3d grid and assign it to a plot3dMesh data type
-vector<plot3dBlock> ReadP3dGrid(const string &gridName, const double &LRef,
-                                double &numCells) {
-  // open binary plot3d grid file
-  ifstream fName;
-  string fPostfix = ".xyz";
-  auto readName = gridName + fPostfix;
+// function to open a plot3d grid file for binary reading
+void OpenP3dGrid(const string &gridName, ifstream &fName) {
+  // gridName -- name of grid (without extension)
+  // fName -- stream to open
+
+  const auto readName = gridName + ".xyz";
   fName.open(readName, ios::in | ios::binary);
 
   // check to see if file opened correctly
   if (fName.fail()) {
-    cerr << "ERROR: Error in plot3d.cpp:ReadP3dGrid(). Grid file " << readName
+    cerr << "ERROR: Error in plot3d.cpp:OpenP3dGrid(). Grid file " << readName
          << " did not open correctly!!!" << endl;
     exit(EXIT_FAILURE);
   }
+}
+
+/* Function to read the header of a plot3d grid file. The header holds the
+number of blocks and the number of points in each direction of every block.
+No coordinates are read, so the grid can be decomposed before it is loaded.
+The coordinates of each block follow the header, stored as all x values, then
+all y values, then all z values.
+*/
+vector<vector3d<int>> ReadP3dGridHeader(const string &gridName) {
+  // gridName -- name of grid (without extension)
 
-  // read the number of plot3d blocks in the file
-  cout << "Reading grid file..." << endl << endl;
-  auto numBlks = 1;
+  ifstream fName;
+  OpenP3dGrid(gridName, fName);
+
+  auto numBlks = 0;
   fName.read(reinterpret_cast<char *>(&numBlks), sizeof(numBlks));
-  cout << "Number of blocks: " << numBlks << endl << endl;
 
-  // read the number of i, j, k coordinates in each plot3d block
+  // vector3d<int> is stored as 3 contiguous ints, the same as in the file
+  vector<vector3d<int>> dims(numBlks);
+  fName.read(reinterpret_cast<char *>(dims.data()),
+             dims.size() * sizeof(dims[0]));
+
+  if (fName.fail()) {
+    cerr << "ERROR: Error in plot3d.cpp:ReadP3dGridHeader(). Header of grid "
+         << "file " << gridName << ".xyz is incomplete!" << endl;
+    exit(EXIT_FAILURE);
+  }
+  return dims;
+}
+
+//------------------------------------------------------------------------------
+// function to find the location of the coordinates of each block in a plot3d
+// grid file
+vector<std::streamoff> P3dBlockLocations(const vector<vector3d<int>> &dims) {
+  // dims -- number of points in each block
+
+  vector<std::streamoff> blkStart(dims.size());
+  std::streamoff loc = sizeof(int) + dims.size() * sizeof(dims[0]);
+  for (auto bb = 0U; bb < dims.size(); bb++) {
+    blkStart[bb] = loc;
+    loc += 3LL * dims[bb][0] * dims[bb][1] * dims[bb][2] * sizeof(double);
+  }
+  return blkStart;
+}
+
+//------------------------------------------------------------------------------
+// constructor to read the header of a plot3d grid file
+plot3dGridFile::plot3dGridFile(const string &gridName, const double &LRef)
+    : name_(gridName), lRef_(LRef), dims_(ReadP3dGridHeader(gridName)),
+      blkStart_(P3dBlockLocations(dims_)) {
+  // gridName -- name of grid (without extension)
+  // LRef -- reference length to nondimensionalize coordinates by
+
+  OpenP3dGrid(gridName, file_);
+}
+
+// member function to get a block range for each whole block in the grid file;
+// the size of each block is printed
+vector<plot3dBlockRange> plot3dGridFile::Blocks(double &numCells) const {
+  // numCells -- output total number of cells in grid
+
+  cout << "Reading grid file header..." << endl << endl;
+  cout << "Number of blocks: " << this->NumBlocks() << endl << endl;
+
   cout << "Size of each block is..." << endl;
-  vector<int> vecI(numBlks, 0);
-  vector<int> vecJ(numBlks, 0);
-  vector<int> vecK(numBlks, 0);
-  auto tempInt = 0;
   numCells = 0;
-
-  // loop over all blocks and fill i, j, k vectors with block sizes
-  for (auto ii = 0; ii < numBlks; ii++) {
+  vector<plot3dBlockRange> blocks;
+  blocks.reserve(this->NumBlocks());
+  for (auto ii = 0; ii < this->NumBlocks(); ii++) {
     cout << "Block Number: " << ii << "     ";
-    fName.read(reinterpret_cast<char *>(&tempInt), sizeof(tempInt));
-    vecI[ii] = tempInt;
-    cout << "I-DIM: " << tempInt << "     ";
-    fName.read(reinterpret_cast<char *>(&tempInt), sizeof(tempInt));
-    vecJ[ii] = tempInt;
-    cout << "J-DIM: " << tempInt << "     ";
-    fName.read(reinterpret_cast<char *>(&tempInt), sizeof(tempInt));
-    vecK[ii] = tempInt;
-    cout << "K-DIM: " << tempInt << endl;
+    cout << "I-DIM: " << dims_[ii][0] << "     ";
+    cout << "J-DIM: " << dims_[ii][1] << "     ";
+    cout << "K-DIM: " << dims_[ii][2] << endl;
+
+    blocks.emplace_back(*this, ii, vector3d<int>(0, 0, 0), dims_[ii]);
 
     // calculate total number of cells (subtract 1 because number of cells is 1
     // less than number of points)
-    numCells += (vecI[ii] - 1) * (vecJ[ii] - 1) * (vecK[ii] - 1);
+    numCells += blocks.back().NumCells();
   }
   cout << endl;
+  cout << "Total number of cells is " << numCells << endl;
 
-  // read each block and add it to the vector of plot3dBlocks
-  auto tempDouble = 0.0;
-  vector<plot3dBlock> mesh;
-  mesh.reserve(numBlks);
-
-  for (auto ii = 0; ii < numBlks; ii++) {
-    multiArray3d<vector3d<double>> coordinates(vecI[ii], vecJ[ii], vecK[ii], 0);
+  return blocks;
+}
 
-    for (auto jj = 0; jj < coordinates.Size(); jj++) {
-      fName.read(reinterpret_cast<char *>(&tempDouble), sizeof(tempDouble));
-      coordinates(jj)[0] = tempDouble / LRef;
-    }
-    for (auto jj = 0; jj < coordinates.Size(); jj++) {
-      fName.read(reinterpret_cast<char *>(&tempDouble), sizeof(tempDouble));
-      coordinates(jj)[1] = tempDouble / LRef;
-    }
-    for (auto jj = 0; jj < coordinates.Size(); jj++) {
-      fName.read(reinterpret_cast<char *>(&tempDouble), sizeof(tempDouble));
-      coordinates(jj)[2] = tempDouble / LRef;
-    }
+// member function to read the coordinates of a single point from the grid file
+vector3d<double> plot3dGridFile::Coords(const int &blk, const int &ii,
+                                        const int &jj, const int &kk) const {
+  // blk -- block of grid file
+  // ii -- i-index of point within block
+  // jj -- j-index of point within block
+  // kk -- k-index of point within block
+
+  const auto &dims = dims_[blk];
+  if (ii < 0 || ii >= dims[0] || jj < 0 || jj >= dims[1] || kk < 0 ||
+      kk >= dims[2]) {
+    cerr << "ERROR: Error in plot3dGridFile::Coords(). Point " << ii << ", "
+         << jj << ", " << kk << " is outside of block " << blk
+         << " with dimensions " << dims << "!" << endl;
+    exit(EXIT_FAILURE);
+  }
 
-    // create single plot3dBlock and assign it appropriate location in vector
-    mesh.push_back(plot3dBlock(coordinates));
+  // file stores all x, then all y, then all z coordinates of a block
+  const auto blkPts = static_cast<std::streamoff>(dims[0]) * dims[1] * dims[2];
+  const auto pt = ii + jj * static_cast<std::streamoff>(dims[0]) +
+      kk * static_cast<std::streamoff>(dims[0]) * dims[1];
+  vector3d<double> coords;
+  for (auto dd = 0; dd < 3; dd++) {
+    auto val = 0.0;
+    file_.seekg(blkStart_[blk] + (dd * blkPts + pt) *
+                static_cast<std::streamoff>(sizeof(val)));
+    file_.read(reinterpret_cast<char *>(&val), sizeof(val));
+    coords[dd] = val / lRef_;
+  }
 
-    cout << "Block " << ii << " read" << endl;
+  if (file_.fail()) {
+    cerr << "ERROR: Error in plot3dGridFile::Coords(). Grid file " << name_
+         << ".xyz ended before block " << blk << " was read!" << endl;
+    exit(EXIT_FAILURE);
   }
+  return coords;
+}
 
-  cout << endl << "Grid file read" << endl;
-  cout << "Total number of cells is " << numCells << endl;
+// member function to read the coordinates of a point in the block range from
+// the grid file
+vector3d<double> plot3dBlockRange::Coords(const int &ii, const int &jj,
+                                          const int &kk) const {
+  // ii -- i-index of point within range
+  // jj -- j-index of point within range
+  // kk -- k-index of point within range
+
+  return grid_->Coords(parent_, start_[0] + ii, start_[1] + jj,
+                       start_[2] + kk);
+}
+
+/* Member function to split a plot3dBlockRange along a plane defined by a
+direction and an index. The plane of points at the index is in both ranges, the
+same as when a plot3dBlock is split.
+*/
+void plot3dBlockRange::Split(const string &dir, const int &ind,
+                             plot3dBlockRange &blk1,
+                             plot3dBlockRange &blk2) const {
+  // dir -- plane to split along, either i, j, or k
+  // ind -- index (face) to split at (w/o counting ghost cells)
+
+  auto dd = 0;
+  if (dir == "i") {
+    dd = 0;
+  } else if (dir == "j") {
+    dd = 1;
+  } else if (dir == "k") {
+    dd = 2;
+  } else {
+    cerr << "ERROR: Error in plot3dBlockRange::Split(). Direction " << dir
+         << " is not recognized! Choose either i, j, or k." << endl;
+    exit(EXIT_FAILURE);
+  }
 
-  // close plot3d grid file
-  fName.close();
+  blk1 = *this;
+  blk1.numPts_[dd] = ind + 1;
 
-  return mesh;
+  blk2 = *this;
+  blk2.start_[dd] += ind;
+  blk2.numPts_[dd] -= ind;
 }
 
+/* Function to read ranges of points from the blocks of a plot3d grid file.
+This is used by each processor to read only the points of its own procBlocks,
+and must be called by all processors. Each range is given by the block it comes
+from, the index of its first point, and its number of points in each
+direction. Each line of points in the i-direction is contiguous in the file, so
+the lines of all ranges are read in a single collective read.
+*/
+vector<plot3dBlock> ReadP3dGridRanges(const string &gridName,
+                                      const double &LRef,
+                                      const vector<int> &blocks,
+                                      const vector<vector3d<int>> &starts,
+                                      const vector<vector3d<int>> &numPts) {
+  // gridName -- name of grid (without extension)
+  // LRef -- reference length to nondimensionalize coordinates by
+  // blocks -- block of grid file that each range is in
+  // starts -- index of first point of each range
+  // numPts -- number of points in each direction of each range
+
+  const auto dims = ReadP3dGridHeader(gridName);
+  const auto blkStart = P3dBlockLocations(dims);
+
+  // find lines of points of each range to read; each range is stored in the
+  // buffer as all x, then all y, then all z coordinates
+  vector<fileRun> runs;
+  vector<long long> rangeStart(blocks.size());
+  auto bufferSize = 0LL;
+  for (auto rr = 0U; rr < blocks.size(); rr++) {
+    const auto &blkDims = dims[blocks[rr]];
+    const auto &st = starts[rr];
+    const auto &np = numPts[rr];
+    if (st[0] + np[0] > blkDims[0] || st[1] + np[1] > blkDims[1] ||
+        st[2] + np[2] > blkDims[2]) {
+      cerr << "ERROR: Error in plot3d.cpp:ReadP3dGridRanges(). Range "
+           << st << " + " << np << " is outside of block " << blocks[rr]
+           << " with dimensions " << blkDims << "!" << endl;
+      exit(EXIT_FAILURE);
+    }
+
+    rangeStart[rr] = bufferSize;
+    const auto blkPts = static_cast<MPI_Offset>(blkDims[0]) * blkDims[1] *
+        blkDims[2];
+    for (auto dd = 0; dd < 3; dd++) {
+      for (auto kk = 0; kk < np[2]; kk++) {
+        for (auto jj = 0; jj < np[1]; jj++) {
+          // location of first point of line within block
+          const auto pt = st[0] + (st[1] + jj) * blkDims[0] +
+              (st[2] + kk) * static_cast<MPI_Offset>(blkDims[0]) * blkDims[1];
+          runs.push_back({blkStart[blocks[rr]] + (dd * blkPts + pt) *
+                          static_cast<MPI_Offset>(sizeof(double)),
+                          bufferSize, np[0]});
+          bufferSize += np[0];
+        }
+      }
+    }
+  }
+
+  const auto readName = gridName + ".xyz";
+  MPI_File fName;
+  if (MPI_File_open(MPI_COMM_WORLD, readName.c_str(), MPI_MODE_RDONLY,
+                    MPI_INFO_NULL, &fName) != MPI_SUCCESS) {
+    cerr << "ERROR: Error in plot3d.cpp:ReadP3dGridRanges(). Grid file "
+         << readName << " did not open correctly!!!" << endl;
+    exit(EXIT_FAILURE);
+  }
+  vector<double> buffer(bufferSize);
+  ReadCollective(fName, runs, buffer);
+  MPI_File_close(&fName);
+
+  vector<plot3dBlock> ranges;
+  ranges.reserve(blocks.size());
+  for (auto rr = 0U; rr < blocks.size(); rr++) {
+    const auto &np = numPts[rr];
+    const auto rangePts = static_cast<long long>(np[0]) * np[1] * np[2];
+    multiArray3d<vector3d<double>> coordinates(np[0], np[1], np[2], 0);
+    auto pt = rangeStart[rr];
+    for (auto kk = 0; kk < np[2]; kk++) {
+      for (auto jj = 0; jj < np[1]; jj++) {
+        for (auto ii = 0; ii < np[0]; ii++, pt++) {
+          for (auto dd = 0; dd < 3; dd++) {
+            coordinates(ii, jj, kk)[dd] = buffer[pt + dd * rangePts] / LRef;
+          }
+        }
+      }
+    }
+    ranges.push_back(plot3dBlock(coordinates));
+  }
+
+  return ranges;
+}
 
 /* Member function to split a plot3dBlock along a plane defined by a direction
 and an index.
@@ -169,10 +169,11 @@ R = ((Ui - Ui-1) / dP) / ((Ui+1 - Ui) / dM)
 Ui+1/2 = Ui + 0.25 * ((Ui - Ui-1) / dM) * ( (1-K) * L  + (1+K) * R * Linv )
 
 */
+template <limiterMethod L>
 primVars primVars::FaceReconMUSCL(const primVars &primUW2,
                                   const primVars &primDW1, const double &kappa,
-                                  const string &lim, const double &uw,
-                                  const double &uw2, const double &dw) const {
+                                  const double &uw, const double &uw2,
+                                  const double &dw) const {
   // primUW2 -- upwind cell furthest from the face at which the primative is
   //            being reconstructed.
   // primUW1 -- upwind cell nearest to the face at which the primative is
@@ -195,18 +196,15 @@ primVars primVars::FaceReconMUSCL(const primVars &primUW2,
 
   primVars limiter;
   primVars invLimiter;
-  if (lim == "none") {
+  if (L == limiterMethod::none) {
     limiter = LimiterNone();
     invLimiter = limiter;
-  } else if (lim == "vanAlbada") {
+  } else if (L == limiterMethod::vanAlbada) {
     limiter = LimiterVanAlbada(r);
     invLimiter = LimiterVanAlbada(1.0 / r);
-  } else if (lim == "minmod") {
+  } else {  // minmod
     limiter = LimiterMinmod(primUW1 - primUW2, primDW1 - primUW1, kappa);
     invLimiter = limiter / r;
-  } else {
-    cerr << "ERROR: Limiter " << lim << " is not recognized!" << endl;
-    exit(EXIT_FAILURE);
   }
 
   // calculate reconstructed state at face using MUSCL method with limiter
@@ -214,6 +212,83 @@ primVars primVars::FaceReconMUSCL(const primVars &primUW2,
     ((1.0 - kappa) * limiter + (1.0 + kappa) * r * invLimiter);
 }
 
+// explicit instantiations for all limiters
+template primVars primVars::FaceReconMUSCL<limiterMethod::none>(
+    const primVars &, const primVars &, const double &, const double &,
+    const double &, const double &) const;
+template primVars primVars::FaceReconMUSCL<limiterMethod::vanAlbada>(
+    const primVars &, const primVars &, const double &, const double &,
+    const double &, const double &) const;
+template primVars primVars::FaceReconMUSCL<limiterMethod::minmod>(
+    const primVars &, const primVars &, const double &, const double &,
+    const double &, const double &) const;
+
+/* Function to reconstruct one variable to the faces of a run of neighboring
+faces with the MUSCL scheme. This is the same calculation as
+primVars::FaceReconMUSCL() for a single variable, written as a loop over the
+faces so the compiler vectorizes it. The values and cell widths of the stencil
+cells of the faces are given as arrays that are indexed by face, so they can
+point directly into the variable planes of structure of arrays storage. The
+limiters are calculated with the same operations in the same order as
+LimiterNone(), LimiterVanAlbada(), and LimiterMinmod().
+*/
+template <limiterMethod L>
+void FaceReconMUSCL(const double *varUW2, const double *varUW1,
+                    const double *varDW1, const double *uw2,
+                    const double *uw, const double *dw, const double &kappa,
+                    const int &numFaces, double *face) {
+  // varUW2 -- variable at upwind cell furthest from each face
+  // varUW1 -- variable at upwind cell nearest to each face
+  // varDW1 -- variable at downwind cell of each face
+  // uw2 -- length of furthest upwind cell of each face
+  // uw -- length of nearest upwind cell of each face
+  // dw -- length of downwind cell of each face
+  // kappa -- parameter that determines which scheme is implemented
+  // numFaces -- number of faces to reconstruct
+  // face -- reconstructed variable at each face
+
+  // minmod parameter beta
+  const auto beta = (3.0 - kappa) / (1.0 - kappa);
+
+#pragma omp simd
+  for (auto ff = 0; ff < numFaces; ff++) {
+    const auto dPlus = (uw[ff] + uw[ff]) / (uw[ff] + dw[ff]);
+    const auto dMinus = (uw[ff] + uw[ff]) / (uw[ff] + uw2[ff]);
+
+    // divided differences to base limiter on
+    const auto r = (EPS + (varDW1[ff] - varUW1[ff]) * dPlus) /
+        (EPS + (varUW1[ff] - varUW2[ff]) * dMinus);
+
+    auto limiter = 1.0;
+    auto invLimiter = 1.0;
+    if (L == limiterMethod::vanAlbada) {
+      limiter = max(0.0, (r + r * r) / (1 + r * r));
+      const auto rInv = 1.0 / r;
+      invLimiter = max(0.0, (rInv + rInv * rInv) / (1 + rInv * rInv));
+    } else if (L == limiterMethod::minmod) {
+      const auto upwind = varUW1[ff] - varUW2[ff];
+      const auto downwind = varDW1[ff] - varUW1[ff];
+      const auto sign = (upwind > 0.0) ? 1.0 : ((upwind < 0.0) ? -1.0 : 0.0);
+      limiter = sign * max(0.0, min(fabs(upwind), sign * downwind * beta));
+      invLimiter = limiter / r;
+    }
+
+    face[ff] = varUW1[ff] + 0.25 * ((varUW1[ff] - varUW2[ff]) * dMinus) *
+        ((1.0 - kappa) * limiter + (1.0 + kappa) * r * invLimiter);
+  }
+}
+
+// explicit instantiations for all limiters
+template void FaceReconMUSCL<limiterMethod::none>(
+    const double *, const double *, const double *, const double *,
+    const double *, const double *, const double &, const int &, double *);
+template void FaceReconMUSCL<limiterMethod::vanAlbada>(
+    const double *, const double *, const double *, const double *,
+    const double *, const double *, const double &, const int &, double *);
+template void FaceReconMUSCL<limiterMethod::minmod>(
+    const double *, const double *, const double *, const double *,
+    const double *, const double *, const double &, const int &, double *);
+
 // member function for higher order reconstruction via weno
 primVars primVars::FaceReconWENO(const primVars &upwind2,
                                  const primVars &upwind3,
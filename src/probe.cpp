@@ -0,0 +1,294 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-17  Michael Nucci (michael.nucci@gmail.com)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#include <iostream>     // cout, cerr
+#include <fstream>      // ofstream, ifstream
+#include <vector>       // vector
+#include <string>       // string
+#include <limits>       // numeric_limits
+#include <algorithm>    // max
+#include <cmath>        // sqrt
+#include "mpi.h"        // parallelism
+#include "probe.hpp"
+#include "procBlock.hpp"  // procBlock
+#include "input.hpp"      // input
+#include "macros.hpp"     // ROOTP
+
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::ios;
+using std::ofstream;
+using std::ifstream;
+
+// constructor -- locate probes given in input file and open probe file
+probeSeries::probeSeries(const vector<procBlock> &vars, const input &inp,
+                         const idealGas &eqnState, const sutherland &suth)
+    : fileName_(inp.SimNameRoot() + ".probe"),
+      variables_(inp.ProbeVariables()),
+      bufferSize_(inp.ProbeBufferSize()) {
+  // vars -- procBlocks on this processor
+  // inp -- input variables
+  // eqnState -- equation of state
+  // suth -- sutherland's law for viscosity
+
+  if (inp.ProbeLocations().empty()) {
+    return;
+  }
+
+  // grid is nondimensionalized by reference length
+  for (const auto &loc : inp.ProbeLocations()) {
+    locations_.push_back(loc / inp.LRef());
+  }
+  kernels_ = OutputKernels(variables_, inp, eqnState, suth);
+  this->Locate(vars);
+
+  auto rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  if (rank == ROOTP) {
+    cout << "Located " << this->NumProbes() << " probes" << endl << endl;
+
+    // on restart, samples are appended to existing probe file
+    ifstream probeFile(fileName_, ios::in | ios::binary);
+    if (inp.IsRestart() && probeFile) {
+      auto numProbes = 0;
+      auto numVars = 0;
+      probeFile.read(reinterpret_cast<char *>(&numProbes), sizeof(numProbes));
+      probeFile.read(reinterpret_cast<char *>(&numVars), sizeof(numVars));
+      if (numProbes != this->NumProbes() || numVars != this->NumVariables()) {
+        cerr << "ERROR: Error in probeSeries::probeSeries(). Probe file "
+             << fileName_ << " has " << numProbes << " probes and " << numVars
+             << " variables, but " << this->NumProbes() << " probes and "
+             << this->NumVariables() << " variables are specified!" << endl;
+        exit(EXIT_FAILURE);
+      }
+    } else {
+      this->WriteHeader(inp.LRef());
+    }
+  }
+}
+
+/* Member function to find the processor, block, and cells used to interpolate
+each probe. Each processor finds the nearest cell center to each probe in its
+own blocks, and the probe is owned by the processor with the nearest cell
+center overall. The owning processor interpolates the probe from the nearest
+cell and its neighboring cells with inverse distance weighting.
+*/
+void probeSeries::Locate(const vector<procBlock> &vars) {
+  // vars -- procBlocks on this processor
+
+  auto rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  // distance squared to nearest cell center, and rank it is on; layout
+  // matches MPI_DOUBLE_INT
+  struct {
+    double dist_;
+    int rank_;
+  } initial = {std::numeric_limits<double>::max(), rank};
+  vector<decltype(initial)> nearest(this->NumProbes(), initial);
+  vector<int> nearestBlock(this->NumProbes(), -1);
+  vector<vector3d<int>> nearestCell(this->NumProbes());
+
+  for (auto pp = 0; pp < this->NumProbes(); pp++) {
+    for (auto bb = 0U; bb < vars.size(); bb++) {
+      const auto &blk = vars[bb];
+      for (auto kk = blk.StartK(); kk < blk.EndK(); kk++) {
+        for (auto jj = blk.StartJ(); jj < blk.EndJ(); jj++) {
+          for (auto ii = blk.StartI(); ii < blk.EndI(); ii++) {
+            const auto dist = (blk.Center(ii, jj, kk) - locations_[pp]).MagSq();
+            if (dist < nearest[pp].dist_) {
+              nearest[pp].dist_ = dist;
+              nearestBlock[pp] = bb;
+              nearestCell[pp] = {ii, jj, kk};
+            }
+          }
+        }
+      }
+    }
+  }
+
+  // find processor with nearest cell center to each probe
+  MPI_Allreduce(MPI_IN_PLACE, nearest.data(), this->NumProbes(),
+                MPI_DOUBLE_INT, MPI_MINLOC, MPI_COMM_WORLD);
+
+  for (auto pp = 0; pp < this->NumProbes(); pp++) {
+    if (nearest[pp].rank_ != rank) {
+      continue;
+    }
+    const auto &blk = vars[nearestBlock[pp]];
+    localProbe probe;
+    probe.probe_ = pp;
+    probe.block_ = nearestBlock[pp];
+
+    // nearest cell and its neighbors within the block
+    const auto &cell = nearestCell[pp];
+    probe.cells_.push_back(cell);
+
+    // a probe inside the domain is within a cell width of the nearest cell
+    // center, so a probe farther away than that is outside of the grid
+    const auto cellSize = std::max(
+        {blk.CellWidthI(cell[0], cell[1], cell[2]),
+         blk.CellWidthJ(cell[0], cell[1], cell[2]),
+         blk.CellWidthK(cell[0], cell[1], cell[2])});
+    if (nearest[pp].dist_ > cellSize * cellSize) {
+      cerr << "WARNING: Probe " << pp << " at " << locations_[pp]
+           << " is outside of the grid. It is " << sqrt(nearest[pp].dist_)
+           << " from the nearest cell center, which has a cell size of "
+           << cellSize << ". It will be interpolated from the nearest cells."
+           << endl;
+    }
+
+    const vector3d<int> start(blk.StartI(), blk.StartJ(), blk.StartK());
+    const vector3d<int> end(blk.EndI(), blk.EndJ(), blk.EndK());
+    for (auto dd = 0; dd < 3; dd++) {
+      for (auto step : {-1, 1}) {
+        auto neighbor = cell;
+        neighbor[dd] += step;
+        if (neighbor[dd] >= start[dd] && neighbor[dd] < end[dd]) {
+          probe.cells_.push_back(neighbor);
+        }
+      }
+    }
+
+    // inverse distance weights; probe at a cell center takes its value
+    if (nearest[pp].dist_ == 0.0) {
+      probe.cells_.resize(1);
+      probe.weights_.push_back(1.0);
+    } else {
+      auto total = 0.0;
+      for (const auto &nb : probe.cells_) {
+        const auto weight = 1.0 /
+            (blk.Center(nb[0], nb[1], nb[2]) - locations_[pp]).MagSq();
+        probe.weights_.push_back(weight);
+        total += weight;
+      }
+      for (auto &weight : probe.weights_) {
+        weight /= total;
+      }
+    }
+
+    local_.push_back(probe);
+  }
+}
+
+// member function to write the header of the probe file
+void probeSeries::WriteHeader(const double &lRef) const {
+  // lRef -- reference length
+
+  ofstream probeFile(fileName_, ios::out | ios::binary);
+  if (probeFile.fail()) {
+    cerr << "ERROR: Error in probeSeries::WriteHeader(). Probe file "
+         << fileName_ << " did not open correctly!" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  auto numProbes = this->NumProbes();
+  auto numVars = this->NumVariables();
+  probeFile.write(reinterpret_cast<char *>(&numProbes), sizeof(numProbes));
+  probeFile.write(reinterpret_cast<char *>(&numVars), sizeof(numVars));
+  for (const auto &var : variables_) {
+    int length = var.size();
+    probeFile.write(reinterpret_cast<char *>(&length), sizeof(length));
+    probeFile.write(var.data(), length);
+  }
+  for (const auto &loc : locations_) {
+    for (auto dd = 0; dd < 3; dd++) {
+      auto coord = loc[dd] * lRef;
+      probeFile.write(reinterpret_cast<char *>(&coord), sizeof(coord));
+    }
+  }
+}
+
+/* Member function to record the variables at all probes. Each processor stores
+the probes it owns, and leaves the others as zero. When the buffer is full the
+samples are written to the probe file.
+*/
+void probeSeries::Sample(const vector<procBlock> &vars, const int &iter) {
+  // vars -- procBlocks on this processor
+  // iter -- iteration number of solution
+
+  if (this->NumProbes() == 0) {
+    return;
+  }
+
+  const auto numVars = this->NumVariables();
+  const auto stride = this->NumProbes() * numVars;
+  iterations_.push_back(iter);
+  samples_.resize(samples_.size() + stride, 0.0);
+  auto *sample = &samples_[samples_.size() - stride];
+
+  for (const auto &probe : local_) {
+    const auto &blk = vars[probe.block_];
+    for (auto vv = 0; vv < numVars; vv++) {
+      auto value = 0.0;
+      for (auto cc = 0U; cc < probe.cells_.size(); cc++) {
+        const auto &cell = probe.cells_[cc];
+        auto cellValue = 0.0;
+        kernels_[vv](blk, cell, cell + 1, &cellValue);
+        value += probe.weights_[cc] * cellValue;
+      }
+      sample[probe.probe_ * numVars + vv] = value;
+    }
+  }
+
+  if (this->NumSamples() >= bufferSize_) {
+    this->Flush();
+  }
+}
+
+/* Member function to write the buffered samples to the probe file. The samples
+from all processors are summed onto ROOT (each probe is only nonzero on its
+owner), which appends them to the probe file in a single write.
+*/
+void probeSeries::Flush() {
+  if (this->NumSamples() == 0) {
+    return;
+  }
+
+  auto rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  if (rank == ROOTP) {
+    MPI_Reduce(MPI_IN_PLACE, samples_.data(), samples_.size(), MPI_DOUBLE,
+               MPI_SUM, ROOTP, MPI_COMM_WORLD);
+
+    // interleave iteration numbers with samples
+    const auto stride = this->NumProbes() * this->NumVariables();
+    vector<double> records;
+    records.reserve(iterations_.size() + samples_.size());
+    for (auto ss = 0; ss < this->NumSamples(); ss++) {
+      records.push_back(iterations_[ss]);
+      records.insert(std::end(records), std::begin(samples_) + ss * stride,
+                     std::begin(samples_) + (ss + 1) * stride);
+    }
+
+    ofstream probeFile(fileName_, ios::out | ios::binary | ios::app);
+    if (probeFile.fail()) {
+      cerr << "ERROR: Error in probeSeries::Flush(). Probe file " << fileName_
+           << " did not open correctly!" << endl;
+      exit(EXIT_FAILURE);
+    }
+    probeFile.write(reinterpret_cast<char *>(records.data()),
+                    records.size() * sizeof(double));
+  } else {
+    // receive buffer is only used on ROOT
+    MPI_Reduce(samples_.data(), nullptr, samples_.size(), MPI_DOUBLE,
+               MPI_SUM, ROOTP, MPI_COMM_WORLD);
+  }
+
+  iterations_.clear();
+  samples_.clear();
+}
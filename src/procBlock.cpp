@@ -19,6 +19,11 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <limits>                 // numeric_limits
+#include <cstring>                // memcpy
+#ifdef _OPENMP
+#include <omp.h>                  // omp_get_thread_num
+#endif
 #include "procBlock.hpp"
 #include "plot3d.hpp"              // plot3d
 #include "eos.hpp"                 // idealGas
@@ -33,6 +38,7 @@
 #include "fluxJacobian.hpp"
 #include "kdtree.hpp"
 #include "utility.hpp"
+#include "haloExchange.hpp"
 
 using std::cout;
 using std::endl;
@@ -49,7 +55,10 @@ procBlock::procBlock(const double &aRef, const plot3dBlock &blk,
                      const int &numBlk, const boundaryConditions &bound,
                      const int &pos, const int &r, const int &lpos,
                      const input &inp, const idealGas &eos,
-                     const sutherland &suth) {
+                     const sutherland &suth)
+    : procBlock(aRef, vector3d<int>(blk.NumI() - 1, blk.NumJ() - 1,
+                                    blk.NumK() - 1),
+                numBlk, bound, pos, r, lpos, inp, eos, suth) {
   // blk -- plot3d block of which this procBlock is a subset of
   // numBlk -- the block number of blk (the parent block)
   // bound -- boundary conditions for block
@@ -60,6 +69,33 @@ procBlock::procBlock(const double &aRef, const plot3dBlock &blk,
   // eos -- equation of state
   // suth -- sutherland's law for viscosity
 
+  vol_ = PadWithGhosts(blk.Volume(), numGhosts_);
+  center_ = PadWithGhosts(blk.Centroid(), numGhosts_);
+  fAreaI_ = PadWithGhosts(blk.FaceAreaI(), numGhosts_);
+  fAreaJ_ = PadWithGhosts(blk.FaceAreaJ(), numGhosts_);
+  fAreaK_ = PadWithGhosts(blk.FaceAreaK(), numGhosts_);
+  fCenterI_ = PadWithGhosts(blk.FaceCenterI(), numGhosts_);
+  fCenterJ_ = PadWithGhosts(blk.FaceCenterJ(), numGhosts_);
+  fCenterK_ = PadWithGhosts(blk.FaceCenterK(), numGhosts_);
+}
+
+// constructor -- initialize procBlock without geometry; the geometry is
+// allocated but must be filled (e.g. from a geometry cache) before use
+procBlock::procBlock(const double &aRef, const vector3d<int> &dims,
+                     const int &numBlk, const boundaryConditions &bound,
+                     const int &pos, const int &r, const int &lpos,
+                     const input &inp, const idealGas &eos,
+                     const sutherland &suth) {
+  // dims -- number of cells in block in each direction
+  // numBlk -- the block number of the parent block
+  // bound -- boundary conditions for block
+  // pos -- global position of block, an identifying number unique to this block
+  // r -- processor rank_ that procBlock should be on
+  // lpos -- local position of block on processor
+  // inp -- input variables
+  // eos -- equation of state
+  // suth -- sutherland's law for viscosity
+
   numGhosts_ = inp.NumberGhostLayers();
   parBlock_ = numBlk;
 
@@ -68,19 +104,21 @@ procBlock::procBlock(const double &aRef, const plot3dBlock &blk,
   localPos_ = lpos;
 
   bc_ = bound;
+  this->ClassifyFaces();
 
   isViscous_ = inp.IsViscous();
   isTurbulent_ = inp.IsTurbulent();
-  storeTimeN_ = (inp.IsImplicit() || inp.TimeIntegration() == "rk4");
+  storeTimeN_ = (inp.IsImplicit() ||
+                 inp.TimeIntegrationMethod() == timeIntegrationMethod::rk4);
   isMultiLevelTime_ = inp.IsMultilevelInTime();
 
   // get initial condition state for parent block
   auto ic = inp.ICStateForBlock(parBlock_);
 
   // dimensions for multiArray3d located at cell centers
-  const auto numI = blk.NumI() - 1;
-  const auto numJ = blk.NumJ() - 1;
-  const auto numK = blk.NumK() - 1;
+  const auto numI = dims.X();
+  const auto numJ = dims.Y();
+  const auto numK = dims.Z();
 
   // get nondimensional state for initialization
   primVars inputState;
@@ -100,14 +138,14 @@ procBlock::procBlock(const double &aRef, const plot3dBlock &blk,
     consVarsNm1_ = {1, 1, 1, 0};
   }
 
-  vol_ = PadWithGhosts(blk.Volume(), numGhosts_);
-  center_ = PadWithGhosts(blk.Centroid(), numGhosts_);
-  fAreaI_ = PadWithGhosts(blk.FaceAreaI(), numGhosts_);
-  fAreaJ_ = PadWithGhosts(blk.FaceAreaJ(), numGhosts_);
-  fAreaK_ = PadWithGhosts(blk.FaceAreaK(), numGhosts_);
-  fCenterI_ = PadWithGhosts(blk.FaceCenterI(), numGhosts_);
-  fCenterJ_ = PadWithGhosts(blk.FaceCenterJ(), numGhosts_);
-  fCenterK_ = PadWithGhosts(blk.FaceCenterK(), numGhosts_);
+  vol_ = {numI, numJ, numK, numGhosts_};
+  center_ = {numI, numJ, numK, numGhosts_};
+  fAreaI_ = {numI + 1, numJ, numK, numGhosts_};
+  fAreaJ_ = {numI, numJ + 1, numK, numGhosts_};
+  fAreaK_ = {numI, numJ, numK + 1, numGhosts_};
+  fCenterI_ = {numI + 1, numJ, numK, numGhosts_};
+  fCenterJ_ = {numI, numJ + 1, numK, numGhosts_};
+  fCenterK_ = {numI, numJ, numK + 1, numGhosts_};
 
   cellWidthI_ = {1, 1, 1, 0};
   cellWidthJ_ = {1, 1, 1, 0};
@@ -118,6 +156,7 @@ procBlock::procBlock(const double &aRef, const plot3dBlock &blk,
   specRadius_ = {numI, numJ, numK, 0};
   dt_ = {numI, numJ, numK, 0};
   residual_ = {numI, numJ, numK, 0};
+  this->OrderHyperplanes();
 
   const auto inputTemperature = inputState.Temperature(eos);
   temperature_ = {numI, numJ, numK, numGhosts_, inputTemperature};
@@ -196,6 +235,7 @@ procBlock::procBlock(const int &ni, const int &nj, const int &nk,
   fCenterJ_ = {ni, nj + 1, nk, numGhosts_};
   fCenterK_ = {ni, nj, nk + 1, numGhosts_};
   residual_ = {ni, nj, nk, 0};
+  this->OrderHyperplanes();
   vol_ = {ni, nj, nk, numGhosts_};
   wallDist_ = {ni, nj, nk, numGhosts_, DEFAULTWALLDIST};
 
@@ -241,15 +281,96 @@ void procBlock::AddToResidual(const inviscidFlux &flux, const int &ii,
   // jj -- j-location of residual to add to
   // kk -- k-location of residual to add to
 
-  residual_(ii, jj, kk)[0] += flux.RhoVel();
-  residual_(ii, jj, kk)[1] += flux.RhoVelU();
-  residual_(ii, jj, kk)[2] += flux.RhoVelV();
-  residual_(ii, jj, kk)[3] += flux.RhoVelW();
-  residual_(ii, jj, kk)[4] += flux.RhoVelH();
-  residual_(ii, jj, kk)[5] += flux.RhoVelK();
-  residual_(ii, jj, kk)[6] += flux.RhoVelO();
+  auto &&resid = residual_(ii, jj, kk);
+  resid[0] += flux.RhoVel();
+  resid[1] += flux.RhoVelU();
+  resid[2] += flux.RhoVelV();
+  resid[3] += flux.RhoVelW();
+  resid[4] += flux.RhoVelH();
+  resid[5] += flux.RhoVelK();
+  resid[6] += flux.RhoVelO();
+}
+
+// member function to determine if a cell is updated by the interior or halo
+// pass of the inviscid fluxes; the interior pass updates the cells in
+// [lower, upper) and the halo pass updates the rest, see CalcInvFlux()
+bool procBlock::InPass(const vector3d<int> &cell, const vector3d<int> &lower,
+                       const vector3d<int> &upper,
+                       const bool &interior) const {
+  // cell -- location of cell
+  // lower -- lower corner of interior cells
+  // upper -- one past upper corner of interior cells
+  // interior -- flag for interior pass instead of halo pass
+
+  const auto isInterior = cell.X() >= lower.X() && cell.X() < upper.X() &&
+                          cell.Y() >= lower.Y() && cell.Y() < upper.Y() &&
+                          cell.Z() >= lower.Z() && cell.Z() < upper.Z();
+  return isInterior == interior;
 }
 
+#ifdef SOA_FIELDS
+/* Member function to add the inviscid fluxes of a batch of faces to the
+residuals of the cells on each side of the faces. The area vector points from
+the lower cell to the upper cell, so the flux is added to the lower cell and
+subtracted from the upper cell. Faces on the lower boundary have no lower cell
+to add to, and faces on the upper boundary have no upper cell to subtract from.
+Only cells in the current pass are updated (see InPass()). The residual is
+updated one variable plane at a time.
+*/
+void procBlock::AddToResidual(const fluxBatch &batch,
+                              const vector3d<int> *faces, const int &numFaces,
+                              const vector3d<int> &dir,
+                              const multiArray3d<unitVec3dMag<double>> &fArea,
+                              const vector3d<int> &lowerCell,
+                              const vector3d<int> &upperCell,
+                              const bool &interior) {
+  // batch -- batch of faces with numerical fluxes calculated
+  // faces -- index of each face in batch
+  // numFaces -- number of faces in batch
+  // dir -- index offset from a face to the cell on its upper side
+  // fArea -- face areas in direction of faces
+  // lowerCell -- lower corner of interior cells
+  // upperCell -- one past upper corner of interior cells
+  // interior -- flag for interior pass instead of halo pass
+
+  const auto dd = (dir.Y() == 1) ? 1 : ((dir.Z() == 1) ? 2 : 0);
+  const vector3d<int> physStart(fArea.PhysStartI(), fArea.PhysStartJ(),
+                                fArea.PhysStartK());
+  const vector3d<int> physEnd(fArea.PhysEndI(), fArea.PhysEndJ(),
+                              fArea.PhysEndK());
+
+  // location of cells on each side of each face; -1 if there is no cell or it
+  // is not in this pass
+  int lower[FLUXBATCH], upper[FLUXBATCH];
+  double areaMag[FLUXBATCH];
+  for (auto ff = 0; ff < numFaces; ff++) {
+    const auto &face = faces[ff];
+    const auto cell = face - dir;
+    lower[ff] = (face[dd] > physStart[dd] &&
+                 this->InPass(cell, lowerCell, upperCell, interior)) ?
+        residual_.Loc1D(cell.X(), cell.Y(), cell.Z()) : -1;
+    upper[ff] = (face[dd] < physEnd[dd] - 1 &&
+                 this->InPass(face, lowerCell, upperCell, interior)) ?
+        residual_.Loc1D(face.X(), face.Y(), face.Z()) : -1;
+    areaMag[ff] = fArea(face.X(), face.Y(), face.Z()).Mag();
+  }
+
+  for (auto vv = 0; vv < NUMVARS; vv++) {
+    auto *resid = residual_.Plane(vv);
+    const auto *flux = batch.FluxVar(vv);
+    for (auto ff = 0; ff < numFaces; ff++) {
+      const auto fluxArea = flux[ff] * areaMag[ff];
+      if (lower[ff] >= 0) {
+        resid[lower[ff]] += fluxArea;
+      }
+      if (upper[ff] >= 0) {
+        resid[upper[ff]] -= fluxArea;
+      }
+    }
+  }
+}
+#endif
+
 // member function to subtract a member of the inviscid flux class from the
 // residual
 void procBlock::SubtractFromResidual(const inviscidFlux &flux, const int &ii,
@@ -259,13 +380,14 @@ void procBlock::SubtractFromResidual(const inviscidFlux &flux, const int &ii,
   // jj -- j-location of residual to add to
   // kk -- k-location of residual to add to
 
-  residual_(ii, jj, kk)[0] -= flux.RhoVel();
-  residual_(ii, jj, kk)[1] -= flux.RhoVelU();
-  residual_(ii, jj, kk)[2] -= flux.RhoVelV();
-  residual_(ii, jj, kk)[3] -= flux.RhoVelW();
-  residual_(ii, jj, kk)[4] -= flux.RhoVelH();
-  residual_(ii, jj, kk)[5] -= flux.RhoVelK();
-  residual_(ii, jj, kk)[6] -= flux.RhoVelO();
+  auto &&resid = residual_(ii, jj, kk);
+  resid[0] -= flux.RhoVel();
+  resid[1] -= flux.RhoVelU();
+  resid[2] -= flux.RhoVelV();
+  resid[3] -= flux.RhoVelW();
+  resid[4] -= flux.RhoVelH();
+  resid[5] -= flux.RhoVelK();
+  resid[6] -= flux.RhoVelO();
 }
 
 // member function to add a member of the viscous flux class to the residual_
@@ -276,12 +398,13 @@ void procBlock::AddToResidual(const viscousFlux &flux, const int &ii,
   // jj -- j-location of residual to add to
   // kk -- k-location of residual to add to
 
-  residual_(ii, jj, kk)[1] += flux.MomX();
-  residual_(ii, jj, kk)[2] += flux.MomY();
-  residual_(ii, jj, kk)[3] += flux.MomZ();
-  residual_(ii, jj, kk)[4] += flux.Engy();
-  residual_(ii, jj, kk)[5] += flux.MomK();
-  residual_(ii, jj, kk)[6] += flux.MomO();
+  auto &&resid = residual_(ii, jj, kk);
+  resid[1] += flux.MomX();
+  resid[2] += flux.MomY();
+  resid[3] += flux.MomZ();
+  resid[4] += flux.Engy();
+  resid[5] += flux.MomK();
+  resid[6] += flux.MomO();
 }
 
 // member function to subtract a member of the viscous flux class from the
@@ -293,12 +416,13 @@ void procBlock::SubtractFromResidual(const viscousFlux &flux, const int &ii,
   // jj -- j-location of residual to add to
   // kk -- k-location of residual to add to
 
-  residual_(ii, jj, kk)[1] -= flux.MomX();
-  residual_(ii, jj, kk)[2] -= flux.MomY();
-  residual_(ii, jj, kk)[3] -= flux.MomZ();
-  residual_(ii, jj, kk)[4] -= flux.Engy();
-  residual_(ii, jj, kk)[5] -= flux.MomK();
-  residual_(ii, jj, kk)[6] -= flux.MomO();
+  auto &&resid = residual_(ii, jj, kk);
+  resid[1] -= flux.MomX();
+  resid[2] -= flux.MomY();
+  resid[3] -= flux.MomZ();
+  resid[4] -= flux.Engy();
+  resid[5] -= flux.MomK();
+  resid[6] -= flux.MomO();
 }
 
 
@@ -311,18 +435,73 @@ void procBlock::SubtractFromResidual(const source &src, const int &ii,
   // jj -- j-location of residual to add to
   // kk -- k-location of residual to add to
 
-  residual_(ii, jj, kk)[0] -= src.SrcMass();
-  residual_(ii, jj, kk)[1] -= src.SrcMomX();
-  residual_(ii, jj, kk)[2] -= src.SrcMomY();
-  residual_(ii, jj, kk)[3] -= src.SrcMomZ();
-  residual_(ii, jj, kk)[4] -= src.SrcEngy();
-  residual_(ii, jj, kk)[5] -= src.SrcTke();
-  residual_(ii, jj, kk)[6] -= src.SrcOmg();
+  auto &&resid = residual_(ii, jj, kk);
+  resid[0] -= src.SrcMass();
+  resid[1] -= src.SrcMomX();
+  resid[2] -= src.SrcMomY();
+  resid[3] -= src.SrcMomZ();
+  resid[4] -= src.SrcEngy();
+  resid[5] -= src.SrcTke();
+  resid[6] -= src.SrcOmg();
 }
 
 //---------------------------------------------------------------------
 // function declarations
 
+#ifdef SOA_FIELDS
+/* Member function to reconstruct the left and right states of a run of faces
+directly from the variable planes of the state. The faces of the run are next
+to each other in i, so for each variable the stencil cells of the faces are
+next to each other in its plane, and the reconstruction is a unit stride loop
+over the faces. The states are the same as those from FaceReconConst() and
+FaceReconMUSCL(), and are stored in the batch starting at face ff.
+*/
+template <reconstructionMethod R, limiterMethod L>
+void procBlock::FaceReconPlanes(const vector3d<int> &face,
+                                const vector3d<int> &dir,
+                                const multiArray3d<double> &cellWidth,
+                                const double &kappa, const int &numFaces,
+                                const int &ff, fluxBatch &batch) const {
+  // face -- index of first face in run
+  // dir -- index offset from a face to the cell on its upper side
+  // cellWidth -- width of cells normal to faces
+  // kappa -- MUSCL parameter kappa
+  // numFaces -- number of faces in run
+  // ff -- index in batch of first face in run
+  // batch -- batch to store face states in
+
+  // cells in stencil; the first face lies between lower1 and upper1
+  const auto lower2 = face - dir - dir;
+  const auto lower1 = face - dir;
+  const auto upper1 = face;
+  const auto upper2 = face + dir;
+
+  const auto *widthL2 = &cellWidth(lower2.X(), lower2.Y(), lower2.Z());
+  const auto *widthL1 = &cellWidth(lower1.X(), lower1.Y(), lower1.Z());
+  const auto *widthU1 = &cellWidth(upper1.X(), upper1.Y(), upper1.Z());
+  const auto *widthU2 = &cellWidth(upper2.X(), upper2.Y(), upper2.Z());
+
+  for (auto vv = 0; vv < NUMVARS; vv++) {
+    const auto *varL1 = state_.Plane(vv, lower1.X(), lower1.Y(), lower1.Z());
+    const auto *varU1 = state_.Plane(vv, upper1.X(), upper1.Y(), upper1.Z());
+    auto *left = batch.LeftVar(vv) + ff;
+    auto *right = batch.RightVar(vv) + ff;
+
+    if (R == reconstructionMethod::constant) {
+      std::copy(varL1, varL1 + numFaces, left);
+      std::copy(varU1, varU1 + numFaces, right);
+    } else {  // muscl
+      const auto *varL2 = state_.Plane(vv, lower2.X(), lower2.Y(), lower2.Z());
+      const auto *varU2 = state_.Plane(vv, upper2.X(), upper2.Y(), upper2.Z());
+      FaceReconMUSCL<L>(varL2, varL1, varU1, widthL2, widthL1, widthU1, kappa,
+                        numFaces, left);
+      FaceReconMUSCL<L>(varU2, varU1, varL1, widthU2, widthU1, widthL1, kappa,
+                        numFaces, right);
+    }
+  }
+}
+#endif
+
 /* Function to calculate the inviscid fluxes on the i-faces. All phyiscal
 (non-ghost) i-faces are looped over. The left and right states are
 calculated, and then the flux at the face is calculated. The flux at the
@@ -350,70 +529,72 @@ a cell basis instead of a face bases, it is only calculated for the upper cell
 variable and is eventually used in the time step calculation if the time step
 isn't explicitly specified.
 */
+template <reconstructionMethod R, limiterMethod L, inviscidFluxMethod F,
+          bool isBlock>
 void procBlock::CalcInvFluxI(const idealGas &eqnState, const input &inp,
                              const unique_ptr<turbModel> &turb,
-                             multiArray3d<fluxJacobian> &mainDiagonal) {
+                             multiArray3d<fluxJacobian> &mainDiagonal,
+                             const vector3d<int> &lower,
+                             const vector3d<int> &upper,
+                             const bool &interior) {
   // eqnState -- equation of state
   // inp -- all input variables
   // mainDiagonal -- main diagonal of LHS to store flux jacobians for implicit
   //                 solver
-
-
-  // loop over all physical i-faces
-  for (auto kk = fAreaI_.PhysStartK(); kk < fAreaI_.PhysEndK(); kk++) {
-    for (auto jj = fAreaI_.PhysStartJ(); jj < fAreaI_.PhysEndJ(); jj++) {
-      for (auto ii = fAreaI_.PhysStartI(); ii < fAreaI_.PhysEndI(); ii++) {
-        primVars faceStateLower, faceStateUpper;
-
-        // use constant reconstruction (first order)
-        if (inp.OrderOfAccuracy() == "first") {
-          faceStateLower = state_(ii - 1, jj, kk).FaceReconConst();
-          faceStateUpper = state_(ii, jj, kk).FaceReconConst();
-        } else {  // second order accuracy
-          if (inp.UsingMUSCLReconstruction()) {
-            faceStateLower = state_(ii - 1, jj, kk).FaceReconMUSCL(
-                state_(ii - 2, jj, kk), state_(ii, jj, kk),
-                inp.Kappa(), inp.Limiter(), cellWidthI_(ii - 1, jj, kk),
-                cellWidthI_(ii - 2, jj, kk), cellWidthI_(ii, jj, kk));
-
-            faceStateUpper = state_(ii, jj, kk).FaceReconMUSCL(
-                state_(ii + 1, jj, kk), state_(ii - 1, jj, kk),
-                inp.Kappa(), inp.Limiter(), cellWidthI_(ii, jj, kk),
-                cellWidthI_(ii + 1, jj, kk), cellWidthI_(ii - 1, jj, kk));
-
-          } else {  // using higher order reconstruction (weno, wenoz)
-            faceStateLower = state_(ii - 1, jj, kk).FaceReconWENO(
-                state_(ii - 2, jj, kk), state_(ii - 3, jj, kk),
-                state_(ii, jj, kk), state_(ii + 1, jj, kk),
-                cellWidthI_(ii - 1, jj, kk), cellWidthI_(ii - 2, jj, kk),
-                cellWidthI_(ii - 3, jj, kk), cellWidthI_(ii, jj, kk),
-                cellWidthI_(ii + 1, jj, kk), inp.IsWenoZ());
-
-            faceStateUpper = state_(ii, jj, kk).FaceReconWENO(
-                state_(ii + 1, jj, kk), state_(ii + 2, jj, kk),
-                state_(ii - 1, jj, kk), state_(ii - 2, jj, kk),
-                cellWidthI_(ii, jj, kk), cellWidthI_(ii + 1, jj, kk),
-                cellWidthI_(ii + 2, jj, kk), cellWidthI_(ii - 1, jj, kk),
-                cellWidthI_(ii - 2, jj, kk), inp.IsWenoZ());
-          }
-        }
-
-        // calculate Roe flux at face
-        const inviscidFlux tempFlux = RoeFlux(faceStateLower, faceStateUpper,
-                                              eqnState,
-                                              this->FAreaUnitI(ii, jj, kk));
+  // lower -- lower corner of interior cells
+  // upper -- one past upper corner of interior cells
+  // interior -- flag for interior pass instead of halo pass
+
+  // only faces with a cell in this pass on either side are calculated, and
+  // only the cells in this pass are updated, see CalcInvFlux()
+  auto inPass = [&](const int &ii, const int &jj, const int &kk) {
+    return this->InPass({ii, jj, kk}, lower, upper, interior);
+  };
+  auto calcFace = [&](const int &ii, const int &jj, const int &kk) {
+    return (ii > fAreaI_.PhysStartI() && inPass(ii - 1, jj, kk)) ||
+        (ii < fAreaI_.PhysEndI() - 1 && inPass(ii, jj, kk));
+  };
+
+  // loop over physical i-faces in given range
+  // threads share out j-lines of faces, see CalcInvFlux()
+#pragma omp parallel
+  {
+    // faces are gathered into batches for the vectorized flux kernel, and a
+    // batch may span several lines; the lines a thread owns are the same in
+    // every plane, so the residual updates of a batch stay with their thread
+    vector3d<int> faces[FLUXBATCH];
+    fluxBatch batch;
+    auto numFaces = 0;
+
+    // calculate numerical flux at faces in batch and add to residual
+    auto flushBatch = [&]() {
+      batch.PadFaces(numFaces);
+      NumericalFlux<F>(batch, eqnState);
+#ifdef SOA_FIELDS
+      this->AddToResidual(batch, faces, numFaces, {1, 0, 0}, fAreaI_,
+                          lower, upper, interior);
+#endif
+      for (auto ff = 0; ff < numFaces; ff++) {
+        const auto ii = faces[ff].X();
+        const auto jj = faces[ff].Y();
+        const auto kk = faces[ff].Z();
+#ifndef SOA_FIELDS
+        const auto tempFlux = batch.Flux(ff);
+#endif
 
         // area vector points from left to right, so add to left cell, subtract
         // from right cell
         // at left boundary there is no left cell to add to
-        if (ii > fAreaI_.PhysStartI()) {
+        if (ii > fAreaI_.PhysStartI() && inPass(ii - 1, jj, kk)) {
+#ifndef SOA_FIELDS
           this->AddToResidual(tempFlux * this->FAreaMagI(ii, jj, kk),
                               ii - 1, jj, kk);
+#endif
 
           // if using a block matrix on main diagonal, accumulate flux jacobian
-          if (inp.IsBlockMatrix()) {
+          if (isBlock) {
             fluxJacobian fluxJac;
-            fluxJac.RusanovFluxJacobian(faceStateLower, eqnState,
+            fluxJac.RusanovFluxJacobian(batch.Left<primVars>(ff), eqnState,
                                         this->FAreaI(ii, jj, kk), true,
                                         inp, turb);
             mainDiagonal(ii - 1, jj, kk) += fluxJac;
@@ -421,15 +602,18 @@ void procBlock::CalcInvFluxI(const idealGas &eqnState, const input &inp,
         }
 
         // at right boundary there is no right cell to add to
-        if (ii < fAreaI_.PhysEndI() - 1) {
+        if (ii < fAreaI_.PhysEndI() - 1 && inPass(ii, jj, kk)) {
+#ifndef SOA_FIELDS
           this->SubtractFromResidual(tempFlux *
                                      this->FAreaMagI(ii, jj, kk),
                                      ii, jj, kk);
+#endif
 
           // calculate component of wave speed. This is done on a cell by cell
           // basis, so only at the upper faces
-          const auto invSpecRad = state_(ii, jj, kk).InvCellSpectralRadius(
-              fAreaI_(ii, jj, kk), fAreaI_(ii + 1, jj, kk), eqnState);
+          const auto invSpecRad =
+              this->State(ii, jj, kk).InvCellSpectralRadius(
+                  fAreaI_(ii, jj, kk), fAreaI_(ii + 1, jj, kk), eqnState);
 
           const auto turbInvSpecRad = isTurbulent_ ?
               turb->InviscidCellSpecRad(state_(ii, jj, kk), fAreaI_(ii, jj, kk),
@@ -439,9 +623,9 @@ void procBlock::CalcInvFluxI(const idealGas &eqnState, const input &inp,
           specRadius_(ii, jj, kk) += specRad;
 
           // if using a block matrix on main diagonal, accumulate flux jacobian
-          if (inp.IsBlockMatrix()) {
+          if (isBlock) {
             fluxJacobian fluxJac;
-            fluxJac.RusanovFluxJacobian(faceStateUpper, eqnState,
+            fluxJac.RusanovFluxJacobian(batch.Right<primVars>(ff), eqnState,
                                         this->FAreaI(ii, jj, kk), false,
                                         inp, turb);
             mainDiagonal(ii, jj, kk) -= fluxJac;
@@ -450,6 +634,104 @@ void procBlock::CalcInvFluxI(const idealGas &eqnState, const input &inp,
           }
         }
       }
+      numFaces = 0;
+    };
+
+#ifdef SOA_FIELDS
+    // reconstruct a run of faces along i from the variable planes and add
+    // them to the batch, flushing it whenever it fills
+    auto addRun = [&](const int &start, const int &jj, const int &kk,
+                      const int &num) {
+      for (auto ii = start; ii < start + num;) {
+        // faces that are not in this pass end a run
+        if (!calcFace(ii, jj, kk)) {
+          ii++;
+          continue;
+        }
+        auto numRun = 1;
+        while (numRun < FLUXBATCH - numFaces && ii + numRun < start + num &&
+               calcFace(ii + numRun, jj, kk)) {
+          numRun++;
+        }
+        this->FaceReconPlanes<R, L>({ii, jj, kk}, {1, 0, 0}, cellWidthI_,
+                                    inp.Kappa(), numRun, numFaces, batch);
+        for (auto rr = 0; rr < numRun; rr++) {
+          batch.SetArea(numFaces, this->FAreaUnitI(ii + rr, jj, kk));
+          faces[numFaces++] = {ii + rr, jj, kk};
+        }
+        ii += numRun;
+        if (numFaces == FLUXBATCH) {
+          flushBatch();
+        }
+      }
+    };
+#endif
+
+    for (auto kk = fAreaI_.PhysStartK(); kk < fAreaI_.PhysEndK(); kk++) {
+#pragma omp for schedule(static) nowait
+      for (auto jj = fAreaI_.PhysStartJ(); jj < fAreaI_.PhysEndJ(); jj++) {
+#ifdef SOA_FIELDS
+        if (R == reconstructionMethod::constant ||
+            R == reconstructionMethod::muscl) {
+          addRun(fAreaI_.PhysStartI(), jj, kk,
+                 fAreaI_.PhysEndI() - fAreaI_.PhysStartI());
+          continue;
+        }
+#endif
+        for (auto ii = fAreaI_.PhysStartI(); ii < fAreaI_.PhysEndI(); ii++) {
+          if (!calcFace(ii, jj, kk)) {
+            continue;
+          }
+          primVars faceStateLower, faceStateUpper;
+
+          // use constant reconstruction (first order)
+          if (R == reconstructionMethod::constant) {
+            faceStateLower = this->State(ii - 1, jj, kk).FaceReconConst();
+            faceStateUpper = this->State(ii, jj, kk).FaceReconConst();
+          } else {  // second order accuracy
+            if (R == reconstructionMethod::muscl) {
+              faceStateLower = this->State(ii - 1, jj, kk).FaceReconMUSCL<L>(
+                  this->State(ii - 2, jj, kk), this->State(ii, jj, kk),
+                  inp.Kappa(), cellWidthI_(ii - 1, jj, kk),
+                  cellWidthI_(ii - 2, jj, kk), cellWidthI_(ii, jj, kk));
+
+              faceStateUpper = this->State(ii, jj, kk).FaceReconMUSCL<L>(
+                  this->State(ii + 1, jj, kk), this->State(ii - 1, jj, kk),
+                  inp.Kappa(), cellWidthI_(ii, jj, kk),
+                  cellWidthI_(ii + 1, jj, kk), cellWidthI_(ii - 1, jj, kk));
+
+            } else {  // using higher order reconstruction (weno, wenoz)
+              faceStateLower = this->State(ii - 1, jj, kk).FaceReconWENO(
+                  this->State(ii - 2, jj, kk), this->State(ii - 3, jj, kk),
+                  this->State(ii, jj, kk), this->State(ii + 1, jj, kk),
+                  cellWidthI_(ii - 1, jj, kk), cellWidthI_(ii - 2, jj, kk),
+                  cellWidthI_(ii - 3, jj, kk), cellWidthI_(ii, jj, kk),
+                  cellWidthI_(ii + 1, jj, kk),
+                  R == reconstructionMethod::wenoZ);
+
+              faceStateUpper = this->State(ii, jj, kk).FaceReconWENO(
+                  this->State(ii + 1, jj, kk), this->State(ii + 2, jj, kk),
+                  this->State(ii - 1, jj, kk), this->State(ii - 2, jj, kk),
+                  cellWidthI_(ii, jj, kk), cellWidthI_(ii + 1, jj, kk),
+                  cellWidthI_(ii + 2, jj, kk), cellWidthI_(ii - 1, jj, kk),
+                  cellWidthI_(ii - 2, jj, kk),
+                  R == reconstructionMethod::wenoZ);
+            }
+          }
+
+          batch.SetFace(numFaces, faceStateLower, faceStateUpper,
+                        this->FAreaUnitI(ii, jj, kk));
+          faces[numFaces++] = {ii, jj, kk};
+          if (numFaces == FLUXBATCH) {
+            flushBatch();
+          }
+        }
+      }
+    }
+
+    // last batch may be partly full
+    if (numFaces > 0) {
+      flushBatch();
     }
   }
 }
@@ -481,84 +763,90 @@ a cell basis instead of a face bases, it is only calculated for the upper cell
 variable and is eventually used in the time step calculation if the time step
 isn't explicitly specified.
 */
+template <reconstructionMethod R, limiterMethod L, inviscidFluxMethod F,
+          bool isBlock>
 void procBlock::CalcInvFluxJ(const idealGas &eqnState, const input &inp,
                              const unique_ptr<turbModel> &turb,
-                             multiArray3d<fluxJacobian> &mainDiagonal) {
+                             multiArray3d<fluxJacobian> &mainDiagonal,
+                             const vector3d<int> &lower,
+                             const vector3d<int> &upper,
+                             const bool &interior) {
   // eqnState -- equation of state
   // inp -- all input variables
   // mainDiagonal -- main diagonal of LHS to store flux jacobians for implicit
   //                 solver
-
-  // loop over all physical j-faces
-  for (auto kk = fAreaJ_.PhysStartK(); kk < fAreaJ_.PhysEndK(); kk++) {
-    for (auto jj = fAreaJ_.PhysStartJ(); jj < fAreaJ_.PhysEndJ(); jj++) {
-      for (auto ii = fAreaJ_.PhysStartI(); ii < fAreaJ_.PhysEndI(); ii++) {
-        primVars faceStateLower, faceStateUpper;
-
-        // use constant reconstruction (first order)
-        if (inp.OrderOfAccuracy() == "first") {
-          faceStateLower = state_(ii, jj - 1, kk).FaceReconConst();
-          faceStateUpper = state_(ii, jj, kk).FaceReconConst();
-        } else {  // second order accuracy
-          if (inp.UsingMUSCLReconstruction()) {
-            faceStateLower = state_(ii, jj - 1, kk).FaceReconMUSCL(
-                state_(ii, jj - 2, kk), state_(ii, jj, kk),
-                inp.Kappa(), inp.Limiter(), cellWidthJ_(ii, jj - 1, kk),
-                cellWidthJ_(ii, jj - 2, kk), cellWidthJ_(ii, jj, kk));
-
-            faceStateUpper = state_(ii, jj, kk).FaceReconMUSCL(
-              state_(ii, jj + 1, kk), state_(ii, jj - 1, kk),
-              inp.Kappa(), inp.Limiter(), cellWidthJ_(ii, jj, kk),
-              cellWidthJ_(ii, jj + 1, kk), cellWidthJ_(ii, jj - 1, kk));
-
-          } else {  // using higher order reconstruction (weno, wenoz)
-            faceStateLower = state_(ii, jj - 1, kk).FaceReconWENO(
-                state_(ii, jj - 2, kk), state_(ii, jj - 3, kk),
-                state_(ii, jj, kk), state_(ii, jj + 1, kk),
-                cellWidthJ_(ii, jj - 1, kk), cellWidthJ_(ii, jj - 2, kk),
-                cellWidthJ_(ii, jj - 3, kk), cellWidthJ_(ii, jj, kk),
-                cellWidthJ_(ii, jj + 1, kk), inp.IsWenoZ());
-
-            faceStateUpper = state_(ii, jj, kk).FaceReconWENO(
-                state_(ii, jj + 1, kk), state_(ii, jj + 2, kk),
-                state_(ii, jj - 1, kk), state_(ii, jj - 2, kk),
-                cellWidthJ_(ii, jj, kk), cellWidthJ_(ii, jj + 1, kk),
-                cellWidthJ_(ii, jj + 2, kk), cellWidthJ_(ii, jj - 1, kk),
-                cellWidthJ_(ii, jj - 2, kk), inp.IsWenoZ());
-          }
-        }
-
-        // calculate Roe flux at face
-        const inviscidFlux tempFlux = RoeFlux(
-            faceStateLower, faceStateUpper, eqnState,
-            this->FAreaUnitJ(ii, jj, kk));
+  // lower -- lower corner of interior cells
+  // upper -- one past upper corner of interior cells
+  // interior -- flag for interior pass instead of halo pass
+
+  // only faces with a cell in this pass on either side are calculated, and
+  // only the cells in this pass are updated, see CalcInvFlux()
+  auto inPass = [&](const int &ii, const int &jj, const int &kk) {
+    return this->InPass({ii, jj, kk}, lower, upper, interior);
+  };
+  auto calcFace = [&](const int &ii, const int &jj, const int &kk) {
+    return (jj > fAreaJ_.PhysStartJ() && inPass(ii, jj - 1, kk)) ||
+        (jj < fAreaJ_.PhysEndJ() - 1 && inPass(ii, jj, kk));
+  };
+
+  // loop over physical j-faces in given range
+  // threads share out i-lines of faces, see CalcInvFlux()
+#pragma omp parallel
+  {
+    // faces are gathered into batches for the vectorized flux kernel, and a
+    // batch may span several lines; the lines a thread owns are the same in
+    // every plane, so the residual updates of a batch stay with their thread
+    vector3d<int> faces[FLUXBATCH];
+    fluxBatch batch;
+    auto numFaces = 0;
+
+    // calculate numerical flux at faces in batch and add to residual
+    auto flushBatch = [&]() {
+      batch.PadFaces(numFaces);
+      NumericalFlux<F>(batch, eqnState);
+#ifdef SOA_FIELDS
+      this->AddToResidual(batch, faces, numFaces, {0, 1, 0}, fAreaJ_,
+                          lower, upper, interior);
+#endif
+      for (auto ff = 0; ff < numFaces; ff++) {
+        const auto ii = faces[ff].X();
+        const auto jj = faces[ff].Y();
+        const auto kk = faces[ff].Z();
+#ifndef SOA_FIELDS
+        const auto tempFlux = batch.Flux(ff);
+#endif
 
         // area vector points from left to right, so add to left cell, subtract
         // from right cell
         // at left boundary no left cell to add to
-        if (jj > fAreaJ_.PhysStartJ()) {
+        if (jj > fAreaJ_.PhysStartJ() && inPass(ii, jj - 1, kk)) {
+#ifndef SOA_FIELDS
           this->AddToResidual(tempFlux * this->FAreaMagJ(ii, jj, kk),
                               ii, jj - 1, kk);
+#endif
 
           // if using block matrix on main diagonal, calculate flux jacobian
-          if (inp.IsBlockMatrix()) {
+          if (isBlock) {
             fluxJacobian fluxJac;
-            fluxJac.RusanovFluxJacobian(faceStateLower, eqnState,
+            fluxJac.RusanovFluxJacobian(batch.Left<primVars>(ff), eqnState,
                                         this->FAreaJ(ii, jj, kk), true,
                                         inp, turb);
             mainDiagonal(ii, jj - 1, kk) += fluxJac;
           }
         }
         // at right boundary no right cell to add to
-        if (jj < fAreaJ_.PhysEndJ() - 1) {
+        if (jj < fAreaJ_.PhysEndJ() - 1 && inPass(ii, jj, kk)) {
+#ifndef SOA_FIELDS
           this->SubtractFromResidual(tempFlux *
                                      this->FAreaMagJ(ii, jj, kk),
                                      ii, jj, kk);
+#endif
 
           // calculate component of wave speed. This is done on a cell by cell
           // basis, so only at the upper faces
-          const auto invSpecRad = state_(ii, jj, kk).InvCellSpectralRadius(
-              fAreaJ_(ii, jj, kk), fAreaJ_(ii, jj + 1, kk), eqnState);
+          const auto invSpecRad =
+              this->State(ii, jj, kk).InvCellSpectralRadius(
+                  fAreaJ_(ii, jj, kk), fAreaJ_(ii, jj + 1, kk), eqnState);
 
           const auto turbInvSpecRad = isTurbulent_ ?
               turb->InviscidCellSpecRad(state_(ii, jj, kk), fAreaJ_(ii, jj, kk),
@@ -568,9 +856,9 @@ void procBlock::CalcInvFluxJ(const idealGas &eqnState, const input &inp,
           specRadius_(ii, jj, kk) += specRad;
 
           // if using block matrix on main diagonal, calculate flux jacobian
-          if (inp.IsBlockMatrix()) {
+          if (isBlock) {
             fluxJacobian fluxJac;
-            fluxJac.RusanovFluxJacobian(faceStateUpper, eqnState,
+            fluxJac.RusanovFluxJacobian(batch.Right<primVars>(ff), eqnState,
                                         this->FAreaJ(ii, jj, kk), false,
                                         inp, turb);
             mainDiagonal(ii, jj, kk) -= fluxJac;
@@ -579,6 +867,108 @@ void procBlock::CalcInvFluxJ(const idealGas &eqnState, const input &inp,
           }
         }
       }
+      numFaces = 0;
+    };
+
+#ifdef SOA_FIELDS
+    // reconstruct a run of faces along i from the variable planes and add
+    // them to the batch, flushing it whenever it fills
+    auto addRun = [&](const int &start, const int &jj, const int &kk,
+                      const int &num) {
+      for (auto ii = start; ii < start + num;) {
+        // faces that are not in this pass end a run
+        if (!calcFace(ii, jj, kk)) {
+          ii++;
+          continue;
+        }
+        auto numRun = 1;
+        while (numRun < FLUXBATCH - numFaces && ii + numRun < start + num &&
+               calcFace(ii + numRun, jj, kk)) {
+          numRun++;
+        }
+        this->FaceReconPlanes<R, L>({ii, jj, kk}, {0, 1, 0}, cellWidthJ_,
+                                    inp.Kappa(), numRun, numFaces, batch);
+        for (auto rr = 0; rr < numRun; rr++) {
+          batch.SetArea(numFaces, this->FAreaUnitJ(ii + rr, jj, kk));
+          faces[numFaces++] = {ii + rr, jj, kk};
+        }
+        ii += numRun;
+        if (numFaces == FLUXBATCH) {
+          flushBatch();
+        }
+      }
+    };
+#endif
+
+    for (auto kk = fAreaJ_.PhysStartK(); kk < fAreaJ_.PhysEndK(); kk++) {
+      for (auto jj = fAreaJ_.PhysStartJ(); jj < fAreaJ_.PhysEndJ(); jj++) {
+#ifdef SOA_FIELDS
+        // threads share out runs of faces instead of single faces
+        if (R == reconstructionMethod::constant ||
+            R == reconstructionMethod::muscl) {
+#pragma omp for schedule(static) nowait
+          for (auto ii = fAreaJ_.PhysStartI(); ii < fAreaJ_.PhysEndI();
+               ii += FLUXBATCH) {
+            addRun(ii, jj, kk, std::min(FLUXBATCH, fAreaJ_.PhysEndI() - ii));
+          }
+          continue;
+        }
+#endif
+#pragma omp for schedule(static) nowait
+        for (auto ii = fAreaJ_.PhysStartI(); ii < fAreaJ_.PhysEndI(); ii++) {
+          if (!calcFace(ii, jj, kk)) {
+            continue;
+          }
+          primVars faceStateLower, faceStateUpper;
+
+          // use constant reconstruction (first order)
+          if (R == reconstructionMethod::constant) {
+            faceStateLower = this->State(ii, jj - 1, kk).FaceReconConst();
+            faceStateUpper = this->State(ii, jj, kk).FaceReconConst();
+          } else {  // second order accuracy
+            if (R == reconstructionMethod::muscl) {
+              faceStateLower = this->State(ii, jj - 1, kk).FaceReconMUSCL<L>(
+                  this->State(ii, jj - 2, kk), this->State(ii, jj, kk),
+                  inp.Kappa(), cellWidthJ_(ii, jj - 1, kk),
+                  cellWidthJ_(ii, jj - 2, kk), cellWidthJ_(ii, jj, kk));
+
+              faceStateUpper = this->State(ii, jj, kk).FaceReconMUSCL<L>(
+                  this->State(ii, jj + 1, kk), this->State(ii, jj - 1, kk),
+                  inp.Kappa(), cellWidthJ_(ii, jj, kk),
+                  cellWidthJ_(ii, jj + 1, kk), cellWidthJ_(ii, jj - 1, kk));
+
+            } else {  // using higher order reconstruction (weno, wenoz)
+              faceStateLower = this->State(ii, jj - 1, kk).FaceReconWENO(
+                  this->State(ii, jj - 2, kk), this->State(ii, jj - 3, kk),
+                  this->State(ii, jj, kk), this->State(ii, jj + 1, kk),
+                  cellWidthJ_(ii, jj - 1, kk), cellWidthJ_(ii, jj - 2, kk),
+                  cellWidthJ_(ii, jj - 3, kk), cellWidthJ_(ii, jj, kk),
+                  cellWidthJ_(ii, jj + 1, kk),
+                  R == reconstructionMethod::wenoZ);
+
+              faceStateUpper = this->State(ii, jj, kk).FaceReconWENO(
+                  this->State(ii, jj + 1, kk), this->State(ii, jj + 2, kk),
+                  this->State(ii, jj - 1, kk), this->State(ii, jj - 2, kk),
+                  cellWidthJ_(ii, jj, kk), cellWidthJ_(ii, jj + 1, kk),
+                  cellWidthJ_(ii, jj + 2, kk), cellWidthJ_(ii, jj - 1, kk),
+                  cellWidthJ_(ii, jj - 2, kk),
+                  R == reconstructionMethod::wenoZ);
+            }
+          }
+
+          batch.SetFace(numFaces, faceStateLower, faceStateUpper,
+                        this->FAreaUnitJ(ii, jj, kk));
+          faces[numFaces++] = {ii, jj, kk};
+          if (numFaces == FLUXBATCH) {
+            flushBatch();
+          }
+        }
+      }
+    }
+
+    // last batch may be partly full
+    if (numFaces > 0) {
+      flushBatch();
     }
   }
 }
@@ -610,86 +1000,91 @@ a cell basis instead of a face bases, it is only calculated for the upper cell
 variable and is eventually used in the time step calculation if the time step
 isn't explicitly specified.
 */
+template <reconstructionMethod R, limiterMethod L, inviscidFluxMethod F,
+          bool isBlock>
 void procBlock::CalcInvFluxK(const idealGas &eqnState, const input &inp,
                              const unique_ptr<turbModel> &turb,
-                             multiArray3d<fluxJacobian> &mainDiagonal) {
+                             multiArray3d<fluxJacobian> &mainDiagonal,
+                             const vector3d<int> &lower,
+                             const vector3d<int> &upper,
+                             const bool &interior) {
   // eqnState -- equation of state
   // inp -- all input variables
   // mainDiagonal -- main diagonal of LHS to store flux jacobians for implicit
   //                 solver
-
-
-  // loop over all physical k-faces
-  for (auto kk = fAreaK_.PhysStartK(); kk < fAreaK_.PhysEndK(); kk++) {
-    for (auto jj = fAreaK_.PhysStartJ(); jj < fAreaK_.PhysEndJ(); jj++) {
-      for (auto ii = fAreaK_.PhysStartI(); ii < fAreaK_.PhysEndI(); ii++) {
-        primVars faceStateLower, faceStateUpper;
-
-        // use constant reconstruction (first order)
-        if (inp.OrderOfAccuracy() == "first") {
-          faceStateLower = state_(ii, jj, kk - 1).FaceReconConst();
-          faceStateUpper = state_(ii, jj, kk).FaceReconConst();
-        } else {  // second order accuracy
-          if (inp.UsingMUSCLReconstruction()) {
-            faceStateLower = state_(ii, jj, kk - 1).FaceReconMUSCL(
-                state_(ii, jj, kk - 2), state_(ii, jj, kk),
-                inp.Kappa(), inp.Limiter(), cellWidthK_(ii, jj, kk - 1),
-                cellWidthK_(ii, jj, kk - 2), cellWidthK_(ii, jj, kk));
-
-            faceStateUpper = state_(ii, jj, kk).FaceReconMUSCL(
-                state_(ii, jj, kk + 1), state_(ii, jj, kk - 1),
-                inp.Kappa(), inp.Limiter(), cellWidthK_(ii, jj, kk),
-                cellWidthK_(ii, jj, kk + 1), cellWidthK_(ii, jj, kk - 1));
-
-          } else {  // using higher order reconstruction (weno, wenoz)
-            faceStateLower = state_(ii, jj, kk - 1).FaceReconWENO(
-                state_(ii, jj, kk - 2), state_(ii, jj, kk - 3),
-                state_(ii, jj, kk), state_(ii, jj, kk + 1),
-                cellWidthK_(ii, jj, kk - 1), cellWidthK_(ii, jj, kk - 2),
-                cellWidthK_(ii, jj, kk - 3), cellWidthK_(ii, jj, kk),
-                cellWidthK_(ii, jj, kk + 1), inp.IsWenoZ());
-
-            faceStateUpper = state_(ii, jj, kk).FaceReconWENO(
-                state_(ii, jj, kk + 1), state_(ii, jj, kk + 2),
-                state_(ii, jj, kk - 1), state_(ii, jj, kk - 2),
-                cellWidthK_(ii, jj, kk), cellWidthK_(ii, jj, kk + 1),
-                cellWidthK_(ii, jj, kk + 2), cellWidthK_(ii, jj, kk - 1),
-                cellWidthK_(ii, jj, kk - 2), inp.IsWenoZ());
-          }
-        }
-
-        // calculate Roe flux at face
-        const inviscidFlux tempFlux = RoeFlux(
-            faceStateLower, faceStateUpper, eqnState,
-            this->FAreaUnitK(ii, jj, kk));
+  // lower -- lower corner of interior cells
+  // upper -- one past upper corner of interior cells
+  // interior -- flag for interior pass instead of halo pass
+
+  // only faces with a cell in this pass on either side are calculated, and
+  // only the cells in this pass are updated, see CalcInvFlux()
+  auto inPass = [&](const int &ii, const int &jj, const int &kk) {
+    return this->InPass({ii, jj, kk}, lower, upper, interior);
+  };
+  auto calcFace = [&](const int &ii, const int &jj, const int &kk) {
+    return (kk > fAreaK_.PhysStartK() && inPass(ii, jj, kk - 1)) ||
+        (kk < fAreaK_.PhysEndK() - 1 && inPass(ii, jj, kk));
+  };
+
+  // loop over physical k-faces in given range
+  // threads share out j-lines of faces, see CalcInvFlux()
+#pragma omp parallel
+  {
+    // faces are gathered into batches for the vectorized flux kernel, and a
+    // batch may span several lines; the lines a thread owns are the same in
+    // every plane, so the residual updates of a batch stay with their thread
+    vector3d<int> faces[FLUXBATCH];
+    fluxBatch batch;
+    auto numFaces = 0;
+
+    // calculate numerical flux at faces in batch and add to residual
+    auto flushBatch = [&]() {
+      batch.PadFaces(numFaces);
+      NumericalFlux<F>(batch, eqnState);
+#ifdef SOA_FIELDS
+      this->AddToResidual(batch, faces, numFaces, {0, 0, 1}, fAreaK_,
+                          lower, upper, interior);
+#endif
+      for (auto ff = 0; ff < numFaces; ff++) {
+        const auto ii = faces[ff].X();
+        const auto jj = faces[ff].Y();
+        const auto kk = faces[ff].Z();
+#ifndef SOA_FIELDS
+        const auto tempFlux = batch.Flux(ff);
+#endif
 
         // area vector points from left to right, so add to left cell, subtract
         // from right cell
         // at left boundary no left cell to add to
-        if (kk > fAreaK_.PhysStartK()) {
+        if (kk > fAreaK_.PhysStartK() && inPass(ii, jj, kk - 1)) {
+#ifndef SOA_FIELDS
           this->AddToResidual(tempFlux *
                               this->FAreaMagK(ii, jj, kk),
                               ii, jj, kk - 1);
+#endif
 
           // if using block matrix on main diagonal, calculate flux jacobian
-          if (inp.IsBlockMatrix()) {
+          if (isBlock) {
             fluxJacobian fluxJac;
-            fluxJac.RusanovFluxJacobian(faceStateLower, eqnState,
+            fluxJac.RusanovFluxJacobian(batch.Left<primVars>(ff), eqnState,
                                         this->FAreaK(ii, jj, kk), true,
                                         inp, turb);
             mainDiagonal(ii, jj, kk - 1) += fluxJac;
           }
         }
         // at right boundary no right cell to add to
-        if (kk < fAreaK_.PhysEndK() - 1) {
+        if (kk < fAreaK_.PhysEndK() - 1 && inPass(ii, jj, kk)) {
+#ifndef SOA_FIELDS
           this->SubtractFromResidual(tempFlux *
                                      this->FAreaMagK(ii, jj, kk),
                                      ii, jj, kk);
+#endif
 
           // calculate component of wave speed. This is done on a cell by cell
           // basis, so only at the upper faces
-          const auto invSpecRad = state_(ii, jj, kk).InvCellSpectralRadius(
-              fAreaK_(ii, jj, kk), fAreaK_(ii, jj, kk + 1), eqnState);
+          const auto invSpecRad =
+              this->State(ii, jj, kk).InvCellSpectralRadius(
+                  fAreaK_(ii, jj, kk), fAreaK_(ii, jj, kk + 1), eqnState);
 
           const auto turbInvSpecRad = isTurbulent_ ?
               turb->InviscidCellSpecRad(state_(ii, jj, kk), fAreaK_(ii, jj, kk),
@@ -699,9 +1094,9 @@ void procBlock::CalcInvFluxK(const idealGas &eqnState, const input &inp,
           specRadius_(ii, jj, kk) += specRad;
 
           // if using block matrix on main diagonal, calculate flux jacobian
-          if (inp.IsBlockMatrix()) {
+          if (isBlock) {
             fluxJacobian fluxJac;
-            fluxJac.RusanovFluxJacobian(faceStateUpper, eqnState,
+            fluxJac.RusanovFluxJacobian(batch.Right<primVars>(ff), eqnState,
                                         this->FAreaK(ii, jj, kk), false,
                                         inp, turb);
             mainDiagonal(ii, jj, kk) -= fluxJac;
@@ -710,6 +1105,104 @@ void procBlock::CalcInvFluxK(const idealGas &eqnState, const input &inp,
           }
         }
       }
+      numFaces = 0;
+    };
+
+#ifdef SOA_FIELDS
+    // reconstruct a run of faces along i from the variable planes and add
+    // them to the batch, flushing it whenever it fills
+    auto addRun = [&](const int &start, const int &jj, const int &kk,
+                      const int &num) {
+      for (auto ii = start; ii < start + num;) {
+        // faces that are not in this pass end a run
+        if (!calcFace(ii, jj, kk)) {
+          ii++;
+          continue;
+        }
+        auto numRun = 1;
+        while (numRun < FLUXBATCH - numFaces && ii + numRun < start + num &&
+               calcFace(ii + numRun, jj, kk)) {
+          numRun++;
+        }
+        this->FaceReconPlanes<R, L>({ii, jj, kk}, {0, 0, 1}, cellWidthK_,
+                                    inp.Kappa(), numRun, numFaces, batch);
+        for (auto rr = 0; rr < numRun; rr++) {
+          batch.SetArea(numFaces, this->FAreaUnitK(ii + rr, jj, kk));
+          faces[numFaces++] = {ii + rr, jj, kk};
+        }
+        ii += numRun;
+        if (numFaces == FLUXBATCH) {
+          flushBatch();
+        }
+      }
+    };
+#endif
+
+    for (auto kk = fAreaK_.PhysStartK(); kk < fAreaK_.PhysEndK(); kk++) {
+#pragma omp for schedule(static) nowait
+      for (auto jj = fAreaK_.PhysStartJ(); jj < fAreaK_.PhysEndJ(); jj++) {
+#ifdef SOA_FIELDS
+        if (R == reconstructionMethod::constant ||
+            R == reconstructionMethod::muscl) {
+          addRun(fAreaK_.PhysStartI(), jj, kk,
+                 fAreaK_.PhysEndI() - fAreaK_.PhysStartI());
+          continue;
+        }
+#endif
+        for (auto ii = fAreaK_.PhysStartI(); ii < fAreaK_.PhysEndI(); ii++) {
+          if (!calcFace(ii, jj, kk)) {
+            continue;
+          }
+          primVars faceStateLower, faceStateUpper;
+
+          // use constant reconstruction (first order)
+          if (R == reconstructionMethod::constant) {
+            faceStateLower = this->State(ii, jj, kk - 1).FaceReconConst();
+            faceStateUpper = this->State(ii, jj, kk).FaceReconConst();
+          } else {  // second order accuracy
+            if (R == reconstructionMethod::muscl) {
+              faceStateLower = this->State(ii, jj, kk - 1).FaceReconMUSCL<L>(
+                  this->State(ii, jj, kk - 2), this->State(ii, jj, kk),
+                  inp.Kappa(), cellWidthK_(ii, jj, kk - 1),
+                  cellWidthK_(ii, jj, kk - 2), cellWidthK_(ii, jj, kk));
+
+              faceStateUpper = this->State(ii, jj, kk).FaceReconMUSCL<L>(
+                  this->State(ii, jj, kk + 1), this->State(ii, jj, kk - 1),
+                  inp.Kappa(), cellWidthK_(ii, jj, kk),
+                  cellWidthK_(ii, jj, kk + 1), cellWidthK_(ii, jj, kk - 1));
+
+            } else {  // using higher order reconstruction (weno, wenoz)
+              faceStateLower = this->State(ii, jj, kk - 1).FaceReconWENO(
+                  this->State(ii, jj, kk - 2), this->State(ii, jj, kk - 3),
+                  this->State(ii, jj, kk), this->State(ii, jj, kk + 1),
+                  cellWidthK_(ii, jj, kk - 1), cellWidthK_(ii, jj, kk - 2),
+                  cellWidthK_(ii, jj, kk - 3), cellWidthK_(ii, jj, kk),
+                  cellWidthK_(ii, jj, kk + 1),
+                  R == reconstructionMethod::wenoZ);
+
+              faceStateUpper = this->State(ii, jj, kk).FaceReconWENO(
+                  this->State(ii, jj, kk + 1), this->State(ii, jj, kk + 2),
+                  this->State(ii, jj, kk - 1), this->State(ii, jj, kk - 2),
+                  cellWidthK_(ii, jj, kk), cellWidthK_(ii, jj, kk + 1),
+                  cellWidthK_(ii, jj, kk + 2), cellWidthK_(ii, jj, kk - 1),
+                  cellWidthK_(ii, jj, kk - 2),
+                  R == reconstructionMethod::wenoZ);
+            }
+          }
+
+          batch.SetFace(numFaces, faceStateLower, faceStateUpper,
+                        this->FAreaUnitK(ii, jj, kk));
+          faces[numFaces++] = {ii, jj, kk};
+          if (numFaces == FLUXBATCH) {
+            flushBatch();
+          }
+        }
+      }
+    }
+
+    // last batch may be partly full
+    if (numFaces > 0) {
+      flushBatch();
     }
   }
 }
@@ -786,24 +1279,24 @@ void procBlock::UpdateBlock(const input &inputVars, const idealGas &eos,
   // l2 -- l-2 norm of residual
   // linf -- l-infinity norm of residual
 
+  const auto timeIntegration = inputVars.TimeIntegrationMethod();
+
   // loop over all physical cells
   for (auto kk = this->StartK(); kk < this->EndK(); kk++) {
     for (auto jj = this->StartJ(); jj < this->EndJ(); jj++) {
       for (auto ii = this->StartI(); ii < this->EndI(); ii++) {
         // explicit euler time integration
-        if (inputVars.TimeIntegration() == "explicitEuler") {
+        if (timeIntegration == timeIntegrationMethod::explicitEuler) {
           this->ExplicitEulerTimeAdvance(eos, turb, ii, jj, kk);
         // 4-stage runge-kutta method (explicit)
-        } else if (inputVars.TimeIntegration() == "rk4") {
+        } else if (timeIntegration == timeIntegrationMethod::rk4) {
           // advance 1 RK stage
           this->RK4TimeAdvance(consVarsN_(ii, jj, kk), eos, turb, ii, jj, kk, rr);
-        } else if (inputVars.IsImplicit()) {  // if implicit use update (du)
+        } else {  // if implicit use update (du)
           this->ImplicitTimeAdvance(du(ii, jj, kk), eos, turb, ii, jj, kk);
-        } else {
-          cerr << "ERROR: Time integration scheme " <<
-              inputVars.TimeIntegration() << " is not recognized!" << endl;
         }
 
+#ifndef SOA_FIELDS
         // accumulate l2 norm of residual
         l2 = l2 + residual_(ii, jj, kk) * residual_(ii, jj, kk);
 
@@ -815,7 +1308,31 @@ void procBlock::UpdateBlock(const input &inputVars, const idealGas &eos,
                            parBlock_, ii, jj, kk, ll + 1);
           }
         }
+#endif
+      }
+
+#ifdef SOA_FIELDS
+      // the residuals of the line are next to each other in each variable
+      // plane, so the norms are accumulated one plane at a time
+      const double *resid[NUMVARS];
+      for (auto ll = 0; ll < NUMVARS; ll++) {
+        resid[ll] = residual_.Plane(ll, this->StartI(), jj, kk);
+        for (auto ii = 0; ii < this->NumI(); ii++) {
+          l2[ll] += resid[ll][ii] * resid[ll][ii];
+        }
+      }
+
+      // if any residual is larger than previous residual, a new linf
+      // residual is found
+      for (auto ii = 0; ii < this->NumI(); ii++) {
+        for (auto ll = 0; ll < NUMVARS; ll++) {
+          if (resid[ll][ii] > linf.Linf()) {
+            linf.UpdateMax(resid[ll][ii], parBlock_, this->StartI() + ii, jj,
+                           kk, ll + 1);
+          }
+        }
       }
+#endif
     }
   }
 }
@@ -840,7 +1357,7 @@ void procBlock::ExplicitEulerTimeAdvance(const idealGas &eqnState,
   // kk -- k-location of cell
 
   // Get conserved variables for current state (time n)
-  auto consVars = state_(ii, jj, kk).ConsVars(eqnState);
+  auto consVars = this->State(ii, jj, kk).ConsVars(eqnState);
   // calculate updated conserved variables
   consVars -= dt_(ii, jj, kk) / vol_(ii, jj, kk) * residual_(ii, jj, kk);
 
@@ -863,7 +1380,8 @@ void procBlock::ImplicitTimeAdvance(const genArray &du,
   // kk -- k-location of cell
 
   // calculate updated state (primative variables)
-  state_(ii, jj, kk) = state_(ii, jj, kk).UpdateWithConsVars(eqnState, du, turb);
+  state_(ii, jj, kk) =
+      this->State(ii, jj, kk).UpdateWithConsVars(eqnState, du, turb);
 }
 
 /*member function to advance the state_ vector to time n+1 using 4th order
@@ -1002,6 +1520,10 @@ double procBlock::SolDeltaNm1Coeff(const int &ii, const int &jj, const int &kk,
 
 genArray procBlock::SolDeltaNm1(const int &ii, const int &jj, const int &kk,
                                 const input &inp) const {
+  // solution at time n-1 is only stored for multilevel methods
+  if (!isMultiLevelTime_) {
+    return genArray(0.0);
+  }
   const auto coeff = this->SolDeltaNm1Coeff(ii, jj, kk, inp);
   return coeff * (consVarsN_(ii, jj, kk) - consVarsNm1_(ii, jj, kk));
 }
@@ -1095,7 +1617,7 @@ void procBlock::AssignSolToTimeN(const idealGas &eos) {
     for (auto jj = this->StartJ(); jj < this->EndJ(); jj++) {
       for (auto ii = this->StartI(); ii < this->EndI(); ii++) {
         // convert state to conservative variables
-        consVarsN_(ii, jj, kk) = state_(ii, jj, kk).ConsVars(eos);
+        consVarsN_(ii, jj, kk) = this->State(ii, jj, kk).ConsVars(eos);
       }
     }
   }
@@ -1213,14 +1735,12 @@ variabes (FD(Unj)) which is known due to sweeping along hyperplanes.
 For viscous simulations, the viscous contribution to the spectral radius K is
 used, and everything else remains the same.
  */
-void procBlock::LUSGS_Forward(const vector<vector3d<int>> &reorder,
-                              multiArray3d<genArray> &x,
+void procBlock::LUSGS_Forward(multiArray3d<genArray> &x,
                               const idealGas &eqnState, const input &inp,
                               const sutherland &suth,
                               const unique_ptr<turbModel> &turb,
                               const multiArray3d<fluxJacobian> &aInv,
                               const int &sweep) const {
-  // reorder -- order of cells to visit (this should be ordered in hyperplanes)
   // x -- correction - added to solution at time n to get to time n+1 (assumed
   //      to be zero to start)
   // eqnState -- equation of state
@@ -1233,152 +1753,152 @@ void procBlock::LUSGS_Forward(const vector<vector3d<int>> &reorder,
   const auto thetaInv = 1.0 / inp.Theta();
 
   //--------------------------------------------------------------------
-  // forward sweep over all physical cells
-  for (auto nn = 0; nn < this->NumCells(); nn++) {
-    // indices for variables without ghost cells
-    const auto ii = reorder[nn].X();
-    const auto jj = reorder[nn].Y();
-    const auto kk = reorder[nn].Z();
-
-    // initialize term for contribution from lower/upper triangular matrix
-    genArray L(0.0);
-    genArray U(0.0);
-
-    // if i lower diagonal cell is in physical location there is a contribution
-    // from it
-    if (this->IsPhysical(ii - 1, jj, kk) ||
-        bc_.GetBCName(ii, jj, kk, 1) == "interblock") {
-      // calculate projected center to center distance along face area
-      const auto projDist = this->ProjC2CDist(ii, jj, kk, "i");
-
-      // update L matrix
-      L += OffDiagonal(state_(ii - 1, jj, kk), state_(ii, jj, kk),
-                       x(ii - 1 , jj, kk), fAreaI_(ii, jj, kk),
-                       this->Viscosity(ii - 1, jj, kk),
-                       this->EddyViscosity(ii - 1, jj, kk),
-                       this->F1(ii - 1, jj, kk), projDist,
-                       this->VelGrad(ii - 1, jj, kk),
-                       eqnState, suth, turb, inp, true);
-    }
-
-    // -----------------------------------------------------------------------
-    // if j lower diagonal cell is in physical location there is a contribution
-    // from it
-    if (this->IsPhysical(ii, jj - 1, kk) ||
-        bc_.GetBCName(ii, jj, kk, 3) == "interblock") {
-      // calculate projected center to center distance along face area
-      const auto projDist = this->ProjC2CDist(ii, jj, kk, "j");
-
-      // update L matrix
-      L += OffDiagonal(state_(ii, jj - 1, kk), state_(ii, jj, kk),
-                       x(ii, jj - 1, kk), fAreaJ_(ii, jj, kk),
-                       this->Viscosity(ii, jj - 1, kk),
-                       this->EddyViscosity(ii, jj - 1, kk),
-                       this->F1(ii, jj - 1, kk), projDist,
-                       this->VelGrad(ii, jj - 1, kk),
-                       eqnState, suth, turb, inp, true);
-    }
-
-    // -----------------------------------------------------------------------
-    // if k lower diagonal cell is in physical location there is a contribution
-    // from it
-    if (this->IsPhysical(ii, jj, kk - 1) ||
-        bc_.GetBCName(ii, jj, kk, 5) == "interblock") {
-      // calculate projected center to center distance along face area
-      const auto projDist = this->ProjC2CDist(ii, jj, kk, "k");
-
-      // update L matrix
-      L += OffDiagonal(state_(ii, jj, kk - 1), state_(ii, jj, kk),
-                       x(ii, jj, kk - 1), fAreaK_(ii, jj, kk),
-                       this->Viscosity(ii, jj, kk - 1),
-                       this->EddyViscosity(ii, jj, kk - 1),
-                       this->F1(ii, jj, kk - 1), projDist,
-                       this->VelGrad(ii, jj, kk - 1),
-                       eqnState, suth, turb, inp, true);
-    }
+  // forward sweep over all physical cells, one hyperplane at a time
+  // cells on a hyperplane only depend on cells of other hyperplanes, so the
+  // threads divide each hyperplane and wait for each other before the next
+  const auto numPlanes = static_cast<int>(hyperplaneStart_.size()) - 1;
+#pragma omp parallel
+  for (auto pp = 0; pp < numPlanes; pp++) {
+#pragma omp for schedule(static)
+    for (auto nn = hyperplaneStart_[pp]; nn < hyperplaneStart_[pp + 1];
+         nn++) {
+      // indices for variables without ghost cells
+      const auto ii = hyperplaneCells_[nn].X();
+      const auto jj = hyperplaneCells_[nn].Y();
+      const auto kk = hyperplaneCells_[nn].Z();
+
+      // initialize term for contribution from lower/upper triangular matrix
+      genArray L(0.0);
+      genArray U(0.0);
+
+      // if i lower diagonal cell is in physical location there is a
+      // contribution from it
+      if (FaceHasNeighbor(faceTypeI_(ii, jj, kk))) {
+        // calculate projected center to center distance along face area
+        const auto projDist = this->ProjC2CDist(ii, jj, kk, "i");
 
+        // update L matrix
+        L += OffDiagonal(state_(ii - 1, jj, kk), state_(ii, jj, kk),
+                         x(ii - 1 , jj, kk), fAreaI_(ii, jj, kk),
+                         this->Viscosity(ii - 1, jj, kk),
+                         this->EddyViscosity(ii - 1, jj, kk),
+                         this->F1(ii - 1, jj, kk), projDist,
+                         this->VelGrad(ii - 1, jj, kk),
+                         eqnState, suth, turb, inp, true);
+      }
 
-    // Only need to calculate contribution for U if matrix update has been
-    // initialized, or if this is not the first sweep through the domain.
-    // If the matrix is not initialized, the update x is 0 for the first
-    // sweep, so U is 0.
-    if (sweep > 0 || inp.MatrixRequiresInitialization()) {
       // -----------------------------------------------------------------------
-      // if i upper cell is in physical location there is a contribution
-      // from it
-      if (this->IsPhysical(ii + 1, jj, kk) ||
-          bc_.GetBCName(ii + 1, jj, kk, 2) == "interblock") {
+      // if j lower diagonal cell is in physical location there is a
+      // contribution from it
+      if (FaceHasNeighbor(faceTypeJ_(ii, jj, kk))) {
         // calculate projected center to center distance along face area
-        const auto projDist = this->ProjC2CDist(ii + 1, jj, kk, "i");
-
-        // update U matrix
-        U += OffDiagonal(state_(ii + 1, jj, kk), state_(ii, jj, kk),
-                         x(ii + 1 , jj, kk), fAreaI_(ii + 1, jj, kk),
-                         this->Viscosity(ii + 1, jj, kk),
-                         this->EddyViscosity(ii + 1, jj, kk),
-                         this->F1(ii + 1, jj, kk), projDist,
-                         this->VelGrad(ii + 1, jj, kk),
-                         eqnState, suth, turb, inp, false);
+        const auto projDist = this->ProjC2CDist(ii, jj, kk, "j");
+
+        // update L matrix
+        L += OffDiagonal(state_(ii, jj - 1, kk), state_(ii, jj, kk),
+                         x(ii, jj - 1, kk), fAreaJ_(ii, jj, kk),
+                         this->Viscosity(ii, jj - 1, kk),
+                         this->EddyViscosity(ii, jj - 1, kk),
+                         this->F1(ii, jj - 1, kk), projDist,
+                         this->VelGrad(ii, jj - 1, kk),
+                         eqnState, suth, turb, inp, true);
       }
 
       // -----------------------------------------------------------------------
-      // if j upper cell is in physical location there is a contribution
-      // from it
-      if (this->IsPhysical(ii, jj + 1, kk) ||
-          bc_.GetBCName(ii, jj + 1, kk, 4) == "interblock") {
+      // if k lower diagonal cell is in physical location there is a
+      // contribution from it
+      if (FaceHasNeighbor(faceTypeK_(ii, jj, kk))) {
         // calculate projected center to center distance along face area
-        const auto projDist = this->ProjC2CDist(ii, jj + 1, kk, "j");
-
-        // update U matrix
-        U += OffDiagonal(state_(ii, jj + 1, kk), state_(ii, jj, kk),
-                         x(ii, jj + 1, kk), fAreaJ_(ii, jj + 1, kk),
-                         this->Viscosity(ii, jj + 1, kk),
-                         this->EddyViscosity(ii, jj + 1, kk),
-                         this->F1(ii, jj + 1, kk), projDist,
-                         this->VelGrad(ii, jj + 1, kk),
-                         eqnState, suth, turb, inp, false);
+        const auto projDist = this->ProjC2CDist(ii, jj, kk, "k");
+
+        // update L matrix
+        L += OffDiagonal(state_(ii, jj, kk - 1), state_(ii, jj, kk),
+                         x(ii, jj, kk - 1), fAreaK_(ii, jj, kk),
+                         this->Viscosity(ii, jj, kk - 1),
+                         this->EddyViscosity(ii, jj, kk - 1),
+                         this->F1(ii, jj, kk - 1), projDist,
+                         this->VelGrad(ii, jj, kk - 1),
+                         eqnState, suth, turb, inp, true);
       }
 
-      // -----------------------------------------------------------------------
-      // if k lower cell is in physical location there is a contribution
-      // from it
-      if (this->IsPhysical(ii, jj, kk + 1) ||
-          bc_.GetBCName(ii, jj, kk + 1, 6) == "interblock") {
-        // calculate projected center to center distance along face area
-        const auto projDist = this->ProjC2CDist(ii, jj, kk + 1, "k");
-
-        // update U matrix
-        U += OffDiagonal(state_(ii, jj, kk + 1), state_(ii, jj, kk),
-                         x(ii, jj, kk + 1), fAreaK_(ii, jj, kk + 1),
-                         this->Viscosity(ii, jj, kk + 1),
-                         this->EddyViscosity(ii, jj, kk + 1),
-                         this->F1(ii, jj, kk + 1), projDist,
-                         this->VelGrad(ii, jj, kk + 1),
-                         eqnState, suth, turb, inp, false);
+
+      // Only need to calculate contribution for U if matrix update has been
+      // initialized, or if this is not the first sweep through the domain.
+      // If the matrix is not initialized, the update x is 0 for the first
+      // sweep, so U is 0.
+      if (sweep > 0 || inp.MatrixRequiresInitialization()) {
+        // ---------------------------------------------------------------------
+        // if i upper cell is in physical location there is a contribution
+        // from it
+        if (FaceHasNeighbor(faceTypeI_(ii + 1, jj, kk))) {
+          // calculate projected center to center distance along face area
+          const auto projDist = this->ProjC2CDist(ii + 1, jj, kk, "i");
+
+          // update U matrix
+          U += OffDiagonal(state_(ii + 1, jj, kk), state_(ii, jj, kk),
+                           x(ii + 1 , jj, kk), fAreaI_(ii + 1, jj, kk),
+                           this->Viscosity(ii + 1, jj, kk),
+                           this->EddyViscosity(ii + 1, jj, kk),
+                           this->F1(ii + 1, jj, kk), projDist,
+                           this->VelGrad(ii + 1, jj, kk),
+                           eqnState, suth, turb, inp, false);
+        }
+
+        // ---------------------------------------------------------------------
+        // if j upper cell is in physical location there is a contribution
+        // from it
+        if (FaceHasNeighbor(faceTypeJ_(ii, jj + 1, kk))) {
+          // calculate projected center to center distance along face area
+          const auto projDist = this->ProjC2CDist(ii, jj + 1, kk, "j");
+
+          // update U matrix
+          U += OffDiagonal(state_(ii, jj + 1, kk), state_(ii, jj, kk),
+                           x(ii, jj + 1, kk), fAreaJ_(ii, jj + 1, kk),
+                           this->Viscosity(ii, jj + 1, kk),
+                           this->EddyViscosity(ii, jj + 1, kk),
+                           this->F1(ii, jj + 1, kk), projDist,
+                           this->VelGrad(ii, jj + 1, kk),
+                           eqnState, suth, turb, inp, false);
+        }
+
+        // ---------------------------------------------------------------------
+        // if k lower cell is in physical location there is a contribution
+        // from it
+        if (FaceHasNeighbor(faceTypeK_(ii, jj, kk + 1))) {
+          // calculate projected center to center distance along face area
+          const auto projDist = this->ProjC2CDist(ii, jj, kk + 1, "k");
+
+          // update U matrix
+          U += OffDiagonal(state_(ii, jj, kk + 1), state_(ii, jj, kk),
+                           x(ii, jj, kk + 1), fAreaK_(ii, jj, kk + 1),
+                           this->Viscosity(ii, jj, kk + 1),
+                           this->EddyViscosity(ii, jj, kk + 1),
+                           this->F1(ii, jj, kk + 1), projDist,
+                           this->VelGrad(ii, jj, kk + 1),
+                           eqnState, suth, turb, inp, false);
+        }
       }
+      // -----------------------------------------------------------------------
+      const auto solDeltaNm1 = this->SolDeltaNm1(ii, jj, kk, inp);
+      const auto solDeltaMmN = this->SolDeltaMmN(ii, jj, kk, inp, eqnState);
+
+      // calculate intermediate update
+      // normal at lower boundaries needs to be reversed, so add instead
+      // of subtract L
+      x(ii, jj, kk) = aInv(ii, jj, kk).ArrayMult(-thetaInv *
+                                                 residual_(ii, jj, kk) -
+                                                 solDeltaNm1 - solDeltaMmN +
+                                                 L - U);
     }
-    // -----------------------------------------------------------------------
-    const auto solDeltaNm1 = this->SolDeltaNm1(ii, jj, kk, inp);
-    const auto solDeltaMmN = this->SolDeltaMmN(ii, jj, kk, inp, eqnState);
-
-    // calculate intermediate update
-    // normal at lower boundaries needs to be reversed, so add instead
-    // of subtract L
-    x(ii, jj, kk) = aInv(ii, jj, kk).ArrayMult(-thetaInv *
-                                               residual_(ii, jj, kk) -
-                                               solDeltaNm1 - solDeltaMmN +
-                                               L - U);
   }  // end forward sweep
 }
 
-double procBlock::LUSGS_Backward(const vector<vector3d<int>> &reorder,
-                                 multiArray3d<genArray> &x,
+double procBlock::LUSGS_Backward(multiArray3d<genArray> &x,
                                  const idealGas &eqnState, const input &inp,
                                  const sutherland &suth,
                                  const unique_ptr<turbModel> &turb,
                                  const multiArray3d<fluxJacobian> &aInv,
                                  const int &sweep) const {
-  // reorder -- order of cells to visit (this should be ordered in hyperplanes)
   // x -- correction - added to solution at time n to get to time n+1 (assumed
   //      to be zero to start)
   // eqnState -- equation of state
@@ -1390,155 +1910,180 @@ double procBlock::LUSGS_Backward(const vector<vector3d<int>> &reorder,
 
   const auto thetaInv = 1.0 / inp.Theta();
 
-  genArray l2Error(0.0);
+  // each thread sums the error of its own cells; the partial sums are added
+  // in thread order afterwards so the result does not depend on which thread
+  // finishes first
+#ifdef _OPENMP
+  vector<genArray> threadErrors(omp_get_max_threads(), genArray(0.0));
+#else
+  vector<genArray> threadErrors(1, genArray(0.0));
+#endif
+
+  // backward sweep over all physical cells, one hyperplane at a time
+  const auto numPlanes = static_cast<int>(hyperplaneStart_.size()) - 1;
+#pragma omp parallel
+  {
+    genArray threadError(0.0);
+    for (auto pp = numPlanes - 1; pp >= 0; pp--) {
+#pragma omp for schedule(static)
+      for (auto nn = hyperplaneStart_[pp + 1] - 1; nn >= hyperplaneStart_[pp];
+           nn--) {
+        // indices for variables without ghost cells
+        const auto ii = hyperplaneCells_[nn].X();
+        const auto jj = hyperplaneCells_[nn].Y();
+        const auto kk = hyperplaneCells_[nn].Z();
+
+        // initialize term for contribution from upper/lower triangular matrix
+        genArray U(0.0);
+        genArray L(0.0);
+
+        // ---------------------------------------------------------------------
+        // if i upper diagonal cell is in physical location there is a
+        // contribution from it
+        if (FaceHasNeighbor(faceTypeI_(ii + 1, jj, kk))) {
+          // calculate projected center to center distance along face area
+          const auto projDist = this->ProjC2CDist(ii + 1, jj, kk, "i");
 
-  // backward sweep over all physical cells
-  for (auto nn = this->NumCells() - 1; nn >= 0; nn--) {
-    // indices for variables without ghost cells
-    const auto ii = reorder[nn].X();
-    const auto jj = reorder[nn].Y();
-    const auto kk = reorder[nn].Z();
-
-    // initialize term for contribution from upper/lower triangular matrix
-    genArray U(0.0);
-    genArray L(0.0);
-
-    // -----------------------------------------------------------------------
-    // if i upper diagonal cell is in physical location there is a contribution
-    // from it
-    if (this->IsPhysical(ii + 1, jj, kk) ||
-        bc_.GetBCName(ii + 1, jj, kk, 2) == "interblock") {
-      // calculate projected center to center distance along face area
-      const auto projDist = this->ProjC2CDist(ii + 1, jj, kk, "i");
-
-      // update U matrix
-      U += OffDiagonal(state_(ii + 1, jj, kk), state_(ii, jj, kk),
-                       x(ii + 1, jj, kk), fAreaI_(ii + 1, jj, kk),
-                       this->Viscosity(ii + 1, jj, kk),
-                       this->EddyViscosity(ii + 1, jj, kk),
-                       this->F1(ii + 1, jj, kk), projDist,
-                       this->VelGrad(ii + 1, jj, kk),
-                       eqnState, suth, turb, inp, false);
-    }
+          // update U matrix
+          U += OffDiagonal(state_(ii + 1, jj, kk), state_(ii, jj, kk),
+                           x(ii + 1, jj, kk), fAreaI_(ii + 1, jj, kk),
+                           this->Viscosity(ii + 1, jj, kk),
+                           this->EddyViscosity(ii + 1, jj, kk),
+                           this->F1(ii + 1, jj, kk), projDist,
+                           this->VelGrad(ii + 1, jj, kk),
+                           eqnState, suth, turb, inp, false);
+        }
 
-    // -----------------------------------------------------------------------
-    // if j upper diagonal cell is in physical location there is a contribution
-    // from it
-    if (this->IsPhysical(ii, jj + 1, kk) ||
-        bc_.GetBCName(ii, jj + 1, kk, 4) == "interblock") {
-      // calculate projected center to center distance along face area
-      const auto projDist = this->ProjC2CDist(ii, jj + 1, kk, "j");
-
-      // update U matrix
-      U += OffDiagonal(state_(ii, jj + 1, kk), state_(ii, jj, kk),
-                       x(ii, jj + 1, kk), fAreaJ_(ii, jj + 1, kk),
-                       this->Viscosity(ii, jj + 1, kk),
-                       this->EddyViscosity(ii, jj + 1, kk),
-                       this->F1(ii, jj + 1, kk), projDist,
-                       this->VelGrad(ii, jj + 1, kk),
-                       eqnState, suth, turb, inp, false);
-    }
+        // ---------------------------------------------------------------------
+        // if j upper diagonal cell is in physical location there is a
+        // contribution from it
+        if (FaceHasNeighbor(faceTypeJ_(ii, jj + 1, kk))) {
+          // calculate projected center to center distance along face area
+          const auto projDist = this->ProjC2CDist(ii, jj + 1, kk, "j");
 
-    // -----------------------------------------------------------------------
-    // if k upper diagonal cell is in physical location there is a contribution
-    // from it
-    if (this->IsPhysical(ii, jj, kk + 1) ||
-        bc_.GetBCName(ii, jj, kk + 1, 6) == "interblock") {
-      // calculate projected center to center distance along face area
-      const auto projDist = this->ProjC2CDist(ii, jj, kk + 1, "k");
-
-      // update U matrix
-      U += OffDiagonal(state_(ii, jj, kk + 1), state_(ii, jj, kk),
-                       x(ii, jj, kk + 1), fAreaK_(ii, jj, kk + 1),
-                       this->Viscosity(ii, jj, kk + 1),
-                       this->EddyViscosity(ii, jj, kk + 1),
-                       this->F1(ii, jj, kk + 1), projDist,
-                       this->VelGrad(ii, jj, kk + 1),
-                       eqnState, suth, turb, inp, false);
-    }
+          // update U matrix
+          U += OffDiagonal(state_(ii, jj + 1, kk), state_(ii, jj, kk),
+                           x(ii, jj + 1, kk), fAreaJ_(ii, jj + 1, kk),
+                           this->Viscosity(ii, jj + 1, kk),
+                           this->EddyViscosity(ii, jj + 1, kk),
+                           this->F1(ii, jj + 1, kk), projDist,
+                           this->VelGrad(ii, jj + 1, kk),
+                           eqnState, suth, turb, inp, false);
+        }
 
+        // ---------------------------------------------------------------------
+        // if k upper diagonal cell is in physical location there is a
+        // contribution from it
+        if (FaceHasNeighbor(faceTypeK_(ii, jj, kk + 1))) {
+          // calculate projected center to center distance along face area
+          const auto projDist = this->ProjC2CDist(ii, jj, kk + 1, "k");
 
-    // Only need to calculate contribution for L if matrix update has been
-    // initialized, or if this is not the first sweep through the domain.
-    // If the matrix is not initialized, then b - Lx^* was already solved for
-    // in the forward sweep, so L is not needed
-    if (sweep > 0 || inp.MatrixRequiresInitialization()) {
-      // -----------------------------------------------------------------------
-      // if i lower cell is in physical location there is a contribution
-      // from it
-      if (this->IsPhysical(ii - 1, jj, kk) ||
-          bc_.GetBCName(ii, jj, kk, 1) == "interblock") {
-        // calculate projected center to center distance along face area
-        const auto projDist = this->ProjC2CDist(ii, jj, kk, "i");
+          // update U matrix
+          U += OffDiagonal(state_(ii, jj, kk + 1), state_(ii, jj, kk),
+                           x(ii, jj, kk + 1), fAreaK_(ii, jj, kk + 1),
+                           this->Viscosity(ii, jj, kk + 1),
+                           this->EddyViscosity(ii, jj, kk + 1),
+                           this->F1(ii, jj, kk + 1), projDist,
+                           this->VelGrad(ii, jj, kk + 1),
+                           eqnState, suth, turb, inp, false);
+        }
 
-        // update U matrix
-        L += OffDiagonal(state_(ii - 1, jj, kk), state_(ii, jj, kk),
-                         x(ii - 1, jj, kk), fAreaI_(ii, jj, kk),
-                         this->Viscosity(ii - 1, jj, kk),
-                         this->EddyViscosity(ii - 1, jj, kk),
-                         this->F1(ii - 1, jj, kk), projDist,
-                         this->VelGrad(ii - 1, jj, kk),
-                         eqnState, suth, turb, inp, true);
-      }
 
-      // -----------------------------------------------------------------------
-      // if j lower cell is in physical location there is a contribution
-      // from it
-      if (this->IsPhysical(ii, jj - 1, kk) ||
-          bc_.GetBCName(ii, jj, kk, 3) == "interblock") {
-        // calculate projected center to center distance along face area
-        const auto projDist = this->ProjC2CDist(ii, jj, kk, "j");
+        // Only need to calculate contribution for L if matrix update has been
+        // initialized, or if this is not the first sweep through the domain.
+        // If the matrix is not initialized, then b - Lx^* was already solved
+        // for in the forward sweep, so L is not needed
+        if (sweep > 0 || inp.MatrixRequiresInitialization()) {
+          // -------------------------------------------------------------------
+          // if i lower cell is in physical location there is a contribution
+          // from it
+          if (FaceHasNeighbor(faceTypeI_(ii, jj, kk))) {
+            // calculate projected center to center distance along face area
+            const auto projDist = this->ProjC2CDist(ii, jj, kk, "i");
+
+            // update U matrix
+            L += OffDiagonal(state_(ii - 1, jj, kk), state_(ii, jj, kk),
+                             x(ii - 1, jj, kk), fAreaI_(ii, jj, kk),
+                             this->Viscosity(ii - 1, jj, kk),
+                             this->EddyViscosity(ii - 1, jj, kk),
+                             this->F1(ii - 1, jj, kk), projDist,
+                             this->VelGrad(ii - 1, jj, kk),
+                             eqnState, suth, turb, inp, true);
+          }
 
-        // update U matrix
-        L += OffDiagonal(state_(ii, jj - 1, kk), state_(ii, jj, kk),
-                         x(ii, jj - 1, kk), fAreaJ_(ii, jj, kk),
-                         this->Viscosity(ii, jj - 1, kk),
-                         this->EddyViscosity(ii, jj - 1, kk),
-                         this->F1(ii, jj - 1, kk), projDist,
-                         this->VelGrad(ii, jj - 1, kk),
-                         eqnState, suth, turb, inp, true);
-      }
+          // -------------------------------------------------------------------
+          // if j lower cell is in physical location there is a contribution
+          // from it
+          if (FaceHasNeighbor(faceTypeJ_(ii, jj, kk))) {
+            // calculate projected center to center distance along face area
+            const auto projDist = this->ProjC2CDist(ii, jj, kk, "j");
+
+            // update U matrix
+            L += OffDiagonal(state_(ii, jj - 1, kk), state_(ii, jj, kk),
+                             x(ii, jj - 1, kk), fAreaJ_(ii, jj, kk),
+                             this->Viscosity(ii, jj - 1, kk),
+                             this->EddyViscosity(ii, jj - 1, kk),
+                             this->F1(ii, jj - 1, kk), projDist,
+                             this->VelGrad(ii, jj - 1, kk),
+                             eqnState, suth, turb, inp, true);
+          }
 
-      // -----------------------------------------------------------------------
-      // if k lower cell is in physical location there is a contribution
-      // from it
-      if (this->IsPhysical(ii, jj, kk - 1) ||
-          bc_.GetBCName(ii, jj, kk, 5) == "interblock") {
-        // calculate projected center to center distance along face area
-        const auto projDist = this->ProjC2CDist(ii, jj, kk, "k");
+          // -------------------------------------------------------------------
+          // if k lower cell is in physical location there is a contribution
+          // from it
+          if (FaceHasNeighbor(faceTypeK_(ii, jj, kk))) {
+            // calculate projected center to center distance along face area
+            const auto projDist = this->ProjC2CDist(ii, jj, kk, "k");
+
+            // update U matrix
+            L += OffDiagonal(state_(ii, jj, kk - 1), state_(ii, jj, kk),
+                             x(ii, jj, kk - 1), fAreaK_(ii, jj, kk),
+                             this->Viscosity(ii, jj, kk - 1),
+                             this->EddyViscosity(ii, jj, kk - 1),
+                             this->F1(ii, jj, kk - 1), projDist,
+                             this->VelGrad(ii, jj, kk - 1),
+                             eqnState, suth, turb, inp, true);
+          }
+        }
+        // ---------------------------------------------------------------------
+        const auto solDeltaNm1 = this->SolDeltaNm1(ii, jj, kk, inp);
+        const auto solDeltaMmN = this->SolDeltaMmN(ii, jj, kk, inp, eqnState);
 
-        // update U matrix
-        L += OffDiagonal(state_(ii, jj, kk - 1), state_(ii, jj, kk),
-                         x(ii, jj, kk - 1), fAreaK_(ii, jj, kk),
-                         this->Viscosity(ii, jj, kk - 1),
-                         this->EddyViscosity(ii, jj, kk - 1),
-                         this->F1(ii, jj, kk - 1), projDist,
-                         this->VelGrad(ii, jj, kk - 1),
-                         eqnState, suth, turb, inp, true);
+        // calculate update
+        auto xold = x(ii, jj, kk);
+        if (sweep > 0 || inp.MatrixRequiresInitialization()) {
+          x(ii, jj, kk) = aInv(ii, jj, kk).ArrayMult(-thetaInv *
+                                                     residual_(ii, jj, kk) -
+                                                     solDeltaNm1 - solDeltaMmN +
+                                                     L - U);
+        } else {
+          x(ii, jj, kk) -= aInv(ii, jj, kk).ArrayMult(U);
+        }
+        const auto error = x(ii, jj, kk) - xold;
+        threadError += error * error;
       }
     }
-    // -----------------------------------------------------------------------
-    const auto solDeltaNm1 = this->SolDeltaNm1(ii, jj, kk, inp);
-    const auto solDeltaMmN = this->SolDeltaMmN(ii, jj, kk, inp, eqnState);
-
-    // calculate update
-    auto xold = x(ii, jj, kk);
-    if (sweep > 0 || inp.MatrixRequiresInitialization()) {
-      x(ii, jj, kk) = aInv(ii, jj, kk).ArrayMult(-thetaInv *
-                                                 residual_(ii, jj, kk) -
-                                                 solDeltaNm1 - solDeltaMmN +
-                                                 L - U);
-    } else {
-      x(ii, jj, kk) -= aInv(ii, jj, kk).ArrayMult(U);
-    }
-    const auto error = x(ii, jj, kk) - xold;
-    l2Error += error * error;
+#ifdef _OPENMP
+    threadErrors[omp_get_thread_num()] = threadError;
+#else
+    threadErrors[0] = threadError;
+#endif
   }  // end backward sweep
 
+  genArray l2Error(0.0);
+  for (const auto &threadError : threadErrors) {
+    l2Error += threadError;
+  }
   return l2Error.Sum();
 }
 
 
+// member function to order the cells of the block by hyperplanes
+void procBlock::OrderHyperplanes() {
+  hyperplaneCells_ = HyperplaneReorder(this->NumI(), this->NumJ(),
+                                       this->NumK(), hyperplaneStart_);
+}
+
 /* Member function to calculate the implicit update via the DP-LUR method
  */
 double procBlock::DPLUR(multiArray3d<genArray> &x,
@@ -1571,8 +2116,7 @@ double procBlock::DPLUR(multiArray3d<genArray> &x,
         // -------------------------------------------------------------
         // if i lower diagonal cell is in physical location there is a
         // contribution from it
-        if (this->IsPhysical(ii - 1, jj, kk) ||
-            bc_.GetBCName(ii, jj, kk, 1) == "interblock") {
+        if (FaceHasNeighbor(faceTypeI_(ii, jj, kk))) {
           // calculate projected center to center distance
           const auto projDist = this->ProjC2CDist(ii, jj, kk, "i");
 
@@ -1589,8 +2133,7 @@ double procBlock::DPLUR(multiArray3d<genArray> &x,
         // --------------------------------------------------------------
         // if j lower diagonal cell is in physical location there is a
         // constribution from it
-        if (this->IsPhysical(ii, jj - 1, kk) ||
-            bc_.GetBCName(ii, jj, kk, 3) == "interblock") {
+        if (FaceHasNeighbor(faceTypeJ_(ii, jj, kk))) {
           // calculate projected center to center distance
           const auto projDist = this->ProjC2CDist(ii, jj, kk, "j");
 
@@ -1607,8 +2150,7 @@ double procBlock::DPLUR(multiArray3d<genArray> &x,
         // --------------------------------------------------------------
         // if k lower diagonal cell is in physical location there is a
         // contribution from it
-        if (this->IsPhysical(ii, jj, kk - 1) ||
-            bc_.GetBCName(ii, jj, kk, 5) == "interblock") {
+        if (FaceHasNeighbor(faceTypeK_(ii, jj, kk))) {
           // calculate projected center to center distance
           const auto projDist = this->ProjC2CDist(ii, jj, kk, "k");
 
@@ -1625,8 +2167,7 @@ double procBlock::DPLUR(multiArray3d<genArray> &x,
         // --------------------------------------------------------------
         // if i upper diagonal cell is in physical location there is a
         // contribution from it
-        if (this->IsPhysical(ii + 1, jj, kk) ||
-            bc_.GetBCName(ii + 1, jj, kk, 2) == "interblock") {
+        if (FaceHasNeighbor(faceTypeI_(ii + 1, jj, kk))) {
           // calculate projected center to center distance
           const auto projDist = this->ProjC2CDist(ii + 1, jj, kk, "i");
 
@@ -1644,8 +2185,7 @@ double procBlock::DPLUR(multiArray3d<genArray> &x,
         // --------------------------------------------------------------
         // if j upper diagonal cell is in physical location there is a
         // contribution from it
-        if (this->IsPhysical(ii, jj + 1, kk) ||
-            bc_.GetBCName(ii, jj + 1, kk, 4) == "interblock") {
+        if (FaceHasNeighbor(faceTypeJ_(ii, jj + 1, kk))) {
           // calculate projected center to center distance
           const auto projDist = this->ProjC2CDist(ii, jj + 1, kk, "j");
 
@@ -1663,8 +2203,7 @@ double procBlock::DPLUR(multiArray3d<genArray> &x,
         // --------------------------------------------------------------
         // if k upper diagonal cell is in physical location there is a
         // contribution from it
-        if (this->IsPhysical(ii, jj, kk + 1) ||
-            bc_.GetBCName(ii, jj, kk + 1, 6) == "interblock") {
+        if (FaceHasNeighbor(faceTypeK_(ii, jj, kk + 1))) {
           // calculate projected center to center distance
           const auto projDist = this->ProjC2CDist(ii, jj, kk + 1, "k");
 
@@ -1835,6 +2374,7 @@ in/out of the page). The stencil for the gradients of all faces in a cell
 touches 15 cells. The gradient calculation with this stencil uses the "edge"
 ghost cells, but not the "corner" ghost cells.
 */
+template <viscousReconstructionMethod V, bool isBlock>
 void procBlock::CalcViscFluxI(const sutherland &suth, const idealGas &eqnState,
                               const input &inp,
                               const unique_ptr<turbModel> &turb,
@@ -1853,21 +2393,63 @@ void procBlock::CalcViscFluxI(const sutherland &suth, const idealGas &eqnState,
   constexpr auto sixth = 1.0 / 6.0;
 
   // loop over all physical i-faces
+  // threads share out j-lines of faces, see CalcInvFlux()
+#pragma omp parallel
   for (auto kk = fAreaI_.PhysStartK(); kk < fAreaI_.PhysEndK(); kk++) {
+#pragma omp for schedule(static) nowait
     for (auto jj = fAreaI_.PhysStartJ(); jj < fAreaI_.PhysEndJ(); jj++) {
+#ifdef SOA_FIELDS
+      // the faces of the line are next to each other in i, so the face states
+      // are reconstructed from the variable planes one variable at a time
+      const auto numFaces = fAreaI_.PhysEndI() - fAreaI_.PhysStartI();
+      vector<double> coeffsD(numFaces), coeffsU(numFaces);
+      vector<double> faceStates(NUMVARS * numFaces);
+      if (V == viscousReconstructionMethod::central) {
+        for (auto ff = 0; ff < numFaces; ff++) {
+          const auto ii = fAreaI_.PhysStartI() + ff;
+          const auto coeffs = LagrangeCoeff(
+              {cellWidthI_(ii - 1, jj, kk), cellWidthI_(ii, jj, kk)}, 1, 0, 0);
+          coeffsD[ff] = coeffs[0];
+          coeffsU[ff] = coeffs[1];
+        }
+        for (auto vv = 0; vv < NUMVARS; vv++) {
+          const auto *varU =
+              state_.Plane(vv, fAreaI_.PhysStartI() - 1, jj, kk);
+          const auto *varD = varU + 1;
+          auto *face = &faceStates[vv * numFaces];
+#pragma omp simd
+          for (auto ff = 0; ff < numFaces; ff++) {
+            face[ff] = coeffsD[ff] * varD[ff] + coeffsU[ff] * varU[ff];
+          }
+        }
+      }
+#endif
       for (auto ii = fAreaI_.PhysStartI(); ii < fAreaI_.PhysEndI(); ii++) {
         primVars state;
         auto wDist = 0.0;
         auto mu = 0.0;
 
-        if (inp.ViscousFaceReconstruction() == "central") {
+        if (V == viscousReconstructionMethod::central) {
+#ifdef SOA_FIELDS
+          const auto ff = ii - fAreaI_.PhysStartI();
+          for (auto vv = 0; vv < NUMVARS; vv++) {
+            state[vv] = faceStates[vv * numFaces + ff];
+          }
+          state.LimitTurb(turb);
+
+          // wall distance and viscosity at face use the same coefficients
+          wDist = coeffsD[ff] * wallDist_(ii, jj, kk) +
+              coeffsU[ff] * wallDist_(ii - 1, jj, kk);
+          mu = coeffsD[ff] * viscosity_(ii, jj, kk) +
+              coeffsU[ff] * viscosity_(ii - 1, jj, kk);
+#else
           // get cell widths
           const vector<double> cellWidth = {cellWidthI_(ii - 1, jj, kk),
                                             cellWidthI_(ii, jj, kk)};
 
           // Get state at face
-          state = FaceReconCentral(state_(ii - 1, jj, kk),
-                                   state_(ii, jj, kk), cellWidth);
+          state = FaceReconCentral<primVars>(state_(ii - 1, jj, kk),
+                                             state_(ii, jj, kk), cellWidth);
           state.LimitTurb(turb);
 
           // Get wall distance at face
@@ -1877,7 +2459,7 @@ void procBlock::CalcViscFluxI(const sutherland &suth, const idealGas &eqnState,
           // Get viscosity at face
           mu = FaceReconCentral(viscosity_(ii - 1, jj, kk),
                                 viscosity_(ii, jj, kk), cellWidth);
-
+#endif
         } else {  // use 4th order reconstruction
           // get cell widths
           const vector<double> cellWidth = {cellWidthI_(ii - 2, jj, kk),
@@ -1886,10 +2468,11 @@ void procBlock::CalcViscFluxI(const sutherland &suth, const idealGas &eqnState,
                                             cellWidthI_(ii + 1, jj, kk)};
 
           // Get state at face
-          state = FaceReconCentral4th(state_(ii - 2, jj, kk),
-                                      state_(ii - 1, jj, kk),
-                                      state_(ii, jj, kk),
-                                      state_(ii + 1, jj, kk), cellWidth);
+          state = FaceReconCentral4th<primVars>(state_(ii - 2, jj, kk),
+                                                state_(ii - 1, jj, kk),
+                                                state_(ii, jj, kk),
+                                                state_(ii + 1, jj, kk),
+                                                cellWidth);
           state.LimitTurb(turb);
 
           // Get wall distance at face
@@ -1949,7 +2532,7 @@ void procBlock::CalcViscFluxI(const sutherland &suth, const idealGas &eqnState,
           }
 
           // if using block matrix on main diagonal, accumulate flux jacobian
-          if (inp.IsBlockMatrix()) {
+          if (isBlock) {
             // using mu, mut, and f1 at face
             fluxJacobian fluxJac;
             fluxJac.ApproxTSLJacobian(state, mu, mut, f1, eqnState, suth,
@@ -1978,7 +2561,7 @@ void procBlock::CalcViscFluxI(const sutherland &suth, const idealGas &eqnState,
           // calculate component of wave speed. This is done on a cell by cell
           // basis, so only at the upper faces
           const auto viscSpecRad =
-              state_(ii, jj, kk).ViscCellSpectralRadius(
+              this->State(ii, jj, kk).ViscCellSpectralRadius(
                   fAreaI_(ii, jj, kk), fAreaI_(ii + 1, jj, kk), eqnState, suth,
                   vol_(ii, jj, kk), viscosity_(ii, jj, kk), mut, turb);
 
@@ -1993,7 +2576,7 @@ void procBlock::CalcViscFluxI(const sutherland &suth, const idealGas &eqnState,
           specRadius_(ii, jj, kk) += specRad * viscCoeff;
 
           // if using block matrix on main diagonal, accumulate flux jacobian
-          if (inp.IsBlockMatrix()) {
+          if (isBlock) {
             // using mu, mut, and f1 at face
             fluxJacobian fluxJac;
             fluxJac.ApproxTSLJacobian(state, mu, mut, f1, eqnState, suth,
@@ -2081,6 +2664,7 @@ In three dimensions each gradient calculation touches the values at 10 cells
 faces in a cell touches 15 cells. The gradient calculation with this stencil uses
 the "edge" ghost cells, but not the "corner" ghost cells.
 */
+template <viscousReconstructionMethod V, bool isBlock>
 void procBlock::CalcViscFluxJ(const sutherland &suth, const idealGas &eqnState,
                               const input &inp,
                               const unique_ptr<turbModel> &turb,
@@ -2099,21 +2683,24 @@ void procBlock::CalcViscFluxJ(const sutherland &suth, const idealGas &eqnState,
   constexpr auto sixth = 1.0 / 6.0;
 
   // loop over all physical j-faces
+  // threads share out i-lines of faces, see CalcInvFlux()
+#pragma omp parallel
   for (auto kk = fAreaJ_.PhysStartK(); kk < fAreaJ_.PhysEndK(); kk++) {
     for (auto jj = fAreaJ_.PhysStartJ(); jj < fAreaJ_.PhysEndJ(); jj++) {
+#pragma omp for schedule(static) nowait
       for (auto ii = fAreaJ_.PhysStartI(); ii < fAreaJ_.PhysEndI(); ii++) {
         primVars state;
         auto wDist = 0.0;
         auto mu = 0.0;
 
-        if (inp.ViscousFaceReconstruction() == "central") {
+        if (V == viscousReconstructionMethod::central) {
           // get cell widths
           const vector<double> cellWidth = {cellWidthJ_(ii, jj - 1, kk),
                                             cellWidthJ_(ii, jj, kk)};
 
           // Get velocity at face
-          state = FaceReconCentral(state_(ii, jj - 1, kk),
-                                   state_(ii, jj, kk), cellWidth);
+          state = FaceReconCentral<primVars>(state_(ii, jj - 1, kk),
+                                             state_(ii, jj, kk), cellWidth);
           state.LimitTurb(turb);
 
           // Get wall distance at face
@@ -2132,10 +2719,11 @@ void procBlock::CalcViscFluxJ(const sutherland &suth, const idealGas &eqnState,
                                             cellWidthJ_(ii, jj + 1, kk)};
 
           // Get velocity at face
-          state = FaceReconCentral4th(state_(ii, jj - 2, kk),
-                                      state_(ii, jj - 1, kk),
-                                      state_(ii, jj, kk),
-                                      state_(ii, jj + 1, kk), cellWidth);
+          state = FaceReconCentral4th<primVars>(state_(ii, jj - 2, kk),
+                                                state_(ii, jj - 1, kk),
+                                                state_(ii, jj, kk),
+                                                state_(ii, jj + 1, kk),
+                                                cellWidth);
           state.LimitTurb(turb);
 
           // Get wall distance at face
@@ -2196,7 +2784,7 @@ void procBlock::CalcViscFluxJ(const sutherland &suth, const idealGas &eqnState,
           }
 
           // if using block matrix on main diagonal, accumulate flux jacobian
-          if (inp.IsBlockMatrix()) {
+          if (isBlock) {
             // using mu, mut, and f1 at face
             fluxJacobian fluxJac;
             fluxJac.ApproxTSLJacobian(state, mu, mut, f1, eqnState, suth,
@@ -2225,7 +2813,7 @@ void procBlock::CalcViscFluxJ(const sutherland &suth, const idealGas &eqnState,
           // calculate component of wave speed. This is done on a cell by cell
           // basis, so only at the upper faces
           const auto viscSpecRad =
-              state_(ii, jj, kk).ViscCellSpectralRadius(
+              this->State(ii, jj, kk).ViscCellSpectralRadius(
                   fAreaJ_(ii, jj, kk), fAreaJ_(ii, jj + 1, kk), eqnState, suth,
                   vol_(ii, jj, kk), viscosity_(ii, jj, kk), mut, turb);
 
@@ -2241,7 +2829,7 @@ void procBlock::CalcViscFluxJ(const sutherland &suth, const idealGas &eqnState,
 
 
           // if using block matrix on main diagonal, accumulate flux jacobian
-          if (inp.IsBlockMatrix()) {
+          if (isBlock) {
             // using mu, mut, and f1 at face
             fluxJacobian fluxJac;
             fluxJac.ApproxTSLJacobian(state, mu, mut, f1, eqnState, suth,
@@ -2328,6 +2916,7 @@ In three dimensions each gradient calculation touches the values at 10 cells
 faces in a cell touches 15 cells. The gradient calculation with this stencil uses
 the "edge" ghost cells, but not the "corner" ghost cells.
 */
+template <viscousReconstructionMethod V, bool isBlock>
 void procBlock::CalcViscFluxK(const sutherland &suth, const idealGas &eqnState,
                               const input &inp,
                               const unique_ptr<turbModel> &turb,
@@ -2346,21 +2935,24 @@ void procBlock::CalcViscFluxK(const sutherland &suth, const idealGas &eqnState,
   constexpr auto sixth = 1.0 / 6.0;
 
   // loop over all physical k-faces
+  // threads share out j-lines of faces, see CalcInvFlux()
+#pragma omp parallel
   for (auto kk = fAreaK_.PhysStartK(); kk < fAreaK_.PhysEndK(); kk++) {
+#pragma omp for schedule(static) nowait
     for (auto jj = fAreaK_.PhysStartJ(); jj < fAreaK_.PhysEndJ(); jj++) {
       for (auto ii = fAreaK_.PhysStartI(); ii < fAreaK_.PhysEndI(); ii++) {
         primVars state;
         auto wDist = 0.0;
         auto mu = 0.0;
 
-        if (inp.ViscousFaceReconstruction() == "central") {
+        if (V == viscousReconstructionMethod::central) {
           // get cell widths
           const vector<double> cellWidth = {cellWidthK_(ii, jj, kk - 1),
                                             cellWidthK_(ii, jj, kk)};
 
           // Get state at face
-          state = FaceReconCentral(state_(ii, jj, kk - 1),
-                                   state_(ii, jj, kk), cellWidth);
+          state = FaceReconCentral<primVars>(state_(ii, jj, kk - 1),
+                                             state_(ii, jj, kk), cellWidth);
           state.LimitTurb(turb);
 
           // Get wall distance at face
@@ -2379,10 +2971,11 @@ void procBlock::CalcViscFluxK(const sutherland &suth, const idealGas &eqnState,
                                             cellWidthK_(ii, jj, kk + 1)};
 
           // Get state at face
-          state = FaceReconCentral4th(state_(ii, jj, kk - 2),
-                                      state_(ii, jj, kk - 1),
-                                      state_(ii, jj, kk),
-                                      state_(ii, jj, kk + 1), cellWidth);
+          state = FaceReconCentral4th<primVars>(state_(ii, jj, kk - 2),
+                                                state_(ii, jj, kk - 1),
+                                                state_(ii, jj, kk),
+                                                state_(ii, jj, kk + 1),
+                                                cellWidth);
           state.LimitTurb(turb);
 
           // Get wall distance at face
@@ -2443,7 +3036,7 @@ void procBlock::CalcViscFluxK(const sutherland &suth, const idealGas &eqnState,
           }
 
           // if using block matrix on main diagonal, accumulate flux jacobian
-          if (inp.IsBlockMatrix()) {
+          if (isBlock) {
             // using mu, mut, and f1 at face
             fluxJacobian fluxJac;
             fluxJac.ApproxTSLJacobian(state, mu, mut, f1, eqnState, suth,
@@ -2472,7 +3065,7 @@ void procBlock::CalcViscFluxK(const sutherland &suth, const idealGas &eqnState,
           // calculate component of wave speed. This is done on a cell by cell
           // basis, so only at the upper faces
           const auto viscSpecRad =
-              state_(ii, jj, kk).ViscCellSpectralRadius(
+              this->State(ii, jj, kk).ViscCellSpectralRadius(
                   fAreaK_(ii, jj, kk), fAreaK_(ii, jj, kk + 1), eqnState, suth,
                   vol_(ii, jj, kk), viscosity_(ii, jj, kk),
                   mut, turb);
@@ -2488,7 +3081,7 @@ void procBlock::CalcViscFluxK(const sutherland &suth, const idealGas &eqnState,
           specRadius_(ii, jj, kk) += specRad * viscCoeff;
 
           // if using block matrix on main diagonal, accumulate flux jacobian
-          if (inp.IsBlockMatrix()) {
+          if (isBlock) {
             // using mu, mut, and f1 at face
             fluxJacobian fluxJac;
             fluxJac.ApproxTSLJacobian(state, mu, mut, f1, eqnState, suth,
@@ -3063,13 +3656,13 @@ void procBlock::AssignInviscidGhostCellsEdge(
             // surface-2 is a wall, but surface-3 is not - extend wall bc
             if (bc_2 == "slipWall" && bc_3 != "slipWall") {
               state_(dir, d1, gCellD2, gCellD3) =
-                  state_(dir, d1, pCellD2, gCellD3).GetGhostState(
+                  primVars(state_(dir, d1, pCellD2, gCellD3)).GetGhostState(
                       bc_2, fArea2, wDist2, surf2, inp, tag2, eos, suth, turb,
                       layer2);
               // surface-3 is a wall, but surface-2 is not - extend wall bc
             } else if (bc_2 != "slipWall" && bc_3 == "slipWall") {
               state_(dir, d1, gCellD2, gCellD3) =
-                  state_(dir, d1, gCellD2, pCellD3).GetGhostState(
+                  primVars(state_(dir, d1, gCellD2, pCellD3)).GetGhostState(
                       bc_3, fArea3, wDist3, surf3, inp, tag3, eos, suth, turb,
                       layer3);
             } else {  // both surfaces or neither are walls - proceed as normal
@@ -3328,13 +3921,13 @@ void procBlock::AssignViscousGhostCellsEdge(const input &inp,
             // surface-2 is a wall, but surface-3 is not - extend wall bc
             if (bc_2 == "slipWall" && bc_3 != "slipWall") {
               state_(dir, d1, gCellD2, gCellD3) =
-                  state_(dir, d1, pCellD2, gCellD3).GetGhostState(
+                  primVars(state_(dir, d1, pCellD2, gCellD3)).GetGhostState(
                       bc_2, fArea2, wDist2, surf2, inp, tag2, eos, suth, turb,
                       layer2);
               // surface-3 is a wall, but surface-2 is not - extend wall bc
             } else if (bc_2 != "slipWall" && bc_3 == "slipWall") {
               state_(dir, d1, gCellD2, gCellD3) =
-                  state_(dir, d1, gCellD2, pCellD3).GetGhostState(
+                  primVars(state_(dir, d1, gCellD2, pCellD3)).GetGhostState(
                       bc_3, fArea3, wDist3, surf3, inp, tag3, eos, suth, turb,
                       layer3);
               // both surfaces are walls - proceed as normal
@@ -3537,41 +4130,38 @@ void procBlock::SwapGradientSlice(const interblock &inter, procBlock &blk) {
 }
 
 
-/* Function to swap slice using MPI. This is similar to the SwapSlice
-function, but is called when the neighboring procBlocks are on different
-processors.
+/* Functions to add the swap of slices using MPI to an exchange. These are
+similar to the swap functions above, but are called when the neighboring
+procBlocks are on different processors. The swaps are not finished until the
+exchange is completed.
 */
-void procBlock::SwapStateSliceMPI(const interblock &inter, const int &rank,
-                                  const MPI_Datatype &MPI_cellData) {
-  // inter -- interblock boundary information
-  // rank -- processor rank
-  // MPI_cellData -- MPI datatype for passing primVars, genArray
+void procBlock::AddStateSliceMPI(const int &conn, haloExchange &exchange) {
+  // conn -- index of interblock
+  // exchange -- exchange to add swap to
 
-  state_.SwapSliceMPI(inter, rank, MPI_cellData);
+  exchange.Add(state_, conn);
 }
 
-void procBlock::SwapTurbSliceMPI(const interblock &inter, const int &rank) {
-  // inter -- interblock boundary information
-  // rank -- processor rank
+void procBlock::AddTurbSliceMPI(const int &conn, haloExchange &exchange) {
+  // conn -- index of interblock
+  // exchange -- exchange to add swap to
 
-  eddyViscosity_.SwapSliceMPI(inter, rank, MPI_DOUBLE, 1);
-  f1_.SwapSliceMPI(inter, rank, MPI_DOUBLE, 2);
-  f2_.SwapSliceMPI(inter, rank, MPI_DOUBLE, 3);
+  exchange.Add(eddyViscosity_, conn);
+  exchange.Add(f1_, conn);
+  exchange.Add(f2_, conn);
 }
 
-void procBlock::SwapGradientSliceMPI(const interblock &inter, const int &rank,
-                                     const MPI_Datatype &MPI_tensorDouble,
-                                     const MPI_Datatype &MPI_vec3d) {
-  // inter -- interblock boundary information
-  // rank -- processor rank
+void procBlock::AddGradientSliceMPI(const int &conn, haloExchange &exchange) {
+  // conn -- index of interblock
+  // exchange -- exchange to add swap to
 
   if (isViscous_) {
-    velocityGrad_.SwapSliceMPI(inter, rank, MPI_tensorDouble, 1);
-    temperatureGrad_.SwapSliceMPI(inter, rank, MPI_vec3d, 2);
+    exchange.Add(velocityGrad_, conn);
+    exchange.Add(temperatureGrad_, conn);
   }
   if (isTurbulent_) {
-    tkeGrad_.SwapSliceMPI(inter, rank, MPI_vec3d, 3);
-    omegaGrad_.SwapSliceMPI(inter, rank, MPI_vec3d, 4);
+    exchange.Add(tkeGrad_, conn);
+    exchange.Add(omegaGrad_, conn);
   }
 }
 
@@ -4491,494 +5081,6 @@ void procBlock::PutStateSlice(const multiArray3d<primVars> &slice,
   state_.PutSlice(slice, inter, d3);
 }
 
-/*Member function to pack and send procBlock geometry data to appropriate
- * processor. */
-void procBlock::PackSendGeomMPI(const MPI_Datatype &MPI_cellData,
-                                const MPI_Datatype &MPI_vec3d,
-                                const MPI_Datatype &MPI_vec3dMag) const {
-  // MPI_cellData -- MPI data type for cell data
-  // MPI_vec3d -- MPI data type for a vector3d
-  // MPI_vec3dMag -- MPI data type for a unitVect3dMag
-
-  // determine size of buffer to send
-  auto sendBufSize = 0;
-  auto tempSize = 0;
-  // adding 3 more ints for block dimensions
-  MPI_Pack_size(8, MPI_INT, MPI_COMM_WORLD,
-                &tempSize);  // add size for ints in class procBlock
-  sendBufSize += tempSize;
-  MPI_Pack_size(4, MPI_CXX_BOOL, MPI_COMM_WORLD,
-                &tempSize);  // add size for bools in class procBlock
-  sendBufSize += tempSize;
-  MPI_Pack_size(state_.Size(), MPI_cellData, MPI_COMM_WORLD,
-                &tempSize);  // add size for states
-  sendBufSize += tempSize;
-  MPI_Pack_size(consVarsNm1_.Size(), MPI_cellData, MPI_COMM_WORLD,
-                &tempSize);  // add size for solution n-1
-  sendBufSize += tempSize;
-  MPI_Pack_size(center_.Size(), MPI_vec3d, MPI_COMM_WORLD,
-                &tempSize);  // add size for cell centers
-  sendBufSize += tempSize;
-  MPI_Pack_size(fAreaI_.Size(), MPI_vec3dMag, MPI_COMM_WORLD,
-                &tempSize);  // add size for face area I
-  sendBufSize += tempSize;
-  MPI_Pack_size(fAreaJ_.Size(), MPI_vec3dMag, MPI_COMM_WORLD,
-                &tempSize);  // add size for face area J
-  sendBufSize += tempSize;
-  MPI_Pack_size(fAreaK_.Size(), MPI_vec3dMag, MPI_COMM_WORLD,
-                &tempSize);  // add size for face area K
-  sendBufSize += tempSize;
-  MPI_Pack_size(fCenterI_.Size(), MPI_vec3d, MPI_COMM_WORLD,
-                &tempSize);  // add size for face center I
-  sendBufSize += tempSize;
-  MPI_Pack_size(fCenterJ_.Size(), MPI_vec3d, MPI_COMM_WORLD,
-                &tempSize);  // add size for face center J
-  sendBufSize += tempSize;
-  MPI_Pack_size(fCenterK_.Size(), MPI_vec3d, MPI_COMM_WORLD,
-                &tempSize);  // add size for face center K
-  sendBufSize += tempSize;
-  MPI_Pack_size(vol_.Size(), MPI_DOUBLE, MPI_COMM_WORLD,
-                &tempSize);  // add size for volumes
-  sendBufSize += tempSize;
-  MPI_Pack_size(3, MPI_INT, MPI_COMM_WORLD,
-                &tempSize);  // add size for number of bc surfaces
-  sendBufSize += tempSize;
-  // 8x because iMin, iMax, jMin, jMax, kMin, kMax, tags, string sizes
-  MPI_Pack_size(bc_.NumSurfaces() * 8, MPI_INT, MPI_COMM_WORLD,
-                &tempSize);  // add size for BCs
-  sendBufSize += tempSize;
-
-  auto stringSize = 0;
-  for (auto jj = 0; jj < bc_.NumSurfaces(); jj++) {
-    MPI_Pack_size(
-        bc_.GetBCTypes(jj).size() + 1, MPI_CHAR, MPI_COMM_WORLD,
-        &tempSize);  // add size for bc_ types (+1 for c_str end character)
-    stringSize += tempSize;
-  }
-  sendBufSize += stringSize;
-
-  // allocate buffer to pack data into
-  auto *sendBuffer = new char[sendBufSize];
-
-  const auto numI = this->NumI();
-  const auto numJ = this->NumJ();
-  const auto numK = this->NumK();
-
-  // pack data to send into buffer
-  auto position = 0;
-  // int and vector data
-  MPI_Pack(&numI, 1, MPI_INT, sendBuffer, sendBufSize, &position,
-           MPI_COMM_WORLD);
-  MPI_Pack(&numJ, 1, MPI_INT, sendBuffer, sendBufSize, &position,
-           MPI_COMM_WORLD);
-  MPI_Pack(&numK, 1, MPI_INT, sendBuffer, sendBufSize, &position,
-           MPI_COMM_WORLD);
-  MPI_Pack(&numGhosts_, 1, MPI_INT, sendBuffer, sendBufSize, &position,
-           MPI_COMM_WORLD);
-  MPI_Pack(&parBlock_, 1, MPI_INT, sendBuffer, sendBufSize, &position,
-           MPI_COMM_WORLD);
-  MPI_Pack(&rank_, 1, MPI_INT, sendBuffer, sendBufSize, &position,
-           MPI_COMM_WORLD);
-  MPI_Pack(&localPos_, 1, MPI_INT, sendBuffer, sendBufSize, &position,
-           MPI_COMM_WORLD);
-  MPI_Pack(&globalPos_, 1, MPI_INT, sendBuffer, sendBufSize, &position,
-           MPI_COMM_WORLD);
-  MPI_Pack(&isViscous_, 1, MPI_CXX_BOOL, sendBuffer, sendBufSize, &position,
-           MPI_COMM_WORLD);
-  MPI_Pack(&isTurbulent_, 1, MPI_CXX_BOOL, sendBuffer, sendBufSize, &position,
-           MPI_COMM_WORLD);
-  MPI_Pack(&storeTimeN_, 1, MPI_CXX_BOOL, sendBuffer, sendBufSize,
-           &position, MPI_COMM_WORLD);
-  MPI_Pack(&isMultiLevelTime_, 1, MPI_CXX_BOOL, sendBuffer, sendBufSize,
-           &position, MPI_COMM_WORLD);
-  MPI_Pack(&(*std::begin(state_)), state_.Size(), MPI_cellData, sendBuffer,
-           sendBufSize, &position, MPI_COMM_WORLD);
-  if (isMultiLevelTime_) {
-    MPI_Pack(&(*std::begin(consVarsNm1_)), consVarsNm1_.Size(), MPI_cellData,
-             sendBuffer, sendBufSize, &position, MPI_COMM_WORLD);
-  }
-  MPI_Pack(&(*std::begin(center_)), center_.Size(), MPI_vec3d, sendBuffer,
-           sendBufSize, &position, MPI_COMM_WORLD);
-  MPI_Pack(&(*std::begin(fAreaI_)), fAreaI_.Size(), MPI_vec3dMag,
-           sendBuffer, sendBufSize, &position, MPI_COMM_WORLD);
-  MPI_Pack(&(*std::begin(fAreaJ_)), fAreaJ_.Size(), MPI_vec3dMag,
-           sendBuffer, sendBufSize, &position, MPI_COMM_WORLD);
-  MPI_Pack(&(*std::begin(fAreaK_)), fAreaK_.Size(), MPI_vec3dMag,
-           sendBuffer, sendBufSize, &position, MPI_COMM_WORLD);
-  MPI_Pack(&(*std::begin(fCenterI_)), fCenterI_.Size(), MPI_vec3d,
-           sendBuffer, sendBufSize, &position, MPI_COMM_WORLD);
-  MPI_Pack(&(*std::begin(fCenterJ_)), fCenterJ_.Size(), MPI_vec3d,
-           sendBuffer, sendBufSize, &position, MPI_COMM_WORLD);
-  MPI_Pack(&(*std::begin(fCenterK_)), fCenterK_.Size(), MPI_vec3d,
-           sendBuffer, sendBufSize, &position, MPI_COMM_WORLD);
-  MPI_Pack(&(*std::begin(vol_)), vol_.Size(), MPI_DOUBLE, sendBuffer,
-           sendBufSize, &position, MPI_COMM_WORLD);
-
-  // pack boundary condition data
-  bc_.PackBC(sendBuffer, sendBufSize, position);
-
-  // send buffer to appropriate processor
-  MPI_Send(sendBuffer, sendBufSize, MPI_PACKED, rank_, 2,
-           MPI_COMM_WORLD);
-
-  delete[] sendBuffer;  // deallocate buffer
-}
-
-void procBlock::RecvUnpackGeomMPI(const MPI_Datatype &MPI_cellData,
-                                  const MPI_Datatype &MPI_vec3d,
-                                  const MPI_Datatype &MPI_vec3dMag) {
-  // MPI_cellData -- MPI data type for cell data
-  // MPI_vec3d -- MPI data type for a vector3d
-  // MPI_vec3dMag -- MPI data type for a unitVect3dMag
-
-  MPI_Status status;  // allocate MPI_Status structure
-
-  // probe message to get correct data size
-  auto recvBufSize = 0;
-  MPI_Probe(ROOTP, 2, MPI_COMM_WORLD, &status);
-  MPI_Get_count(&status, MPI_CHAR, &recvBufSize);  // use MPI_CHAR because
-                                                   // sending buffer was
-                                                   // allocated with chars
-
-  auto *recvBuffer = new char[recvBufSize];  // allocate buffer of correct size
-
-  // receive message from ROOT
-  MPI_Recv(recvBuffer, recvBufSize, MPI_PACKED, ROOTP, 2, MPI_COMM_WORLD,
-           &status);
-
-  auto numI = 0, numJ = 0, numK = 0;
-  // unpack procBlock INTs
-  auto position = 0;
-  MPI_Unpack(recvBuffer, recvBufSize, &position, &numI, 1,
-             MPI_INT, MPI_COMM_WORLD);
-  MPI_Unpack(recvBuffer, recvBufSize, &position, &numJ, 1,
-             MPI_INT, MPI_COMM_WORLD);
-  MPI_Unpack(recvBuffer, recvBufSize, &position, &numK, 1,
-             MPI_INT, MPI_COMM_WORLD);
-  MPI_Unpack(recvBuffer, recvBufSize, &position, &numGhosts_, 1,
-             MPI_INT, MPI_COMM_WORLD);
-  MPI_Unpack(recvBuffer, recvBufSize, &position, &parBlock_, 1, MPI_INT,
-             MPI_COMM_WORLD);
-  MPI_Unpack(recvBuffer, recvBufSize, &position, &rank_, 1, MPI_INT,
-             MPI_COMM_WORLD);
-  MPI_Unpack(recvBuffer, recvBufSize, &position, &localPos_, 1, MPI_INT,
-             MPI_COMM_WORLD);
-  MPI_Unpack(recvBuffer, recvBufSize, &position, &globalPos_, 1,
-             MPI_INT, MPI_COMM_WORLD);
-
-  // unpack procBlock bools
-  MPI_Unpack(recvBuffer, recvBufSize, &position, &isViscous_, 1,
-             MPI_CXX_BOOL, MPI_COMM_WORLD);
-  MPI_Unpack(recvBuffer, recvBufSize, &position, &isTurbulent_, 1,
-             MPI_CXX_BOOL, MPI_COMM_WORLD);
-  MPI_Unpack(recvBuffer, recvBufSize, &position, &storeTimeN_, 1,
-             MPI_CXX_BOOL, MPI_COMM_WORLD);
-  MPI_Unpack(recvBuffer, recvBufSize, &position, &isMultiLevelTime_, 1,
-             MPI_CXX_BOOL, MPI_COMM_WORLD);
-
-  // clean and resize the vectors in the class to
-  this->CleanResizeVecs(numI, numJ, numK, numGhosts_);
-
-  // unpack vector data into allocated vectors
-  MPI_Unpack(recvBuffer, recvBufSize, &position, &(*std::begin(state_)),
-             state_.Size(), MPI_cellData,
-             MPI_COMM_WORLD);  // unpack states
-  if (isMultiLevelTime_) {
-    MPI_Unpack(recvBuffer, recvBufSize, &position, &(*std::begin(consVarsNm1_)),
-               consVarsNm1_.Size(), MPI_cellData,
-               MPI_COMM_WORLD);  // unpack sol n-1
-  }
-  MPI_Unpack(recvBuffer, recvBufSize, &position, &(*std::begin(center_)),
-             center_.Size(), MPI_vec3d,
-             MPI_COMM_WORLD);  // unpack cell centers
-  MPI_Unpack(recvBuffer, recvBufSize, &position, &(*std::begin(fAreaI_)),
-             fAreaI_.Size(), MPI_vec3dMag,
-             MPI_COMM_WORLD);  // unpack face area I
-  MPI_Unpack(recvBuffer, recvBufSize, &position, &(*std::begin(fAreaJ_)),
-             fAreaJ_.Size(), MPI_vec3dMag,
-             MPI_COMM_WORLD);  // unpack face area J
-  MPI_Unpack(recvBuffer, recvBufSize, &position, &(*std::begin(fAreaK_)),
-             fAreaK_.Size(), MPI_vec3dMag,
-             MPI_COMM_WORLD);  // unpack face area K
-  MPI_Unpack(recvBuffer, recvBufSize, &position, &(*std::begin(fCenterI_)),
-             fCenterI_.Size(), MPI_vec3d,
-             MPI_COMM_WORLD);  // unpack face center_ I
-  MPI_Unpack(recvBuffer, recvBufSize, &position, &(*std::begin(fCenterJ_)),
-             fCenterJ_.Size(), MPI_vec3d,
-             MPI_COMM_WORLD);  // unpack face center_ J
-  MPI_Unpack(recvBuffer, recvBufSize, &position, &(*std::begin(fCenterK_)),
-             fCenterK_.Size(), MPI_vec3d,
-             MPI_COMM_WORLD);  // unpack face center_ K
-  MPI_Unpack(recvBuffer, recvBufSize, &position, &(*std::begin(vol_)),
-             vol_.Size(), MPI_DOUBLE,
-             MPI_COMM_WORLD);  // unpack volumes
-
-  // unpack boundary conditions
-  bc_.UnpackBC(recvBuffer, recvBufSize, position);
-
-  delete[] recvBuffer;  // deallocate receiving buffer
-}
-
-/*Member function to zero and resize the vectors in a procBlock to their
- * appropriate size given the i, j, and k dimensions.*/
-void procBlock::CleanResizeVecs(const int &numI, const int &numJ,
-                                const int &numK, const int &numGhosts) {
-  // numI -- i-dimension to resize to (no ghosts)
-  // numJ -- j-dimension to resize to (no ghosts)
-  // numK -- k-dimension to resize to (no ghosts)
-  // numGhosts -- number of ghost cells
-
-  state_.ClearResize(numI, numJ, numK, numGhosts);
-  if (storeTimeN_) {
-    consVarsN_.ClearResize(numI, numJ, numK, 0);
-  }
-  if (isMultiLevelTime_) {
-    consVarsNm1_.ClearResize(numI, numJ, numK, 0);
-  }
-  center_.ClearResize(numI, numJ, numK, numGhosts);
-  vol_.ClearResize(numI, numJ, numK, numGhosts);
-
-  fCenterI_.ClearResize(numI + 1, numJ, numK, numGhosts);
-  fAreaI_.ClearResize(numI + 1, numJ, numK, numGhosts);
-
-  fCenterJ_.ClearResize(numI, numJ + 1, numK, numGhosts);
-  fAreaJ_.ClearResize(numI, numJ + 1, numK, numGhosts);
-
-  fCenterK_.ClearResize(numI, numJ, numK + 1, numGhosts);
-  fAreaK_.ClearResize(numI, numJ, numK + 1, numGhosts);
-
-  wallDist_.ClearResize(numI, numJ, numK, numGhosts, DEFAULTWALLDIST);
-
-  residual_.ClearResize(numI, numJ, numK, 0);
-  specRadius_.ClearResize(numI, numJ, numK, 0);
-  dt_.ClearResize(numI, numJ, numK, 0);
-
-  temperature_.ClearResize(numI, numJ, numK, numGhosts);
-
-  if (isViscous_) {
-    velocityGrad_.ClearResize(numI, numJ, numK, numGhosts);
-    temperatureGrad_.ClearResize(numI, numJ, numK, numGhosts);
-    viscosity_.ClearResize(numI, numJ, numK, numGhosts);
-  }
-
-  if (isTurbulent_) {
-    tkeGrad_.ClearResize(numI, numJ, numK, numGhosts);
-    omegaGrad_.ClearResize(numI, numJ, numK, numGhosts);
-    eddyViscosity_.ClearResize(numI, numJ, numK, numGhosts);
-    f1_.ClearResize(numI, numJ, numK, numGhosts);
-    f2_.ClearResize(numI, numJ, numK, numGhosts);
-  }
-}
-
-/*Member function to receive and unpack procBlock state data. This is used to
- * gather the solution on the ROOT processor to write out the solution. */
-void procBlock::RecvUnpackSolMPI(const MPI_Datatype &MPI_cellData,
-                                 const MPI_Datatype &MPI_uncoupledScalar,
-                                 const MPI_Datatype &MPI_vec3d,
-                                 const MPI_Datatype &MPI_tensorDouble) {
-  // MPI_cellData -- MPI data type for cell data
-  // MPI_uncoupledScalar -- MPI data type for uncoupledScalar
-  // MPI_vec3d -- MPI data type for vector3d<double>
-  // MPI_tensorDouble -- MPI data taype for tensor<double>
-
-  MPI_Status status;  // allocate MPI_Status structure
-
-  // probe message to get correct data size
-  auto recvBufSize = 0;
-  MPI_Probe(rank_, globalPos_, MPI_COMM_WORLD,
-            &status);  // global position used as tag because each block has a
-                       // unique one
-  MPI_Get_count(&status, MPI_CHAR, &recvBufSize);  // use MPI_CHAR because
-                                                   // sending buffer was
-                                                   // allocated with chars
-
-  auto *recvBuffer = new char[recvBufSize];  // allocate buffer of correct size
-
-  // receive message from non-ROOT
-  MPI_Recv(recvBuffer, recvBufSize, MPI_PACKED, rank_,
-           globalPos_, MPI_COMM_WORLD, &status);
-
-  // unpack vector data into allocated vectors
-  auto position = 0;
-  MPI_Unpack(recvBuffer, recvBufSize, &position, &(*std::begin(state_)),
-             state_.Size(), MPI_cellData,
-             MPI_COMM_WORLD);  // unpack states
-  if (isMultiLevelTime_) {
-    MPI_Unpack(recvBuffer, recvBufSize, &position, &(*std::begin(consVarsNm1_)),
-               consVarsNm1_.Size(), MPI_cellData,
-               MPI_COMM_WORLD);  // unpack states
-  }
-  MPI_Unpack(recvBuffer, recvBufSize, &position, &(*std::begin(residual_)),
-             residual_.Size(), MPI_cellData,
-             MPI_COMM_WORLD);  // unpack residuals
-  MPI_Unpack(recvBuffer, recvBufSize, &position, &(*std::begin(dt_)),
-             dt_.Size(), MPI_DOUBLE,
-             MPI_COMM_WORLD);  // unpack time steps
-  MPI_Unpack(recvBuffer, recvBufSize, &position, &(*std::begin(wallDist_)),
-             wallDist_.Size(), MPI_DOUBLE,
-             MPI_COMM_WORLD);  // unpack wall distance
-  MPI_Unpack(recvBuffer, recvBufSize, &position, &(*std::begin(specRadius_)),
-             specRadius_.Size(), MPI_uncoupledScalar,
-             MPI_COMM_WORLD);  // unpack average wave speeds
-  MPI_Unpack(recvBuffer, recvBufSize, &position, &(*std::begin(temperature_)),
-             temperature_.Size(), MPI_DOUBLE,
-             MPI_COMM_WORLD);  // unpack temperature
-
-  if (isViscous_) {
-    MPI_Unpack(recvBuffer, recvBufSize, &position, &(*std::begin(viscosity_)),
-               viscosity_.Size(), MPI_DOUBLE,
-               MPI_COMM_WORLD);  // unpack viscosity
-    MPI_Unpack(recvBuffer, recvBufSize, &position,
-               &(*std::begin(velocityGrad_)), velocityGrad_.Size(),
-               MPI_tensorDouble, MPI_COMM_WORLD);  // unpack velocity gradient
-    MPI_Unpack(recvBuffer, recvBufSize, &position,
-               &(*std::begin(temperatureGrad_)), temperatureGrad_.Size(),
-               MPI_vec3d, MPI_COMM_WORLD);  // unpack temperature gradient
-  }
-
-  if (isTurbulent_) {
-    MPI_Unpack(recvBuffer, recvBufSize, &position,
-               &(*std::begin(eddyViscosity_)), eddyViscosity_.Size(),
-               MPI_DOUBLE, MPI_COMM_WORLD);  // unpack eddy viscosity
-    MPI_Unpack(recvBuffer, recvBufSize, &position, &(*std::begin(f1_)),
-               f1_.Size(), MPI_DOUBLE,
-               MPI_COMM_WORLD);  // unpack blending variable f1
-    MPI_Unpack(recvBuffer, recvBufSize, &position, &(*std::begin(f2_)),
-               f2_.Size(), MPI_DOUBLE,
-               MPI_COMM_WORLD);  // unpack blending variable f2
-    MPI_Unpack(recvBuffer, recvBufSize, &position, &(*std::begin(tkeGrad_)),
-               tkeGrad_.Size(), MPI_vec3d,
-               MPI_COMM_WORLD);  // unpack tke gradient
-    MPI_Unpack(recvBuffer, recvBufSize, &position, &(*std::begin(omegaGrad_)),
-               omegaGrad_.Size(), MPI_vec3d,
-               MPI_COMM_WORLD);  // unpack omega gradient
-  }
-
-  delete[] recvBuffer;  // deallocate receiving buffer
-}
-
-/*Member function to pack and send procBlock state data to the ROOT proecessor.
- * This is used to gather the solution on the ROOT processor to write out the
- * solution. */
-void procBlock::PackSendSolMPI(const MPI_Datatype &MPI_cellData,
-                               const MPI_Datatype &MPI_uncoupledScalar,
-                               const MPI_Datatype &MPI_vec3d,
-                               const MPI_Datatype &MPI_tensorDouble) const {
-  // MPI_cellData -- MPI data type for cell data
-  // MPI_uncoupledScalar -- MPI data type for uncoupledScalar
-  // MPI_vec3d -- MPI data type for vector3d<double>
-  // MPI_tensorDouble -- MPI data taype for tensor<double>
-
-  // determine size of buffer to send
-  auto sendBufSize = 0;
-  auto tempSize = 0;
-  MPI_Pack_size(state_.Size(), MPI_cellData, MPI_COMM_WORLD,
-                &tempSize);  // add size for states
-  sendBufSize += tempSize;
-  if (isMultiLevelTime_) {
-    MPI_Pack_size(consVarsNm1_.Size(), MPI_cellData, MPI_COMM_WORLD,
-                  &tempSize);  // add size for sol n-1
-    sendBufSize += tempSize;
-  }
-  MPI_Pack_size(residual_.Size(), MPI_cellData, MPI_COMM_WORLD,
-                &tempSize);  // add size for residuals
-  sendBufSize += tempSize;
-  MPI_Pack_size(dt_.Size(), MPI_DOUBLE, MPI_COMM_WORLD,
-                &tempSize);  // add size for time steps
-  sendBufSize += tempSize;
-  MPI_Pack_size(wallDist_.Size(), MPI_DOUBLE, MPI_COMM_WORLD,
-                &tempSize);  // add size for wall distance
-  sendBufSize += tempSize;
-  MPI_Pack_size(specRadius_.Size(), MPI_uncoupledScalar, MPI_COMM_WORLD,
-                &tempSize);  // add size for average wave speed
-  sendBufSize += tempSize;
-  MPI_Pack_size(temperature_.Size(), MPI_DOUBLE, MPI_COMM_WORLD,
-                &tempSize);  // add size for temperature
-  sendBufSize += tempSize;
-
-  if (isViscous_) {
-    MPI_Pack_size(viscosity_.Size(), MPI_DOUBLE, MPI_COMM_WORLD,
-                  &tempSize);  // add size for viscosity
-    sendBufSize += tempSize;
-    MPI_Pack_size(velocityGrad_.Size(), MPI_tensorDouble, MPI_COMM_WORLD,
-                  &tempSize);  // add size for velocity gradient
-    sendBufSize += tempSize;
-    MPI_Pack_size(temperatureGrad_.Size(), MPI_vec3d, MPI_COMM_WORLD,
-                  &tempSize);  // add size for temperature gradient
-    sendBufSize += tempSize;
-  }
-
-  if (isTurbulent_) {
-    MPI_Pack_size(eddyViscosity_.Size(), MPI_DOUBLE, MPI_COMM_WORLD,
-                  &tempSize);  // add size for eddy viscosity
-    sendBufSize += tempSize;
-    MPI_Pack_size(f1_.Size(), MPI_DOUBLE, MPI_COMM_WORLD,
-                  &tempSize);  // add size for blending variable f1
-    sendBufSize += tempSize;
-    MPI_Pack_size(f2_.Size(), MPI_DOUBLE, MPI_COMM_WORLD,
-                  &tempSize);  // add size for blending variable f2
-    sendBufSize += tempSize;
-    MPI_Pack_size(tkeGrad_.Size(), MPI_vec3d, MPI_COMM_WORLD,
-                  &tempSize);  // add size for tke gradient
-    sendBufSize += tempSize;
-    MPI_Pack_size(omegaGrad_.Size(), MPI_vec3d, MPI_COMM_WORLD,
-                  &tempSize);  // add size for omega gradient
-    sendBufSize += tempSize;
-  }
-
-
-  auto *sendBuffer = new char[sendBufSize];  // allocate buffer to pack data
-                                             // into
-
-  // pack data to send into buffer
-  auto position = 0;
-  MPI_Pack(&(*std::begin(state_)), state_.Size(), MPI_cellData, sendBuffer,
-           sendBufSize, &position, MPI_COMM_WORLD);
-  if (isMultiLevelTime_) {
-    MPI_Pack(&(*std::begin(consVarsNm1_)), consVarsNm1_.Size(), MPI_cellData,
-             sendBuffer, sendBufSize, &position, MPI_COMM_WORLD);
-  }
-  MPI_Pack(&(*std::begin(residual_)), residual_.Size(), MPI_cellData,
-           sendBuffer, sendBufSize, &position, MPI_COMM_WORLD);
-  MPI_Pack(&(*std::begin(dt_)), dt_.Size(), MPI_DOUBLE, sendBuffer,
-           sendBufSize, &position, MPI_COMM_WORLD);
-  MPI_Pack(&(*std::begin(wallDist_)), wallDist_.Size(), MPI_DOUBLE,
-           sendBuffer, sendBufSize, &position, MPI_COMM_WORLD);
-  MPI_Pack(&(*std::begin(specRadius_)), specRadius_.Size(), MPI_uncoupledScalar,
-           sendBuffer, sendBufSize, &position, MPI_COMM_WORLD);
-  MPI_Pack(&(*std::begin(temperature_)), temperature_.Size(), MPI_DOUBLE,
-           sendBuffer, sendBufSize, &position, MPI_COMM_WORLD);
-
-  if (isViscous_) {
-    MPI_Pack(&(*std::begin(viscosity_)), viscosity_.Size(), MPI_DOUBLE,
-             sendBuffer, sendBufSize, &position, MPI_COMM_WORLD);
-    MPI_Pack(&(*std::begin(velocityGrad_)), velocityGrad_.Size(),
-             MPI_tensorDouble, sendBuffer, sendBufSize, &position,
-             MPI_COMM_WORLD);
-    MPI_Pack(&(*std::begin(temperatureGrad_)), temperatureGrad_.Size(),
-             MPI_vec3d, sendBuffer, sendBufSize, &position, MPI_COMM_WORLD);
-  }
-
-  if (isTurbulent_) {
-    MPI_Pack(&(*std::begin(eddyViscosity_)), eddyViscosity_.Size(), MPI_DOUBLE,
-             sendBuffer, sendBufSize, &position, MPI_COMM_WORLD);
-    MPI_Pack(&(*std::begin(f1_)), f1_.Size(), MPI_DOUBLE,
-             sendBuffer, sendBufSize, &position, MPI_COMM_WORLD);
-    MPI_Pack(&(*std::begin(f2_)), f2_.Size(), MPI_DOUBLE,
-             sendBuffer, sendBufSize, &position, MPI_COMM_WORLD);
-    MPI_Pack(&(*std::begin(tkeGrad_)), tkeGrad_.Size(), MPI_vec3d,
-             sendBuffer, sendBufSize, &position, MPI_COMM_WORLD);
-    MPI_Pack(&(*std::begin(omegaGrad_)), omegaGrad_.Size(), MPI_vec3d,
-             sendBuffer, sendBufSize, &position, MPI_COMM_WORLD);
-  }
-
-  // send buffer to appropriate processor
-  MPI_Send(sendBuffer, sendBufSize, MPI_PACKED, ROOTP, globalPos_,
-           MPI_COMM_WORLD);
-
-  delete[] sendBuffer;  // deallocate buffer
-}
-
 /* Member function to split a procBlock along a plane defined by a direction and
 an index. The calling instance will retain the lower portion of the split,
 and the returned instance will retain the upper portion of the split.
@@ -5135,8 +5237,10 @@ procBlock procBlock::Split(const string &dir, const int &ind, const int &num,
 
   // assign boundary conditions
   blk1.bc_ = bound1;
+  blk1.ClassifyFaces();
   (*this) = blk1;
   blk2.bc_ = bound2;
+  blk2.ClassifyFaces();
   return blk2;
 }
 
@@ -5179,6 +5283,7 @@ void procBlock::Join(const procBlock &blk, const string &dir,
 
   newBlk.bc_ = bc_;
   newBlk.bc_.Join(blk.bc_, dir, alteredSurf);
+  newBlk.ClassifyFaces();
 
   // assign variables from lower block -----------------------------
   // assign cell variables with ghost cells
@@ -5426,28 +5531,36 @@ void procBlock::CalcGradsI(const int &ii, const int &jj, const int &kk,
   // calculate volume of alternate control volume
   const auto vol = 0.5 * (vol_(ii - 1, jj, kk) + vol_(ii, jj, kk));
 
+  // states of the cells in the stencil
+  const auto &stateL = state_(ii - 1, jj, kk);
+  const auto &stateU = state_(ii, jj, kk);
+  const auto &stateLjm = state_(ii - 1, jj - 1, kk);
+  const auto &stateLjp = state_(ii - 1, jj + 1, kk);
+  const auto &stateLkm = state_(ii - 1, jj, kk - 1);
+  const auto &stateLkp = state_(ii - 1, jj, kk + 1);
+  const auto &stateUjm = state_(ii, jj - 1, kk);
+  const auto &stateUjp = state_(ii, jj + 1, kk);
+  const auto &stateUkm = state_(ii, jj, kk - 1);
+  const auto &stateUkp = state_(ii, jj, kk + 1);
+
   // calculate average velocity on j and k faces of alternate control volume
   const auto vju = 0.25 *
-      (state_(ii - 1, jj, kk).Velocity() + state_(ii, jj, kk).Velocity() +
-       state_(ii, jj + 1, kk).Velocity() +
-       state_(ii - 1, jj + 1, kk).Velocity());
+      (stateL.Velocity() + stateU.Velocity() + stateUjp.Velocity() +
+       stateLjp.Velocity());
   const auto vjl = 0.25 *
-      (state_(ii - 1, jj, kk).Velocity() + state_(ii, jj, kk).Velocity() +
-       state_(ii, jj - 1, kk).Velocity() +
-       state_(ii - 1, jj - 1, kk).Velocity());
+      (stateL.Velocity() + stateU.Velocity() + stateUjm.Velocity() +
+       stateLjm.Velocity());
 
   const auto vku = 0.25 *
-      (state_(ii - 1, jj, kk).Velocity() + state_(ii, jj, kk).Velocity() +
-       state_(ii, jj, kk + 1).Velocity() +
-       state_(ii - 1, jj, kk + 1).Velocity());
+      (stateL.Velocity() + stateU.Velocity() + stateUkp.Velocity() +
+       stateLkp.Velocity());
   const auto vkl = 0.25 *
-      (state_(ii - 1, jj, kk).Velocity() + state_(ii, jj, kk).Velocity() +
-       state_(ii, jj, kk - 1).Velocity() +
-       state_(ii - 1, jj, kk - 1).Velocity());
+      (stateL.Velocity() + stateU.Velocity() + stateUkm.Velocity() +
+       stateLkm.Velocity());
 
   // Get velocity gradient at face
-  velGrad = VectorGradGG(state_(ii - 1, jj, kk).Velocity(),
-                         state_(ii, jj, kk).Velocity(), vjl, vju, vkl, vku,
+  velGrad = VectorGradGG(stateL.Velocity(),
+                         stateU.Velocity(), vjl, vju, vkl, vku,
                          ail, aiu, ajl, aju, akl, aku, vol);
 
   // calculate average temperature on j and k faces of alternate control volume
@@ -5477,42 +5590,34 @@ void procBlock::CalcGradsI(const int &ii, const int &jj, const int &kk,
   if (isTurbulent_) {
     // calculate average tke on j and k faces of alternate control volume
     const auto tkeju = 0.25 *
-        (state_(ii - 1, jj, kk).Tke() + state_(ii, jj, kk).Tke() +
-         state_(ii, jj + 1, kk).Tke() + state_(ii - 1, jj + 1, kk).Tke());
+        (stateL.Tke() + stateU.Tke() + stateUjp.Tke() + stateLjp.Tke());
     const auto tkejl = 0.25 *
-        (state_(ii - 1, jj, kk).Tke() + state_(ii, jj, kk).Tke() +
-         state_(ii, jj - 1, kk).Tke() + state_(ii - 1, jj - 1, kk).Tke());
+        (stateL.Tke() + stateU.Tke() + stateUjm.Tke() + stateLjm.Tke());
 
     const auto tkeku = 0.25 *
-        (state_(ii - 1, jj, kk).Tke() + state_(ii, jj, kk).Tke() +
-         state_(ii, jj, kk + 1).Tke() + state_(ii - 1, jj, kk + 1).Tke());
+        (stateL.Tke() + stateU.Tke() + stateUkp.Tke() + stateLkp.Tke());
     const auto tkekl = 0.25 *
-        (state_(ii - 1, jj, kk).Tke() + state_(ii, jj, kk).Tke() +
-         state_(ii, jj, kk - 1).Tke() + state_(ii - 1, jj, kk - 1).Tke());
+        (stateL.Tke() + stateU.Tke() + stateUkm.Tke() + stateLkm.Tke());
 
     // Get tke gradient at face
-    tkeGrad = ScalarGradGG(state_(ii - 1, jj, kk).Tke(),
-                           state_(ii, jj, kk).Tke(), tkejl, tkeju, tkekl,
+    tkeGrad = ScalarGradGG(stateL.Tke(),
+                           stateU.Tke(), tkejl, tkeju, tkekl,
                            tkeku, ail, aiu, ajl, aju, akl, aku, vol);
 
     // calculate average Omega on j and k faces of alternate control volume
     const auto omgju = 0.25 *
-        (state_(ii - 1, jj, kk).Omega() + state_(ii, jj, kk).Omega() +
-         state_(ii, jj + 1, kk).Omega() + state_(ii - 1, jj + 1, kk).Omega());
+        (stateL.Omega() + stateU.Omega() + stateUjp.Omega() + stateLjp.Omega());
     const auto omgjl = 0.25 *
-        (state_(ii - 1, jj, kk).Omega() + state_(ii, jj, kk).Omega() +
-         state_(ii, jj - 1, kk).Omega() + state_(ii - 1, jj - 1, kk).Omega());
+        (stateL.Omega() + stateU.Omega() + stateUjm.Omega() + stateLjm.Omega());
 
     const auto omgku = 0.25 *
-        (state_(ii - 1, jj, kk).Omega() + state_(ii, jj, kk).Omega() +
-         state_(ii, jj, kk + 1).Omega() + state_(ii - 1, jj, kk + 1).Omega());
+        (stateL.Omega() + stateU.Omega() + stateUkp.Omega() + stateLkp.Omega());
     const auto omgkl = 0.25 *
-        (state_(ii - 1, jj, kk).Omega() + state_(ii, jj, kk).Omega() +
-         state_(ii, jj, kk - 1).Omega() + state_(ii - 1, jj, kk - 1).Omega());
+        (stateL.Omega() + stateU.Omega() + stateUkm.Omega() + stateLkm.Omega());
 
     // Get omega gradient at face
     omegaGrad = ScalarGradGG(
-        state_(ii - 1, jj, kk).Omega(), state_(ii, jj, kk).Omega(), omgjl,
+        stateL.Omega(), stateU.Omega(), omgjl,
         omgju, omgkl, omgku, ail, aiu, ajl, aju, akl, aku, vol);
   }
 }
@@ -5548,28 +5653,36 @@ void procBlock::CalcGradsJ(const int &ii, const int &jj, const int &kk,
   // calculate volume of alternate control volume
   const auto vol = 0.5 * (vol_(ii, jj - 1, kk) + vol_(ii, jj, kk));
 
+  // states of the cells in the stencil
+  const auto &stateL = state_(ii, jj - 1, kk);
+  const auto &stateU = state_(ii, jj, kk);
+  const auto &stateLim = state_(ii - 1, jj - 1, kk);
+  const auto &stateLip = state_(ii + 1, jj - 1, kk);
+  const auto &stateLkm = state_(ii, jj - 1, kk - 1);
+  const auto &stateLkp = state_(ii, jj - 1, kk + 1);
+  const auto &stateUim = state_(ii - 1, jj, kk);
+  const auto &stateUip = state_(ii + 1, jj, kk);
+  const auto &stateUkm = state_(ii, jj, kk - 1);
+  const auto &stateUkp = state_(ii, jj, kk + 1);
+
   // calculate average velocity on i and k faces of alternate control volume
   const auto viu = 0.25 *
-      (state_(ii, jj - 1, kk).Velocity() + state_(ii, jj, kk).Velocity() +
-       state_(ii + 1, jj, kk).Velocity() +
-       state_(ii + 1, jj - 1, kk).Velocity());
+      (stateL.Velocity() + stateU.Velocity() + stateUip.Velocity() +
+       stateLip.Velocity());
   const auto vil = 0.25 *
-      (state_(ii, jj - 1, kk).Velocity() + state_(ii, jj, kk).Velocity() +
-       state_(ii - 1, jj, kk).Velocity() +
-       state_(ii - 1, jj - 1, kk).Velocity());
+      (stateL.Velocity() + stateU.Velocity() + stateUim.Velocity() +
+       stateLim.Velocity());
 
   const auto vku = 0.25 *
-      (state_(ii, jj - 1, kk).Velocity() + state_(ii, jj, kk).Velocity() +
-       state_(ii, jj, kk + 1).Velocity() +
-       state_(ii, jj - 1, kk + 1).Velocity());
+      (stateL.Velocity() + stateU.Velocity() + stateUkp.Velocity() +
+       stateLkp.Velocity());
   const auto vkl = 0.25 *
-      (state_(ii, jj - 1, kk).Velocity() + state_(ii, jj, kk).Velocity() +
-       state_(ii, jj, kk - 1).Velocity() +
-       state_(ii, jj - 1, kk - 1).Velocity());
+      (stateL.Velocity() + stateU.Velocity() + stateUkm.Velocity() +
+       stateLkm.Velocity());
 
   // Get velocity gradient at face
-  velGrad = VectorGradGG(vil, viu, state_(ii, jj - 1, kk).Velocity(),
-                         state_(ii, jj, kk).Velocity(), vkl, vku, ail, aiu,
+  velGrad = VectorGradGG(vil, viu, stateL.Velocity(),
+                         stateU.Velocity(), vkl, vku, ail, aiu,
                          ajl, aju, akl, aku, vol);
 
   // calculate average temperature on i and k faces of alternate control volume
@@ -5599,42 +5712,34 @@ void procBlock::CalcGradsJ(const int &ii, const int &jj, const int &kk,
   if (isTurbulent_) {
     // calculate average tke on i and k faces of alternate control volume
     const auto tkeiu = 0.25 *
-        (state_(ii, jj - 1, kk).Tke() + state_(ii, jj, kk).Tke() +
-         state_(ii + 1, jj, kk).Tke() + state_(ii + 1, jj - 1, kk).Tke());
+        (stateL.Tke() + stateU.Tke() + stateUip.Tke() + stateLip.Tke());
     const auto tkeil = 0.25 *
-        (state_(ii, jj - 1, kk).Tke() + state_(ii, jj, kk).Tke() +
-         state_(ii - 1, jj, kk).Tke() + state_(ii - 1, jj - 1, kk).Tke());
+        (stateL.Tke() + stateU.Tke() + stateUim.Tke() + stateLim.Tke());
 
     const auto tkeku = 0.25 *
-        (state_(ii, jj - 1, kk).Tke() + state_(ii, jj, kk).Tke() +
-         state_(ii, jj, kk + 1).Tke() + state_(ii, jj - 1, kk + 1).Tke());
+        (stateL.Tke() + stateU.Tke() + stateUkp.Tke() + stateLkp.Tke());
     const auto tkekl = 0.25 *
-        (state_(ii, jj - 1, kk).Tke() + state_(ii, jj, kk).Tke() +
-         state_(ii, jj, kk - 1).Tke() + state_(ii, jj - 1, kk - 1).Tke());
+        (stateL.Tke() + stateU.Tke() + stateUkm.Tke() + stateLkm.Tke());
 
     // Get temperature gradient at face
-    tkeGrad = ScalarGradGG(tkeil, tkeiu, state_(ii, jj - 1, kk).Tke(),
-                           state_(ii, jj, kk).Tke(), tkekl, tkeku, ail, aiu,
+    tkeGrad = ScalarGradGG(tkeil, tkeiu, stateL.Tke(),
+                           stateU.Tke(), tkekl, tkeku, ail, aiu,
                            ajl, aju, akl, aku, vol);
 
     // calculate average omega on i and k faces of alternate control volume
     const auto omgiu = 0.25 *
-        (state_(ii, jj - 1, kk).Omega() + state_(ii, jj, kk).Omega() +
-         state_(ii + 1, jj, kk).Omega() + state_(ii + 1, jj - 1, kk).Omega());
+        (stateL.Omega() + stateU.Omega() + stateUip.Omega() + stateLip.Omega());
     const auto omgil = 0.25 *
-        (state_(ii, jj - 1, kk).Omega() + state_(ii, jj, kk).Omega() +
-         state_(ii - 1, jj, kk).Omega() + state_(ii - 1, jj - 1, kk).Omega());
+        (stateL.Omega() + stateU.Omega() + stateUim.Omega() + stateLim.Omega());
 
     const auto omgku = 0.25 *
-        (state_(ii, jj - 1, kk).Omega() + state_(ii, jj, kk).Omega() +
-         state_(ii, jj, kk + 1).Omega() + state_(ii, jj - 1, kk + 1).Omega());
+        (stateL.Omega() + stateU.Omega() + stateUkp.Omega() + stateLkp.Omega());
     const auto omgkl = 0.25 *
-        (state_(ii, jj - 1, kk).Omega() + state_(ii, jj, kk).Omega() +
-         state_(ii, jj, kk - 1).Omega() + state_(ii, jj - 1, kk - 1).Omega());
+        (stateL.Omega() + stateU.Omega() + stateUkm.Omega() + stateLkm.Omega());
 
     // Get temperature gradient at face
-    omegaGrad = ScalarGradGG(omgil, omgiu, state_(ii, jj - 1, kk).Omega(),
-                             state_(ii, jj, kk).Omega(), omgkl, omgku, ail,
+    omegaGrad = ScalarGradGG(omgil, omgiu, stateL.Omega(),
+                             stateU.Omega(), omgkl, omgku, ail,
                              aiu, ajl, aju, akl, aku, vol);
   }
 }
@@ -5670,28 +5775,36 @@ void procBlock::CalcGradsK(const int &ii, const int &jj, const int &kk,
   // calculate volume of alternate control volume
   const auto vol = 0.5 * (vol_(ii, jj, kk - 1) + vol_(ii, jj, kk));
 
+  // states of the cells in the stencil
+  const auto &stateL = state_(ii, jj, kk - 1);
+  const auto &stateU = state_(ii, jj, kk);
+  const auto &stateLim = state_(ii - 1, jj, kk - 1);
+  const auto &stateLip = state_(ii + 1, jj, kk - 1);
+  const auto &stateLjm = state_(ii, jj - 1, kk - 1);
+  const auto &stateLjp = state_(ii, jj + 1, kk - 1);
+  const auto &stateUim = state_(ii - 1, jj, kk);
+  const auto &stateUip = state_(ii + 1, jj, kk);
+  const auto &stateUjm = state_(ii, jj - 1, kk);
+  const auto &stateUjp = state_(ii, jj + 1, kk);
+
   // calculate average velocity on i and j faces of alternate control volume
   const auto viu = 0.25 *
-      (state_(ii, jj, kk - 1).Velocity() + state_(ii, jj, kk).Velocity() +
-       state_(ii + 1, jj, kk).Velocity() +
-       state_(ii + 1, jj, kk - 1).Velocity());
+      (stateL.Velocity() + stateU.Velocity() + stateUip.Velocity() +
+       stateLip.Velocity());
   const auto vil = 0.25 *
-      (state_(ii, jj, kk - 1).Velocity() + state_(ii, jj, kk).Velocity() +
-       state_(ii - 1, jj, kk).Velocity() +
-       state_(ii - 1, jj, kk - 1).Velocity());
+      (stateL.Velocity() + stateU.Velocity() + stateUim.Velocity() +
+       stateLim.Velocity());
 
   const auto vju = 0.25 *
-      (state_(ii, jj, kk - 1).Velocity() + state_(ii, jj, kk).Velocity() +
-       state_(ii, jj + 1, kk).Velocity() +
-       state_(ii, jj + 1, kk - 1).Velocity());
+      (stateL.Velocity() + stateU.Velocity() + stateUjp.Velocity() +
+       stateLjp.Velocity());
   const auto vjl = 0.25 *
-      (state_(ii, jj, kk - 1).Velocity() + state_(ii, jj, kk).Velocity() +
-       state_(ii, jj - 1, kk).Velocity() +
-       state_(ii, jj - 1, kk - 1).Velocity());
+      (stateL.Velocity() + stateU.Velocity() + stateUjm.Velocity() +
+       stateLjm.Velocity());
 
   // Get velocity gradient at face
-  velGrad = VectorGradGG(vil, viu, vjl, vju, state_(ii, jj, kk - 1).Velocity(),
-                         state_(ii, jj, kk).Velocity(), ail, aiu, ajl, aju,
+  velGrad = VectorGradGG(vil, viu, vjl, vju, stateL.Velocity(),
+                         stateU.Velocity(), ail, aiu, ajl, aju,
                          akl, aku, vol);
 
   // calculate average temperature on i and j faces of alternate control volume
@@ -5721,43 +5834,35 @@ void procBlock::CalcGradsK(const int &ii, const int &jj, const int &kk,
   if (isTurbulent_) {
     // calculate average tke on i and j faces of alternate control volume
     const auto tkeiu = 0.25 *
-        (state_(ii, jj, kk - 1).Tke() + state_(ii, jj, kk).Tke() +
-         state_(ii + 1, jj, kk).Tke() + state_(ii + 1, jj, kk - 1).Tke());
+        (stateL.Tke() + stateU.Tke() + stateUip.Tke() + stateLip.Tke());
     const auto tkeil = 0.25 *
-        (state_(ii, jj, kk - 1).Tke() + state_(ii, jj, kk).Tke() +
-         state_(ii - 1, jj, kk).Tke() + state_(ii - 1, jj, kk - 1).Tke());
+        (stateL.Tke() + stateU.Tke() + stateUim.Tke() + stateLim.Tke());
 
     const auto tkeju = 0.25 *
-        (state_(ii, jj, kk - 1).Tke() + state_(ii, jj, kk).Tke() +
-         state_(ii, jj + 1, kk).Tke() + state_(ii, jj + 1, kk - 1).Tke());
+        (stateL.Tke() + stateU.Tke() + stateUjp.Tke() + stateLjp.Tke());
     const auto tkejl = 0.25 *
-        (state_(ii, jj, kk - 1).Tke() + state_(ii, jj, kk).Tke() +
-         state_(ii, jj - 1, kk).Tke() + state_(ii, jj - 1, kk - 1).Tke());
+        (stateL.Tke() + stateU.Tke() + stateUjm.Tke() + stateLjm.Tke());
 
     // Get temperature gradient at face
     tkeGrad = ScalarGradGG(
-        tkeil, tkeiu, tkejl, tkeju, state_(ii, jj, kk - 1).Tke(),
-        state_(ii, jj, kk).Tke(), ail, aiu, ajl, aju, akl, aku, vol);
+        tkeil, tkeiu, tkejl, tkeju, stateL.Tke(),
+        stateU.Tke(), ail, aiu, ajl, aju, akl, aku, vol);
 
     // calculate average omega on i and j faces of alternate control volume
     const auto omgiu = 0.25 *
-        (state_(ii, jj, kk - 1).Omega() + state_(ii, jj, kk).Omega() +
-         state_(ii + 1, jj, kk).Omega() + state_(ii + 1, jj, kk - 1).Omega());
+        (stateL.Omega() + stateU.Omega() + stateUip.Omega() + stateLip.Omega());
     const auto omgil = 0.25 *
-        (state_(ii, jj, kk - 1).Omega() + state_(ii, jj, kk).Omega() +
-         state_(ii - 1, jj, kk).Omega() + state_(ii - 1, jj, kk - 1).Omega());
+        (stateL.Omega() + stateU.Omega() + stateUim.Omega() + stateLim.Omega());
 
     const auto omgju = 0.25 *
-        (state_(ii, jj, kk - 1).Omega() + state_(ii, jj, kk).Omega() +
-         state_(ii, jj + 1, kk).Omega() + state_(ii, jj + 1, kk - 1).Omega());
+        (stateL.Omega() + stateU.Omega() + stateUjp.Omega() + stateLjp.Omega());
     const auto omgjl = 0.25 *
-        (state_(ii, jj, kk - 1).Omega() + state_(ii, jj, kk).Omega() +
-         state_(ii, jj - 1, kk).Omega() + state_(ii, jj - 1, kk - 1).Omega());
+        (stateL.Omega() + stateU.Omega() + stateUjm.Omega() + stateLjm.Omega());
 
     // Get temperature gradient at face
     omegaGrad = ScalarGradGG(
-        omgil, omgiu, omgjl, omgju, state_(ii, jj, kk - 1).Omega(),
-        state_(ii, jj, kk).Omega(), ail, aiu, ajl, aju, akl, aku, vol);
+        omgil, omgiu, omgjl, omgju, stateL.Omega(),
+        stateU.Omega(), ail, aiu, ajl, aju, akl, aku, vol);
   }
 }
 
@@ -5809,32 +5914,483 @@ void procBlock::CalcSrcTerms(const sutherland &suth,
   }
 }
 
+/* Member function to return all cells, including ghosts, in the order they
+are searched for the distance to the nearest viscous wall. The search of
+each cell starts from the distance of the cell before it, and the closer
+together consecutive cells are, the more this helps. So by default the cells
+are ordered along a space filling curve.
+*/
+vector<vector3d<int>> procBlock::WallDistanceCells(const input &inp) const {
+  // inp -- input variables
 
-// member function to calculate the distance to the nearest viscous wall of
-// all cell centers
-void procBlock::CalcWallDistance(const kdtree &tree) {
-  vector3d<double> neighbor;
-  // loop over cells, including ghosts
+  vector<vector3d<int>> cells;
+  cells.reserve(wallDist_.Size());
   for (auto kk = wallDist_.StartK(); kk < wallDist_.EndK(); kk++) {
     for (auto jj = wallDist_.StartJ(); jj < wallDist_.EndJ(); jj++) {
       for (auto ii = wallDist_.StartI(); ii < wallDist_.EndI(); ii++) {
-        // ghost cells should have negative wall distance so that wall distance
-        // at viscous face will be 0 during flux calculation
+        cells.emplace_back(ii, jj, kk);
+      }
+    }
+  }
+
+  if (inp.IsMortonWallDistance()) {
+    vector<vector3d<double>> centers;
+    centers.reserve(cells.size());
+    for (const auto &cell : cells) {
+      centers.push_back(center_(cell[0], cell[1], cell[2]));
+    }
+    const auto order = MortonOrder(centers);
+    vector<vector3d<int>> orderedCells;
+    orderedCells.reserve(order.size());
+    for (const auto &ind : order) {
+      orderedCells.push_back(cells[ind]);
+    }
+    cells.swap(orderedCells);
+  }
+  return cells;
+}
+
+// member function to assign the wall distance of the given cells
+void procBlock::AssignWallDistance(const vector<vector3d<int>> &cells,
+                                   const double *distances) {
+  // cells -- cells to assign wall distance to
+  // distances -- distance to nearest viscous wall of each cell
+
+  for (auto nn = 0U; nn < cells.size(); nn++) {
+    const auto &cell = cells[nn];
+    // ghost cells should have negative wall distance so that wall distance
+    // at viscous face will be 0 during flux calculation
+    auto fac = this->IsPhysical(cell[0], cell[1], cell[2]) ? 1.0 : -1.0;
+    wallDist_(cell[0], cell[1], cell[2]) = fac * distances[nn];
+  }
+}
+
+/* Member function to start the nearest wall points of the eikonal wall
+distance method. The cells on both sides of each viscous wall face start with
+the center of the face as their nearest wall point. The distance squared to
+the nearest wall point is stored with it.
+*/
+void procBlock::SeedWallPoints(multiArray3d<vector3d<double>> &wallPoint,
+                               multiArray3d<double> &wallDistSq) const {
+  // wallPoint -- nearest wall point of each cell
+  // wallDistSq -- distance squared to nearest wall point of each cell
+
+  for (auto ss = 0; ss < bc_.NumSurfaces(); ss++) {
+    if (bc_.GetBCTypes(ss) != "viscousWall") {
+      continue;
+    }
+
+    // direction normal to surface (0, 1, 2 for i, j, k)
+    const auto dir = (bc_.GetSurfaceType(ss) - 1) / 2;
+    const vector3d<int> lo(bc_.GetIMin(ss), bc_.GetJMin(ss), bc_.GetKMin(ss));
+    vector3d<int> hi(bc_.GetIMax(ss), bc_.GetJMax(ss), bc_.GetKMax(ss));
+    hi[dir] = lo[dir] + 1;  // min and max face indices are the same
+
+    for (auto kk = lo[2]; kk < hi[2]; kk++) {
+      for (auto jj = lo[1]; jj < hi[1]; jj++) {
+        for (auto ii = lo[0]; ii < hi[0]; ii++) {
+          const auto face = (dir == 0) ? fCenterI_(ii, jj, kk) :
+              (dir == 1) ? fCenterJ_(ii, jj, kk) : fCenterK_(ii, jj, kk);
+
+          // cells on both sides of face
+          for (auto side = -1; side <= 0; side++) {
+            vector3d<int> cell(ii, jj, kk);
+            cell[dir] += side;
+            const auto distSq = center_(cell[0], cell[1], cell[2]).DistSq(face);
+            if (distSq < wallDistSq(cell[0], cell[1], cell[2])) {
+              wallDistSq(cell[0], cell[1], cell[2]) = distSq;
+              wallPoint(cell[0], cell[1], cell[2]) = face;
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+/* Member function to sweep the nearest wall points of the eikonal wall
+distance method through the block. The cells, including ghosts, are visited in
+all 8 combinations of increasing and decreasing i, j, and k. Each cell checks
+the nearest wall points of its neighbors (across faces, edges, and corners)
+that were visited before it, and takes the point of a neighbor if that point
+is closer to its own center. The
+distance to the nearest wall point satisfies the eikonal equation
+|grad(d)| = 1, and passing points downwind along each sweep direction is the
+fast sweeping method for it. Because each cell holds the point itself rather
+than only the distance, the distance is to a real wall face, and is exact
+wherever the nearest face is passed along to the cell by its neighbors, which
+is nearly everywhere. Returns true if the distance of any physical cell
+changed.
+*/
+bool procBlock::SweepWallPoints(multiArray3d<vector3d<double>> &wallPoint,
+                                multiArray3d<double> &wallDistSq) const {
+  // wallPoint -- nearest wall point of each cell
+  // wallDistSq -- distance squared to nearest wall point of each cell
+
+  const vector3d<int> start(wallDistSq.StartI(), wallDistSq.StartJ(),
+                            wallDistSq.StartK());
+  const vector3d<int> end(wallDistSq.EndI(), wallDistSq.EndJ(),
+                          wallDistSq.EndK());
+  const auto noPoint = std::numeric_limits<double>::max();
+
+  auto changed = false;
+  for (auto sweep = 0; sweep < 8; sweep++) {
+    // step through block in each direction
+    const vector3d<int> step((sweep & 1) ? -1 : 1, (sweep & 2) ? -1 : 1,
+                             (sweep & 4) ? -1 : 1);
+    vector3d<int> first, last;
+    for (auto dd = 0; dd < 3; dd++) {
+      first[dd] = (step[dd] > 0) ? start[dd] : end[dd] - 1;
+      last[dd] = (step[dd] > 0) ? end[dd] : start[dd] - 1;
+    }
+
+    for (auto kk = first[2]; kk != last[2]; kk += step[2]) {
+      for (auto jj = first[1]; jj != last[1]; jj += step[1]) {
+        for (auto ii = first[0]; ii != last[0]; ii += step[0]) {
+          // neighbors visited before this cell in this sweep, including
+          // those across edges and corners
+          for (auto nn = 1; nn < 8; nn++) {
+            vector3d<int> nb(ii, jj, kk);
+            auto inside = true;
+            for (auto dd = 0; dd < 3; dd++) {
+              if (nn & (1 << dd)) {
+                nb[dd] -= step[dd];
+                inside = inside && nb[dd] >= start[dd] && nb[dd] < end[dd];
+              }
+            }
+            if (!inside || wallDistSq(nb[0], nb[1], nb[2]) == noPoint) {
+              continue;
+            }
+            const auto &point = wallPoint(nb[0], nb[1], nb[2]);
+            const auto distSq = center_(ii, jj, kk).DistSq(point);
+            if (distSq < wallDistSq(ii, jj, kk)) {
+              wallDistSq(ii, jj, kk) = distSq;
+              wallPoint(ii, jj, kk) = point;
+              changed = changed || this->IsPhysical(ii, jj, kk);
+            }
+          }
+        }
+      }
+    }
+  }
+  return changed;
+}
+
+// member function to assign the wall distance from the distance squared to
+// the nearest wall point of each cell; cells that were not reached by any
+// wall point keep the default wall distance
+void procBlock::AssignWallDistance(const multiArray3d<double> &wallDistSq) {
+  // wallDistSq -- distance squared to nearest wall point of each cell
+
+  for (auto kk = wallDist_.StartK(); kk < wallDist_.EndK(); kk++) {
+    for (auto jj = wallDist_.StartJ(); jj < wallDist_.EndJ(); jj++) {
+      for (auto ii = wallDist_.StartI(); ii < wallDist_.EndI(); ii++) {
+        if (wallDistSq(ii, jj, kk) == std::numeric_limits<double>::max()) {
+          continue;
+        }
+        // ghost cells should have negative wall distance so that wall
+        // distance at viscous face will be 0 during flux calculation
         auto fac = this->IsPhysical(ii, jj, kk) ? 1.0 : -1.0;
-        wallDist_(ii, jj, kk) = fac *
-            tree.NearestNeighbor(center_(ii, jj, kk), neighbor);
+        wallDist_(ii, jj, kk) = fac * sqrt(wallDistSq(ii, jj, kk));
       }
     }
   }
 }
 
-// member function to calculate the residual (RHS) excluding any contributions
-// from source terms
-void procBlock::CalcResidualNoSource(const sutherland &suth,
-                                     const idealGas &eos,
-                                     const input &inp,
+// function to copy an array into a buffer of doubles and advance the buffer
+template <typename T>
+void PackArray(const multiArray3d<T> &arr, double *&buffer) {
+  // arr -- array to copy
+  // buffer -- location in buffer to copy to
+
+  static_assert(sizeof(T) % sizeof(double) == 0,
+                "PackArray requires cells made up of doubles");
+  const auto size = arr.Size() * sizeof(T) / sizeof(double);
+  std::memcpy(buffer, reinterpret_cast<const double *>(&(*std::begin(arr))),
+              size * sizeof(double));
+  buffer += size;
+}
+
+// function to copy an array from a buffer of doubles and advance the buffer
+template <typename T>
+void UnpackArray(const double *&buffer, multiArray3d<T> &arr) {
+  // buffer -- location in buffer to copy from
+  // arr -- array to copy to
+
+  static_assert(sizeof(T) % sizeof(double) == 0,
+                "UnpackArray requires cells made up of doubles");
+  const auto size = arr.Size() * sizeof(T) / sizeof(double);
+  std::memcpy(reinterpret_cast<double *>(&(*std::begin(arr))), buffer,
+              size * sizeof(double));
+  buffer += size;
+}
+
+/* Member function to copy the geometry (including ghost cells), cell widths,
+and wall distance of the block into a buffer of doubles. This is the data
+stored for the block in the geometry cache.
+*/
+void procBlock::PackGeometry(double *buffer) const {
+  // buffer -- buffer to copy geometry to
+
+  PackArray(vol_, buffer);
+  PackArray(center_, buffer);
+  PackArray(fAreaI_, buffer);
+  PackArray(fAreaJ_, buffer);
+  PackArray(fAreaK_, buffer);
+  PackArray(fCenterI_, buffer);
+  PackArray(fCenterJ_, buffer);
+  PackArray(fCenterK_, buffer);
+  PackArray(cellWidthI_, buffer);
+  PackArray(cellWidthJ_, buffer);
+  PackArray(cellWidthK_, buffer);
+  PackArray(wallDist_, buffer);
+}
+
+// member function to assign the geometry packed by PackGeometry
+void procBlock::UnpackGeometry(const double *buffer) {
+  // buffer -- buffer to copy geometry from
+
+  cellWidthI_.ClearResize(this->NumI(), this->NumJ(), this->NumK(),
+                          this->NumGhosts());
+  cellWidthJ_.ClearResize(this->NumI(), this->NumJ(), this->NumK(),
+                          this->NumGhosts());
+  cellWidthK_.ClearResize(this->NumI(), this->NumJ(), this->NumK(),
+                          this->NumGhosts());
+
+  UnpackArray(buffer, vol_);
+  UnpackArray(buffer, center_);
+  UnpackArray(buffer, fAreaI_);
+  UnpackArray(buffer, fAreaJ_);
+  UnpackArray(buffer, fAreaK_);
+  UnpackArray(buffer, fCenterI_);
+  UnpackArray(buffer, fCenterJ_);
+  UnpackArray(buffer, fCenterK_);
+  UnpackArray(buffer, cellWidthI_);
+  UnpackArray(buffer, cellWidthJ_);
+  UnpackArray(buffer, cellWidthK_);
+  UnpackArray(buffer, wallDist_);
+}
+
+/* Member function to calculate the inviscid fluxes on the interior or halo
+faces of the block. The flux kernels are templates specialized on the numerical
+methods, so the methods in the input are only looked at here, once per call, and
+the kernels do not branch on them inside their loops.
+
+The ghost cells of a surface with an interblock to another processor are
+received while the interior of the block is being calculated. The halo faces
+are those whose reconstruction stencil reaches into the ghost cells of such a
+surface; all other faces are interior faces. Since a face only uses cells in
+its own direction, this only depends on the surfaces normal to the face
+direction. A block with no surfaces swapped with other processors has no halo
+faces.
+
+The inviscid and viscous flux kernels can also be run by all threads together
+when threads are not already working on separate blocks. Each face adds to the
+residual, spectral radius, gradients, and flux jacobians of the two cells it
+separates, so the faces are divided among the threads by lines that run across
+the face direction (j-lines for i-faces and k-faces, i-lines for j-faces). All
+of the updates from a face stay on its line, and because the loops use a
+static schedule with the same trip count, each thread is given the same lines
+in every plane. No two threads update the same cell, and each cell receives
+its contributions in the same order as the serial loops.
+*/
+void procBlock::CalcInvFlux(const idealGas &eos, const input &inp,
+                            const unique_ptr<turbModel> &turb,
+                            multiArray3d<fluxJacobian> &mainDiagonal,
+                            const bool (&haloSurf)[6], const bool &interior) {
+  // eos -- equation of state
+  // inp -- all input variables
+  // turb -- turbulence model
+  // mainDiagonal -- main diagonal of LHS to store flux jacobians for implicit
+  //                 solver
+  // haloSurf -- surfaces with ghost cells from other processors
+  // interior -- flag to calculate interior faces instead of halo faces
+
+  // limiter is only used with MUSCL reconstruction
+  switch (inp.ReconstructionMethod()) {
+    case reconstructionMethod::constant:
+      this->CalcInvFlux<reconstructionMethod::constant, limiterMethod::none>(
+          eos, inp, turb, mainDiagonal, haloSurf, interior);
+      break;
+    case reconstructionMethod::muscl:
+      switch (inp.LimiterMethod()) {
+        case limiterMethod::none:
+          this->CalcInvFlux<reconstructionMethod::muscl, limiterMethod::none>(
+              eos, inp, turb, mainDiagonal, haloSurf, interior);
+          break;
+        case limiterMethod::vanAlbada:
+          this->CalcInvFlux<reconstructionMethod::muscl,
+                            limiterMethod::vanAlbada>(eos, inp, turb,
+                                                      mainDiagonal, haloSurf,
+                                                      interior);
+          break;
+        case limiterMethod::minmod:
+          this->CalcInvFlux<reconstructionMethod::muscl,
+                            limiterMethod::minmod>(eos, inp, turb,
+                                                   mainDiagonal, haloSurf,
+                                                   interior);
+          break;
+      }
+      break;
+    case reconstructionMethod::weno:
+      this->CalcInvFlux<reconstructionMethod::weno, limiterMethod::none>(
+          eos, inp, turb, mainDiagonal, haloSurf, interior);
+      break;
+    case reconstructionMethod::wenoZ:
+      this->CalcInvFlux<reconstructionMethod::wenoZ, limiterMethod::none>(
+          eos, inp, turb, mainDiagonal, haloSurf, interior);
+      break;
+  }
+}
+
+// member function to select the inviscid flux kernels for a given
+// reconstruction and limiter
+template <reconstructionMethod R, limiterMethod L>
+void procBlock::CalcInvFlux(const idealGas &eos, const input &inp,
+                            const unique_ptr<turbModel> &turb,
+                            multiArray3d<fluxJacobian> &mainDiagonal,
+                            const bool (&haloSurf)[6], const bool &interior) {
+  // eos -- equation of state
+  // inp -- all input variables
+  // turb -- turbulence model
+  // mainDiagonal -- main diagonal of LHS to store flux jacobians for implicit
+  //                 solver
+  // haloSurf -- surfaces with ghost cells from other processors
+  // interior -- flag to calculate interior faces instead of halo faces
+
+  if (inp.InviscidFluxMethod() == inviscidFluxMethod::roe) {
+    if (inp.IsBlockMatrix()) {
+      this->CalcInvFlux<R, L, inviscidFluxMethod::roe, true>(
+          eos, inp, turb, mainDiagonal, haloSurf, interior);
+    } else {
+      this->CalcInvFlux<R, L, inviscidFluxMethod::roe, false>(
+          eos, inp, turb, mainDiagonal, haloSurf, interior);
+    }
+  } else {
+    if (inp.IsBlockMatrix()) {
+      this->CalcInvFlux<R, L, inviscidFluxMethod::rusanov, true>(
+          eos, inp, turb, mainDiagonal, haloSurf, interior);
+    } else {
+      this->CalcInvFlux<R, L, inviscidFluxMethod::rusanov, false>(
+          eos, inp, turb, mainDiagonal, haloSurf, interior);
+    }
+  }
+}
+
+// member function to run the inviscid flux kernels over the interior or halo
+// cells in each direction
+template <reconstructionMethod R, limiterMethod L, inviscidFluxMethod F,
+          bool isBlock>
+void procBlock::CalcInvFlux(const idealGas &eos, const input &inp,
+                            const unique_ptr<turbModel> &turb,
+                            multiArray3d<fluxJacobian> &mainDiagonal,
+                            const bool (&haloSurf)[6], const bool &interior) {
+  // eos -- equation of state
+  // inp -- all input variables
+  // turb -- turbulence model
+  // mainDiagonal -- main diagonal of LHS to store flux jacobians for implicit
+  //                 solver
+  // haloSurf -- surfaces with ghost cells from other processors
+  // interior -- flag to calculate interior faces instead of halo faces
+
+  // number of cells on each side of a face used in its reconstruction
+  constexpr auto reach = (R == reconstructionMethod::constant) ? 1 :
+      (R == reconstructionMethod::muscl) ? 2 : 3;
+
+  // interior cells in a direction are [lower, upper); the faces of cell n use
+  // cells n - reach to n + reach, so it reaches the lower ghost cells if n <
+  // reach, and the upper ghost cells if n >= numCells - reach
+  auto interiorCells = [&](const int &numCells, const bool &haloLower,
+                           const bool &haloUpper, int &lower, int &upper) {
+    lower = haloLower ? reach : 0;
+    upper = haloUpper ? std::max(lower, numCells - reach) : numCells;
+  };
+  int lowI, upI, lowJ, upJ, lowK, upK;
+  interiorCells(this->NumI(), haloSurf[0], haloSurf[1], lowI, upI);
+  interiorCells(this->NumJ(), haloSurf[2], haloSurf[3], lowJ, upJ);
+  interiorCells(this->NumK(), haloSurf[4], haloSurf[5], lowK, upK);
+  const vector3d<int> lower(lowI, lowJ, lowK);
+  const vector3d<int> upper(upI, upJ, upK);
+
+  // the passes are split by cell rather than by face so that each cell sums
+  // its face fluxes in the same order whether or not the residual is
+  // overlapped with the halo exchange; faces between an interior cell and a
+  // halo cell are calculated in both passes
+  this->CalcInvFluxI<R, L, F, isBlock>(eos, inp, turb, mainDiagonal, lower,
+                                       upper, interior);
+  this->CalcInvFluxJ<R, L, F, isBlock>(eos, inp, turb, mainDiagonal, lower,
+                                       upper, interior);
+  this->CalcInvFluxK<R, L, F, isBlock>(eos, inp, turb, mainDiagonal, lower,
+                                       upper, interior);
+}
+
+// member function to calculate the viscous fluxes on all faces with kernels
+// specialized on the viscous reconstruction and matrix type
+void procBlock::CalcViscFlux(const sutherland &suth, const idealGas &eos,
+                             const input &inp,
+                             const unique_ptr<turbModel> &turb,
+                             multiArray3d<fluxJacobian> &mainDiagonal) {
+  // suth -- sutherland's law for viscosity
+  // eos -- equation of state
+  // inp -- all input variables
+  // turb -- turbulence model
+  // mainDiagonal -- main diagonal of LHS to store flux jacobians for implicit
+  //                 solver
+
+  constexpr auto central = viscousReconstructionMethod::central;
+  constexpr auto centralFourth = viscousReconstructionMethod::centralFourth;
+
+  if (inp.ViscousReconstructionMethod() == central) {
+    if (inp.IsBlockMatrix()) {
+      this->CalcViscFluxI<central, true>(suth, eos, inp, turb, mainDiagonal);
+      this->CalcViscFluxJ<central, true>(suth, eos, inp, turb, mainDiagonal);
+      this->CalcViscFluxK<central, true>(suth, eos, inp, turb, mainDiagonal);
+    } else {
+      this->CalcViscFluxI<central, false>(suth, eos, inp, turb, mainDiagonal);
+      this->CalcViscFluxJ<central, false>(suth, eos, inp, turb, mainDiagonal);
+      this->CalcViscFluxK<central, false>(suth, eos, inp, turb, mainDiagonal);
+    }
+  } else {
+    if (inp.IsBlockMatrix()) {
+      this->CalcViscFluxI<centralFourth, true>(suth, eos, inp, turb,
+                                               mainDiagonal);
+      this->CalcViscFluxJ<centralFourth, true>(suth, eos, inp, turb,
+                                               mainDiagonal);
+      this->CalcViscFluxK<centralFourth, true>(suth, eos, inp, turb,
+                                               mainDiagonal);
+    } else {
+      this->CalcViscFluxI<centralFourth, false>(suth, eos, inp, turb,
+                                                mainDiagonal);
+      this->CalcViscFluxJ<centralFourth, false>(suth, eos, inp, turb,
+                                                mainDiagonal);
+      this->CalcViscFluxK<centralFourth, false>(suth, eos, inp, turb,
+                                                mainDiagonal);
+    }
+  }
+}
+
+/* Member functions to calculate the residual (RHS) excluding any contributions
+from source terms. The residual is calculated in two parts so that the ghost
+cells from other processors can be received while the first part is being
+calculated. CalcResidualInterior() only adds the inviscid fluxes to cells whose
+faces do not reach into ghost cells received from other processors (see
+CalcInvFlux()). CalcResidualHalo() is called once the ghost cells have arrived
+and the edge ghost cells have been assigned; it adds the inviscid fluxes to the
+remaining cells, and then the viscous fluxes. The viscous ghost cells,
+gradients, and auxillary variables all depend on the received ghost cells, so
+all viscous fluxes are in the second part.
+*/
+void procBlock::CalcResidualInterior(const idealGas &eos, const input &inp,
                                      const unique_ptr<turbModel> &turb,
-                                     multiArray3d<fluxJacobian> &mainDiagonal) {
+                                     multiArray3d<fluxJacobian> &mainDiagonal,
+                                     const bool (&haloSurf)[6]) {
+  // eos -- equation of state
+  // inp -- all input variables
+  // turb -- turbulence model
+  // mainDiagonal -- main diagonal of LHS to store flux jacobians for implicit
+  //                 solver
+  // haloSurf -- surfaces with ghost cells from other processors
+
   // Zero spectral radii, residuals, gradients, turbulence variables
   this->ResetResidWS();
   if (isViscous_) {
@@ -5844,10 +6400,25 @@ void procBlock::CalcResidualNoSource(const sutherland &suth,
     }
   }
 
-  // Calculate inviscid fluxes
-  this->CalcInvFluxI(eos, inp, turb, mainDiagonal);
-  this->CalcInvFluxJ(eos, inp, turb, mainDiagonal);
-  this->CalcInvFluxK(eos, inp, turb, mainDiagonal);
+  // Calculate inviscid fluxes on interior faces
+  this->CalcInvFlux(eos, inp, turb, mainDiagonal, haloSurf, true);
+}
+
+void procBlock::CalcResidualHalo(const sutherland &suth, const idealGas &eos,
+                                 const input &inp,
+                                 const unique_ptr<turbModel> &turb,
+                                 multiArray3d<fluxJacobian> &mainDiagonal,
+                                 const bool (&haloSurf)[6]) {
+  // suth -- sutherland's law for viscosity
+  // eos -- equation of state
+  // inp -- all input variables
+  // turb -- turbulence model
+  // mainDiagonal -- main diagonal of LHS to store flux jacobians for implicit
+  //                 solver
+  // haloSurf -- surfaces with ghost cells from other processors
+
+  // Calculate inviscid fluxes on halo faces
+  this->CalcInvFlux(eos, inp, turb, mainDiagonal, haloSurf, false);
 
   // If viscous change ghost cells and calculate viscous fluxes
   if (isViscous_) {
@@ -5858,9 +6429,7 @@ void procBlock::CalcResidualNoSource(const sutherland &suth,
     this->UpdateAuxillaryVariables(eos, suth);
 
     // Calculate viscous fluxes
-    this->CalcViscFluxI(suth, eos, inp, turb, mainDiagonal);
-    this->CalcViscFluxJ(suth, eos, inp, turb, mainDiagonal);
-    this->CalcViscFluxK(suth, eos, inp, turb, mainDiagonal);
+    this->CalcViscFlux(suth, eos, inp, turb, mainDiagonal);
 
   } else {
     // Update temperature
@@ -5885,7 +6454,7 @@ void procBlock::UpdateAuxillaryVariables(const idealGas &eos,
       for (auto ii = temperature_.StartI(); ii < temperature_.EndI(); ii++) {
         if (!this->AtCorner(ii, jj, kk) &&
             (includeGhosts || this->IsPhysical(ii, jj, kk))) {
-          temperature_(ii, jj, kk) = state_(ii, jj, kk).Temperature(eos);
+          temperature_(ii, jj, kk) = this->State(ii, jj, kk).Temperature(eos);
           if (isViscous_) {
             viscosity_(ii, jj, kk) = suth.Viscosity(temperature_(ii, jj, kk));
           }
@@ -6014,10 +6583,18 @@ void procBlock::CalcCellWidths() {
 }
 
 
-void procBlock::ReadSolFromRestart(ifstream &resFile, const input &inp,
-                                const idealGas &eos, const sutherland &suth,
-                                const unique_ptr<turbModel> &turb,
+void procBlock::ReadSolFromRestart(vector<double>::const_iterator &resData,
+                                   const input &inp, const idealGas &eos,
+                                   const sutherland &suth,
+                                   const unique_ptr<turbModel> &turb,
                                    const vector<string> &restartVars) {
+  // resData -- restart data for this block, advanced past data used
+  // inp -- input variables
+  // eos -- equation of state
+  // suth -- sutherland's law for viscosity
+  // turb -- turbulence model
+  // restartVars -- variables stored for each cell in restart file
+
   // define reference speed of sound
   const auto refSoS = inp.ARef(eos);
 
@@ -6030,25 +6607,25 @@ void procBlock::ReadSolFromRestart(ifstream &resFile, const input &inp,
           // loop over the number of variables to read
           for (auto &var : restartVars) {
             if (var == "density") {
-              resFile.read(reinterpret_cast<char *>(&value[0]), sizeof(value[0]));
+              value[0] = *resData++;
               value[0] /= inp.RRef();
             } else if (var == "vel_x") {
-              resFile.read(reinterpret_cast<char *>(&value[1]), sizeof(value[1]));
+              value[1] = *resData++;
               value[1] /= refSoS;
             } else if (var == "vel_y") {
-              resFile.read(reinterpret_cast<char *>(&value[2]), sizeof(value[2]));
+              value[2] = *resData++;
               value[2] /= refSoS;
             } else if (var == "vel_z") {
-              resFile.read(reinterpret_cast<char *>(&value[3]), sizeof(value[3]));
+              value[3] = *resData++;
               value[3] /= refSoS;
             } else if (var == "pressure") {
-              resFile.read(reinterpret_cast<char *>(&value[4]), sizeof(value[4]));
+              value[4] = *resData++;
               value[4] /= inp.RRef() * refSoS * refSoS;
             } else if (var == "tke") {
-              resFile.read(reinterpret_cast<char *>(&value[5]), sizeof(value[5]));
+              value[5] = *resData++;
               value[5] /= refSoS * refSoS;
             } else if (var == "sdr") {
-              resFile.read(reinterpret_cast<char *>(&value[6]), sizeof(value[6]));
+              value[6] = *resData++;
               value[6] /= refSoS * refSoS * inp.RRef() / suth.MuRef();
             } else {
               cerr << "ERROR: Variable " << var
@@ -6065,10 +6642,17 @@ void procBlock::ReadSolFromRestart(ifstream &resFile, const input &inp,
     this->UpdateAuxillaryVariables(eos, suth, false);
 }
 
-void procBlock::ReadSolNm1FromRestart(ifstream &resFile, const input &inp,
-                                      const idealGas &eos, const sutherland &suth,
-                                      const unique_ptr<turbModel> &turb,
-                                      const vector<string> &restartVars) {
+void procBlock::ReadSolNm1FromRestart(
+    vector<double>::const_iterator &resData, const input &inp,
+    const idealGas &eos, const sutherland &suth,
+    const unique_ptr<turbModel> &turb, const vector<string> &restartVars) {
+  // resData -- restart data for this block, advanced past data used
+  // inp -- input variables
+  // eos -- equation of state
+  // suth -- sutherland's law for viscosity
+  // turb -- turbulence model
+  // restartVars -- variables stored for each cell in restart file
+
   // define reference speed of sound
   const auto refSoS = inp.ARef(eos);
 
@@ -6081,25 +6665,25 @@ void procBlock::ReadSolNm1FromRestart(ifstream &resFile, const input &inp,
         // loop over the number of variables to read
         for (auto &var : restartVars) {
           if (var == "density") {
-            resFile.read(reinterpret_cast<char *>(&value[0]), sizeof(value[0]));
+            value[0] = *resData++;
             value[0] /= inp.RRef();
           } else if (var == "vel_x") {  // conserved var is rho-u
-            resFile.read(reinterpret_cast<char *>(&value[1]), sizeof(value[1]));
+            value[1] = *resData++;
             value[1] /= refSoS * inp.RRef();
           } else if (var == "vel_y") {  // conserved var is rho-v
-            resFile.read(reinterpret_cast<char *>(&value[2]), sizeof(value[2]));
+            value[2] = *resData++;
             value[2] /= refSoS * inp.RRef();
           } else if (var == "vel_z") {  // conserved var is rho-w
-            resFile.read(reinterpret_cast<char *>(&value[3]), sizeof(value[3]));
+            value[3] = *resData++;
             value[3] /= refSoS * inp.RRef();
           } else if (var == "pressure") {  // conserved var is rho-E
-            resFile.read(reinterpret_cast<char *>(&value[4]), sizeof(value[4]));
+            value[4] = *resData++;
             value[4] /= inp.RRef() * refSoS * refSoS;
           } else if (var == "tke") {  // conserved var is rho-tke
-            resFile.read(reinterpret_cast<char *>(&value[5]), sizeof(value[5]));
+            value[5] = *resData++;
             value[5] /= refSoS * refSoS * inp.RRef();
           } else if (var == "sdr") {  // conserved var is rho-sdr
-            resFile.read(reinterpret_cast<char *>(&value[6]), sizeof(value[6]));
+            value[6] = *resData++;
             value[6] /= refSoS * refSoS * inp.RRef() *inp.RRef() / suth.MuRef();
           } else {
             cerr << "ERROR: Variable " << var
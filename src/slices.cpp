@@ -172,3 +172,98 @@ geomSlice::geomSlice(const procBlock &blk, const range &ir, const range &jr,
     }
   }
 }
+
+/* Member function to swap a geomSlice with the partner block of an interblock
+on another processor. The slice is packed into a buffer, the buffer is swapped
+with the processor of the partner block, and the partner's slice is unpacked
+into *this. The slices on both sides of an interblock have the same number of
+cells and faces, so the buffers are the same size.
+*/
+void geomSlice::PackSwapUnpackMPI(const interblock &inter,
+                                  const MPI_Datatype &MPI_vec3d,
+                                  const MPI_Datatype &MPI_vec3dMag,
+                                  const int &rank) {
+  // inter -- interblock boundary for the swap
+  // MPI_vec3d -- MPI datatype for a vector3d<double>
+  // MPI_vec3dMag -- MPI datatype for a unitVec3dMag<double>
+  // rank -- processor rank
+
+  // determine size of buffer to send
+  auto bufSize = 0;
+  auto tempSize = 0;
+  // add size for 4 ints for slice dims and parent block
+  MPI_Pack_size(4, MPI_INT, MPI_COMM_WORLD, &tempSize);
+  bufSize += tempSize;
+  MPI_Pack_size(center_.Size() + fCenterI_.Size() + fCenterJ_.Size() +
+                fCenterK_.Size(), MPI_vec3d, MPI_COMM_WORLD, &tempSize);
+  bufSize += tempSize;
+  MPI_Pack_size(fAreaI_.Size() + fAreaJ_.Size() + fAreaK_.Size(),
+                MPI_vec3dMag, MPI_COMM_WORLD, &tempSize);
+  bufSize += tempSize;
+  MPI_Pack_size(vol_.Size(), MPI_DOUBLE, MPI_COMM_WORLD, &tempSize);
+  bufSize += tempSize;
+
+  auto *buffer = new char[bufSize];  // allocate buffer to pack data into
+
+  // pack data into buffer
+  auto numI = this->NumI();
+  auto numJ = this->NumJ();
+  auto numK = this->NumK();
+  auto position = 0;
+  MPI_Pack(&numI, 1, MPI_INT, buffer, bufSize, &position, MPI_COMM_WORLD);
+  MPI_Pack(&numJ, 1, MPI_INT, buffer, bufSize, &position, MPI_COMM_WORLD);
+  MPI_Pack(&numK, 1, MPI_INT, buffer, bufSize, &position, MPI_COMM_WORLD);
+  MPI_Pack(&parBlock_, 1, MPI_INT, buffer, bufSize, &position,
+           MPI_COMM_WORLD);
+  MPI_Pack(&(*std::begin(center_)), center_.Size(), MPI_vec3d, buffer,
+           bufSize, &position, MPI_COMM_WORLD);
+  MPI_Pack(&(*std::begin(fAreaI_)), fAreaI_.Size(), MPI_vec3dMag, buffer,
+           bufSize, &position, MPI_COMM_WORLD);
+  MPI_Pack(&(*std::begin(fAreaJ_)), fAreaJ_.Size(), MPI_vec3dMag, buffer,
+           bufSize, &position, MPI_COMM_WORLD);
+  MPI_Pack(&(*std::begin(fAreaK_)), fAreaK_.Size(), MPI_vec3dMag, buffer,
+           bufSize, &position, MPI_COMM_WORLD);
+  MPI_Pack(&(*std::begin(fCenterI_)), fCenterI_.Size(), MPI_vec3d, buffer,
+           bufSize, &position, MPI_COMM_WORLD);
+  MPI_Pack(&(*std::begin(fCenterJ_)), fCenterJ_.Size(), MPI_vec3d, buffer,
+           bufSize, &position, MPI_COMM_WORLD);
+  MPI_Pack(&(*std::begin(fCenterK_)), fCenterK_.Size(), MPI_vec3d, buffer,
+           bufSize, &position, MPI_COMM_WORLD);
+  MPI_Pack(&(*std::begin(vol_)), vol_.Size(), MPI_DOUBLE, buffer, bufSize,
+           &position, MPI_COMM_WORLD);
+
+  // swap with processor of partner block
+  const auto partner = (rank == inter.RankFirst()) ? inter.RankSecond()
+                                                    : inter.RankFirst();
+  MPI_Status status;
+  MPI_Sendrecv_replace(buffer, bufSize, MPI_PACKED, partner, 4, partner, 4,
+                       MPI_COMM_WORLD, &status);
+
+  // unpack partner slice into *this
+  position = 0;
+  auto parBlock = 0;
+  MPI_Unpack(buffer, bufSize, &position, &numI, 1, MPI_INT, MPI_COMM_WORLD);
+  MPI_Unpack(buffer, bufSize, &position, &numJ, 1, MPI_INT, MPI_COMM_WORLD);
+  MPI_Unpack(buffer, bufSize, &position, &numK, 1, MPI_INT, MPI_COMM_WORLD);
+  MPI_Unpack(buffer, bufSize, &position, &parBlock, 1, MPI_INT,
+             MPI_COMM_WORLD);
+  *this = geomSlice(numI, numJ, numK, parBlock);
+  MPI_Unpack(buffer, bufSize, &position, &(*std::begin(center_)),
+             center_.Size(), MPI_vec3d, MPI_COMM_WORLD);
+  MPI_Unpack(buffer, bufSize, &position, &(*std::begin(fAreaI_)),
+             fAreaI_.Size(), MPI_vec3dMag, MPI_COMM_WORLD);
+  MPI_Unpack(buffer, bufSize, &position, &(*std::begin(fAreaJ_)),
+             fAreaJ_.Size(), MPI_vec3dMag, MPI_COMM_WORLD);
+  MPI_Unpack(buffer, bufSize, &position, &(*std::begin(fAreaK_)),
+             fAreaK_.Size(), MPI_vec3dMag, MPI_COMM_WORLD);
+  MPI_Unpack(buffer, bufSize, &position, &(*std::begin(fCenterI_)),
+             fCenterI_.Size(), MPI_vec3d, MPI_COMM_WORLD);
+  MPI_Unpack(buffer, bufSize, &position, &(*std::begin(fCenterJ_)),
+             fCenterJ_.Size(), MPI_vec3d, MPI_COMM_WORLD);
+  MPI_Unpack(buffer, bufSize, &position, &(*std::begin(fCenterK_)),
+             fCenterK_.Size(), MPI_vec3d, MPI_COMM_WORLD);
+  MPI_Unpack(buffer, bufSize, &position, &(*std::begin(vol_)), vol_.Size(),
+             MPI_DOUBLE, MPI_COMM_WORLD);
+
+  delete[] buffer;  // deallocate buffer
+}
@@ -46,14 +46,14 @@ ostream &operator<<(ostream &os, const source &src) {
 }
 
 // Member function to calculate the source terms for the turbulence equations
-squareMatrix source::CalcTurbSrc(const unique_ptr<turbModel> &turb,
-                                 const primVars &state,
-                                 const tensor<double> &velGrad,
-                                 const vector3d<double> &tGrad,
-                                 const vector3d<double> &tkeGrad,
-                                 const vector3d<double> &omegaGrad,
-                                 const sutherland &suth, const double &vol,
-                                 const double &mut, const double &f1) {
+turbMatrix source::CalcTurbSrc(const unique_ptr<turbModel> &turb,
+                               const primVars &state,
+                               const tensor<double> &velGrad,
+                               const vector3d<double> &tGrad,
+                               const vector3d<double> &tkeGrad,
+                               const vector3d<double> &omegaGrad,
+                               const sutherland &suth, const double &vol,
+                               const double &mut, const double &f1) {
   // turb -- turbulence model
   // state -- primative variables
   // velGrad -- velocity gradient
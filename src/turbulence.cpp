@@ -20,7 +20,7 @@
 #include "turbulence.hpp"
 #include "primVars.hpp"  // primVars
 #include "eos.hpp"       // sutherland
-#include "matrix.hpp"    // squareMatrix
+#include "matrix.hpp"    // turbMatrix
 
 using std::cout;
 using std::endl;
@@ -162,9 +162,9 @@ double turbModel::FaceSpectralRadius(const primVars &state,
 // v = vel (dot) area
 // df_dq = [v +/- |v|     0     ]
 //         [   0       v +/- |v|]
-squareMatrix turbModel::InviscidJacobian(const primVars &state,
-                                         const unitVec3dMag<double> &fArea,
-                                         const bool &positive) const {
+turbMatrix turbModel::InviscidJacobian(const primVars &state,
+                                       const unitVec3dMag<double> &fArea,
+                                       const bool &positive) const {
   // state -- primative variables at face
   // fArea -- face area
   // positive -- flag to determine whether to add/subtract dissipation
@@ -175,27 +175,27 @@ squareMatrix turbModel::InviscidJacobian(const primVars &state,
              this->InviscidDissJacobian(state, fArea));
 }
 
-squareMatrix turbModel::InviscidConvJacobian(
+turbMatrix turbModel::InviscidConvJacobian(
     const primVars &state, const unitVec3dMag<double> &fArea) const {
   // state -- primative variables at face
   // fArea -- face area
 
   const auto velNorm = state.Velocity().DotProd(fArea.UnitVector());
   const auto diag = velNorm * fArea.Mag();
-  squareMatrix jacobian(2);
+  turbMatrix jacobian(2);
   jacobian(0, 0) = diag;
   jacobian(1, 1) = diag;
   return jacobian;
 }
 
-squareMatrix turbModel::InviscidDissJacobian(
+turbMatrix turbModel::InviscidDissJacobian(
     const primVars &state, const unitVec3dMag<double> &fArea) const {
   // state -- primative variables at face
   // fArea -- face area
 
   const auto velNorm = state.Velocity().DotProd(fArea.UnitVector());
   const auto diag = fabs(velNorm) * fArea.Mag();
-  squareMatrix jacobian(2);
+  turbMatrix jacobian(2);
   jacobian(0, 0) = diag;
   jacobian(1, 1) = diag;
   return jacobian;
@@ -234,7 +234,7 @@ double turbModel::InviscidFaceSpecRad(const primVars &state,
 
 // member function to calculate viscous flux jacobian for models with no
 // viscous contribution
-squareMatrix turbModel::ViscousJacobian(const primVars &state,
+turbMatrix turbModel::ViscousJacobian(const primVars &state,
                                            const unitVec3dMag<double> &fArea,
                                            const double &mu,
                                            const sutherland &suth,
@@ -249,7 +249,7 @@ squareMatrix turbModel::ViscousJacobian(const primVars &state,
   // mut -- turbulent viscosity
   // f1 -- first blending coefficient
 
-  return squareMatrix();
+  return turbMatrix();
 }
 
 // -------------------------------------------------------------------------
@@ -261,13 +261,13 @@ void turbNone::Print() const {
 }
 
 // member function to calculate turbulence source terms
-squareMatrix turbNone::CalcTurbSrc(const primVars &state,
-                                   const tensor<double> &velGrad,
-                                   const vector3d<double> &kGrad,
-                                   const vector3d<double> &wGrad,
-                                   const sutherland &suth, const double &vol,
-                                   const double &turbVisc, const double &f1,
-                                   double &ksrc, double &wsrc) const {
+turbMatrix turbNone::CalcTurbSrc(const primVars &state,
+                                 const tensor<double> &velGrad,
+                                 const vector3d<double> &kGrad,
+                                 const vector3d<double> &wGrad,
+                                 const sutherland &suth, const double &vol,
+                                 const double &turbVisc, const double &f1,
+                                 double &ksrc, double &wsrc) const {
   // set k and omega source terms to zero
   ksrc = 0.0;
   wsrc = 0.0;
@@ -276,36 +276,36 @@ squareMatrix turbNone::CalcTurbSrc(const primVars &state,
   return this->TurbSrcJac(state, 0.0, suth, vol);
 }
 
-squareMatrix turbNone::TurbSrcJac(const primVars &state, const double &beta,
-                                  const sutherland &suth,
-                                  const double &vol) const {
-  return squareMatrix();
+turbMatrix turbNone::TurbSrcJac(const primVars &state, const double &beta,
+                                const sutherland &suth,
+                                const double &vol) const {
+  return turbMatrix();
 }
 
-squareMatrix turbNone::InviscidJacobian(const primVars &state,
-                                        const unitVec3dMag<double> &fArea,
-                                        const bool &positive) const {
+turbMatrix turbNone::InviscidJacobian(const primVars &state,
+                                      const unitVec3dMag<double> &fArea,
+                                      const bool &positive) const {
   // state -- primative variables at face
   // fArea -- face area
   // positive -- flag to determine whether to add/subtract spectral radius
 
-  return squareMatrix();
+  return turbMatrix();
 }
 
-squareMatrix turbNone::InviscidConvJacobian(
+turbMatrix turbNone::InviscidConvJacobian(
     const primVars &state, const unitVec3dMag<double> &fArea) const {
   // state -- primative variables at face
   // fArea -- face area
 
-  return squareMatrix();
+  return turbMatrix();
 }
 
-squareMatrix turbNone::InviscidDissJacobian(
+turbMatrix turbNone::InviscidDissJacobian(
     const primVars &state, const unitVec3dMag<double> &fArea) const {
   // state -- primative variables at face
   // fArea -- face area
 
-  return squareMatrix();
+  return turbMatrix();
 }
 
 // ---------------------------------------------------------------------
@@ -406,14 +406,14 @@ double turbKWWilcox::OmegaTilda(const primVars &state,
 
 // member function to calculate turbulence source terms and return source
 // jacobian
-squareMatrix turbKWWilcox::CalcTurbSrc(const primVars &state,
-                                       const tensor<double> &velGrad,
-                                       const vector3d<double> &kGrad,
-                                       const vector3d<double> &wGrad,
-                                       const sutherland &suth,
-                                       const double &vol,
-                                       const double &mut, const double &f1,
-                                       double &ksrc, double &wsrc) const {
+turbMatrix turbKWWilcox::CalcTurbSrc(const primVars &state,
+                                     const tensor<double> &velGrad,
+                                     const vector3d<double> &kGrad,
+                                     const vector3d<double> &wGrad,
+                                     const sutherland &suth,
+                                     const double &vol,
+                                     const double &mut, const double &f1,
+                                     double &ksrc, double &wsrc) const {
   // state -- primative variables
   // velGrad -- velocity gradient
   // kGrad -- tke gradient
@@ -505,16 +505,16 @@ double turbKWWilcox::SrcSpecRad(const primVars &state,
   return -2.0 * betaStar_ * state.Omega() * vol * suth.InvNondimScaling();
 }
 
-squareMatrix turbKWWilcox::TurbSrcJac(const primVars &state,
-                                      const double &beta,
-                                      const sutherland &suth,
-                                      const double &vol) const {
+turbMatrix turbKWWilcox::TurbSrcJac(const primVars &state,
+                                    const double &beta,
+                                    const sutherland &suth,
+                                    const double &vol) const {
   // state -- primative variables
   // beta -- destruction coefficient for omega equation
   // suth -- sutherland's law for viscosity
   // vol -- cell volume
 
-  squareMatrix jac(2);
+  turbMatrix jac(2);
   jac(0, 0) = -2.0 * betaStar_ * state.Omega() * vol * suth.InvNondimScaling();
   jac(1, 1) = -2.0 * beta * state.Omega() * vol * suth.InvNondimScaling();
 
@@ -525,13 +525,13 @@ squareMatrix turbKWWilcox::TurbSrcJac(const primVars &state,
 // member function to calculate viscous flux jacobian
 // dfv_dq = [ (nu + sigmaStar * nut) / dist           0               ]
 //          [             0                  (nu + sigma * nut) / dist]
-squareMatrix turbKWWilcox::ViscousJacobian(const primVars &state,
-                                           const unitVec3dMag<double> &fArea,
-                                           const double &mu,
-                                           const sutherland &suth,
-                                           const double &dist,
-                                           const double &mut,
-                                           const double &f1) const {
+turbMatrix turbKWWilcox::ViscousJacobian(const primVars &state,
+                                         const unitVec3dMag<double> &fArea,
+                                         const double &mu,
+                                         const sutherland &suth,
+                                         const double &dist,
+                                         const double &mut,
+                                         const double &f1) const {
   // state -- primative variables
   // fAreaL -- face area for left face
   // mu -- laminar viscosity
@@ -540,7 +540,7 @@ squareMatrix turbKWWilcox::ViscousJacobian(const primVars &state,
   // mut -- turbulent viscosity
   // f1 -- first blending coefficient
 
-  squareMatrix jacobian(2);
+  turbMatrix jacobian(2);
   // Wilcox method uses unlimited eddy viscosity
   jacobian(0, 0) = fArea.Mag() * suth.NondimScaling() / (dist * state.Rho()) *
       (mu + this->SigmaK(f1) * this->EddyViscNoLim(state));
@@ -680,13 +680,13 @@ double turbKWSst::Alpha3(const primVars &state, const double &wallDist,
 }
 
 // member function to calculate turbulence source terms and source jacobian
-squareMatrix turbKWSst::CalcTurbSrc(const primVars &state,
-                                    const tensor<double> &velGrad,
-                                    const vector3d<double> &kGrad,
-                                    const vector3d<double> &wGrad,
-                                    const sutherland &suth, const double &vol,
-                                    const double &mut, const double &f1,
-                                    double &ksrc, double &wsrc) const {
+turbMatrix turbKWSst::CalcTurbSrc(const primVars &state,
+                                  const tensor<double> &velGrad,
+                                  const vector3d<double> &kGrad,
+                                  const vector3d<double> &wGrad,
+                                  const sutherland &suth, const double &vol,
+                                  const double &mut, const double &f1,
+                                  double &ksrc, double &wsrc) const {
   // state -- primative variables
   // velGrad -- velocity gradient
   // kGrad -- tke gradient
@@ -790,16 +790,16 @@ double turbKWSst::SrcSpecRad(const primVars &state,
   return -2.0 * betaStar_ * state.Omega() * vol * suth.InvNondimScaling();
 }
 
-squareMatrix turbKWSst::TurbSrcJac(const primVars &state,
-                                   const double &beta,
-                                   const sutherland &suth,
-                                   const double &vol) const {
+turbMatrix turbKWSst::TurbSrcJac(const primVars &state,
+                                 const double &beta,
+                                 const sutherland &suth,
+                                 const double &vol) const {
   // state -- primative variables
   // beta -- destruction coefficient for omega equation
   // suth -- sutherland's law for viscosity
   // vol -- cell volume
 
-  squareMatrix jac(2);
+  turbMatrix jac(2);
   jac(0, 0) = -2.0 * betaStar_ * state.Omega() * vol * suth.InvNondimScaling();
   jac(1, 1) = -2.0 * beta * state.Omega() * vol * suth.InvNondimScaling();
 
@@ -810,12 +810,12 @@ squareMatrix turbKWSst::TurbSrcJac(const primVars &state,
 // member function to calculate viscous flux jacobian
 // dfv_dq = [ (nu + sigmaStar * nut) / dist           0               ]
 //          [             0                  (nu + sigma * nut) / dist]
-squareMatrix turbKWSst::ViscousJacobian(const primVars &state,
-                                        const unitVec3dMag<double> &fArea,
-                                        const double &mu,
-                                        const sutherland &suth,
-                                        const double &dist, const double &mut,
-                                        const double &f1) const {
+turbMatrix turbKWSst::ViscousJacobian(const primVars &state,
+                                      const unitVec3dMag<double> &fArea,
+                                      const double &mu,
+                                      const sutherland &suth,
+                                      const double &dist, const double &mut,
+                                      const double &f1) const {
   // state -- primative variables
   // fArea -- face area
   // mu -- laminar viscosity
@@ -824,7 +824,7 @@ squareMatrix turbKWSst::ViscousJacobian(const primVars &state,
   // mut -- turbulent viscosity
   // f1 -- first blending coefficient
 
-  squareMatrix jacobian(2);
+  turbMatrix jacobian(2);
   jacobian(0, 0) = fArea.Mag() * suth.NondimScaling() / (dist * state.Rho()) *
       (mu + this->SigmaK(f1) * mut);
   jacobian(1, 1) = fArea.Mag() * suth.NondimScaling() / (dist * state.Rho()) *
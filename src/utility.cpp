@@ -20,6 +20,10 @@
 #include <string>
 #include <memory>
 #include <numeric>
+#include <limits>                 // numeric_limits
+#ifdef _OPENMP
+#include <omp.h>                  // omp_get_max_threads
+#endif
 #include "utility.hpp"
 #include "procBlock.hpp"
 #include "eos.hpp"                 // idealGas
@@ -29,8 +33,10 @@
 #include "slices.hpp"
 #include "fluxJacobian.hpp"
 #include "kdtree.hpp"
+#include "parallel.hpp"            // NearestWallDistances
 #include "resid.hpp"
 #include "primVars.hpp"
+#include "haloExchange.hpp"
 
 using std::cout;
 using std::endl;
@@ -254,48 +260,177 @@ void SwapGeomSlice(interblock &inter, procBlock &blk1, procBlock &blk2) {
 }
 
 
+/* Function to swap the geometry of a block on this processor with the partner
+block of an interblock on another processor. This does the same as
+SwapGeomSlice(), except only the block on this processor is updated.
+*/
+void SwapGeomSliceMPI(interblock &inter, procBlock &blk, const int &rank,
+                      const MPI_Datatype &MPI_vec3d,
+                      const MPI_Datatype &MPI_vec3dMag) {
+  // inter -- interblock boundary information
+  // blk -- block on this processor involved in interblock boundary
+  // rank -- processor rank
+  // MPI_vec3d -- MPI datatype for a vector3d<double>
+  // MPI_vec3dMag -- MPI datatype for a unitVec3dMag<double>
+
+  const auto isFirst = rank == inter.RankFirst();
+
+  // Get indices for slice coming from local block to swap
+  auto is = 0, ie = 0;
+  auto js = 0, je = 0;
+  auto ks = 0, ke = 0;
+  if (isFirst) {
+    inter.FirstSliceIndices(is, ie, js, je, ks, ke, blk.NumGhosts());
+  } else {
+    inter.SecondSliceIndices(is, ie, js, je, ks, ke, blk.NumGhosts());
+  }
+
+  // swap local slice for slice of partner block
+  auto geom = geomSlice(blk, {is, ie}, {js, je}, {ks, ke});
+  geom.PackSwapUnpackMPI(inter, MPI_vec3d, MPI_vec3dMag, rank);
+
+  // change interblock to work with slice and ghosts
+  auto interAdj = inter;
+  interAdj.AdjustForSlice(isFirst, blk.NumGhosts());
+
+  // put slice in local block and update interblock border if necessary
+  const auto adjEdge = blk.PutGeomSlice(geom, interAdj, blk.NumGhosts());
+  for (auto ii = 0U; ii < adjEdge.size(); ii++) {
+    if (adjEdge[ii]) {
+      isFirst ? inter.UpdateBorderFirst(ii) : inter.UpdateBorderSecond(ii);
+    }
+  }
+}
+
+/* Function to swap the geometry of the ghost cells at all interblocks. Every
+processor loops over the interblocks in the same order, swapping the ones its
+blocks are on. The slice swapped across an interblock can contain ghost cells
+filled by an earlier interblock, so the order must match a swap of all blocks
+on one processor (see PutGeomSlice() for "t" intersections). A processor only
+waits on a swap once all earlier swaps of its partner have been done, so swaps
+between different pairs of processors happen at the same time.
+*/
+void SwapGeometry(vector<interblock> &connections, vector<procBlock> &blocks,
+                  const int &rank, const MPI_Datatype &MPI_vec3d,
+                  const MPI_Datatype &MPI_vec3dMag) {
+  // connections -- interblock boundary conditions
+  // blocks -- procBlocks on this processor
+  // rank -- processor rank
+  // MPI_vec3d -- MPI datatype for a vector3d<double>
+  // MPI_vec3dMag -- MPI datatype for a unitVec3dMag<double>
+
+  for (auto &conn : connections) {
+    if (conn.RankFirst() == rank && conn.RankSecond() == rank) {
+      // both sides of interblock on this processor, swap w/o mpi
+      SwapGeomSlice(conn, blocks[conn.LocalBlockFirst()],
+                    blocks[conn.LocalBlockSecond()]);
+    } else if (conn.RankFirst() == rank) {
+      SwapGeomSliceMPI(conn, blocks[conn.LocalBlockFirst()], rank, MPI_vec3d,
+                       MPI_vec3dMag);
+    } else if (conn.RankSecond() == rank) {
+      SwapGeomSliceMPI(conn, blocks[conn.LocalBlockSecond()], rank, MPI_vec3d,
+                       MPI_vec3dMag);
+    }
+  }
+
+  // each processor only updated the interblock borders on its side, so
+  // combine them so all processors have the same interblocks
+  vector<int> borders(8 * connections.size());
+  for (auto ii = 0U; ii < connections.size(); ii++) {
+    const auto &conn = connections[ii];
+    borders[8 * ii] = conn.Dir1StartInterBorderFirst();
+    borders[8 * ii + 1] = conn.Dir1EndInterBorderFirst();
+    borders[8 * ii + 2] = conn.Dir2StartInterBorderFirst();
+    borders[8 * ii + 3] = conn.Dir2EndInterBorderFirst();
+    borders[8 * ii + 4] = conn.Dir1StartInterBorderSecond();
+    borders[8 * ii + 5] = conn.Dir1EndInterBorderSecond();
+    borders[8 * ii + 6] = conn.Dir2StartInterBorderSecond();
+    borders[8 * ii + 7] = conn.Dir2EndInterBorderSecond();
+  }
+  MPI_Allreduce(MPI_IN_PLACE, borders.data(), borders.size(), MPI_INT,
+                MPI_LOR, MPI_COMM_WORLD);
+  for (auto ii = 0U; ii < connections.size(); ii++) {
+    for (auto aa = 0; aa < 4; aa++) {
+      if (borders[8 * ii + aa]) {
+        connections[ii].UpdateBorderFirst(aa);
+      }
+      if (borders[8 * ii + 4 + aa]) {
+        connections[ii].UpdateBorderSecond(aa);
+      }
+    }
+  }
+}
+
 /* Function to populate ghost cells with proper cell states for inviscid flow
 calculation. This function operates on the entire grid and uses interblock
-boundaries to pass the correct data between grid blocks.
+boundaries to pass the correct data between grid blocks. The ghost cells from
+other processors are left in flight, so the residual on the faces that do not
+need them can be calculated before they arrive; CompleteBoundaryConditions()
+must be called before the rest of the ghost cells are used.
 */
 void GetBoundaryConditions(vector<procBlock> &states, const input &inp,
                            const idealGas &eos, const sutherland &suth,
                            const unique_ptr<turbModel> &turb,
                            vector<interblock> &conn, const int &rank,
-                           const MPI_Datatype &MPI_cellData) {
+                           haloExchange &exchange) {
   // states -- vector of all procBlocks in the solution domain
   // inp -- all input variables
   // eos -- equation of state
   // suth -- sutherland's law for viscosity
   // conn -- vector of interblock connections
   // rank -- processor rank
-  // MPI_cellData -- data type to pass primVars, genArray
+  // exchange -- exchange for interblocks with other processors
 
   // loop over all blocks and assign inviscid ghost cells
+#pragma omp parallel for schedule(dynamic)
   for (auto ii = 0U; ii < states.size(); ii++) {
     states[ii].AssignInviscidGhostCells(inp, eos, suth, turb);
   }
 
-  // loop over connections and swap ghost cells where needed
+  // exchange ghost cells with other processors
+  for (auto ii = 0U; ii < conn.size(); ii++) {
+    if (conn[ii].RankFirst() == rank && conn[ii].RankSecond() != rank) {
+      // rank matches rank of first side of interblock, swap over mpi
+      states[conn[ii].LocalBlockFirst()].AddStateSliceMPI(ii, exchange);
+    } else if (conn[ii].RankSecond() == rank &&
+               conn[ii].RankFirst() != rank) {
+      // rank matches rank of second side of interblock, swap over mpi
+      states[conn[ii].LocalBlockSecond()].AddStateSliceMPI(ii, exchange);
+    }
+  }
+
+  exchange.Start();
+
+  // swap ghost cells between blocks on this processor while messages are in
+  // flight
   for (auto ii = 0U; ii < conn.size(); ii++) {
     if (conn[ii].RankFirst() == rank && conn[ii].RankSecond() == rank) {
       // both sides of interblock on this processor, swap w/o mpi
       states[conn[ii].LocalBlockFirst()].SwapStateSlice(
           conn[ii], states[conn[ii].LocalBlockSecond()]);
-    } else if (conn[ii].RankFirst() == rank) {
-      // rank matches rank of first side of interblock, swap over mpi
-      states[conn[ii].LocalBlockFirst()].SwapStateSliceMPI(conn[ii], rank,
-                                                           MPI_cellData);
-    } else if (conn[ii].RankSecond() == rank) {
-      // rank matches rank of second side of interblock, swap over mpi
-      states[conn[ii].LocalBlockSecond()].SwapStateSliceMPI(conn[ii], rank,
-                                                            MPI_cellData);
     }
     // if rank doesn't match either side of interblock, then do nothing and
     // move on to the next interblock
   }
+}
+
+// function to receive the ghost cells from other processors started by
+// GetBoundaryConditions() and assign the edge ghost cells that depend on them
+void CompleteBoundaryConditions(vector<procBlock> &states, const input &inp,
+                                const idealGas &eos, const sutherland &suth,
+                                const unique_ptr<turbModel> &turb,
+                                haloExchange &exchange) {
+  // states -- vector of all procBlocks in the solution domain
+  // inp -- all input variables
+  // eos -- equation of state
+  // suth -- sutherland's law for viscosity
+  // turb -- turbulence model
+  // exchange -- exchange for interblocks with other processors
+
+  exchange.Complete();
 
   // loop over all blocks and get ghost cell edge data
+#pragma omp parallel for schedule(dynamic)
   for (auto ii = 0U; ii < states.size(); ii++) {
     states[ii].AssignInviscidGhostCellsEdge(inp, eos, suth, turb);
   }
@@ -365,10 +500,123 @@ vector<vector3d<double>> GetViscousFaceCenters(const vector<procBlock> &blks) {
 
 // function to calculate the distance to the nearest viscous wall of all
 // cell centers
-void CalcWallDistance(vector<procBlock> &localBlocks, const kdtree &tree) {
-  for (auto &block : localBlocks) {
-    block.CalcWallDistance(tree);
+/* The viscous wall faces are divided among the processors, and the k-d tree
+holds the faces given to this processor. The cells of all blocks on this
+processor are searched for together, see NearestWallDistances(). If there are
+no viscous walls, the wall distance is left at its default value.
+*/
+void CalcWallDistance(vector<procBlock> &localBlocks, const kdtree &tree,
+                      const input &inp) {
+  // localBlocks -- vector of all procBlocks on processor
+  // tree -- k-d tree of viscous wall face centers on processor
+  // inp -- input variables
+
+  auto numFaces = tree.Size();
+  MPI_Allreduce(MPI_IN_PLACE, &numFaces, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+  if (numFaces == 0) {
+    return;
+  }
+
+  // gather cell centers of all blocks in search order
+  vector<vector<vector3d<int>>> cells(localBlocks.size());
+  vector<vector3d<double>> centers;
+  for (auto bb = 0U; bb < localBlocks.size(); bb++) {
+    cells[bb] = localBlocks[bb].WallDistanceCells(inp);
+    for (const auto &cell : cells[bb]) {
+      centers.push_back(localBlocks[bb].Center(cell[0], cell[1], cell[2]));
+    }
+  }
+
+  const auto distances = NearestWallDistances(tree, centers);
+
+  auto position = 0U;
+  for (auto bb = 0U; bb < localBlocks.size(); bb++) {
+    localBlocks[bb].AssignWallDistance(cells[bb], &distances[position]);
+    position += cells[bb].size();
+  }
+}
+
+// function to calculate the distance to the nearest viscous wall of all
+// cell centers with the eikonal method
+/* Each cell holds the nearest viscous wall point found so far, starting with
+the centers of the viscous wall faces next to it. The points are swept through
+each block (see procBlock::SweepWallPoints()), and then the points in the
+ghost cells of interblocks are swapped so they can be swept into the
+neighboring blocks. This is repeated until no physical cell on any processor
+finds a closer point. Unlike the k-d tree search, the cost scales with the
+number of cells and does not depend on the number of viscous wall faces. The
+number of sweep cycles is returned.
+*/
+int CalcWallDistanceEikonal(vector<procBlock> &localBlocks,
+                            const vector<interblock> &conn, const int &rank,
+                            haloExchange &exchange) {
+  // localBlocks -- vector of all procBlocks on processor
+  // conn -- interblock boundary conditions
+  // rank -- processor rank
+  // exchange -- exchange for interblocks with other processors
+
+  // nearest wall point and distance squared to it of each cell
+  vector<multiArray3d<vector3d<double>>> wallPoint;
+  vector<multiArray3d<double>> wallDistSq;
+  wallPoint.reserve(localBlocks.size());
+  wallDistSq.reserve(localBlocks.size());
+  for (const auto &block : localBlocks) {
+    wallPoint.emplace_back(block.NumI(), block.NumJ(), block.NumK(),
+                           block.NumGhosts());
+    wallDistSq.emplace_back(block.NumI(), block.NumJ(), block.NumK(),
+                            block.NumGhosts(),
+                            std::numeric_limits<double>::max());
+    block.SeedWallPoints(wallPoint.back(), wallDistSq.back());
+  }
+
+  auto numCycles = 0;
+  auto changed = 1;
+  while (changed) {
+    changed = 0;
+#pragma omp parallel for schedule(dynamic) reduction(||: changed)
+    for (auto bb = 0U; bb < localBlocks.size(); bb++) {
+      changed = localBlocks[bb].SweepWallPoints(wallPoint[bb],
+                                                wallDistSq[bb]) || changed;
+    }
+
+    // swap wall points across interblocks with other processors
+    for (auto ii = 0U; ii < conn.size(); ii++) {
+      if (conn[ii].RankFirst() == rank && conn[ii].RankSecond() != rank) {
+        // rank matches rank of first side of interblock, swap over mpi
+        exchange.Add(wallPoint[conn[ii].LocalBlockFirst()], ii);
+        exchange.Add(wallDistSq[conn[ii].LocalBlockFirst()], ii);
+      } else if (conn[ii].RankSecond() == rank &&
+                 conn[ii].RankFirst() != rank) {
+        // rank matches rank of second side of interblock, swap over mpi
+        exchange.Add(wallPoint[conn[ii].LocalBlockSecond()], ii);
+        exchange.Add(wallDistSq[conn[ii].LocalBlockSecond()], ii);
+      }
+    }
+
+    exchange.Start();
+
+    // swap wall points between blocks on this processor while messages are
+    // in flight
+    for (auto ii = 0U; ii < conn.size(); ii++) {
+      if (conn[ii].RankFirst() == rank && conn[ii].RankSecond() == rank) {
+        // both sides of interblock are on this processor, swap w/o mpi
+        const auto first = conn[ii].LocalBlockFirst();
+        const auto second = conn[ii].LocalBlockSecond();
+        wallPoint[first].SwapSlice(conn[ii], wallPoint[second]);
+        wallDistSq[first].SwapSlice(conn[ii], wallDistSq[second]);
+      }
+    }
+    exchange.Complete();
+
+    MPI_Allreduce(MPI_IN_PLACE, &changed, 1, MPI_INT, MPI_LOR,
+                  MPI_COMM_WORLD);
+    numCycles++;
   }
+
+  for (auto bb = 0U; bb < localBlocks.size(); bb++) {
+    localBlocks[bb].AssignWallDistance(wallDistSq[bb]);
+  }
+  return numCycles;
 }
 
 void AssignSolToTimeN(vector<procBlock> &blocks, const idealGas &eos) {
@@ -390,9 +638,38 @@ void ExplicitUpdate(vector<procBlock> &blocks,
                     genArray &residL2, resid &residLinf) {
   // create dummy update (not used in explicit update)
   multiArray3d<genArray> du(1, 1, 1, 0);
+
+  // residuals are stored for each block so blocks can be updated concurrently
+  vector<genArray> blockL2(blocks.size(), genArray(0.0));
+  vector<resid> blockLinf(blocks.size());
+
   // loop over all blocks and update
+#pragma omp parallel for schedule(dynamic)
   for (auto bb = 0U; bb < blocks.size(); bb++) {
-    blocks[bb].UpdateBlock(inp, eos, aRef, suth, du, turb, mm, residL2, residLinf);
+    blocks[bb].UpdateBlock(inp, eos, aRef, suth, du, turb, mm, blockL2[bb],
+                           blockLinf[bb]);
+  }
+
+  AccumulateResidual(blockL2, blockLinf, residL2, residLinf);
+}
+
+/* Function to combine the residual norms calculated for each block into the
+norms for the processor. The blocks are visited in order so the result does not
+depend on the order in which the blocks were updated.
+*/
+void AccumulateResidual(const vector<genArray> &blockL2,
+                        const vector<resid> &blockLinf, genArray &residL2,
+                        resid &residLinf) {
+  // blockL2 -- L2 residual of each block
+  // blockLinf -- L infinity residual of each block
+  // residL2 -- L2 residual of processor
+  // residLinf -- L infinity residual of processor
+
+  for (auto bb = 0U; bb < blockL2.size(); bb++) {
+    residL2 += blockL2[bb];
+    if (blockLinf[bb].Linf() > residLinf.Linf()) {
+      residLinf = blockLinf[bb];
+    }
   }
 }
 
@@ -404,7 +681,7 @@ double ImplicitUpdate(vector<procBlock> &blocks,
                       const unique_ptr<turbModel> &turb, const int &mm,
                       genArray &residL2, resid &residLinf,
                       const vector<interblock> &connections, const int &rank,
-                      const MPI_Datatype &MPI_cellData) {
+                      haloExchange &exchange) {
   // blocks -- vector of procBlocks on current processor
   // mainDiagonal -- main diagonal of A matrix for all blocks on processor
   // inp -- input variables
@@ -414,76 +691,76 @@ double ImplicitUpdate(vector<procBlock> &blocks,
   // mm -- nonlinear iteration
   // residL2 -- L2 residual
   // residLinf -- L infinity residual
+  // connections -- interblock boundary conditions
+  // rank -- processor rank
+  // exchange -- exchange for interblocks with other processors
 
-  // initialize matrix error
-  auto matrixError = 0.0;
+  // initialize matrix error; stored for each block so blocks can be solved
+  // concurrently
+  vector<double> blockError(blocks.size(), 0.0);
 
   const auto numG = blocks[0].NumGhosts();
 
   // add volume and time term and calculate inverse of main diagonal
-  for (auto bb = 0U; bb < blocks.size(); bb++) {
-    blocks[bb].InvertDiagonal(mainDiagonal[bb], inp);
-  }
-
   // initialize matrix update
   vector<multiArray3d<genArray>> du(blocks.size());
+#pragma omp parallel for schedule(dynamic)
   for (auto bb = 0U; bb < blocks.size(); bb++) {
+    blocks[bb].InvertDiagonal(mainDiagonal[bb], inp);
     du[bb] = blocks[bb].InitializeMatrixUpdate(inp, eos, mainDiagonal[bb]);
   }
 
   // Solve Ax=b with supported solver
-  if (inp.MatrixSolver() == "lusgs" || inp.MatrixSolver() == "blusgs") {
-    // calculate order by hyperplanes for each block
-    vector<vector<vector3d<int>>> reorder(blocks.size());
-    for (auto bb = 0U; bb < blocks.size(); bb++) {
-      reorder[bb] = HyperplaneReorder(blocks[bb].NumI(), blocks[bb].NumJ(),
-                                      blocks[bb].NumK());
-    }
-
+  const auto solver = inp.MatrixSolverMethod();
+  if (solver == matrixSolverMethod::lusgs ||
+      solver == matrixSolverMethod::blusgs) {
     // start sweeps through domain
     for (auto ii = 0; ii < inp.MatrixSweeps(); ii++) {
       // swap updates for ghost cells
-      SwapImplicitUpdate(du, connections, rank, MPI_cellData, numG);
+      SwapImplicitUpdate(du, connections, rank, numG, exchange);
 
       // forward lu-sgs sweep
+      // with fewer blocks than threads, the threads sweep each block together
+      // one hyperplane at a time
+#pragma omp parallel for schedule(dynamic) if (ThreadOverBlocks(blocks))
       for (auto bb = 0U; bb < blocks.size(); bb++) {
-        blocks[bb].LUSGS_Forward(reorder[bb], du[bb], eos, inp, suth, turb,
+        blocks[bb].LUSGS_Forward(du[bb], eos, inp, suth, turb,
                                  mainDiagonal[bb], ii);
       }
 
       // swap updates for ghost cells
-      SwapImplicitUpdate(du, connections, rank, MPI_cellData, numG);
+      SwapImplicitUpdate(du, connections, rank, numG, exchange);
 
       // backward lu-sgs sweep
+#pragma omp parallel for schedule(dynamic) if (ThreadOverBlocks(blocks))
       for (auto bb = 0U; bb < blocks.size(); bb++) {
-        matrixError += blocks[bb].LUSGS_Backward(reorder[bb], du[bb], eos, inp,
-                                                 suth, turb, mainDiagonal[bb],
-                                                 ii);
+        blockError[bb] += blocks[bb].LUSGS_Backward(du[bb], eos, inp, suth,
+                                                    turb, mainDiagonal[bb],
+                                                    ii);
       }
     }
-  } else if (inp.MatrixSolver() == "dplur" || inp.MatrixSolver() == "bdplur") {
+  } else {  // dplur or bdplur
     for (auto ii = 0; ii < inp.MatrixSweeps(); ii++) {
       // swap updates for ghost cells
-      SwapImplicitUpdate(du, connections, rank, MPI_cellData, numG);
+      SwapImplicitUpdate(du, connections, rank, numG, exchange);
 
+#pragma omp parallel for schedule(dynamic)
       for (auto bb = 0U; bb < blocks.size(); bb++) {
         // Calculate correction (du)
-        matrixError += blocks[bb].DPLUR(du[bb], eos, inp, suth, turb,
-                                        mainDiagonal[bb]);
+        blockError[bb] += blocks[bb].DPLUR(du[bb], eos, inp, suth, turb,
+                                           mainDiagonal[bb]);
       }
     }
-  } else {
-    cerr << "ERROR: Matrix solver " << inp.MatrixSolver() <<
-        " is not recognized!" << endl;
-    cerr << "Please choose lusgs, blusgs, dplur, or bdplur." << endl;
-    exit(EXIT_FAILURE);
   }
 
   // Update blocks and reset main diagonal
+  vector<genArray> blockL2(blocks.size(), genArray(0.0));
+  vector<resid> blockLinf(blocks.size());
+#pragma omp parallel for schedule(dynamic)
   for (auto bb = 0U; bb < blocks.size(); bb++) {
     // Update solution
-    blocks[bb].UpdateBlock(inp, eos, aRef, suth, du[bb], turb, mm, residL2,
-                           residLinf);
+    blocks[bb].UpdateBlock(inp, eos, aRef, suth, du[bb], turb, mm,
+                           blockL2[bb], blockLinf[bb]);
 
     // Assign time n to time n-1 at end of nonlinear iterations
     if (inp.IsMultilevelInTime() && mm == inp.NonlinearIterations() - 1) {
@@ -494,92 +771,119 @@ double ImplicitUpdate(vector<procBlock> &blocks,
     mainDiagonal[bb].Zero();
   }
 
-  return matrixError;
+  AccumulateResidual(blockL2, blockLinf, residL2, residLinf);
+
+  return std::accumulate(std::begin(blockError), std::end(blockError), 0.0);
 }
 
 void SwapImplicitUpdate(vector<multiArray3d<genArray>> &du,
                         const vector<interblock> &conn, const int &rank,
-                        const MPI_Datatype &MPI_cellData,
-                        const int &numGhosts) {
+                        const int &numGhosts, haloExchange &exchange) {
   // du -- implicit update in conservative variables
   // conn -- interblock boundary conditions
   // rank -- processor rank
-  // MPI_cellData -- datatype to pass primVars or genArray
   // numGhosts -- number of ghost cells
+  // exchange -- exchange for interblocks with other processors
 
-  // loop over all connections and swap interblock updates when necessary
+  // exchange updates with other processors
+  for (auto ii = 0U; ii < conn.size(); ii++) {
+    if (conn[ii].RankFirst() == rank && conn[ii].RankSecond() != rank) {
+      // rank matches rank of first side of interblock, swap over mpi
+      exchange.Add(du[conn[ii].LocalBlockFirst()], ii);
+    } else if (conn[ii].RankSecond() == rank &&
+               conn[ii].RankFirst() != rank) {
+      // rank matches rank of second side of interblock, swap over mpi
+      exchange.Add(du[conn[ii].LocalBlockSecond()], ii);
+    }
+  }
+
+  exchange.Start();
+
+  // swap updates between blocks on this processor while messages are in
+  // flight
   for (auto ii = 0U; ii < conn.size(); ii++) {
     if (conn[ii].RankFirst() == rank && conn[ii].RankSecond() == rank) {
       // both sides of interblock are on this processor, swap w/o mpi
       du[conn[ii].LocalBlockFirst()].SwapSlice(conn[ii],
                                                du[conn[ii].LocalBlockSecond()]);
-    } else if (conn[ii].RankFirst() == rank) {
-      // rank matches rank of first side of interblock, swap over mpi
-      du[conn[ii].LocalBlockFirst()].SwapSliceMPI(conn[ii], rank, MPI_cellData);
-    } else if (conn[ii].RankSecond() == rank) {
-      // rank matches rank of second side of interblock, swap over mpi
-      du[conn[ii].LocalBlockSecond()].SwapSliceMPI(conn[ii], rank, MPI_cellData);
     }
     // if rank doesn't match either side of interblock, then do nothing and
     // move on to the next interblock
   }
+  exchange.Complete();
 }
 
 
+// function to swap turbulence variables at interblocks
+/* Swaps between blocks on this processor are done immediately. Swaps with
+other processors are added to the exchange, which the caller starts and
+completes. This allows several fields to be sent in the same messages.
+*/
 void SwapTurbVars(vector<procBlock> &states,
                   const vector<interblock> &conn, const int &rank,
-                  const int &numGhosts) {
+                  const int &numGhosts, haloExchange &exchange) {
   // states -- vector of all procBlocks in the solution domain
   // conn -- interblock boundary conditions
   // rank -- processor rank
   // numGhosts -- number of ghost cells
+  // exchange -- exchange to add swaps with other processors to
 
-  // loop over all connections and swap interblock updates when necessary
+  // add swaps with other processors to exchange
+  for (auto ii = 0U; ii < conn.size(); ii++) {
+    if (conn[ii].RankFirst() == rank && conn[ii].RankSecond() != rank) {
+      // rank matches rank of first side of interblock, swap over mpi
+      states[conn[ii].LocalBlockFirst()].AddTurbSliceMPI(ii, exchange);
+    } else if (conn[ii].RankSecond() == rank &&
+               conn[ii].RankFirst() != rank) {
+      // rank matches rank of second side of interblock, swap over mpi
+      states[conn[ii].LocalBlockSecond()].AddTurbSliceMPI(ii, exchange);
+    }
+  }
+
+  // swap between blocks on this processor
   for (auto ii = 0U; ii < conn.size(); ii++) {
     if (conn[ii].RankFirst() == rank && conn[ii].RankSecond() == rank) {
       // both sides of interblock are on this processor, swap w/o mpi
       states[conn[ii].LocalBlockFirst()].SwapTurbSlice(
           conn[ii], states[conn[ii].LocalBlockSecond()]);
-    } else if (conn[ii].RankFirst() == rank) {
-      // rank matches rank of first side of interblock, swap over mpi
-      states[conn[ii].LocalBlockFirst()].SwapTurbSliceMPI(conn[ii], rank);
-    } else if (conn[ii].RankSecond() == rank) {
-      // rank matches rank of second side of interblock, swap over mpi
-      states[conn[ii].LocalBlockSecond()].SwapTurbSliceMPI(conn[ii], rank);
     }
     // if rank doesn't match either side of interblock, then do nothing and
     // move on to the next interblock
   }
 }
 
+// function to swap gradients at interblocks
+/* Swaps between blocks on this processor are done immediately. Swaps with
+other processors are added to the exchange, which the caller starts and
+completes. This allows several fields to be sent in the same messages.
+*/
 void SwapGradients(vector<procBlock> &states,
                    const vector<interblock> &conn, const int &rank,
-                   const MPI_Datatype &MPI_tensorDouble,
-                   const MPI_Datatype &MPI_vec3d,
-                   const int &numGhosts) {
+                   const int &numGhosts, haloExchange &exchange) {
   // states -- vector of all procBlocks in the solution domain
   // conn -- interblock boundary conditions
   // rank -- processor rank
-  // MPI_tensorDouble -- MPI datatype for tensor<double>
-  // MPI_vec3d -- MPI datatype for vector3d<double>
   // numGhosts -- number of ghost cells
+  // exchange -- exchange to add swaps with other processors to
+
+  // add swaps with other processors to exchange
+  for (auto ii = 0U; ii < conn.size(); ii++) {
+    if (conn[ii].RankFirst() == rank && conn[ii].RankSecond() != rank) {
+      // rank matches rank of first side of interblock, swap over mpi
+      states[conn[ii].LocalBlockFirst()].AddGradientSliceMPI(ii, exchange);
+    } else if (conn[ii].RankSecond() == rank &&
+               conn[ii].RankFirst() != rank) {
+      // rank matches rank of second side of interblock, swap over mpi
+      states[conn[ii].LocalBlockSecond()].AddGradientSliceMPI(ii, exchange);
+    }
+  }
 
-  // loop over all connections and swap interblock updates when necessary
+  // swap between blocks on this processor
   for (auto ii = 0U; ii < conn.size(); ii++) {
     if (conn[ii].RankFirst() == rank && conn[ii].RankSecond() == rank) {
       // both sides of interblock are on this processor, swap w/o mpi
       states[conn[ii].LocalBlockFirst()].SwapGradientSlice(
           conn[ii], states[conn[ii].LocalBlockSecond()]);
-    } else if (conn[ii].RankFirst() == rank) {
-      // rank matches rank of first side of interblock, swap over mpi
-      states[conn[ii].LocalBlockFirst()].SwapGradientSliceMPI(conn[ii], rank,
-                                                              MPI_tensorDouble,
-                                                              MPI_vec3d);
-    } else if (conn[ii].RankSecond() == rank) {
-      // rank matches rank of second side of interblock, swap over mpi
-      states[conn[ii].LocalBlockSecond()].SwapGradientSliceMPI(conn[ii], rank,
-                                                               MPI_tensorDouble,
-                                                               MPI_vec3d);
     }
     // if rank doesn't match either side of interblock, then do nothing and
     // move on to the next interblock
@@ -592,8 +896,7 @@ void CalcResidual(vector<procBlock> &states,
                   const sutherland &suth, const idealGas &eos,
                   const input &inp, const unique_ptr<turbModel> &turb,
                   const vector<interblock> &connections, const int &rank,
-                  const MPI_Datatype &MPI_tensorDouble,
-                  const MPI_Datatype &MPI_vec3d) {
+                  haloExchange &exchange) {
   // states -- vector of all procBlocks on processor
   // mainDiagonal -- main diagonal of A matrix for implicit solve
   // suth -- sutherland's law for viscosity
@@ -602,26 +905,63 @@ void CalcResidual(vector<procBlock> &states,
   // turb -- turbulence model
   // connections -- interblock boundary conditions
   // rank -- processor rank
-  // MPI_tensorDouble -- MPI datatype for tensor<double>
-  // MPI_vec3d -- MPI datatype for vector3d<double>
+  // exchange -- exchange for interblocks with other processors
 
+  // the ghost cells from other processors are still in flight from
+  // GetBoundaryConditions(), so the faces that do not use them are calculated
+  // first; with fewer blocks than threads, the threads are used within each
+  // block on the flux calculation instead
+#pragma omp parallel for schedule(dynamic) if (ThreadOverBlocks(states))
   for (auto bb = 0U; bb < states.size(); bb++) {
-    // calculate residual
-    states[bb].CalcResidualNoSource(suth, eos, inp, turb, mainDiagonal[bb]);
+    bool haloSurf[6];
+    exchange.HaloSurfaces(bb, haloSurf);
+    states[bb].CalcResidualInterior(eos, inp, turb, mainDiagonal[bb],
+                                    haloSurf);
   }
-  // swap gradients calculated during residual calculation
-  SwapGradients(states, connections, rank, MPI_tensorDouble, MPI_vec3d,
-                inp.NumberGhostLayers());
 
+  CompleteBoundaryConditions(states, inp, eos, suth, turb, exchange);
+
+#pragma omp parallel for schedule(dynamic) if (ThreadOverBlocks(states))
+  for (auto bb = 0U; bb < states.size(); bb++) {
+    bool haloSurf[6];
+    exchange.HaloSurfaces(bb, haloSurf);
+    // calculate rest of residual
+    states[bb].CalcResidualHalo(suth, eos, inp, turb, mainDiagonal[bb],
+                                haloSurf);
+  }
+  // swap gradients and turbulence variables calculated during residual
+  // calculation; both are sent to other processors in the same messages
+  SwapGradients(states, connections, rank, inp.NumberGhostLayers(), exchange);
   if (inp.IsTurbulent()) {
-    // swap turbulence variables calculated during residual calculation
-    SwapTurbVars(states, connections, rank, inp.NumberGhostLayers());
+    SwapTurbVars(states, connections, rank, inp.NumberGhostLayers(),
+                 exchange);
+  }
+  exchange.Start();
 
+  if (inp.IsTurbulent()) {
+    // source terms only use physical cells, so they are calculated while the
+    // ghost cells are in flight from other processors
+#pragma omp parallel for schedule(dynamic)
     for (auto bb = 0U; bb < states.size(); bb++) {
       // calculate source terms for residual
       states[bb].CalcSrcTerms(suth, turb, inp, mainDiagonal[bb]);
     }
   }
+  exchange.Complete();
+}
+
+// function to decide if threads should be divided among the blocks
+/* When there are at least as many blocks as threads, each thread works on
+separate blocks. Otherwise some threads would sit idle, so the blocks are
+visited one at a time and the threads divide the faces of each block.
+*/
+bool ThreadOverBlocks(const vector<procBlock> &states) {
+  // states -- vector of all procBlocks on processor
+#ifdef _OPENMP
+  return states.size() >= static_cast<unsigned int>(omp_get_max_threads());
+#else
+  return true;
+#endif
 }
 
 void CalcTimeStep(vector<procBlock> &states, const input &inp,
@@ -630,6 +970,7 @@ void CalcTimeStep(vector<procBlock> &states, const input &inp,
   // inp -- input variables
   // aRef -- reference speed of sound
 
+#pragma omp parallel for schedule(dynamic)
   for (auto bb = 0U; bb < states.size(); bb++) {
     // calculate time step
     states[bb].CalcBlockTimeStep(inp, aRef);
@@ -641,24 +982,43 @@ void CalcTimeStep(vector<procBlock> &states, const input &inp,
 /*A hyperplane is a plane of i+j+k=constant within an individual block. The
 LUSGS solver must sweep along these hyperplanes to avoid
 calculating a flux jacobian. Ex. The solver must visit all points on hyperplane
-1 before visiting any points on hyperplane 2.
+1 before visiting any points on hyperplane 2. The cells are bucketed by their
+hyperplane with a counting sort, so the cost is linear in the number of cells.
+Within a hyperplane the cells are ordered by k, then j, then i. The index of
+the first cell of each hyperplane is returned in planeStart, which has one more
+entry than there are hyperplanes so that the cells of hyperplane p are
+[planeStart[p], planeStart[p + 1]).
 */
 vector<vector3d<int>> HyperplaneReorder(const int &imax, const int &jmax,
-                                        const int &kmax) {
+                                        const int &kmax,
+                                        vector<int> &planeStart) {
+  // imax -- number of cells in i-direction
+  // jmax -- number of cells in j-direction
+  // kmax -- number of cells in k-direction
+  // planeStart -- index of first cell in each hyperplane (output)
+
   // total number of hyperplanes in a given block
   const auto numPlanes = imax + jmax + kmax - 2;
-  vector<vector3d<int>> reorder;
-  reorder.reserve(imax * jmax * kmax);
-
-  for (auto pp = 0; pp < numPlanes; pp++) {
-    for (auto kk = 0; kk < kmax; kk++) {
-      for (auto jj = 0; jj < jmax; jj++) {
-        for (auto ii = 0; ii < imax; ii++) {
-          if (ii + jj + kk == pp) {  // if sum of ii, jj, and kk equals pp than
-                                     // point is on hyperplane pp
-            reorder.push_back(vector3d<int>(ii, jj, kk));
-          }
-        }
+
+  // count cells on each hyperplane, then convert counts to starting indices
+  planeStart.assign(numPlanes + 1, 0);
+  for (auto kk = 0; kk < kmax; kk++) {
+    for (auto jj = 0; jj < jmax; jj++) {
+      for (auto ii = 0; ii < imax; ii++) {
+        planeStart[ii + jj + kk + 1]++;
+      }
+    }
+  }
+  std::partial_sum(std::begin(planeStart), std::end(planeStart),
+                   std::begin(planeStart));
+
+  // place each cell in next open position of its hyperplane
+  vector<vector3d<int>> reorder(imax * jmax * kmax);
+  auto next = planeStart;
+  for (auto kk = 0; kk < kmax; kk++) {
+    for (auto jj = 0; jj < jmax; jj++) {
+      for (auto ii = 0; ii < imax; ii++) {
+        reorder[next[ii + jj + kk]++] = vector3d<int>(ii, jj, kk);
       }
     }
   }
@@ -0,0 +1,130 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-17  Michael Nucci (michael.nucci@gmail.com)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+/* This test compares the batched Roe and Rusanov flux kernels with the scalar
+   RoeFlux() and RusanovFlux() functions on random face states. The batched
+   kernels add the same terms in the same order, so they only differ from the
+   scalar functions by the rounding of fused multiply-adds. Each batch is only
+   partly filled with faces, so the padded lanes are exercised as well.
+*/
+
+#include <iostream>                // cout, cerr, endl
+#include <random>                  // mt19937, uniform_real_distribution
+#include <cmath>                   // fabs
+#include <algorithm>               // max
+#include <string>                  // string
+#include <cstdlib>                 // EXIT_SUCCESS, EXIT_FAILURE
+#include "inviscidFlux.hpp"        // fluxBatch, RoeFlux, RusanovFlux
+#include "primVars.hpp"            // primVars
+#include "eos.hpp"                 // idealGas
+#include "vector3d.hpp"            // vector3d
+#include "inputOptions.hpp"        // inviscidFluxMethod
+#include "macros.hpp"              // NUMVARS
+
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::string;
+
+// largest difference allowed between batched and scalar fluxes, relative to
+// the largest component of the scalar flux
+constexpr double TOLERANCE = 1.0e-12;
+
+// function to compare the batched flux kernel with the scalar flux function
+// on random faces; returns the largest relative difference
+template <inviscidFluxMethod F>
+double CompareFluxes(const idealGas &eos, const int &numBatches,
+                     std::mt19937 &gen) {
+  // eos -- equation of state
+  // numBatches -- number of batches of faces to compare
+  // gen -- random number generator
+
+  // nondimensional states around freestream, including turbulence variables
+  std::uniform_real_distribution<double> rho(0.5, 2.0);
+  std::uniform_real_distribution<double> vel(-1.5, 1.5);
+  std::uniform_real_distribution<double> press(0.3, 1.5);
+  std::uniform_real_distribution<double> turb(1.0e-6, 1.0e-2);
+  std::uniform_real_distribution<double> dir(-1.0, 1.0);
+  std::uniform_int_distribution<int> faces(1, FLUXBATCH);
+
+  auto randomState = [&]() {
+    return primVars(rho(gen), vel(gen), vel(gen), vel(gen), press(gen),
+                    turb(gen), turb(gen));
+  };
+
+  auto maxDiff = 0.0;
+  for (auto bb = 0; bb < numBatches; bb++) {
+    fluxBatch batch;
+    primVars left[FLUXBATCH], right[FLUXBATCH];
+    vector3d<double> area[FLUXBATCH];
+    const auto numFaces = faces(gen);
+    for (auto ff = 0; ff < numFaces; ff++) {
+      left[ff] = randomState();
+      right[ff] = randomState();
+      area[ff] = vector3d<double>(dir(gen), dir(gen), dir(gen)).Normalize();
+      batch.SetFace(ff, left[ff], right[ff], area[ff]);
+    }
+    batch.PadFaces(numFaces);
+    NumericalFlux<F>(batch, eos);
+
+    for (auto ff = 0; ff < numFaces; ff++) {
+      const auto scalar = NumericalFlux<F>(left[ff], right[ff], eos, area[ff]);
+      const auto batched = batch.Flux(ff);
+      const double scalarVars[] = {scalar.RhoVel(), scalar.RhoVelU(),
+                                   scalar.RhoVelV(), scalar.RhoVelW(),
+                                   scalar.RhoVelH(), scalar.RhoVelK(),
+                                   scalar.RhoVelO()};
+      const double batchedVars[] = {batched.RhoVel(), batched.RhoVelU(),
+                                    batched.RhoVelV(), batched.RhoVelW(),
+                                    batched.RhoVelH(), batched.RhoVelK(),
+                                    batched.RhoVelO()};
+      auto scale = 0.0;
+      for (auto vv = 0; vv < NUMVARS; vv++) {
+        scale = std::max(scale, std::fabs(scalarVars[vv]));
+      }
+      for (auto vv = 0; vv < NUMVARS; vv++) {
+        maxDiff = std::max(maxDiff, std::fabs(batchedVars[vv] -
+                                              scalarVars[vv]) / scale);
+      }
+    }
+  }
+  return maxDiff;
+}
+
+int main() {
+  const idealGas eos(1.4, 287.058);
+  std::mt19937 gen(42);
+  constexpr auto numBatches = 10000;
+
+  const auto roeDiff =
+      CompareFluxes<inviscidFluxMethod::roe>(eos, numBatches, gen);
+  const auto rusanovDiff =
+      CompareFluxes<inviscidFluxMethod::rusanov>(eos, numBatches, gen);
+
+  auto passed = true;
+  auto report = [&](const string &name, const double &diff) {
+    cout << name << " flux: largest relative difference " << diff << endl;
+    if (diff > TOLERANCE) {
+      cerr << "ERROR: batched " << name << " flux differs from scalar "
+           << name << " flux by more than " << TOLERANCE << endl;
+      passed = false;
+    }
+  };
+  report("Roe", roeDiff);
+  report("Rusanov", rusanovDiff);
+
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -23,6 +23,7 @@ import shutil
 import sys
 import datetime
 import subprocess
+import hashlib
 
 class regressionTest:
     caseName = "none"
@@ -40,6 +41,10 @@ class regressionTest:
 
     def __init__(self):
         self.location = os.getcwd()
+        self.inputOptions = {}
+        self.outputChecksums = {}
+        self.outputSizes = {}
+        self.outputMessages = []
         
     def SetRegressionCase(self, name):
         self.caseName = name
@@ -76,6 +81,18 @@ class regressionTest:
 
     def SetRestartFile(self, resFile):
         self.restartFile = resFile
+
+    def SetInputOption(self, key, value):
+        self.inputOptions[key] = value
+
+    def SetOutputChecksum(self, fname, checksum):
+        self.outputChecksums[fname] = checksum
+
+    def SetOutputSize(self, fname, size):
+        self.outputSizes[fname] = size
+
+    def SetOutputMessage(self, message):
+        self.outputMessages.append(message)
         
     def ReturnToHomeDirectory(self):
         os.chdir(self.location)
@@ -104,23 +121,63 @@ class regressionTest:
             passing = [False for ii in resids]
         return passing, resids
         
+    # compare md5 checksums of output files with those expected
+    def CompareOutputFiles(self):
+        passing = []
+        for fname, checksum in sorted(self.outputChecksums.items()):
+            if os.path.isfile(fname):
+                with open(fname, "rb") as fin:
+                    fileChecksum = hashlib.md5(fin.read()).hexdigest()
+            else:
+                fileChecksum = "missing"
+            if (fileChecksum != checksum):
+                print("Checksum of", fname, "should be:", checksum)
+                print("Checksum of", fname, "is:", fileChecksum)
+            passing.append(fileChecksum == checksum)
+        for fname, size in sorted(self.outputSizes.items()):
+            if os.path.isfile(fname):
+                fileSize = os.path.getsize(fname)
+            else:
+                fileSize = "missing"
+            if (fileSize != size):
+                print("Size of", fname, "should be:", size)
+                print("Size of", fname, "is:", fileSize)
+            passing.append(fileSize == size)
+        if self.outputMessages:
+            with open(self.caseName + ".out", "r") as fin:
+                output = fin.read()
+            for message in self.outputMessages:
+                if message not in output:
+                    print("Output should contain:", message)
+                passing.append(message in output)
+        return passing
+
     def GetResiduals(self):
         return self.residuals
         
-    # change input file to have number of iterations specified for test
+    # change input file to have number of iterations and any input options
+    # specified for test; options not in the input file are added after the
+    # number of iterations
     def ModifyInputFile(self):
         fname = self.caseName + ".inp"
         fnameBackup = fname + ".old"
         shutil.move(fname, fnameBackup)
         with open(fname, "w") as fout:
             with open(fnameBackup, "r") as fin:
-                for line in fin:
-                    if "iterations:" in line:
-                        fout.write("iterations: " + str(self.iterations) + "\n")
-                    elif "outputFrequency:" in line:
-                        fout.write("outputFrequency: " + str(self.iterations) + "\n")
-                    else:
-                        fout.write(line)
+                lines = fin.readlines()
+            keys = [line.split(":")[0].strip() for line in lines]
+            for key, line in zip(keys, lines):
+                if key in self.inputOptions:
+                    fout.write(key + ": " + self.inputOptions[key] + "\n")
+                elif "iterations:" in line:
+                    fout.write("iterations: " + str(self.iterations) + "\n")
+                    for option, value in self.inputOptions.items():
+                        if option not in keys:
+                            fout.write(option + ": " + value + "\n")
+                elif "outputFrequency:" in line:
+                    fout.write("outputFrequency: " + str(self.iterations) + "\n")
+                else:
+                    fout.write(line)
                 
     # modify the input file and run the test
     def RunCase(self):
@@ -148,6 +205,7 @@ class regressionTest:
         
         # test residuals for pass/fail
         passed, resids = self.CompareResiduals(returnCode)
+        passed += self.CompareOutputFiles()
         if (all(passed)):
             print("All tests for", self.caseName, "passed!")
         else:
@@ -221,6 +279,11 @@ def main():
         multiCyl.SetResiduals([2.3188e-1, 2.9621e-1, 4.5868e-1, 1.2813, 2.3009e-1])
     multiCyl.SetIgnoreIndices(3)
     multiCyl.SetMpirunPath(options.mpirunPath)
+    # grid and initial solution must be byte-identical to the serial writer
+    multiCyl.SetOutputChecksum("multiblockCylinder_center.xyz",
+                               "7ddffbd0a2dcbafbf53d5016375c1883")
+    multiCyl.SetOutputChecksum("multiblockCylinder_0_center.fun",
+                               "d64f81031be406c8b1de1fe8127f73cc")
     
     # run regression case
     passed = multiCyl.RunCase()
@@ -255,6 +318,37 @@ def main():
     # run regression case
     passed = shockTubeRestart.RunCase()   
     totalPass = totalPass and all(passed)
+
+    # ------------------------------------------------------------------
+    # sod shock tube with lossless restart compression
+    # laminar, inviscid, bdf2, weno
+    shockTubeLossless = regressionTest()
+    shockTubeLossless.SetRegressionCase("shockTube")
+    shockTubeLossless.SetAitherPath(options.aitherPath)
+    shockTubeLossless.SetRunDirectory("shockTube")
+    shockTubeLossless.SetNumberOfProcessors(1)
+    shockTubeLossless.SetNumberOfIterations(numIterations)
+    shockTubeLossless.SetResiduals([5.0503e-1, 4.4569e-1, 1.0e0, 1.0e0, 2.6181e-1])
+    shockTubeLossless.SetIgnoreIndices(2)
+    shockTubeLossless.SetIgnoreIndices(3)
+    shockTubeLossless.SetInputOption("restartCompression", "lossless")
+    shockTubeLossless.SetMpirunPath(options.mpirunPath)
+
+    # run regression case
+    passed = shockTubeLossless.RunCase()
+    totalPass = totalPass and all(passed)
+
+    # ------------------------------------------------------------------
+    # sod shock tube restart from lossless compressed restart file
+    # laminar, inviscid, bdf2, weno
+    shockTubeLosslessRestart = shockTubeLossless
+    shockTubeLosslessRestart.SetNumberOfIterations(numIterationsRestart)
+    shockTubeLosslessRestart.SetRestart(True)
+    shockTubeLosslessRestart.SetRestartFile("shockTube_50.rst")
+
+    # run regression case
+    passed = shockTubeLosslessRestart.RunCase()
+    totalPass = totalPass and all(passed)
         
     # ------------------------------------------------------------------
     # supersonic wedge
@@ -310,6 +404,110 @@ def main():
     passed = viscPlate.RunCase()
     totalPass = totalPass and all(passed)        
 
+    # ------------------------------------------------------------------
+    # viscous flat plate with snapshot output
+    # laminar, viscous, lu-sgs, output written in background
+    viscPlateSnapshot = regressionTest()
+    viscPlateSnapshot.SetRegressionCase("viscousFlatPlate")
+    viscPlateSnapshot.SetAitherPath(options.aitherPath)
+    viscPlateSnapshot.SetRunDirectory("viscousFlatPlate")
+    viscPlateSnapshot.SetNumberOfProcessors(maxProcs)
+    viscPlateSnapshot.SetNumberOfIterations(numIterations)
+    viscPlateSnapshot.SetResiduals(viscPlate.GetResiduals())
+    viscPlateSnapshot.SetIgnoreIndices(3)
+    viscPlateSnapshot.SetInputOption("outputMode", "snapshot")
+    viscPlateSnapshot.SetInputOption("outputFrequency", "25")
+    viscPlateSnapshot.SetMpirunPath(options.mpirunPath)
+
+    # run regression case
+    passed = viscPlateSnapshot.RunCase()
+    totalPass = totalPass and all(passed)
+
+    # ------------------------------------------------------------------
+    # viscous flat plate with extractions
+    # laminar, viscous, lu-sgs, walls, plane, and range extractions
+    viscPlateExtract = regressionTest()
+    viscPlateExtract.SetRegressionCase("viscousFlatPlate")
+    viscPlateExtract.SetAitherPath(options.aitherPath)
+    viscPlateExtract.SetRunDirectory("viscousFlatPlate")
+    viscPlateExtract.SetNumberOfProcessors(maxProcs)
+    viscPlateExtract.SetNumberOfIterations(numIterations)
+    viscPlateExtract.SetResiduals(viscPlate.GetResiduals())
+    viscPlateExtract.SetIgnoreIndices(3)
+    viscPlateExtract.SetInputOption(
+        "extractions",
+        "<extraction(name=wall; type=walls; "
+        "variables=[pressureCoefficient, skinFriction]),\n"
+        "extraction(name=plane; type=plane; block=0; direction=j; index=10),\n"
+        "extraction(name=box; type=range; block=0; start=[20, 0, 0]; "
+        "end=[39, 9, 0])>")
+    viscPlateExtract.SetInputOption("extractFrequency", "25")
+    # extraction grids and initial solution do not depend on decomposition
+    viscPlateExtract.SetOutputChecksum("viscousFlatPlate_wall.xyz",
+                                       "3de10b879f440b1a3fefdedf3391a80b")
+    viscPlateExtract.SetOutputChecksum("viscousFlatPlate_plane.xyz",
+                                       "88b322363d7b3703a75d5b22965d94da")
+    viscPlateExtract.SetOutputChecksum("viscousFlatPlate_box.xyz",
+                                       "615e07426d19e876308ceda0c5a6b0e9")
+    viscPlateExtract.SetOutputChecksum("viscousFlatPlate_0_plane.fun",
+                                       "19abfcfea5ed496fff643c0ca8c9351f")
+    viscPlateExtract.SetOutputChecksum("viscousFlatPlate_0_box.fun",
+                                       "7304a53a5c0ff262af6f0a98ca73c54e")
+    viscPlateExtract.SetMpirunPath(options.mpirunPath)
+
+    # run regression case
+    passed = viscPlateExtract.RunCase()
+    totalPass = totalPass and all(passed)
+
+    # ------------------------------------------------------------------
+    # viscous flat plate with probes
+    # laminar, viscous, lu-sgs, probes with a small buffer so that samples
+    # are appended to the probe file several times
+    viscPlateProbe = regressionTest()
+    viscPlateProbe.SetRegressionCase("viscousFlatPlate")
+    viscPlateProbe.SetAitherPath(options.aitherPath)
+    viscPlateProbe.SetRunDirectory("viscousFlatPlate")
+    viscPlateProbe.SetNumberOfProcessors(maxProcs)
+    viscPlateProbe.SetNumberOfIterations(numIterations)
+    viscPlateProbe.SetResiduals(viscPlate.GetResiduals())
+    viscPlateProbe.SetIgnoreIndices(3)
+    viscPlateProbe.SetInputOption(
+        "probeLocations",
+        "<[0.05, 0.001, 0.01], [0.1, 0.005, 0.01], [0.15, 0.01, 0.01]>")
+    viscPlateProbe.SetInputOption("probeFrequency", "1")
+    viscPlateProbe.SetInputOption("probeBufferSize", "16")
+    # header is probe and variable counts, variable names, and probe
+    # locations; each sample is the iteration and a value per probe variable
+    probeHeader = 4 + 4 + (4 + 5) * 3 + (4 + 8) + 3 * 3 * 8
+    probeSample = (1 + 3 * 4) * 8
+    viscPlateProbe.SetOutputSize("viscousFlatPlate.probe",
+                                 probeHeader + numIterations * probeSample)
+    viscPlateProbe.SetMpirunPath(options.mpirunPath)
+
+    # run regression case
+    passed = viscPlateProbe.RunCase()
+    totalPass = totalPass and all(passed)
+
+    # ------------------------------------------------------------------
+    # viscous flat plate on 3 processors
+    # laminar, viscous, lu-sgs, three blocks on different processors meet
+    # at a corner, so the residual calculated while the halo exchange is in
+    # flight must match the non-overlapped residual to roundoff
+    viscPlate3 = regressionTest()
+    viscPlate3.SetRegressionCase("viscousFlatPlate")
+    viscPlate3.SetAitherPath(options.aitherPath)
+    viscPlate3.SetRunDirectory("viscousFlatPlate")
+    viscPlate3.SetNumberOfProcessors(3)
+    viscPlate3.SetNumberOfIterations(numIterations)
+    viscPlate3.SetResiduals([7.6140e-2, 2.4712e-1, 5.5213e-2, 9.1712e-1, 7.8174e-2])
+    viscPlate3.SetIgnoreIndices(3)
+    viscPlate3.SetPercentTolerance(1.0e-4)
+    viscPlate3.SetMpirunPath(options.mpirunPath)
+
+    # run regression case
+    passed = viscPlate3.RunCase()
+    totalPass = totalPass and all(passed)
+
     # ------------------------------------------------------------------
     # turbulent flat plate
     # viscous, lu-sgs, k-w wilcox
@@ -332,6 +530,50 @@ def main():
     passed = turbPlate.RunCase()
     totalPass = totalPass and all(passed)        
 
+    # ------------------------------------------------------------------
+    # turbulent flat plate with geometry cache
+    # viscous, lu-sgs, k-w wilcox, geometry and wall distance are cached by
+    # the first run and read from the cache by the second
+    turbPlateCache = regressionTest()
+    turbPlateCache.SetRegressionCase("turbFlatPlate")
+    turbPlateCache.SetAitherPath(options.aitherPath)
+    turbPlateCache.SetRunDirectory("turbFlatPlate")
+    turbPlateCache.SetNumberOfProcessors(maxProcs)
+    turbPlateCache.SetNumberOfIterations(numIterations)
+    turbPlateCache.SetResiduals(turbPlate.GetResiduals())
+    turbPlateCache.SetIgnoreIndices(2)
+    turbPlateCache.SetInputOption("geometryCache", "turbFlatPlate.cache")
+    turbPlateCache.SetMpirunPath(options.mpirunPath)
+
+    # run regression case
+    passed = turbPlateCache.RunCase()
+    totalPass = totalPass and all(passed)
+
+    # rerun with same grid and decomposition, so cache is reused
+    turbPlateCache.SetOutputMessage(
+        "Geometry and wall distance read from cache turbFlatPlate.cache")
+    passed = turbPlateCache.RunCase()
+    totalPass = totalPass and all(passed)
+
+    # ------------------------------------------------------------------
+    # turbulent flat plate with eikonal wall distance
+    # viscous, lu-sgs, k-w wilcox
+    turbPlateEikonal = regressionTest()
+    turbPlateEikonal.SetRegressionCase("turbFlatPlate")
+    turbPlateEikonal.SetAitherPath(options.aitherPath)
+    turbPlateEikonal.SetRunDirectory("turbFlatPlate")
+    turbPlateEikonal.SetNumberOfProcessors(1)
+    turbPlateEikonal.SetNumberOfIterations(numIterations)
+    turbPlateEikonal.SetResiduals([3.9321e-2, 4.2746e-2, 8.4941e-1, 7.4586e-2, 3.8140e-2,
+                                   4.7594e-8, 1.1619e-5])
+    turbPlateEikonal.SetIgnoreIndices(2)
+    turbPlateEikonal.SetInputOption("wallDistance", "eikonal")
+    turbPlateEikonal.SetMpirunPath(options.mpirunPath)
+
+    # run regression case
+    passed = turbPlateEikonal.RunCase()
+    totalPass = totalPass and all(passed)
+
     # ------------------------------------------------------------------
     # rae2822
     # turbulent, k-w sst, c-grid